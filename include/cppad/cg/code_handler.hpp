@@ -160,6 +160,22 @@ protected:
      * executing the operation graph
      */
     bool _zeroDependents;
+    /**
+     * whether or not to apply algebraic simplifications to the operation
+     * graph before generating source code
+     */
+    bool _simplify;
+    /**
+     * whether or not divisions by constants are replaced by multiplications
+     * with the reciprocal (changes rounding)
+     */
+    bool _divByConstAsMult;
+    /**
+     * the number of operations of each type before and after the last
+     * algebraic simplification
+     */
+    std::map<CGOpCode, size_t> _opCountBeforeSimplify;
+    std::map<CGOpCode, size_t> _opCountAfterSimplify;
     //
     bool _verbose;
     /**
@@ -280,6 +296,52 @@ public:
      */
     inline void setZeroDependents(bool zeroDependents);
 
+    /**
+     * Whether or not algebraic simplifications are applied to the operation
+     * graph when source code is generated.
+     */
+    inline bool isSimplifyOperations() const;
+
+    /**
+     * Defines whether or not to apply algebraic simplifications to the
+     * operation graph when source code is generated (disabled by default).
+     * Constants are folded, identities (x+0, x*1, x/1, -(-x), ...) are
+     * removed, pow(x, k) is replaced by multiplications for small integer
+     * values of k and pow(x, 0.5) by sqrt(x).
+     * The operation graph is permanently modified.
+     *
+     * @param simplify true to enable the simplifications
+     */
+    inline void setSimplifyOperations(bool simplify);
+
+    /**
+     * Whether or not divisions by constants are replaced by multiplications
+     * with their reciprocal during the algebraic simplifications.
+     */
+    inline bool isDivisionByConstantAsMultiplication() const;
+
+    /**
+     * Defines whether or not divisions by constants are replaced by
+     * multiplications with their reciprocal during the algebraic
+     * simplifications (disabled by default).
+     * The results can change due to different rounding.
+     *
+     * @param divAsMult true to enable this replacement
+     */
+    inline void setDivisionByConstantAsMultiplication(bool divAsMult);
+
+    /**
+     * Provides the number of operations of each type reachable from the
+     * dependents before the last algebraic simplification.
+     */
+    inline const std::map<CGOpCode, size_t>& getOperationCountBeforeSimplification() const;
+
+    /**
+     * Provides the number of operations of each type reachable from the
+     * dependents after the last algebraic simplification.
+     */
+    inline const std::map<CGOpCode, size_t>& getOperationCountAfterSimplification() const;
+
     inline size_t getOperationTreeVisitId() const;
 
     inline void startNewOperationTreeVisit();
@@ -699,6 +761,23 @@ protected:
 
     inline void reduceTemporaryVariables(ArrayView<CGB>& dependent);
 
+    /**
+     * Applies algebraic simplifications and strength reductions to the
+     * operations used by the dependents.
+     */
+    inline void simplifyOperations(ArrayView<CGB>& dependent);
+
+    /**
+     * Simplifies a single operation whose arguments have already been
+     * simplified.
+     */
+    inline void simplifyOperation(Node& node);
+
+    inline void countOperations(ArrayView<CGB>& dependent,
+                                std::map<CGOpCode, size_t>& count);
+
+    static inline bool isSimplifiable(CGOpCode op);
+
     /**
      * Change operation order so that the total number of temporary variables is
      * reduced.
@@ -41,6 +41,8 @@ CodeHandler<Base>::CodeHandler(size_t varCount) :
         _lang(nullptr),
         _minTemporaryVarID(0),
         _zeroDependents(false),
+        _simplify(false),
+        _divByConstAsMult(false),
         _verbose(false),
         _jobTimer(nullptr) {
     _codeBlocks.reserve(varCount);
@@ -135,6 +137,36 @@ inline void CodeHandler<Base>::setZeroDependents(bool zeroDependents) {
     _zeroDependents = zeroDependents;
 }
 
+template<class Base>
+inline bool CodeHandler<Base>::isSimplifyOperations() const {
+    return _simplify;
+}
+
+template<class Base>
+inline void CodeHandler<Base>::setSimplifyOperations(bool simplify) {
+    _simplify = simplify;
+}
+
+template<class Base>
+inline bool CodeHandler<Base>::isDivisionByConstantAsMultiplication() const {
+    return _divByConstAsMult;
+}
+
+template<class Base>
+inline void CodeHandler<Base>::setDivisionByConstantAsMultiplication(bool divAsMult) {
+    _divByConstAsMult = divAsMult;
+}
+
+template<class Base>
+inline const std::map<CGOpCode, size_t>& CodeHandler<Base>::getOperationCountBeforeSimplification() const {
+    return _opCountBeforeSimplify;
+}
+
+template<class Base>
+inline const std::map<CGOpCode, size_t>& CodeHandler<Base>::getOperationCountAfterSimplification() const {
+    return _opCountAfterSimplify;
+}
+
 template<class Base>
 size_t CodeHandler<Base>::getIndependentVariableIndex(const Node& var) const {
     CPPADCG_ASSERT_UNKNOWN(var.getOperationType() == CGOpCode::Inv);
@@ -288,6 +320,14 @@ void CodeHandler<Base>::generateCode(std::ostream& out,
     _atomicFunctionsOrder = &atomicFunctions;
     _atomicFunctionsMaxForward.resize(atomicFunctions.size());
     _atomicFunctionsMaxReverse.resize(atomicFunctions.size());
+
+    /**
+     * algebraic simplifications (might create new nodes)
+     */
+    if (_simplify) {
+        simplifyOperations(dependent);
+    }
+
     _atomicFunctionName2Index.clear();
     _loops.prepare4NewSourceGen();
     _scopeColorCount = 0;
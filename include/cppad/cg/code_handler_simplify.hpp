@@ -0,0 +1,326 @@
+#ifndef CPPAD_CG_CODE_HANDLER_SIMPLIFY_INCLUDED
+#define CPPAD_CG_CODE_HANDLER_SIMPLIFY_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+template<class Base>
+inline bool CodeHandler<Base>::isSimplifiable(CGOpCode op) {
+    switch (op) {
+        case CGOpCode::Abs:
+        case CGOpCode::Acos:
+        case CGOpCode::Add:
+        case CGOpCode::Asin:
+        case CGOpCode::Atan:
+        case CGOpCode::Cosh:
+        case CGOpCode::Cos:
+        case CGOpCode::Div:
+        case CGOpCode::Exp:
+        case CGOpCode::Log:
+        case CGOpCode::Mul:
+        case CGOpCode::Pow:
+        case CGOpCode::Sinh:
+        case CGOpCode::Sin:
+        case CGOpCode::Sqrt:
+        case CGOpCode::Sub:
+        case CGOpCode::Tanh:
+        case CGOpCode::Tan:
+        case CGOpCode::UnMinus:
+            return true;
+        default:
+            return false;
+    }
+}
+
+template<class Base>
+inline void CodeHandler<Base>::countOperations(ArrayView<CGB>& dependent,
+                                               std::map<CGOpCode, size_t>& count) {
+    count.clear();
+
+    std::set<const Node*> visited;
+    std::vector<const Node*> stack;
+
+    for (size_t i = 0; i < dependent.size(); i++) {
+        const Node* node = dependent[i].getOperationNode();
+        if (node != nullptr && visited.insert(node).second)
+            stack.push_back(node);
+    }
+
+    while (!stack.empty()) {
+        const Node* node = stack.back();
+        stack.pop_back();
+
+        if (node->getOperationType() != CGOpCode::Alias)
+            count[node->getOperationType()]++;
+
+        for (const Arg& a : node->getArguments()) {
+            const Node* arg = a.getOperation();
+            if (arg != nullptr && visited.insert(arg).second)
+                stack.push_back(arg);
+        }
+    }
+}
+
+template<class Base>
+inline void CodeHandler<Base>::simplifyOperations(ArrayView<CGB>& dependent) {
+    countOperations(dependent, _opCountBeforeSimplify);
+
+    /**
+     * visit the nodes so that the arguments are simplified before the
+     * operations which use them (new nodes are never visited)
+     */
+    size_t nNodes = _codeBlocks.size();
+    std::vector<bool> visited(nNodes, false);
+    std::vector<std::pair<Node*, size_t> > stack;
+
+    for (size_t i = 0; i < dependent.size(); i++) {
+        Node* root = dependent[i].getOperationNode();
+        if (root == nullptr || root->getHandlerPosition() >= nNodes || visited[root->getHandlerPosition()])
+            continue;
+
+        visited[root->getHandlerPosition()] = true;
+        stack.emplace_back(root, 0);
+
+        while (!stack.empty()) {
+            Node* node = stack.back().first;
+            size_t& a = stack.back().second;
+            const std::vector<Arg>& args = node->getArguments();
+
+            if (a < args.size()) {
+                Node* arg = args[a].getOperation();
+                a++;
+                if (arg != nullptr && arg->getHandlerPosition() < nNodes && !visited[arg->getHandlerPosition()]) {
+                    visited[arg->getHandlerPosition()] = true;
+                    stack.emplace_back(arg, 0);
+                }
+                continue;
+            }
+
+            stack.pop_back();
+            simplifyOperation(*node);
+        }
+    }
+
+    countOperations(dependent, _opCountAfterSimplify);
+
+    if (_verbose) {
+        std::cout << "\n  operations (before -> after simplification):\n";
+        std::set<CGOpCode> ops;
+        for (const auto& it : _opCountBeforeSimplify)
+            ops.insert(it.first);
+        for (const auto& it : _opCountAfterSimplify)
+            ops.insert(it.first);
+
+        for (CGOpCode op : ops) {
+            auto itB = _opCountBeforeSimplify.find(op);
+            auto itA = _opCountAfterSimplify.find(op);
+            std::cout << "    " << op << ": "
+                    << (itB == _opCountBeforeSimplify.end() ? 0 : itB->second) << " -> "
+                    << (itA == _opCountAfterSimplify.end() ? 0 : itA->second) << "\n";
+        }
+        std::cout.flush();
+    }
+}
+
+template<class Base>
+inline void CodeHandler<Base>::simplifyOperation(Node& node) {
+    using std::abs;
+    using std::acos;
+    using std::asin;
+    using std::atan;
+    using std::cosh;
+    using std::cos;
+    using std::exp;
+    using std::log;
+    using std::pow;
+    using std::sinh;
+    using std::sin;
+    using std::sqrt;
+    using std::tanh;
+    using std::tan;
+
+    const CGOpCode op = node.getOperationType();
+    if (!isSimplifiable(op))
+        return;
+
+    std::vector<Arg>& args = node.getArguments();
+
+    /**
+     * follow aliases and assignments of constants
+     */
+    bool allParameters = true;
+    for (Arg& a : args) {
+        while (a.getOperation() != nullptr) {
+            Node* n = a.getOperation();
+            if (n->getOperationType() == CGOpCode::Alias ||
+                    (n->getOperationType() == CGOpCode::Assign && n->getArguments()[0].getParameter() != nullptr)) {
+                CPPADCG_ASSERT_UNKNOWN(n->getArguments().size() == 1);
+                Arg aa = n->getArguments()[0];
+                a = aa;
+            } else {
+                break;
+            }
+        }
+        if (a.getParameter() == nullptr)
+            allParameters = false;
+    }
+
+    auto makeConstant = [&node](const Base& value) {
+        node.setOperation(CGOpCode::Assign, {Arg(value)});
+    };
+
+    auto makeSameAs = [&node](const Arg& arg) {
+        if (arg.getParameter() != nullptr)
+            node.setOperation(CGOpCode::Assign, {arg});
+        else
+            node.setOperation(CGOpCode::Alias, {arg});
+    };
+
+    auto isValue = [](const Arg& arg, double v) {
+        return arg.getParameter() != nullptr && *arg.getParameter() == Base(v);
+    };
+
+    /**
+     * constant folding
+     */
+    if (allParameters) {
+        if (args.size() == 1) {
+            const Base& x = *args[0].getParameter();
+            switch (op) {
+                case CGOpCode::Abs: return makeConstant(abs(x));
+                case CGOpCode::Acos: return makeConstant(acos(x));
+                case CGOpCode::Asin: return makeConstant(asin(x));
+                case CGOpCode::Atan: return makeConstant(atan(x));
+                case CGOpCode::Cosh: return makeConstant(cosh(x));
+                case CGOpCode::Cos: return makeConstant(cos(x));
+                case CGOpCode::Exp: return makeConstant(exp(x));
+                case CGOpCode::Log: return makeConstant(log(x));
+                case CGOpCode::Sinh: return makeConstant(sinh(x));
+                case CGOpCode::Sin: return makeConstant(sin(x));
+                case CGOpCode::Sqrt: return makeConstant(sqrt(x));
+                case CGOpCode::Tanh: return makeConstant(tanh(x));
+                case CGOpCode::Tan: return makeConstant(tan(x));
+                case CGOpCode::UnMinus: return makeConstant(-x);
+                default: return;
+            }
+        } else if (args.size() == 2) {
+            const Base& x = *args[0].getParameter();
+            const Base& y = *args[1].getParameter();
+            switch (op) {
+                case CGOpCode::Add: return makeConstant(x + y);
+                case CGOpCode::Sub: return makeConstant(x - y);
+                case CGOpCode::Mul: return makeConstant(x * y);
+                case CGOpCode::Div: return makeConstant(x / y);
+                case CGOpCode::Pow: return makeConstant(pow(x, y));
+                default: return;
+            }
+        }
+        return;
+    }
+
+    /**
+     * identities and strength reduction
+     * (infinity and NaN are not considered, as in the CG operators)
+     */
+    switch (op) {
+        case CGOpCode::Add:
+            if (isValue(args[0], 0)) {
+                makeSameAs(args[1]);
+            } else if (isValue(args[1], 0)) {
+                makeSameAs(args[0]);
+            }
+            break;
+
+        case CGOpCode::Sub:
+            if (isValue(args[1], 0)) {
+                makeSameAs(args[0]);
+            } else if (isValue(args[0], 0)) {
+                node.setOperation(CGOpCode::UnMinus, {args[1]});
+                simplifyOperation(node);
+            }
+            break;
+
+        case CGOpCode::Mul:
+            if (isValue(args[0], 0) || isValue(args[1], 0)) {
+                makeConstant(Base(0));
+            } else if (isValue(args[0], 1)) {
+                makeSameAs(args[1]);
+            } else if (isValue(args[1], 1)) {
+                makeSameAs(args[0]);
+            } else if (isValue(args[0], -1)) {
+                node.setOperation(CGOpCode::UnMinus, {args[1]});
+                simplifyOperation(node);
+            } else if (isValue(args[1], -1)) {
+                node.setOperation(CGOpCode::UnMinus, {args[0]});
+                simplifyOperation(node);
+            }
+            break;
+
+        case CGOpCode::Div:
+            if (isValue(args[0], 0)) {
+                makeConstant(Base(0));
+            } else if (isValue(args[1], 1)) {
+                makeSameAs(args[0]);
+            } else if (isValue(args[1], -1)) {
+                node.setOperation(CGOpCode::UnMinus, {args[0]});
+                simplifyOperation(node);
+            } else if (_divByConstAsMult && args[1].getParameter() != nullptr && !isValue(args[1], 0)) {
+                Base inv = Base(1) / *args[1].getParameter();
+                node.setOperation(CGOpCode::Mul, {args[0], Arg(inv)});
+            }
+            break;
+
+        case CGOpCode::UnMinus:
+            if (args[0].getOperation() != nullptr && args[0].getOperation()->getOperationType() == CGOpCode::UnMinus) {
+                Arg inner = args[0].getOperation()->getArguments()[0];
+                makeSameAs(inner);
+            }
+            break;
+
+        case CGOpCode::Pow:
+            if (args[1].getParameter() != nullptr) {
+                const Base& k = *args[1].getParameter();
+                Arg x = args[0];
+                if (k == Base(0)) {
+                    makeConstant(Base(1));
+                } else if (k == Base(1)) {
+                    makeSameAs(x);
+                } else if (k == Base(2)) {
+                    node.setOperation(CGOpCode::Mul, {x, x});
+                } else if (k == Base(3)) {
+                    Node* x2 = makeNode(CGOpCode::Mul, {x, x});
+                    node.setOperation(CGOpCode::Mul, {Arg(*x2), x});
+                } else if (k == Base(4)) {
+                    Node* x2 = makeNode(CGOpCode::Mul, {x, x});
+                    node.setOperation(CGOpCode::Mul, {Arg(*x2), Arg(*x2)});
+                } else if (k == Base(0.5)) {
+                    node.setOperation(CGOpCode::Sqrt, {x});
+                } else if (k == Base(-1)) {
+                    node.setOperation(CGOpCode::Div, {Arg(Base(1)), x});
+                }
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
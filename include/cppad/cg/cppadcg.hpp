@@ -22,6 +22,7 @@
 #include <array>
 #include <assert.h>
 #include <cstddef>
+#include <cstdint>
 #include <errno.h>
 #include <fstream>
 #include <iomanip>
@@ -43,9 +44,18 @@
 #include <sstream>
 #include <string>
 #include <string.h>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <tuple>
+#include <type_traits>
 #include <chrono>
 #include <thread>
 #include <functional>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
 
 // ---------------------------------------------------------------------------
 // operating system detection
@@ -129,6 +139,7 @@
 #include <cppad/cg/code_handler_impl.hpp>
 #include <cppad/cg/code_handler_vector.hpp>
 #include <cppad/cg/code_handler_loops.hpp>
+#include <cppad/cg/code_handler_simplify.hpp>
 
 // ---------------------------------------------------------------------------
 #include <cppad/cg/base_double.hpp>
@@ -158,6 +169,15 @@
 #include <cppad/cg/graph_mod.hpp>
 #include <cppad/cg/operation_node_name_streambuf.hpp>
 
+// ---------------------------------------------------------------------------
+// graph optimization
+#include <cppad/cg/optimization/graph_optimization_pass.hpp>
+#include <cppad/cg/optimization/evaluator_clone.hpp>
+#include <cppad/cg/optimization/evaluator_cse.hpp>
+#include <cppad/cg/optimization/evaluator_canonical.hpp>
+#include <cppad/cg/optimization/graph_optimization_passes.hpp>
+#include <cppad/cg/optimization/graph_optimizer.hpp>
+
 // ---------------------------------------------------------------------------
 // atomic function utilities
 #include <cppad/cg/custom_position.hpp>
@@ -181,11 +201,13 @@
 // ---------------------------------------------------------------------------
 // C source code generation
 #include <cppad/cg/lang/c/lang_c_atomic_fun.hpp>
+#include <cppad/cg/lang/c/lang_c_constant_pool.hpp>
 #include <cppad/cg/lang/c/language_c.hpp>
 #include <cppad/cg/lang/c/language_c_arrays.hpp>
 #include <cppad/cg/lang/c/language_c_index_patterns.hpp>
 #include <cppad/cg/lang/c/language_c_double.hpp>
 #include <cppad/cg/lang/c/language_c_float.hpp>
+#include <cppad/cg/lang/c/language_c_single_precision.hpp>
 #include <cppad/cg/lang/c/language_c_loops.hpp>
 #include <cppad/cg/lang/c/lang_c_default_var_name_gen.hpp>
 #include <cppad/cg/lang/c/lang_c_default_hessian_var_name_gen.hpp>
@@ -193,9 +215,15 @@
 #include <cppad/cg/lang/c/lang_c_custom_var_name_gen.hpp>
 #include <cppad/cg/lang/c/lang_c_util.hpp>
 
+// ---------------------------------------------------------------------------
+// bytecode generation
+#include <cppad/cg/lang/bytecode/bytecode_program.hpp>
+#include <cppad/cg/lang/bytecode/language_bytecode.hpp>
+
 //
 #include <cppad/cg/model/threadpool/multi_threading_type.hpp>
 #include <cppad/cg/model/threadpool/thread_pool_schedule_strategy.hpp>
+#include <cppad/cg/model/threadpool/thread_pool_affinity_policy.hpp>
 #include <cppad/cg/model/external_function_wrapper.hpp>
 #include <cppad/cg/model/atomic_external_function_wrapper.hpp>
 #include <cppad/cg/model/generic_model_external_function_wrapper.hpp>
@@ -204,13 +232,16 @@
 #include <cppad/cg/model/generic_model.hpp>
 #include <cppad/cg/model/functor_generic_model.hpp>
 #include <cppad/cg/model/functor_model_library.hpp>
+#include <cppad/cg/model/bytecode_model.hpp>
 #include <cppad/cg/model/save_files_model_library_processor.hpp>
+#include <cppad/cg/model/model_fingerprint.hpp>
 
 // automated static library creation
 #include <cppad/cg/model/dynamic_lib/archiver.hpp>
 #include <cppad/cg/model/dynamic_lib/ar_archiver.hpp>
 
 // compiler
+#include <cppad/cg/model/compiler/source_statistics.hpp>
 #include <cppad/cg/model/compiler/c_compiler.hpp>
 #include <cppad/cg/model/compiler/abstract_c_compiler.hpp>
 #include <cppad/cg/model/compiler/gcc_compiler.hpp>
@@ -232,6 +263,8 @@
 #include <cppad/cg/model/model_c_source_gen_rev2.hpp>
 #include <cppad/cg/model/model_c_source_gen_jac.hpp>
 #include <cppad/cg/model/model_c_source_gen_hes.hpp>
+#include <cppad/cg/model/model_c_source_gen_params.hpp>
+#include <cppad/cg/model/model_c_source_gen_fingerprint.hpp>
 #include <cppad/cg/model/patterns/model_c_source_gen_loops.hpp>
 #include <cppad/cg/model/patterns/model_c_source_gen_loops_for0.hpp>
 #include <cppad/cg/model/patterns/model_c_source_gen_loops_for1.hpp>
@@ -246,6 +279,7 @@
 // automated dynamic library creation
 #include <cppad/cg/model/dynamic_lib/dynamiclib.hpp>
 #include <cppad/cg/model/dynamic_lib/dynamic_library_processor.hpp>
+#include <cppad/cg/model/hot_swap_model.hpp>
 
 // ---------------------------------------------------------------------------
 // automated dynamic library creation for Linux
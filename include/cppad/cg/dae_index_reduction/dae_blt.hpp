@@ -0,0 +1,497 @@
+#ifndef CPPAD_CG_DAE_BLT_INCLUDED
+#define CPPAD_CG_DAE_BLT_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#include <cppad/cg/dae_index_reduction/dae_index_reduction.hpp>
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A diagonal block of a block lower triangular (BLT) decomposition of a
+ * DAE system.
+ * The equations of a block must be solved simultaneously for the
+ * block variables once the variables of all the previous blocks are known.
+ */
+class DaeBltBlock {
+private:
+    /**
+     * Equation indexes (in the model)
+     */
+    std::vector<size_t> equations_;
+    /**
+     * Variable tape indexes; variables_[k] is matched with equations_[k]
+     */
+    std::vector<size_t> variables_;
+public:
+
+    inline DaeBltBlock() {
+    }
+
+    inline DaeBltBlock(const std::vector<size_t>& equations,
+                       const std::vector<size_t>& variables) :
+        equations_(equations),
+        variables_(variables) {
+    }
+
+    /**
+     * Provides the equation indexes of this block.
+     */
+    inline const std::vector<size_t>& getEquations() const {
+        return equations_;
+    }
+
+    /**
+     * Provides the variable tape indexes solved by this block
+     * (in the same order as the equations they are matched to).
+     */
+    inline const std::vector<size_t>& getVariables() const {
+        return variables_;
+    }
+
+    /**
+     * The number of equations (and variables) in this block.
+     */
+    inline size_t size() const {
+        return equations_.size();
+    }
+
+    /**
+     * Whether or not this block contains a single equation which can be
+     * solved for a single variable.
+     */
+    inline bool isScalar() const {
+        return equations_.size() == 1;
+    }
+
+    inline virtual ~DaeBltBlock() {
+    }
+};
+
+/**
+ * Determines the block lower triangular (BLT) decomposition of an
+ * index 1 DAE system (typically the result of a DAE index reduction).
+ *
+ * Equations are matched to the unknowns of the system (algebraic variables
+ * and time derivatives) and the strongly connected components of the
+ * resulting directed graph are determined using the algorithm of Tarjan.
+ * Blocks are provided in the order in which they must be solved.
+ */
+template<class Base>
+class DaeBltDecomposition : public SimpleLogger {
+protected:
+    using CGBase = CG<Base>;
+    using ADCG = AD<CGBase>;
+protected:
+    /**
+     * The index 1 DAE model
+     */
+    ADFun<CGBase>* const fun_;
+    /**
+     * Variable information (in the same order as in the tape)
+     */
+    const std::vector<DaeVarInfo> varInfo_;
+    /**
+     * Equation information (in the same order as in the tape)
+     */
+    const std::vector<DaeEquationInfo> eqInfo_;
+    /**
+     * The model Jacobian sparsity pattern
+     */
+    std::vector<std::set<size_t> > jacSparsity_;
+    /**
+     * The BLT blocks in the order in which they must be solved
+     */
+    std::vector<DaeBltBlock> blocks_;
+    /**
+     * The models with the residuals of each block
+     */
+    std::vector<std::unique_ptr<ADFun<CGBase> > > blockFuns_;
+public:
+
+    /**
+     * Creates a new BLT decomposition for an index 1 DAE system.
+     *
+     * @param fun The index 1 DAE model (should only be deleted after this
+     *            object)
+     * @param varInfo Variable related information of the model (e.g. the
+     *                one provided by DaeIndexReduction::reduceIndex())
+     * @param eqInfo Equation related information of the model (e.g. the
+     *               one provided by DaeIndexReduction::reduceIndex())
+     */
+    DaeBltDecomposition(ADFun<CGBase>& fun,
+                        const std::vector<DaeVarInfo>& varInfo,
+                        const std::vector<DaeEquationInfo>& eqInfo) :
+        fun_(&fun),
+        varInfo_(varInfo),
+        eqInfo_(eqInfo) {
+        CPPADCG_ASSERT_KNOWN(varInfo.size() == fun.Domain(), "Invalid variable information size");
+        CPPADCG_ASSERT_KNOWN(eqInfo.size() == fun.Range(), "Invalid equation information size");
+    }
+
+    DaeBltDecomposition(const DaeBltDecomposition&) = delete;
+    DaeBltDecomposition& operator=(const DaeBltDecomposition&) = delete;
+
+    inline virtual ~DaeBltDecomposition() {
+    }
+
+    /**
+     * Whether or not a variable is an unknown of the index 1 system,
+     * that is, an algebraic variable or a time derivative.
+     * Differential variables, constants and the integrated variable are
+     * assumed to be known when the system is solved.
+     *
+     * @param j the variable tape index
+     */
+    inline bool isUnknown(size_t j) const {
+        const DaeVarInfo& v = varInfo_[j];
+        return !v.isIntegratedVariable() && v.isFunctionOfIntegrated() && v.getDerivative() < 0;
+    }
+
+    /**
+     * Determines the BLT decomposition of the model.
+     *
+     * @return the diagonal blocks in the order in which they must be solved
+     * @throws CGException if the system is structurally singular
+     */
+    inline const std::vector<DaeBltBlock>& decompose() {
+        using std::vector;
+
+        const size_t m = eqInfo_.size();
+
+        blocks_.clear();
+        blockFuns_.clear();
+
+        jacSparsity_ = jacobianSparsitySet<vector<std::set<size_t> > >(*fun_);
+
+        /**
+         * match equations to unknowns
+         */
+        vector<int> eq2Var = matchEquations();
+
+        vector<int> var2Eq(varInfo_.size(), -1);
+        for (size_t i = 0; i < m; ++i) {
+            var2Eq[eq2Var[i]] = i;
+        }
+
+        /**
+         * directed graph: equation i depends on equation k when it uses
+         *                 the unknown matched to k
+         */
+        vector<vector<size_t> > deps(m);
+        for (size_t i = 0; i < m; ++i) {
+            for (size_t j : jacSparsity_[i]) {
+                int k = var2Eq[j];
+                if (k >= 0 && size_t(k) != i)
+                    deps[i].push_back(k);
+            }
+        }
+
+        /**
+         * Tarjan's strongly connected components (non-recursive)
+         *
+         * components are found in reverse topological order which
+         * corresponds to the order in which blocks must be solved
+         */
+        const size_t undefined = std::numeric_limits<size_t>::max();
+        vector<size_t> index(m, undefined);
+        vector<size_t> lowLink(m, 0);
+        vector<bool> onStack(m, false);
+        vector<size_t> stack;
+        vector<std::pair<size_t, size_t> > callStack; // equation, next dependency position
+        size_t counter = 0;
+
+        for (size_t start = 0; start < m; ++start) {
+            if (index[start] != undefined)
+                continue;
+
+            callStack.push_back(std::make_pair(start, 0));
+
+            while (!callStack.empty()) {
+                size_t i = callStack.back().first;
+                size_t& pos = callStack.back().second;
+
+                if (pos == 0 && index[i] == undefined) {
+                    index[i] = counter;
+                    lowLink[i] = counter;
+                    counter++;
+                    stack.push_back(i);
+                    onStack[i] = true;
+                }
+
+                if (pos < deps[i].size()) {
+                    size_t k = deps[i][pos];
+                    pos++;
+                    if (index[k] == undefined) {
+                        callStack.push_back(std::make_pair(k, 0));
+                    } else if (onStack[k]) {
+                        lowLink[i] = std::min(lowLink[i], index[k]);
+                    }
+                    continue;
+                }
+
+                // all dependencies visited
+                if (lowLink[i] == index[i]) {
+                    vector<size_t> eqs;
+                    size_t k;
+                    do {
+                        k = stack.back();
+                        stack.pop_back();
+                        onStack[k] = false;
+                        eqs.push_back(k);
+                    } while (k != i);
+
+                    std::sort(eqs.begin(), eqs.end());
+                    vector<size_t> vars(eqs.size());
+                    for (size_t e = 0; e < eqs.size(); ++e) {
+                        vars[e] = eq2Var[eqs[e]];
+                    }
+                    blocks_.push_back(DaeBltBlock(eqs, vars));
+                }
+
+                callStack.pop_back();
+                if (!callStack.empty()) {
+                    size_t parent = callStack.back().first;
+                    lowLink[parent] = std::min(lowLink[parent], lowLink[i]);
+                }
+            }
+        }
+
+        if (this->verbosity_ >= Verbosity::Low) {
+            log() << "########  BLT decomposition  ########\n"
+                    << "# " << blocks_.size() << " blocks for " << m << " equations\n";
+            if (this->verbosity_ >= Verbosity::High) {
+                for (size_t b = 0; b < blocks_.size(); ++b) {
+                    log() << "# block " << b << ":";
+                    for (size_t e = 0; e < blocks_[b].size(); ++e) {
+                        log() << " (" << blocks_[b].getEquations()[e] << ", "
+                                << varInfo_[blocks_[b].getVariables()[e]].getName() << ")";
+                    }
+                    log() << "\n";
+                }
+            }
+            log() << std::endl;
+        }
+
+        return blocks_;
+    }
+
+    /**
+     * Provides the blocks determined by the last call to decompose().
+     */
+    inline const std::vector<DaeBltBlock>& getBlocks() const {
+        return blocks_;
+    }
+
+    /**
+     * Creates a model with the residuals of the equations of a block.
+     * The new model has the same independent variables as the original
+     * model.
+     *
+     * @param block The block
+     * @param x typical variable values (used for the taping)
+     * @return the model for the block residuals
+     */
+    inline std::unique_ptr<ADFun<CGBase> > createBlockModel(const DaeBltBlock& block,
+                                                            const std::vector<Base>& x) const {
+        using std::vector;
+
+        const size_t n = fun_->Domain();
+        CPPADCG_ASSERT_KNOWN(x.size() == n, "Invalid typical variable values size");
+
+        CodeHandler<Base> handler;
+
+        vector<CGBase> indep0(n);
+        handler.makeVariables(indep0);
+
+        const vector<CGBase> res0 = fun_->Forward(0, indep0);
+
+        vector<CGBase> resBlock(block.size());
+        for (size_t e = 0; e < block.size(); ++e) {
+            resBlock[e] = res0[block.getEquations()[e]];
+        }
+
+        vector<ADCG> indep(n);
+        for (size_t j = 0; j < n; ++j) {
+            indep[j] = x[j];
+        }
+        Independent(indep);
+
+        Evaluator<Base, CGBase> evaluator(handler);
+        vector<ADCG> dep = evaluator.evaluate(indep, resBlock);
+
+        return std::unique_ptr<ADFun<CGBase> >(new ADFun<CGBase>(indep, dep));
+    }
+
+    /**
+     * Creates one source code generator per BLT block so that the residuals
+     * and the Jacobian relative to the block variables can be compiled as
+     * separate functions.
+     * The models used by the generators are kept by this object which
+     * must not be deleted before the returned generators.
+     * decompose() must be called first.
+     *
+     * @param baseName the base model name (the block index is appended)
+     * @param x typical variable values
+     * @return the source generators (in the block solution order)
+     */
+    inline std::vector<std::unique_ptr<ModelCSourceGen<Base> > > createBlockSourceGenerators(const std::string& baseName,
+                                                                                           const std::vector<Base>& x) {
+        using std::vector;
+
+        vector<std::unique_ptr<ModelCSourceGen<Base> > > gens;
+        gens.reserve(blocks_.size());
+
+        blockFuns_.clear();
+        blockFuns_.reserve(blocks_.size());
+
+        for (size_t b = 0; b < blocks_.size(); ++b) {
+            const DaeBltBlock& block = blocks_[b];
+
+            blockFuns_.push_back(createBlockModel(block, x));
+
+            /**
+             * Jacobian of the residuals relative to the block variables
+             */
+            vector<size_t> rows, cols;
+            for (size_t e = 0; e < block.size(); ++e) {
+                const std::set<size_t>& eqVars = jacSparsity_[block.getEquations()[e]];
+                for (size_t j : block.getVariables()) {
+                    if (eqVars.find(j) != eqVars.end()) {
+                        rows.push_back(e);
+                        cols.push_back(j);
+                    }
+                }
+            }
+
+            gens.push_back(std::unique_ptr<ModelCSourceGen<Base> >(new ModelCSourceGen<Base>(*blockFuns_.back(), baseName + "_block" + std::to_string(b))));
+            ModelCSourceGen<Base>& gen = *gens.back();
+            gen.setTypicalIndependentValues(x);
+            gen.setCreateForwardZero(true);
+            gen.setCreateSparseJacobian(true);
+            gen.setCustomSparseJacobianElements(rows, cols);
+        }
+
+        return gens;
+    }
+
+protected:
+
+    /**
+     * Determines a maximum matching between equations and unknowns using
+     * augmenting paths.
+     * Existing assignments in the equation information are used as a
+     * starting point.
+     *
+     * @return the unknown variable tape index matched to each equation
+     * @throws CGException if the system is structurally singular
+     */
+    inline std::vector<int> matchEquations() const {
+        using std::vector;
+
+        const size_t m = eqInfo_.size();
+        const size_t n = varInfo_.size();
+
+        size_t nUnknowns = 0;
+        for (size_t j = 0; j < n; ++j) {
+            if (isUnknown(j))
+                nUnknowns++;
+        }
+        if (nUnknowns != m) {
+            throw CGException("Unable to determine BLT decomposition: the number of equations (", m,
+                              ") is different from the number of unknowns (", nUnknowns, ")");
+        }
+
+        vector<int> eq2Var(m, -1);
+        vector<int> var2Eq(n, -1);
+
+        // initial matching
+        for (size_t i = 0; i < m; ++i) {
+            int j = eqInfo_[i].getAssignedVarIndex();
+            if (j >= 0 && size_t(j) < n && isUnknown(j) && var2Eq[j] < 0 &&
+                    jacSparsity_[i].find(j) != jacSparsity_[i].end()) {
+                eq2Var[i] = j;
+                var2Eq[j] = i;
+            }
+        }
+
+        vector<size_t> visited(n, m); // equation which last visited the variable
+        for (size_t i = 0; i < m; ++i) {
+            if (eq2Var[i] < 0 && !augmentPath(i, eq2Var, var2Eq, visited)) {
+                throw CGException("Unable to determine BLT decomposition: the system is structurally singular (equation ",
+                                  i, " could not be matched)");
+            }
+        }
+
+        return eq2Var;
+    }
+
+    inline bool augmentPath(size_t start,
+                            std::vector<int>& eq2Var,
+                            std::vector<int>& var2Eq,
+                            std::vector<size_t>& visited) const {
+        using std::vector;
+
+        /**
+         * depth first search (non-recursive) for an unmatched unknown
+         */
+        vector<std::pair<size_t, std::set<size_t>::const_iterator> > path; // equation, next variable
+        path.push_back(std::make_pair(start, jacSparsity_[start].begin()));
+
+        while (!path.empty()) {
+            size_t i = path.back().first;
+            std::set<size_t>::const_iterator& it = path.back().second;
+
+            if (it == jacSparsity_[i].end()) {
+                path.pop_back(); // dead end
+                continue;
+            }
+
+            size_t j = *it;
+            ++it;
+
+            if (!isUnknown(j) || visited[j] == start)
+                continue;
+            visited[j] = start;
+
+            if (var2Eq[j] < 0) {
+                // found an augmenting path: flip the assignments along it
+                size_t jj = j;
+                for (size_t p = path.size(); p > 0; --p) {
+                    size_t ii = path[p - 1].first;
+                    int prev = eq2Var[ii];
+                    eq2Var[ii] = jj;
+                    var2Eq[jj] = ii;
+                    if (prev < 0)
+                        break;
+                    jj = prev;
+                }
+                return true;
+            }
+
+            size_t k = var2Eq[j];
+            path.push_back(std::make_pair(k, jacSparsity_[k].cbegin()));
+        }
+
+        return false;
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
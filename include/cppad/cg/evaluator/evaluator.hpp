@@ -36,9 +36,13 @@ class EvaluatorBase;
  * pattern (CRTP). Therefore the default behaviour can be overridden without
  * the use of virtual methods.
  *
- * This class should not be instantiated directly.
+ * The operation graph is traversed with an explicit stack (path_) so that
+ * the arguments of an operation are evaluated before the operation itself
+ * (see isArgumentEvaluatedFirst()). This avoids stack limit issues for
+ * deep graphs. The evaluation results are kept in a single contiguous
+ * vector.
  *
- * @todo implement nonrecursive algorithm (so that there will never be any stack limit issues)
+ * This class should not be instantiated directly.
  */
 template<class ScalarIn, class ScalarOut, class ActiveOut, class FinalEvaluatorType>
 class EvaluatorBase {
@@ -48,7 +52,14 @@ protected:
 protected:
     CodeHandler<ScalarIn>& handler_;
     const ActiveOut* indep_;
-    CodeHandlerVector<ScalarIn, std::unique_ptr<ActiveOut>> evals_;
+    /**
+     * the evaluation results (in evaluation order)
+     */
+    std::vector<ActiveOut> evals_;
+    /**
+     * the index of each evaluated node in evals_
+     */
+    CodeHandlerVector<ScalarIn, size_t> evalIndex_;
     std::map<size_t, std::vector<ActiveOut>* > evalsArrays_;
     std::map<size_t, std::vector<ActiveOut>* > evalsSparseArrays_;
     bool underEval_;
@@ -62,7 +73,7 @@ public:
     inline EvaluatorBase(CodeHandler<ScalarIn>& handler) :
         handler_(handler),
         indep_(nullptr),
-        evals_(handler),
+        evalIndex_(handler),
         underEval_(false),
         depth_(0) { // not really required (but it avoids warnings)
     }
@@ -152,7 +163,10 @@ public:
         underEval_ = true;
 
         clear(); // clean-up from any previous call that might have failed
-        evals_.adjustSize();
+        evalIndex_.adjustSize();
+        evalIndex_.fill((std::numeric_limits<size_t>::max)());
+        // results are never moved during the evaluation
+        evals_.reserve(handler_.getManagedNodesCount());
 
         depth_ = 0;
         path_.clear();
@@ -195,6 +209,7 @@ protected:
      */
     inline void clear() {
         evals_.clear();
+        evalIndex_.clear();
 
         for (const auto& p : evalsArrays_) {
             delete p.second;
@@ -238,43 +253,89 @@ protected:
         }
     }
 
+    /**
+     * @return true if the node was already evaluated
+     */
+    inline bool isEvaluated(const OperationNode<ScalarIn>& node) const {
+        return evalIndex_[node] != (std::numeric_limits<size_t>::max)();
+    }
+
+    /**
+     * @return the result of a previously evaluated node
+     */
+    inline ActiveOut& getEvaluation(const OperationNode<ScalarIn>& node) {
+        CPPADCG_ASSERT_UNKNOWN(isEvaluated(node));
+        return evals_[evalIndex_[node]];
+    }
+
+    /**
+     * Evaluates a node and all the arguments which it requires.
+     * The arguments are evaluated first (when allowed by
+     * isArgumentEvaluatedFirst()) using path_ as an explicit stack.
+     * Arguments which are not evaluated first are determined by
+     * evalOperation() when they are requested through evalArg().
+     */
     inline const ActiveOut& evalOperations(OperationNode<ScalarIn>& node) {
         CPPADCG_ASSERT_KNOWN(node.getHandlerPosition() < handler_.getManagedNodesCount(), "this node is not managed by the code handler");
 
         // check if this node was previously determined
-        if (evals_[node] != nullptr) {
-            return *evals_[node];
+        if (isEvaluated(node)) {
+            return getEvaluation(node);
         }
 
-        // first evaluation of this node
         FinalEvaluatorType& thisOps = static_cast<FinalEvaluatorType&>(*this);
 
-        path_.push_back(OperationPathNode<ScalarIn>(&node, -1));
+        const size_t noArg = (std::numeric_limits<size_t>::max)();
+        const size_t start = path_.size();
+
+        path_.push_back(OperationPathNode<ScalarIn>(&node, noArg));
         depth_++;
 
-        ActiveOut result = thisOps.evalOperation(node);
+        while (path_.size() > start) {
+            OperationNode<ScalarIn>& n = *path_.back().node;
+            const std::vector<Argument<ScalarIn> >& args = n.getArguments();
+
+            // the next argument which must be evaluated first
+            size_t a = path_.back().argIndex == noArg ? 0 : path_.back().argIndex + 1;
+            for (; a < args.size(); ++a) {
+                OperationNode<ScalarIn>* arg = args[a].getOperation();
+                if (arg != nullptr && !isEvaluated(*arg) && thisOps.isArgumentEvaluatedFirst(n, a)) {
+                    break;
+                }
+            }
 
-        // save it for reuse
-        ActiveOut* resultPtr = saveEvaluation(node, ActiveOut(result));
+            if (a < args.size()) {
+                path_.back().argIndex = a;
+                path_.push_back(OperationPathNode<ScalarIn>(args[a].getOperation(), noArg));
+                depth_++;
+                continue;
+            }
+
+            // all the required arguments are available
+            path_.back().argIndex = noArg;
+            saveEvaluation(n, thisOps.evalOperation(n));
 
-        depth_--;
-        path_.pop_back();
+            depth_--;
+            path_.pop_back();
+        }
 
-        return *resultPtr;
+        return getEvaluation(node);
     }
 
     inline ActiveOut* saveEvaluation(const OperationNode<ScalarIn>& node,
                                      ActiveOut&& result) {
-        std::unique_ptr<ActiveOut>& resultPtr = evals_[node];
-        CPPADCG_ASSERT_UNKNOWN(resultPtr == nullptr); // not supposed to override existing result
-        resultPtr.reset(new ActiveOut(std::move(result)));
+        size_t& index = evalIndex_[node];
+        CPPADCG_ASSERT_UNKNOWN(index == (std::numeric_limits<size_t>::max)()); // not supposed to override existing result
+        CPPADCG_ASSERT_UNKNOWN(evals_.size() < evals_.capacity()); // references to previous results must remain valid
+        index = evals_.size();
+        evals_.push_back(std::move(result));
 
-        ActiveOut* resultPtr2 = resultPtr.get(); // do not use a reference (just in case evals_ is resized)
+        ActiveOut* resultPtr = &evals_.back();
 
         FinalEvaluatorType& thisOps = static_cast<FinalEvaluatorType&>(*this);
-        thisOps.processActiveOut(node, *resultPtr2);
+        thisOps.processActiveOut(node, *resultPtr);
 
-        return resultPtr2;
+        return resultPtr;
     }
 
     inline std::vector<ActiveOut>& evalArrayCreationOperation(const OperationNode<ScalarIn>& node) {
@@ -477,6 +538,29 @@ protected:
         }
     }
 
+    /**
+     * Whether or not an argument of an operation should be evaluated
+     * before the operation itself (without recursion).
+     * Override this method when evalOperation() does not evaluate all of
+     * its arguments or evaluates them in a special way.
+     *
+     * @param node the operation
+     * @param argIndex the argument index
+     */
+    inline bool isArgumentEvaluatedFirst(const NodeIn& node,
+                                         size_t argIndex) {
+        switch (node.getOperationType()) {
+            case CGOpCode::ArrayCreation:
+            case CGOpCode::SparseArrayCreation:
+            case CGOpCode::ArrayElement:
+            case CGOpCode::AtomicForward:
+            case CGOpCode::AtomicReverse:
+                return false; // not evaluated through evalOperations()
+            default:
+                return true;
+        }
+    }
+
     inline ActiveOut evalAssign(const NodeIn& node) {
         const std::vector<ArgIn>& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 1, "Invalid number of arguments for assign()");
@@ -53,7 +53,8 @@ protected:
      * during the evaluation.
      */
     bool printOutPriOperations_;
-    using EvaluatorBase<ScalarIn, ScalarOut, CG<ScalarOut>, FinalEvaluatorType>::evals_;
+    using EvaluatorBase<ScalarIn, ScalarOut, CG<ScalarOut>, FinalEvaluatorType>::isEvaluated;
+    using EvaluatorBase<ScalarIn, ScalarOut, CG<ScalarOut>, FinalEvaluatorType>::getEvaluation;
 public:
 
     inline EvaluatorCG(CodeHandler<ScalarIn>& handler) :
@@ -154,8 +155,8 @@ protected:
                              "Invalid operation type");
 
         // check if this node was previously determined
-        if (evals_[node] != nullptr) {
-            return; // *evals_[node];
+        if (isEvaluated(node)) {
+            return;
         }
 
         const std::vector<size_t>& info = node.getInfo();
@@ -227,8 +228,8 @@ protected:
      */
     inline ActiveOut evalArrayElement(const NodeIn& node) {
         // check if this node was previously determined
-        if (evals_[node] != nullptr) {
-            return *evals_[node];
+        if (isEvaluated(node)) {
+            return getEvaluation(node);
         }
 
         const std::vector<ArgIn>& args = node.getArguments();
@@ -244,7 +245,7 @@ protected:
         FinalEvaluatorType& thisOps = static_cast<FinalEvaluatorType&>(*this);
         const NodeIn& atomicNode = *args[1].getOperation();
         thisOps.evalAtomicOperation(atomicNode); // atomic operation
-        ArgOut atomicArg = *evals_[atomicNode]->getOperationNode();
+        ArgOut atomicArg = *getEvaluation(atomicNode).getOperationNode();
 
         ActiveOut out(*outHandler_->makeNode(CGOpCode::ArrayElement, {index}, {arrayArg, atomicArg}));
 
@@ -291,8 +292,8 @@ protected:
         CPPADCG_ASSERT_KNOWN(node.getHandlerPosition() < this->handler_.getManagedNodesCount(), "this node is not managed by the code handler");
 
         // check if this node was previously determined
-        if (evals_[node] != nullptr) {
-            return *evals_[node];
+        if (isEvaluated(node)) {
+            return getEvaluation(node);
         }
 
         if (outHandler_ == nullptr) {
@@ -311,8 +312,8 @@ protected:
         CPPADCG_ASSERT_KNOWN(node.getHandlerPosition() < this->handler_.getManagedNodesCount(), "this node is not managed by the code handler");
 
         // check if this node was previously determined
-        if (evals_[node] != nullptr) {
-            return *evals_[node];
+        if (isEvaluated(node)) {
+            return getEvaluation(node);
         }
 
         if (outHandler_ == nullptr) {
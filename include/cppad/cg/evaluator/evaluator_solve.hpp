@@ -133,6 +133,19 @@ public:
 
 protected:
 
+    /**
+     * Only some of the nodes are cloned and the decision depends on the
+     * path used to reach each node, therefore the arguments are only
+     * evaluated when requested by evalOperation().
+     *
+     * @note overrides the default isArgumentEvaluatedFirst() even though
+     *       this method is not virtual (hides a method in EvaluatorOperations)
+     */
+    inline bool isArgumentEvaluatedFirst(const OperationNode<Scalar>& node,
+                                         size_t argIndex) {
+        return false;
+    }
+
     /**
      * @note overrides the default evalOperation() even though this method
      *        is not virtual (hides a method in EvaluatorOperations)
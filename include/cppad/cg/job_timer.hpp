@@ -77,6 +77,8 @@ public:
     static const JobType STATIC_MODEL_LIBRARY;
     static const JobType ASSEMBLE_STATIC_LIBRARY;
     static const JobType JIT_MODEL_LIBRARY;
+    static const JobType PROFILING;
+    static const JobType REUSING_FOR_MODEL;
 };
 
 template<int T>
@@ -115,6 +117,12 @@ const JobType JobTypeHolder<T>::ASSEMBLE_STATIC_LIBRARY("assembling static libra
 template<int T>
 const JobType JobTypeHolder<T>::JIT_MODEL_LIBRARY("preparing JIT library", "prepared JIT library");
 
+template<int T>
+const JobType JobTypeHolder<T>::PROFILING("collecting profile data for", "collected profile data for");
+
+template<int T>
+const JobType JobTypeHolder<T>::REUSING_FOR_MODEL("reusing object files for model", "reused object files for model");
+
 /**
  * Represents a task for which the execution time will be determined
  */
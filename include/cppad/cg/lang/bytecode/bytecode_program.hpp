@@ -0,0 +1,368 @@
+#ifndef CPPAD_CG_BYTECODE_PROGRAM_INCLUDED
+#define CPPAD_CG_BYTECODE_PROGRAM_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Operations understood by the bytecode interpreter
+ */
+enum class BytecodeOp : unsigned char {
+    Copy, // r[dst] = r[a0]
+    Abs,
+    Acos,
+    Acosh,
+    Add,
+    Asin,
+    Asinh,
+    Atan,
+    Atanh,
+    Cosh,
+    Cos,
+    Div,
+    Erf,
+    Exp,
+    Expm1,
+    Log,
+    Log1p,
+    Mul,
+    Pow,
+    Sign,
+    Sinh,
+    Sin,
+    Sqrt,
+    Sub,
+    Tanh,
+    Tan,
+    UnMinus,
+    ComLt, // r[dst] = r[a0] <  r[a1] ? r[a2] : r[a3]
+    ComLe, // r[dst] = r[a0] <= r[a1] ? r[a2] : r[a3]
+    ComEq, // r[dst] = r[a0] == r[a1] ? r[a2] : r[a3]
+    ComGe, // r[dst] = r[a0] >= r[a1] ? r[a2] : r[a3]
+    ComGt, // r[dst] = r[a0] >  r[a1] ? r[a2] : r[a3]
+    ComNe  // r[dst] = r[a0] != r[a1] ? r[a2] : r[a3]
+};
+
+/**
+ * A single bytecode instruction.
+ * All arguments are register indexes (constants are also kept in registers).
+ */
+struct BytecodeInstruction {
+    BytecodeOp op;
+    unsigned dst;
+    unsigned arg[4];
+};
+
+/**
+ * A register based program created from the evaluation order of a
+ * CodeHandler operation graph (see LanguageBytecode).
+ *
+ * Register layout:
+ *  - register 0 is not used;
+ *  - registers 1 to n hold the independent variables;
+ *  - the following registers hold the dependent and the (reused) temporary
+ *    variables, using the same IDs as the generated source code;
+ *  - the last registers hold the constants used by the program.
+ *
+ * The registers are owned by the program and therefore the same program
+ * must not be evaluated concurrently by several threads.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class BytecodeProgram {
+protected:
+    /**
+     * the instructions in evaluation order
+     */
+    std::vector<BytecodeInstruction> _instructions;
+    /**
+     * the register used for each dependent variable
+     */
+    std::vector<unsigned> _outputs;
+    /**
+     * the register file (variables followed by constants)
+     */
+    std::vector<Base> _registers;
+    /**
+     * the number of independent variables
+     */
+    size_t _inputCount;
+    /**
+     * the number of registers used by variables (including register 0)
+     */
+    size_t _variableRegisters;
+    /**
+     * the size of each independent variable array used by evaluate()
+     */
+    std::vector<size_t> _inputSizes;
+public:
+
+    inline BytecodeProgram() :
+        _registers(1),
+        _inputCount(0),
+        _variableRegisters(1),
+        _inputSizes(1, 0) {
+    }
+
+    inline BytecodeProgram(size_t inputCount,
+                           size_t variableRegisters) :
+        _registers(variableRegisters),
+        _inputCount(inputCount),
+        _variableRegisters(variableRegisters),
+        _inputSizes(1, inputCount) {
+        CPPADCG_ASSERT_KNOWN(variableRegisters > inputCount, "Invalid number of registers");
+    }
+
+    inline size_t getInputCount() const {
+        return _inputCount;
+    }
+
+    inline size_t getOutputCount() const {
+        return _outputs.size();
+    }
+
+    inline size_t getRegisterCount() const {
+        return _registers.size();
+    }
+
+    inline size_t getConstantCount() const {
+        return _registers.size() - _variableRegisters;
+    }
+
+    inline const std::vector<BytecodeInstruction>& getInstructions() const {
+        return _instructions;
+    }
+
+    /**
+     * Defines how the independent variables are split into several arrays
+     * (e.g. the independent variables and the multipliers of a Hessian).
+     *
+     * @param sizes the number of elements in each independent array
+     */
+    inline void setInputSizes(const std::vector<size_t>& sizes) {
+        size_t total = 0;
+        for (size_t s : sizes)
+            total += s;
+        CPPADCG_ASSERT_KNOWN(total == _inputCount, "Invalid independent array sizes");
+        _inputSizes = sizes;
+    }
+
+    inline const std::vector<size_t>& getInputSizes() const {
+        return _inputSizes;
+    }
+
+    /**
+     * Adds a new constant to the register file.
+     *
+     * @return the register with the constant value
+     */
+    inline unsigned addConstant(const Base& value) {
+        size_t r = _registers.size();
+        checkRegister(r);
+        _registers.push_back(value);
+        return unsigned(r);
+    }
+
+    inline void addInstruction(BytecodeOp op,
+                               size_t dst,
+                               size_t a0,
+                               size_t a1 = 0,
+                               size_t a2 = 0,
+                               size_t a3 = 0) {
+        CPPADCG_ASSERT_KNOWN(dst > _inputCount && dst < _variableRegisters, "Invalid destination register");
+        checkRegister(a0);
+        checkRegister(a1);
+        checkRegister(a2);
+        checkRegister(a3);
+
+        BytecodeInstruction ins;
+        ins.op = op;
+        ins.dst = unsigned(dst);
+        ins.arg[0] = unsigned(a0);
+        ins.arg[1] = unsigned(a1);
+        ins.arg[2] = unsigned(a2);
+        ins.arg[3] = unsigned(a3);
+        _instructions.push_back(ins);
+    }
+
+    inline void addOutput(size_t reg) {
+        checkRegister(reg);
+        _outputs.push_back(unsigned(reg));
+    }
+
+    /**
+     * Evaluates the program.
+     *
+     * @param in the independent variable arrays (their sizes are defined
+     *           by setInputSizes())
+     * @param out the dependent variable array
+     */
+    inline void evaluate(const Base* const in[],
+                         Base* out) {
+        Base* r = _registers.data();
+
+        size_t pos = 1;
+        for (size_t a = 0; a < _inputSizes.size(); a++) {
+            std::copy(in[a], in[a] + _inputSizes[a], r + pos);
+            pos += _inputSizes[a];
+        }
+
+        run(r);
+
+        const size_t m = _outputs.size();
+        for (size_t i = 0; i < m; i++) {
+            out[i] = r[_outputs[i]];
+        }
+    }
+
+    inline void evaluate(ArrayView<const Base> x,
+                         ArrayView<Base> y) {
+        CPPADCG_ASSERT_KNOWN(_inputSizes.size() == 1, "The program uses more than one independent array");
+        CPPADCG_ASSERT_KNOWN(x.size() >= _inputCount, "Invalid independent array size");
+        CPPADCG_ASSERT_KNOWN(y.size() >= _outputs.size(), "Invalid dependent array size");
+
+        const Base* in[1] = {x.data()};
+        evaluate(in, y.data());
+    }
+
+protected:
+
+    inline void checkRegister(size_t r) const {
+        if (r > std::numeric_limits<unsigned>::max()) {
+            throw CGException("Too many registers required by the bytecode program");
+        }
+    }
+
+    /**
+     * The interpreter loop
+     */
+    inline void run(Base* r) const {
+        for (const BytecodeInstruction& ins : _instructions) {
+            const unsigned* a = ins.arg;
+            Base& dst = r[ins.dst];
+
+            switch (ins.op) {
+                case BytecodeOp::Copy:
+                    dst = r[a[0]];
+                    break;
+                case BytecodeOp::Abs:
+                    dst = CppAD::abs(r[a[0]]);
+                    break;
+                case BytecodeOp::Acos:
+                    dst = CppAD::acos(r[a[0]]);
+                    break;
+                case BytecodeOp::Acosh:
+                    dst = CppAD::acosh(r[a[0]]);
+                    break;
+                case BytecodeOp::Add:
+                    dst = r[a[0]] + r[a[1]];
+                    break;
+                case BytecodeOp::Asin:
+                    dst = CppAD::asin(r[a[0]]);
+                    break;
+                case BytecodeOp::Asinh:
+                    dst = CppAD::asinh(r[a[0]]);
+                    break;
+                case BytecodeOp::Atan:
+                    dst = CppAD::atan(r[a[0]]);
+                    break;
+                case BytecodeOp::Atanh:
+                    dst = CppAD::atanh(r[a[0]]);
+                    break;
+                case BytecodeOp::Cosh:
+                    dst = CppAD::cosh(r[a[0]]);
+                    break;
+                case BytecodeOp::Cos:
+                    dst = CppAD::cos(r[a[0]]);
+                    break;
+                case BytecodeOp::Div:
+                    dst = r[a[0]] / r[a[1]];
+                    break;
+                case BytecodeOp::Erf:
+                    dst = CppAD::erf(r[a[0]]);
+                    break;
+                case BytecodeOp::Exp:
+                    dst = CppAD::exp(r[a[0]]);
+                    break;
+                case BytecodeOp::Expm1:
+                    dst = CppAD::expm1(r[a[0]]);
+                    break;
+                case BytecodeOp::Log:
+                    dst = CppAD::log(r[a[0]]);
+                    break;
+                case BytecodeOp::Log1p:
+                    dst = CppAD::log1p(r[a[0]]);
+                    break;
+                case BytecodeOp::Mul:
+                    dst = r[a[0]] * r[a[1]];
+                    break;
+                case BytecodeOp::Pow:
+                    dst = CppAD::pow(r[a[0]], r[a[1]]);
+                    break;
+                case BytecodeOp::Sign:
+                    dst = CppAD::sign(r[a[0]]);
+                    break;
+                case BytecodeOp::Sinh:
+                    dst = CppAD::sinh(r[a[0]]);
+                    break;
+                case BytecodeOp::Sin:
+                    dst = CppAD::sin(r[a[0]]);
+                    break;
+                case BytecodeOp::Sqrt:
+                    dst = CppAD::sqrt(r[a[0]]);
+                    break;
+                case BytecodeOp::Sub:
+                    dst = r[a[0]] - r[a[1]];
+                    break;
+                case BytecodeOp::Tanh:
+                    dst = CppAD::tanh(r[a[0]]);
+                    break;
+                case BytecodeOp::Tan:
+                    dst = CppAD::tan(r[a[0]]);
+                    break;
+                case BytecodeOp::UnMinus:
+                    dst = -r[a[0]];
+                    break;
+                case BytecodeOp::ComLt:
+                    dst = r[a[0]] < r[a[1]] ? r[a[2]] : r[a[3]];
+                    break;
+                case BytecodeOp::ComLe:
+                    dst = r[a[0]] <= r[a[1]] ? r[a[2]] : r[a[3]];
+                    break;
+                case BytecodeOp::ComEq:
+                    dst = r[a[0]] == r[a[1]] ? r[a[2]] : r[a[3]];
+                    break;
+                case BytecodeOp::ComGe:
+                    dst = r[a[0]] >= r[a[1]] ? r[a[2]] : r[a[3]];
+                    break;
+                case BytecodeOp::ComGt:
+                    dst = r[a[0]] > r[a[1]] ? r[a[2]] : r[a[3]];
+                    break;
+                case BytecodeOp::ComNe:
+                    dst = r[a[0]] != r[a[1]] ? r[a[2]] : r[a[3]];
+                    break;
+            }
+        }
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
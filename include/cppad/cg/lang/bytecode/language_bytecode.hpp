@@ -0,0 +1,323 @@
+#ifndef CPPAD_CG_LANGUAGE_BYTECODE_INCLUDED
+#define CPPAD_CG_LANGUAGE_BYTECODE_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Compiles an operation graph into a register based bytecode program
+ * (BytecodeProgram) instead of source code.
+ * Every operation is assigned to a variable so that the registers are
+ * the variable IDs determined by the CodeHandler, which are reused when
+ * CodeHandler::isReuseVariableIDs() is enabled.
+ *
+ * Loops, conditional blocks (if/else), arrays, and atomic functions are
+ * not supported.
+ * Print operations are evaluated as a copy of their argument (nothing is
+ * printed).
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class LanguageBytecode : public Language<Base> {
+public:
+    using Node = OperationNode<Base>;
+    using Arg = Argument<Base>;
+protected:
+    // information from the code handler (not owned)
+    LanguageGenerationData<Base>* _info;
+    // the program being created
+    std::unique_ptr<BytecodeProgram<Base> > _program;
+    // maps constant values to their registers
+    std::map<Base, unsigned> _constants;
+public:
+
+    inline LanguageBytecode() :
+        _info(nullptr) {
+    }
+
+    /**
+     * Provides the program created by the last call to
+     * CodeHandler::generateCode() with this language.
+     * The language no longer holds the program after this call.
+     *
+     * @return the bytecode program (null if no program was created)
+     */
+    inline std::unique_ptr<BytecodeProgram<Base> > releaseProgram() {
+        return std::move(_program);
+    }
+
+    inline virtual ~LanguageBytecode() = default;
+
+protected:
+
+    void generateSourceCode(std::ostream& out,
+                            const std::unique_ptr<LanguageGenerationData<Base> >& info) override {
+        _info = info.get();
+        _constants.clear();
+
+        const std::vector<Node*>& variableOrder = info->variableOrder;
+        const ArrayView<CG<Base> >& dependent = info->dependent;
+        const size_t n = info->independent.size();
+
+        /**
+         * determine the number of registers used by variables
+         */
+        size_t maxId = n;
+        for (size_t i = 0; i < dependent.size(); i++) {
+            Node* node = dependent[i].getOperationNode();
+            if (node != nullptr && isRegister(getVariableID(*node))) {
+                maxId = std::max(maxId, getVariableID(*node));
+            }
+        }
+        for (Node* node : variableOrder) {
+            if (isRegister(getVariableID(*node))) {
+                maxId = std::max(maxId, getVariableID(*node));
+            }
+        }
+
+        _program.reset(new BytecodeProgram<Base>(n, maxId + 1));
+
+        /**
+         * the operations
+         */
+        for (Node* node : variableOrder) {
+            compileOperation(*node);
+        }
+
+        /**
+         * the dependent variables
+         */
+        for (size_t i = 0; i < dependent.size(); i++) {
+            const CG<Base>& dep = dependent[i];
+            if (dep.getOperationNode() == nullptr) {
+                _program->addOutput(getConstantRegister(dep.getValue()));
+            } else {
+                _program->addOutput(getRegister(*dep.getOperationNode()));
+            }
+        }
+
+        _info = nullptr;
+        _constants.clear();
+    }
+
+    bool createsNewVariable(const Node& var,
+                            size_t totalUseCount) const override {
+        return true; // every operation is saved in its own register
+    }
+
+    bool requiresVariableArgument(enum CGOpCode op,
+                                  size_t argIndex) const override {
+        return false;
+    }
+
+    bool requiresVariableDependencies() const override {
+        return false;
+    }
+
+    inline size_t getVariableID(const Node& node) const {
+        return _info->varId[node];
+    }
+
+    static inline bool isRegister(size_t id) {
+        return id != 0 && id != (std::numeric_limits<size_t>::max)();
+    }
+
+    virtual void compileOperation(Node& node) {
+        const std::vector<Arg>& args = node.getArguments();
+        CGOpCode op = node.getOperationType();
+        size_t dst = getVariableID(node);
+
+        switch (op) {
+            case CGOpCode::Alias:
+            case CGOpCode::Pri:
+                // the original variable is used directly (see getRegister())
+                break;
+            case CGOpCode::Assign:
+                compileUnary(BytecodeOp::Copy, dst, args);
+                break;
+            case CGOpCode::Abs:
+                compileUnary(BytecodeOp::Abs, dst, args);
+                break;
+            case CGOpCode::Acos:
+                compileUnary(BytecodeOp::Acos, dst, args);
+                break;
+            case CGOpCode::Acosh:
+                compileUnary(BytecodeOp::Acosh, dst, args);
+                break;
+            case CGOpCode::Add:
+                compileBinary(BytecodeOp::Add, dst, args);
+                break;
+            case CGOpCode::Asin:
+                compileUnary(BytecodeOp::Asin, dst, args);
+                break;
+            case CGOpCode::Asinh:
+                compileUnary(BytecodeOp::Asinh, dst, args);
+                break;
+            case CGOpCode::Atan:
+                compileUnary(BytecodeOp::Atan, dst, args);
+                break;
+            case CGOpCode::Atanh:
+                compileUnary(BytecodeOp::Atanh, dst, args);
+                break;
+            case CGOpCode::Cosh:
+                compileUnary(BytecodeOp::Cosh, dst, args);
+                break;
+            case CGOpCode::Cos:
+                compileUnary(BytecodeOp::Cos, dst, args);
+                break;
+            case CGOpCode::Div:
+                compileBinary(BytecodeOp::Div, dst, args);
+                break;
+            case CGOpCode::Erf:
+                compileUnary(BytecodeOp::Erf, dst, args);
+                break;
+            case CGOpCode::Exp:
+                compileUnary(BytecodeOp::Exp, dst, args);
+                break;
+            case CGOpCode::Expm1:
+                compileUnary(BytecodeOp::Expm1, dst, args);
+                break;
+            case CGOpCode::Log:
+                compileUnary(BytecodeOp::Log, dst, args);
+                break;
+            case CGOpCode::Log1p:
+                compileUnary(BytecodeOp::Log1p, dst, args);
+                break;
+            case CGOpCode::Mul:
+                compileBinary(BytecodeOp::Mul, dst, args);
+                break;
+            case CGOpCode::Pow:
+                compileBinary(BytecodeOp::Pow, dst, args);
+                break;
+            case CGOpCode::Sign:
+                compileUnary(BytecodeOp::Sign, dst, args);
+                break;
+            case CGOpCode::Sinh:
+                compileUnary(BytecodeOp::Sinh, dst, args);
+                break;
+            case CGOpCode::Sin:
+                compileUnary(BytecodeOp::Sin, dst, args);
+                break;
+            case CGOpCode::Sqrt:
+                compileUnary(BytecodeOp::Sqrt, dst, args);
+                break;
+            case CGOpCode::Sub:
+                compileBinary(BytecodeOp::Sub, dst, args);
+                break;
+            case CGOpCode::Tanh:
+                compileUnary(BytecodeOp::Tanh, dst, args);
+                break;
+            case CGOpCode::Tan:
+                compileUnary(BytecodeOp::Tan, dst, args);
+                break;
+            case CGOpCode::UnMinus:
+                compileUnary(BytecodeOp::UnMinus, dst, args);
+                break;
+            case CGOpCode::ComLt:
+                compileConditional(BytecodeOp::ComLt, dst, args);
+                break;
+            case CGOpCode::ComLe:
+                compileConditional(BytecodeOp::ComLe, dst, args);
+                break;
+            case CGOpCode::ComEq:
+                compileConditional(BytecodeOp::ComEq, dst, args);
+                break;
+            case CGOpCode::ComGe:
+                compileConditional(BytecodeOp::ComGe, dst, args);
+                break;
+            case CGOpCode::ComGt:
+                compileConditional(BytecodeOp::ComGt, dst, args);
+                break;
+            case CGOpCode::ComNe:
+                compileConditional(BytecodeOp::ComNe, dst, args);
+                break;
+            default:
+                throw CGException("Operation '", op, "' is not supported by the bytecode interpreter");
+        }
+    }
+
+    inline void compileUnary(BytecodeOp op,
+                             size_t dst,
+                             const std::vector<Arg>& args) {
+        CPPADCG_ASSERT_KNOWN(args.size() == 1, "Invalid number of arguments for unary operation");
+        _program->addInstruction(op, dst, getRegister(args[0]));
+    }
+
+    inline void compileBinary(BytecodeOp op,
+                              size_t dst,
+                              const std::vector<Arg>& args) {
+        CPPADCG_ASSERT_KNOWN(args.size() == 2, "Invalid number of arguments for binary operation");
+        _program->addInstruction(op, dst, getRegister(args[0]), getRegister(args[1]));
+    }
+
+    inline void compileConditional(BytecodeOp op,
+                                   size_t dst,
+                                   const std::vector<Arg>& args) {
+        CPPADCG_ASSERT_KNOWN(args.size() == 4, "Invalid number of arguments for a conditional expression");
+        _program->addInstruction(op, dst,
+                                 getRegister(args[0]), getRegister(args[1]),
+                                 getRegister(args[2]), getRegister(args[3]));
+    }
+
+    inline size_t getRegister(const Arg& arg) {
+        if (arg.getOperation() == nullptr) {
+            return getConstantRegister(*arg.getParameter());
+        }
+        return getRegister(*arg.getOperation());
+    }
+
+    inline size_t getRegister(Node& node) {
+        Node* n = &node;
+        // aliases and print operations only have their own register when
+        // they are dependent variables (the original variable is used instead)
+        while (n->getOperationType() == CGOpCode::Alias || n->getOperationType() == CGOpCode::Pri) {
+            const Arg& a = n->getArguments()[0];
+            if (a.getOperation() == nullptr) {
+                return getConstantRegister(*a.getParameter());
+            }
+            n = a.getOperation();
+        }
+
+        size_t id = getVariableID(*n);
+        CPPADCG_ASSERT_KNOWN(isRegister(id), "Operation without a register in the bytecode program");
+        return id;
+    }
+
+    inline size_t getConstantRegister(const Base& value) {
+        if (value != value) {
+            return _program->addConstant(value); // NaN cannot be used as a key
+        } else if (value == Base(0) && std::signbit(value)) {
+            return _program->addConstant(value); // -0.0 would be equal to the key 0.0
+        }
+
+        auto it = _constants.find(value);
+        if (it != _constants.end()) {
+            return it->second;
+        }
+
+        unsigned r = _program->addConstant(value);
+        _constants[value] = r;
+        return r;
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
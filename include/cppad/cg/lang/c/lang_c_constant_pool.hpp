@@ -0,0 +1,166 @@
+#ifndef CPPAD_CG_LANG_C_CONSTANT_POOL_INCLUDED
+#define CPPAD_CG_LANG_C_CONSTANT_POOL_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Distinct constant values used by the generated C source code.
+ * Long literals are replaced by elements of a single constant array which
+ * can be shared by several source files (e.g. all the files of a model
+ * library).
+ *
+ * @author Joao Leal
+ */
+class LangCConstantPool {
+protected:
+    /**
+     * the name of the constant array
+     */
+    std::string _name;
+    /**
+     * literals with this number of characters or less are not placed in the
+     * constant array
+     */
+    size_t _minLength;
+    /**
+     * the literals in the order they were added
+     */
+    std::vector<std::string> _values;
+    /**
+     * maps literals to their position in the constant array
+     */
+    std::map<std::string, size_t> _index;
+public:
+
+    inline explicit LangCConstantPool(std::string name = "cppadcg_constants",
+                                      size_t minLength = 6) :
+        _name(std::move(name)),
+        _minLength(minLength) {
+    }
+
+    inline const std::string& getName() const {
+        return _name;
+    }
+
+    inline void setName(const std::string& name) {
+        CPPADCG_ASSERT_KNOWN(_values.empty(), "Cannot rename a constant pool already in use");
+        _name = name;
+    }
+
+    inline size_t getMinimumLength() const {
+        return _minLength;
+    }
+
+    /**
+     * Defines the smallest literals which are not printed directly in the
+     * source code.
+     *
+     * @param minLength literals with this number of characters or less
+     *                  remain in the source code
+     */
+    inline void setMinimumLength(size_t minLength) {
+        _minLength = minLength;
+    }
+
+    /**
+     * Whether or not a literal should be replaced by an element of the
+     * constant array.
+     */
+    inline bool isPooled(const char* literal,
+                         size_t length) const {
+        if (length <= _minLength)
+            return false;
+        // infinity and NaN are printed with other names
+        return std::memchr(literal, 'n', length) == nullptr;
+    }
+
+    /**
+     * Provides the position of a literal in the constant array (the literal
+     * is added if it was not used before).
+     */
+    inline size_t add(const std::string& literal) {
+        auto it = _index.find(literal);
+        if (it != _index.end())
+            return it->second;
+
+        size_t pos = _values.size();
+        _index[literal] = pos;
+        _values.push_back(literal);
+        return pos;
+    }
+
+    inline size_t size() const {
+        return _values.size();
+    }
+
+    inline bool empty() const {
+        return _values.empty();
+    }
+
+    inline const std::vector<std::string>& getValues() const {
+        return _values;
+    }
+
+    inline void clear() {
+        _values.clear();
+        _index.clear();
+    }
+
+    /**
+     * Creates the declaration of the constant array to be used in the
+     * source files which reference its elements.
+     *
+     * @param baseTypeName the type of the constant values
+     */
+    inline std::string generateDeclaration(const std::string& baseTypeName) const {
+        return generateArrayDeclaration(baseTypeName, true) + ";\n";
+    }
+
+    /**
+     * Creates the source file with the definition of the constant array.
+     *
+     * @param baseTypeName the type of the constant values
+     */
+    inline std::string generateDefinition(const std::string& baseTypeName) const {
+        std::ostringstream out;
+        out << generateArrayDeclaration(baseTypeName, false) << " = {";
+        for (size_t i = 0; i < _values.size(); ++i) {
+            if (i > 0) out << ",";
+            out << (i % 4 == 0 ? "\n   " : " ") << _values[i];
+        }
+        out << "\n};\n";
+        return out.str();
+    }
+
+protected:
+
+    inline std::string generateArrayDeclaration(const std::string& baseTypeName,
+                                                bool external) const {
+        // hidden so that the libraries loaded in the same process never share it
+        return std::string("#if defined(__GNUC__)\n"
+                           "__attribute__((visibility(\"hidden\")))\n"
+                           "#endif\n") +
+                (external ? "extern " : "") + "const " + baseTypeName + " " + _name + "[]";
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
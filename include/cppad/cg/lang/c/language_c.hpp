@@ -108,6 +108,57 @@ protected:
     std::vector<const LoopStartOperationNode<Base>*> _currentLoops;
     // the maximum precision used to print values
     size_t _parameterPrecision;
+    // whether or not to evaluate related transcendental functions together
+    bool _fuseTranscendentals;
+    /**
+     * transcendental functions with the same argument which are evaluated
+     * together (only one call to sincos() or exp())
+     */
+    struct FusedFunctionGroup {
+        bool trigonometric;
+        std::set<CGOpCode> ops;
+        // the local function where the values were last evaluated (0 if never)
+        size_t evaluatedIn;
+    };
+    std::vector<FusedFunctionGroup> _fusedGroups;
+    std::map<const Node*, size_t> _fusedNode2Group;
+    // the groups used in the current (local) function
+    std::set<size_t> _fusedGroupsInFunction;
+    // the index of the current (local) function
+    size_t _fusedFunctionIndex;
+    // when higher than zero the fused values cannot be evaluated
+    // (code inside conditional branches)
+    size_t _fusedDisabled;
+    // whether or not to split functions where few temporaries are alive
+    bool _splitMinimizeLive;
+    // whether or not the positions where functions are split were determined
+    bool _splitPlanned;
+    // the positions (in the variable order) where new local functions start
+    std::set<size_t> _splitPositions;
+    // the IDs of the temporary variables declared locally in each local function
+    std::vector<std::set<size_t> > _localTemporaries;
+    // the table with the long constant values (not owned)
+    LangCConstantPool* _constantPool;
+    // whether or not to annotate loops and arrays so that loops are vectorized
+    bool _vectorizeLoops;
+    /**
+     * information on a loop being printed used to determine whether or not
+     * its iterations are independent
+     */
+    struct LoopVectorization {
+        // the code printed before the loop (the loop is printed in its own
+        // stream so that only its code is changed when the loop ends)
+        std::ostringstream outerCode;
+        // the position in the loop code where the loop body starts
+        size_t bodyStart;
+        bool vectorizable;
+        // the IDs of the temporary variables declared inside the loop body
+        std::set<size_t> temporaries;
+        std::set<const Node*> temporaryNodes;
+        // variables declared outside the loop which are assigned in every iteration
+        std::set<std::string> privateVariables;
+    };
+    std::vector<LoopVectorization> _loopVectorization;
 private:
     std::vector<std::string> funcArgDcl_;
     std::vector<std::string> localFuncArgDcl_;
@@ -138,7 +189,14 @@ public:
         _ignoreZeroDepAssign(false),
         _maxAssigmentsPerFunction(0),
         _sources(nullptr),
-        _parameterPrecision(std::numeric_limits<Base>::digits10) {
+        _parameterPrecision(std::numeric_limits<Base>::digits10),
+        _fuseTranscendentals(false),
+        _fusedFunctionIndex(1),
+        _fusedDisabled(0),
+        _splitMinimizeLive(false),
+        _splitPlanned(false),
+        _constantPool(nullptr),
+        _vectorizeLoops(false) {
     }
 
     inline virtual ~LanguageC() = default;
@@ -220,6 +278,112 @@ public:
         _parameterPrecision = p;
     }
 
+    /**
+     * Whether or not transcendental functions with the same argument are
+     * evaluated together.
+     */
+    virtual bool isFuseTranscendentalFunctions() const {
+        return _fuseTranscendentals;
+    }
+
+    /**
+     * Defines whether or not transcendental functions with the same argument
+     * (in the same scope) are evaluated together in the generated code:
+     *  - sin() and cos() use a single call to sincos();
+     *  - exp(), expm1(), sinh(), and cosh() use a single call to expm1().
+     * Repeated calls to the same function with the same argument are also
+     * evaluated only once.
+     * It is only applied when a function is generated
+     * (see setGenerateFunction()) and sincos() requires a C library which
+     * provides it (e.g. glibc).
+     *
+     * @param fuse true to enable fused evaluations
+     */
+    virtual void setFuseTranscendentalFunctions(bool fuse) {
+        _fuseTranscendentals = fuse;
+    }
+
+    /**
+     * Whether or not the generated code is split into local functions
+     * at positions with few live temporary variables.
+     */
+    virtual bool isSplitMinimizingLiveVariables() const {
+        return _splitMinimizeLive;
+    }
+
+    /**
+     * Defines how the code is split into several local functions
+     * (see setMaxAssigmentsPerFunction()).
+     * When enabled, each local function has between half and the maximum
+     * number of assignments and it ends where the fewest temporary
+     * variables are still required by the following functions.
+     * Temporary variables only used inside a single local function are
+     * declared locally instead of being saved in the shared temporary
+     * array.
+     * Code with loops is always split using only the number of assignments.
+     *
+     * @param minimize true to split where fewer temporaries are alive
+     */
+    virtual void setSplitMinimizingLiveVariables(bool minimize) {
+        _splitMinimizeLive = minimize;
+    }
+
+    virtual LangCConstantPool* getConstantPool() const {
+        return _constantPool;
+    }
+
+    /**
+     * Defines a table where long constant values are saved.
+     * Each distinct value is printed only once (in the source file created
+     * with LangCConstantPool::generateDefinition()) and the generated code
+     * references the elements of a constant array instead.
+     *
+     * @param pool the constant table (not owned) or nullptr to print all
+     *             values directly in the generated code
+     */
+    virtual void setConstantPool(LangCConstantPool* pool) {
+        _constantPool = pool;
+    }
+
+    /**
+     * Creates the declaration of the constant array which must be included
+     * in the source files with the generated code.
+     *
+     * @return the declaration or an empty string if a constant pool is
+     *         not used
+     */
+    inline std::string generateConstantPoolDeclaration() const {
+        if (_constantPool == nullptr)
+            return "";
+        return _constantPool->generateDeclaration(_baseTypeName) + "\n";
+    }
+
+    /**
+     * Whether or not the generated loops are prepared to be vectorized.
+     */
+    virtual bool isVectorizeLoops() const {
+        return _vectorizeLoops;
+    }
+
+    /**
+     * Prepares the generated code so that the compiler can vectorize the
+     * loops created for repeated patterns:
+     *  - the temporary variables computed inside a loop are declared in the
+     *    loop body instead of the shared temporary array;
+     *  - loops whose iterations are independent are annotated with
+     *    '#pragma omp simd' (requires -fopenmp-simd);
+     *  - the arrays of the independent, dependent, and temporary variables
+     *    are declared with '__restrict' (they must not overlap).
+     * The mathematical functions are only evaluated with a vector math
+     * library (e.g. libmvec in glibc) if the compiler is allowed to do so
+     * (see GccCompiler::setVectorMathLibrary()).
+     *
+     * @param vectorize true to prepare the loops for vectorization
+     */
+    virtual void setVectorizeLoops(bool vectorize) {
+        _vectorizeLoops = vectorize;
+    }
+
     virtual void setMaxAssigmentsPerFunction(size_t maxAssigmentsPerFunction,
                                              std::map<std::string, std::string>* sources) {
         _maxAssigmentsPerFunction = maxAssigmentsPerFunction;
@@ -467,6 +631,7 @@ public:
     CPPAD_CG_C_LANG_FUNCNAME(tanh)
     CPPAD_CG_C_LANG_FUNCNAME(tan)
     CPPAD_CG_C_LANG_FUNCNAME(pow)
+    CPPAD_CG_C_LANG_FUNCNAME(sincos)
 
 #if CPPAD_USE_CPLUSPLUS_2011
     CPPAD_CG_C_LANG_FUNCNAME(erf)
@@ -627,6 +792,7 @@ protected:
         localFuncArgs_ = "";
         auxArrayName_ = "";
         _currentLoops.clear();
+        _loopVectorization.clear();
         _atomicFuncArrays.clear();
 
         // save some info
@@ -735,16 +901,28 @@ protected:
             localFuncNames.reserve(variableOrder.size() / _maxAssigmentsPerFunction);
         }
 
+        findFusedFunctions(variableOrder);
+
         /**
          * non-constant variables
          */
         if (variableOrder.size() > 0) {
             // generate names for temporary variables
+            size_t loopDepth = 0;
             for (Node* node : variableOrder) {
                 CGOpCode op = node->getOperationType();
+                if (op == CGOpCode::LoopStart) {
+                    loopDepth++;
+                } else if (op == CGOpCode::LoopEnd) {
+                    loopDepth--;
+                }
+
                 if (!isDependent(*node) && op != CGOpCode::IndexDeclaration) {
                     // variable names for temporaries must always be created since they might have been used before with a different name/id
-                    if (requiresVariableName(*node) && op != CGOpCode::ArrayCreation && op != CGOpCode::SparseArrayCreation) {
+                    if (_vectorizeLoops && loopDepth > 0 && isLocalTemporaryCandidate(op)) {
+                        // declared inside the loop body when the loop is printed
+                        node->clearName();
+                    } else if (requiresVariableName(*node) && op != CGOpCode::ArrayCreation && op != CGOpCode::SparseArrayCreation) {
                         node->setName(_nameGen->generateTemporary(*node, getVariableID(*node)));
                     } else if (op == CGOpCode::ArrayCreation) {
                         node->setName(_nameGen->generateTemporaryArray(*node, getVariableID(*node)));
@@ -754,6 +932,11 @@ protected:
                 }
             }
 
+            _splitPlanned = false;
+            if (multiFunction && _splitMinimizeLive) {
+                planFunctionSplitting(variableOrder);
+            }
+
             /**
              * Source code generation magic!
              */
@@ -778,7 +961,9 @@ protected:
                 Node* it = variableOrder[i];
 
                 // check if a new function should start
-                if (assignCount >= _maxAssigmentsPerFunction && multiFunction && _currentLoops.empty()) {
+                bool split = _splitPlanned ? _splitPositions.find(i) != _splitPositions.end() :
+                                             assignCount >= _maxAssigmentsPerFunction;
+                if (split && multiFunction && _currentLoops.empty()) {
                     assignCount = 0;
                     saveLocalFunction(localFuncNames, localFuncNames.empty() && info->zeroDependents);
                 }
@@ -813,6 +998,7 @@ protected:
                                  "The temporary variables must be saved in an array in order to generate multiple functions");
 
             _code << ATOMICFUN_STRUCT_DEFINITION << "\n\n";
+            _code << generateConstantPoolDeclaration();
             // forward declarations
             std::string localFuncArgDcl2 = implode(localFuncArgDcl_, ", ");
             for (size_t i = 0; i < localFuncNames.size(); i++) {
@@ -875,9 +1061,11 @@ protected:
          */
         if (createFunction) {
             if (localFuncNames.empty()) {
-                _ss << "#include <math.h>\n"
+                _ss << generateFusedFunctionsHeader()
+                    << "#include <math.h>\n"
                         "#include <stdio.h>\n\n"
-                    << ATOMICFUN_STRUCT_DEFINITION << "\n\n";
+                    << ATOMICFUN_STRUCT_DEFINITION << "\n\n"
+                    << generateConstantPoolDeclaration();
                 printFunctionDeclaration(_ss, "void", _functionName, funcArgDcl_);
                 _ss << " {\n";
                 _nameGen->customFunctionVariableDeclarations(_ss);
@@ -886,6 +1074,7 @@ protected:
                 _ss << generateTemporaryVariableDeclaration(false, info->zeroDependents,
                                                             info->atomicFunctionsMaxForward,
                                                             info->atomicFunctionsMaxReverse) << "\n";
+                _ss << generateFusedVariableDeclaration();
                 _nameGen->prepareCustomFunctionVariables(_ss);
                 _ss << _code.str();
                 _nameGen->finalizeCustomFunctionVariables(_ss);
@@ -931,6 +1120,7 @@ protected:
                                    Node& nodeRhs) {
         bool createsVar = directlyAssignsVariable(nodeRhs); // do we need to do the assignment here?
         if (!createsVar) {
+            printFusedEvaluations(nodeRhs);
             printAssignmentStart(nodeName);
         }
         unsigned lines = printExpressionNoVarCheck(nodeRhs);
@@ -962,6 +1152,10 @@ protected:
             _temporary[getVariableID(node)] = &node;
         }
 
+        if (!_loopVectorization.empty() && !isVectorizableAssignment(node, isDep)) {
+            _loopVectorization.back().vectorizable = false;
+        }
+
         _code << _indentation << varName << " ";
         if (isDep) {
             CGOpCode op = node.getOperationType();
@@ -983,7 +1177,7 @@ protected:
     virtual std::string argumentDeclaration(const FuncArgument& funcArg) const {
         std::string dcl = _baseTypeName;
         if (funcArg.array) {
-            dcl += "*";
+            dcl += _vectorizeLoops ? "* __restrict" : "*";
         }
         return dcl + " " + funcArg.name;
     }
@@ -994,14 +1188,25 @@ protected:
         std::string funcName = _ss.str();
         _ss.str("");
 
-        _ss << "#include <math.h>\n"
+        _ss << generateFusedFunctionsHeader()
+            << "#include <math.h>\n"
                 "#include <stdio.h>\n\n"
-                << ATOMICFUN_STRUCT_DEFINITION << "\n\n";
+                << ATOMICFUN_STRUCT_DEFINITION << "\n\n"
+                << generateConstantPoolDeclaration();
         printFunctionDeclaration(_ss, "void", funcName, localFuncArgDcl_);
         _ss << " {\n";
         _nameGen->customFunctionVariableDeclarations(_ss);
         _ss << generateIndependentVariableDeclaration() << "\n";
         _ss << generateDependentVariableDeclaration() << "\n";
+        size_t localFunc = localFuncNames.size();
+        if (localFunc < _localTemporaries.size() && !_localTemporaries[localFunc].empty()) {
+            _ss << _spaces << _baseTypeName;
+            size_t e = 0;
+            for (size_t id : _localTemporaries[localFunc]) {
+                _ss << (e++ == 0 ? " " : ", ") << localTemporaryName(id);
+            }
+            _ss << ";\n";
+        }
         size_t arraySize = _nameGen->getMaxTemporaryArrayVariableID();
         size_t sArraySize = _nameGen->getMaxTemporarySparseArrayVariableID();
         if (arraySize > 0 || sArraySize > 0) {
@@ -1019,6 +1224,11 @@ protected:
         // loop indexes
         createIndexDeclaration();
 
+        _ss << generateFusedVariableDeclaration();
+        // the fused values must be evaluated again in the next function
+        _fusedGroupsInFunction.clear();
+        _fusedFunctionIndex++;
+
         _nameGen->prepareCustomFunctionVariables(_ss);
         _ss << _code.str();
         _nameGen->finalizeCustomFunctionVariables(_ss);
@@ -1031,6 +1241,196 @@ protected:
         _ss.str("");
     }
 
+    static inline std::string localTemporaryName(size_t id) {
+        return "lv" + std::to_string(id);
+    }
+
+    static inline std::string loopTemporaryName(size_t id) {
+        return "lt" + std::to_string(id);
+    }
+
+    /**
+     * Whether or not a temporary variable created by an operation can be
+     * declared inside a local function.
+     */
+    static inline bool isLocalTemporaryCandidate(CGOpCode op) {
+        switch (op) {
+            case CGOpCode::Abs:
+            case CGOpCode::Acos:
+            case CGOpCode::Acosh:
+            case CGOpCode::Add:
+            case CGOpCode::Asin:
+            case CGOpCode::Asinh:
+            case CGOpCode::Assign:
+            case CGOpCode::Atan:
+            case CGOpCode::Atanh:
+            case CGOpCode::Cosh:
+            case CGOpCode::Cos:
+            case CGOpCode::Div:
+            case CGOpCode::Erf:
+            case CGOpCode::Exp:
+            case CGOpCode::Expm1:
+            case CGOpCode::Log:
+            case CGOpCode::Log1p:
+            case CGOpCode::Mul:
+            case CGOpCode::Pow:
+            case CGOpCode::Sign:
+            case CGOpCode::Sinh:
+            case CGOpCode::Sin:
+            case CGOpCode::Sqrt:
+            case CGOpCode::Sub:
+            case CGOpCode::Tanh:
+            case CGOpCode::Tan:
+            case CGOpCode::UnMinus:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * Determines where the code should be split into local functions so
+     * that few temporary variables are alive between functions, and which
+     * temporary variables can be declared locally.
+     */
+    virtual void planFunctionSplitting(const std::vector<Node*>& variableOrder) {
+        _splitPositions.clear();
+        _localTemporaries.clear();
+
+        const size_t n = variableOrder.size();
+        const size_t maxAssign = _maxAssigmentsPerFunction;
+
+        std::map<const Node*, size_t> position;
+        std::vector<size_t> weight(n, 0);
+        std::vector<bool> splittable(n, false); // whether a function can start at each position
+        size_t ifDepth = 0;
+        for (size_t i = 0; i < n; i++) {
+            const Node* node = variableOrder[i];
+            CGOpCode op = node->getOperationType();
+            if (op == CGOpCode::LoopStart || op == CGOpCode::LoopIndexedDep)
+                return; // loops are split using only the number of assignments
+
+            splittable[i] = ifDepth == 0;
+            if (op == CGOpCode::StartIf) {
+                ifDepth++;
+            } else if (op == CGOpCode::EndIf) {
+                ifDepth--;
+            }
+
+            if (op != CGOpCode::DependentRefRhs && op != CGOpCode::TmpDcl)
+                weight[i] = 1;
+            position[node] = i;
+        }
+
+        /**
+         * determine the last position where each variable is used
+         */
+        std::vector<size_t> lastUse(n);
+        std::vector<bool> usedByArray(n, false); // arrays may use consecutive array elements
+        std::vector<const Node*> stack;
+        for (size_t i = 0; i < n; i++) {
+            lastUse[i] = i;
+
+            stack.push_back(variableOrder[i]);
+            while (!stack.empty()) {
+                const Node* node = stack.back();
+                stack.pop_back();
+                CGOpCode op = node->getOperationType();
+                bool array = op == CGOpCode::ArrayCreation || op == CGOpCode::SparseArrayCreation;
+
+                for (const Arg& a : node->getArguments()) {
+                    const Node* arg = a.getOperation();
+                    if (arg == nullptr)
+                        continue;
+                    auto it = position.find(arg);
+                    if (it != position.end()) {
+                        lastUse[it->second] = std::max(lastUse[it->second], i);
+                        if (array)
+                            usedByArray[it->second] = true;
+                    } else if (getVariableID(*arg) == 0) {
+                        stack.push_back(arg); // printed inline
+                    }
+                }
+            }
+        }
+
+        /**
+         * number of temporary variables alive before each position
+         */
+        std::vector<long> live(n + 1, 0);
+        for (size_t d = 0; d < n; d++) {
+            const Node& node = *variableOrder[d];
+            if (lastUse[d] > d && !isDependent(node) && getVariableID(node) > _independentSize) {
+                live[d + 1]++;
+                live[lastUse[d] + 1]--;
+            }
+        }
+        for (size_t i = 1; i <= n; i++)
+            live[i] += live[i - 1];
+
+        /**
+         * select the split positions
+         */
+        std::vector<size_t> accWeight(n + 1, 0);
+        for (size_t i = 0; i < n; i++)
+            accWeight[i + 1] = accWeight[i] + weight[i];
+
+        size_t start = 0;
+        while (accWeight[n] - accWeight[start] > maxAssign) {
+            size_t best = n;
+            for (size_t i = start + 1; i < n && accWeight[i] - accWeight[start] <= maxAssign; i++) {
+                if (splittable[i] && accWeight[i] - accWeight[start] >= maxAssign / 2 &&
+                    (best == n || live[i] <= live[best])) {
+                    best = i;
+                }
+            }
+
+            if (best == n) {
+                // no position within the limits: use the next possible one
+                for (size_t i = start + 1; i < n; i++) {
+                    if (splittable[i] && accWeight[i] > accWeight[start]) {
+                        best = i;
+                        break;
+                    }
+                }
+                if (best == n)
+                    break;
+            }
+
+            _splitPositions.insert(best);
+            start = best;
+        }
+
+        if (_splitPositions.empty())
+            return;
+
+        _splitPlanned = true;
+
+        /**
+         * temporaries used only inside one local function
+         */
+        _localTemporaries.resize(_splitPositions.size() + 1);
+        auto function = [this](size_t pos) {
+            return size_t(std::distance(_splitPositions.begin(), _splitPositions.upper_bound(pos)));
+        };
+
+        for (size_t d = 0; d < n; d++) {
+            Node& node = *variableOrder[d];
+            if (usedByArray[d] || isDependent(node) || !isLocalTemporaryCandidate(node.getOperationType()))
+                continue;
+
+            size_t id = getVariableID(node);
+            if (id <= _independentSize)
+                continue;
+
+            size_t f = function(d);
+            if (f == function(lastUse[d])) {
+                node.setName(localTemporaryName(id));
+                _localTemporaries[f].insert(id);
+            }
+        }
+    }
+
     bool createsNewVariable(const Node& var,
                             size_t totalUseCount) const override {
         CGOpCode op = var.getOperationType();
@@ -1159,6 +1559,14 @@ protected:
                 CPPADCG_ASSERT_KNOWN(tmpVar != nullptr && tmpVar->getOperationType() == CGOpCode::TmpDcl, "Invalid arguments for loop indexed temporary operation");
                 return createVariableName(*tmpVar);
 
+            } else if (!_loopVectorization.empty() && isLocalTemporaryCandidate(op)) {
+                // each loop iteration uses its own copy
+                LoopVectorization& loop = _loopVectorization.back();
+                size_t id = getVariableID(var);
+                var.setName(loopTemporaryName(id));
+                loop.temporaries.insert(id);
+                loop.temporaryNodes.insert(&var);
+
             } else {
                 // temporary variable
                 var.setName(_nameGen->generateTemporary(var, getVariableID(var)));
@@ -1203,6 +1611,10 @@ protected:
 
     virtual unsigned printExpressionNoVarCheck(Node& node) {
         CGOpCode op = node.getOperationType();
+        if (!_loopVectorization.empty()) {
+            checkLoopVectorization(node);
+        }
+
         switch (op) {
             case CGOpCode::ArrayCreation:
                 printArrayCreationOp(node);
@@ -1353,6 +1765,12 @@ protected:
     virtual void printUnaryFunction(Node& op) {
         CPPADCG_ASSERT_KNOWN(op.getArguments().size() == 1, "Invalid number of arguments for unary function");
 
+        if (!_fusedNode2Group.empty() && printFusedFunction(op)) {
+            if (!_loopVectorization.empty())
+                _loopVectorization.back().vectorizable = false; // the fused values are shared
+            return;
+        }
+
         switch (op.getOperationType()) {
             case CGOpCode::Abs:
                 _code << absFuncName();
@@ -1422,6 +1840,282 @@ protected:
         _code << ")";
     }
 
+    static inline bool isFusableTrigonometric(CGOpCode op) {
+        return op == CGOpCode::Sin || op == CGOpCode::Cos;
+    }
+
+    static inline bool isFusableHyperbolic(CGOpCode op) {
+#if CPPAD_USE_CPLUSPLUS_2011
+        return op == CGOpCode::Exp || op == CGOpCode::Expm1 || op == CGOpCode::Sinh || op == CGOpCode::Cosh;
+#else
+        return op == CGOpCode::Exp;
+#endif
+    }
+
+    /**
+     * Determines which transcendental functions have the same argument
+     * in the same scope.
+     */
+    virtual void findFusedFunctions(const std::vector<Node*>& variableOrder) {
+        _fusedGroups.clear();
+        _fusedNode2Group.clear();
+        _fusedGroupsInFunction.clear();
+        _fusedFunctionIndex = 1;
+        _fusedDisabled = 0;
+
+        if (!_fuseTranscendentals || _functionName.empty())
+            return;
+
+        using ScopeIDType = typename LanguageGenerationData<Base>::ScopeIDType;
+        using Key = std::tuple<const Node*, ScopeIDType, bool>;
+        std::map<Key, std::vector<const Node*> > candidates;
+
+        // visit all nodes (including the ones which do not create variables)
+        std::set<const Node*> visited;
+        std::vector<const Node*> stack(variableOrder.begin(), variableOrder.end());
+        while (!stack.empty()) {
+            const Node* node = stack.back();
+            stack.pop_back();
+            if (!visited.insert(node).second)
+                continue;
+
+            CGOpCode op = node->getOperationType();
+            const std::vector<Arg>& args = node->getArguments();
+            if (isFusableTrigonometric(op) || isFusableHyperbolic(op)) {
+                const Node* arg = args[0].getOperation();
+                if (arg != nullptr) {
+                    Key key(arg, _info->scope[*node], isFusableTrigonometric(op));
+                    candidates[key].push_back(node);
+                }
+            }
+
+            for (const Arg& a : args) {
+                if (a.getOperation() != nullptr && getVariableID(*a.getOperation()) == 0)
+                    stack.push_back(a.getOperation());
+            }
+        }
+
+        for (const auto& it : candidates) {
+            if (it.second.size() < 2)
+                continue;
+
+            size_t g = _fusedGroups.size();
+            _fusedGroups.push_back(FusedFunctionGroup{std::get<2>(it.first), {}, 0});
+            for (const Node* node : it.second) {
+                _fusedGroups[g].ops.insert(node->getOperationType());
+                _fusedNode2Group[node] = g;
+            }
+        }
+    }
+
+    inline std::string fusedVariableName(size_t group,
+                                         const std::string& suffix) const {
+        return (_fusedGroups[group].trigonometric ? "sc" : "eh") + std::to_string(group) + "_" + suffix;
+    }
+
+    /**
+     * Prints, as separate statements, the evaluation of the fused
+     * transcendental functions which are used for the first time (in the
+     * current function) by an expression.
+     * These statements must be printed before the statement with the
+     * expression.
+     *
+     * @param node the expression to be printed next
+     */
+    virtual void printFusedEvaluations(Node& node) {
+        if (_fusedNode2Group.empty() || _fusedDisabled > 0)
+            return;
+
+        std::set<const Node*> visited;
+        printFusedEvaluations(node, visited);
+    }
+
+    virtual void printFusedEvaluations(Node& node,
+                                       std::set<const Node*>& visited) {
+        if (!visited.insert(&node).second)
+            return;
+
+        // the arguments of this function could also be fused functions
+        for (const Arg& a : node.getArguments()) {
+            Node* arg = a.getOperation();
+            if (arg != nullptr && getVariableID(*arg) == 0)
+                printFusedEvaluations(*arg, visited);
+        }
+
+        auto it = _fusedNode2Group.find(&node);
+        if (it == _fusedNode2Group.end())
+            return;
+
+        size_t g = it->second;
+        FusedFunctionGroup& group = _fusedGroups[g];
+        if (group.evaluatedIn == _fusedFunctionIndex)
+            return; // already evaluated in this function
+
+        group.evaluatedIn = _fusedFunctionIndex;
+        _fusedGroupsInFunction.insert(g);
+        if (!_loopVectorization.empty())
+            _loopVectorization.back().vectorizable = false; // the fused values are shared
+
+        const std::set<CGOpCode>& ops = group.ops;
+        const Arg& arg = node.getArguments()[0];
+
+        if (group.trigonometric) {
+            bool sin = ops.count(CGOpCode::Sin) > 0;
+            bool cos = ops.count(CGOpCode::Cos) > 0;
+            _code << _indentation;
+            if (sin && cos) {
+                _code << sincosFuncName() << "(";
+                print(arg);
+                _code << ", &" << fusedVariableName(g, "s") << ", &" << fusedVariableName(g, "c") << ");\n";
+            } else {
+                _code << fusedVariableName(g, sin ? "s" : "c") << " = " << (sin ? sinFuncName() : cosFuncName()) << "(";
+                print(arg);
+                _code << ");\n";
+            }
+            return;
+        }
+
+        if (usesFusedExp(ops)) {
+            _code << _indentation << fusedVariableName(g, "e") << " = " << expFuncName() << "(";
+            print(arg);
+            _code << ");\n";
+        }
+        if (usesFusedInverseExp(ops)) {
+            // exp(-x)
+            _code << _indentation << fusedVariableName(g, "r") << " = ";
+            printParameter(Base(1));
+            _code << " / " << fusedVariableName(g, "e") << ";\n";
+        }
+#if CPPAD_USE_CPLUSPLUS_2011
+        if (usesFusedExpm1(ops)) {
+            _code << _indentation << fusedVariableName(g, "u") << " = " << expm1FuncName() << "(";
+            print(arg);
+            _code << ");\n";
+        }
+#endif
+    }
+
+    /**
+     * Whether or not exp(x) must be determined for a group of fused
+     * hyperbolic functions
+     */
+    static inline bool usesFusedExp(const std::set<CGOpCode>& ops) {
+        return ops.count(CGOpCode::Exp) > 0 || usesFusedInverseExp(ops);
+    }
+
+    /**
+     * Whether or not exp(-x) must be determined for a group of fused
+     * hyperbolic functions
+     */
+    static inline bool usesFusedInverseExp(const std::set<CGOpCode>& ops) {
+        return ops.count(CGOpCode::Sinh) > 0 || ops.count(CGOpCode::Cosh) > 0;
+    }
+
+    /**
+     * Whether or not expm1(x) must be determined for a group of fused
+     * hyperbolic functions
+     */
+    static inline bool usesFusedExpm1(const std::set<CGOpCode>& ops) {
+        return ops.count(CGOpCode::Expm1) > 0 || ops.count(CGOpCode::Sinh) > 0;
+    }
+
+    /**
+     * Prints the value of a transcendental function which was determined
+     * together with other functions with the same argument.
+     *
+     * @return true if the function was printed
+     */
+    virtual bool printFusedFunction(Node& node) {
+        if (_fusedDisabled > 0)
+            return false;
+
+        auto it = _fusedNode2Group.find(&node);
+        if (it == _fusedNode2Group.end())
+            return false;
+
+        size_t g = it->second;
+        const FusedFunctionGroup& group = _fusedGroups[g];
+        if (group.evaluatedIn != _fusedFunctionIndex)
+            return false; // not evaluated in a previous statement of this function
+
+        switch (node.getOperationType()) {
+            case CGOpCode::Sin:
+                _code << fusedVariableName(g, "s");
+                break;
+            case CGOpCode::Cos:
+                _code << fusedVariableName(g, "c");
+                break;
+            case CGOpCode::Exp:
+                _code << fusedVariableName(g, "e");
+                break;
+            case CGOpCode::Expm1:
+                _code << fusedVariableName(g, "u");
+                break;
+            case CGOpCode::Sinh:
+                // (exp(x) - exp(-x)) / 2 = expm1(x) * (1 + exp(-x)) / 2
+                _code << "(";
+                printParameter(Base(0.5));
+                _code << " * " << fusedVariableName(g, "u") << " * (";
+                printParameter(Base(1));
+                _code << " + " << fusedVariableName(g, "r") << "))";
+                break;
+            case CGOpCode::Cosh:
+                _code << "(";
+                printParameter(Base(0.5));
+                _code << " * (" << fusedVariableName(g, "e") << " + " << fusedVariableName(g, "r") << "))";
+                break;
+            default:
+                CPPADCG_ASSERT_UNKNOWN(false);
+        }
+
+        return true;
+    }
+
+    /**
+     * Declaration of the variables used by the fused transcendental
+     * functions in the current function
+     */
+    virtual std::string generateFusedVariableDeclaration() {
+        if (_fusedGroupsInFunction.empty())
+            return "";
+
+        std::string names;
+        for (size_t g : _fusedGroupsInFunction) {
+            const std::set<CGOpCode>& ops = _fusedGroups[g].ops;
+            std::vector<std::string> suffixes;
+            if (_fusedGroups[g].trigonometric) {
+                if (ops.count(CGOpCode::Sin) > 0) suffixes.push_back("s");
+                if (ops.count(CGOpCode::Cos) > 0) suffixes.push_back("c");
+            } else {
+                if (usesFusedExp(ops)) suffixes.push_back("e");
+                if (usesFusedInverseExp(ops)) suffixes.push_back("r");
+                if (usesFusedExpm1(ops)) suffixes.push_back("u");
+            }
+            for (const std::string& suffix : suffixes) {
+                if (!names.empty()) names += ", ";
+                names += fusedVariableName(g, suffix);
+            }
+        }
+
+        return _spaces + _baseTypeName + " " + names + ";\n";
+    }
+
+    /**
+     * Preprocessor definitions required by the fused transcendental
+     * functions in the current function
+     */
+    virtual std::string generateFusedFunctionsHeader() const {
+        for (size_t g : _fusedGroupsInFunction) {
+            const FusedFunctionGroup& group = _fusedGroups[g];
+            if (group.trigonometric && group.ops.size() == 2) {
+                return "#ifndef _GNU_SOURCE\n"
+                        "#define _GNU_SOURCE // sincos()\n"
+                        "#endif\n";
+            }
+        }
+        return "";
+    }
+
     virtual void printPowFunction(Node& op) {
         CPPADCG_ASSERT_KNOWN(op.getArguments().size() == 2, "Invalid number of arguments for pow() function");
 
@@ -1649,6 +2343,7 @@ protected:
             _code << " " << getComparison(node.getOperationType()) << " ";
             print(right);
             _code << " ) {\n";
+            _fusedDisabled++; // only one of the branches is evaluated
             _code << _spaces;
             printAssignmentStart(node, varName, isDep);
             print(trueCase);
@@ -1659,6 +2354,7 @@ protected:
             print(falseCase);
             printAssignmentEnd(node);
             _code << _indentation << "}\n";
+            _fusedDisabled--;
         }
     }
 
@@ -1818,6 +2514,17 @@ protected:
         LoopStartOperationNode<Base>& lnode = static_cast<LoopStartOperationNode<Base>&> (node);
         _currentLoops.push_back(&lnode);
 
+        if (_vectorizeLoops) {
+            // only the innermost loops are vectorized
+            for (LoopVectorization& outer : _loopVectorization)
+                outer.vectorizable = false;
+            _loopVectorization.emplace_back();
+            LoopVectorization& loop = _loopVectorization.back();
+            loop.vectorizable = true;
+            loop.outerCode.copyfmt(_code);
+            loop.outerCode.swap(_code);
+        }
+
         const std::string& jj = *lnode.getIndex().getName();
         std::string iterationCount;
         if (lnode.getIterationCountNode() != nullptr) {
@@ -1833,6 +2540,10 @@ protected:
                 << jj << " < " << iterationCount << "; "
                 << jj << "++) {\n";
         _indentation += _spaces;
+
+        if (_vectorizeLoops) {
+            _loopVectorization.back().bodyStart = size_t(_code.tellp());
+        }
     }
 
     virtual void printLoopEnd(Node& node) {
@@ -1842,9 +2553,122 @@ protected:
 
         _code << _indentation << "}\n";
 
+        if (_vectorizeLoops) {
+            finishLoopVectorization();
+        }
+
         _currentLoops.pop_back();
     }
 
+    /**
+     * Declares the temporary variables of the loop which just ended inside
+     * its body and annotates the loop if its iterations are independent.
+     */
+    virtual void finishLoopVectorization() {
+        CPPADCG_ASSERT_UNKNOWN(!_loopVectorization.empty());
+        LoopVectorization& loop = _loopVectorization.back();
+
+        std::string code = _code.str(); // only the code of this loop
+        std::ostringstream ss;
+
+        if (!loop.temporaries.empty()) {
+            ss << _indentation << _spaces << _baseTypeName;
+            size_t e = 0;
+            for (size_t id : loop.temporaries) {
+                ss << (e++ == 0 ? " " : ", ") << loopTemporaryName(id);
+            }
+            ss << ";\n";
+            code.insert(loop.bodyStart, ss.str());
+            ss.str("");
+        }
+
+        if (loop.vectorizable) {
+            ss << "#pragma omp simd";
+            if (!loop.privateVariables.empty()) {
+                ss << " private(";
+                size_t e = 0;
+                for (const std::string& v : loop.privateVariables) {
+                    ss << (e++ == 0 ? "" : ", ") << v;
+                }
+                ss << ")";
+            }
+            ss << "\n";
+            code.insert(0, ss.str());
+        }
+
+        _code.swap(loop.outerCode);
+        _code << code;
+
+        _loopVectorization.pop_back();
+    }
+
+    /**
+     * Determines whether or not an operation inside a loop prevents its
+     * iterations from being evaluated simultaneously.
+     */
+    virtual void checkLoopVectorization(const Node& node) {
+        LoopVectorization& loop = _loopVectorization.back();
+
+        switch (node.getOperationType()) {
+            case CGOpCode::IndexAssign: {
+                // an index declared outside the loop
+                const auto& inode = static_cast<const IndexAssignOperationNode<Base>&> (node);
+                loop.privateVariables.insert(*inode.getIndex().getName());
+                break;
+            }
+            case CGOpCode::ArrayCreation:
+            case CGOpCode::SparseArrayCreation:
+            case CGOpCode::ArrayElement:
+            case CGOpCode::AtomicForward:
+            case CGOpCode::AtomicReverse:
+            case CGOpCode::DependentMultiAssign:
+            case CGOpCode::LoopIndexedTmp: // accumulation between iterations
+            case CGOpCode::IndexCondExpr:
+            case CGOpCode::StartIf:
+            case CGOpCode::ElseIf:
+            case CGOpCode::Else:
+            case CGOpCode::EndIf:
+            case CGOpCode::CondResult:
+            case CGOpCode::Pri:
+            case CGOpCode::UserCustom:
+                loop.vectorizable = false;
+                break;
+            default:
+                break;
+        }
+    }
+
+    /**
+     * Whether or not an assignment inside a loop can be performed in
+     * every iteration simultaneously.
+     */
+    virtual bool isVectorizableAssignment(const Node& node,
+                                          bool isDep) const {
+        const LoopVectorization& loop = _loopVectorization.back();
+
+        if (!isDep) {
+            // temporary variables shared between iterations cannot be used
+            return loop.temporaryNodes.find(&node) != loop.temporaryNodes.end();
+        }
+
+        // each iteration must assign a different dependent element
+        if (node.getOperationType() != CGOpCode::LoopIndexedDep || node.getArguments().size() != 2)
+            return false;
+
+        const Node* index = node.getArguments()[1].getOperation();
+        if (index == nullptr || index->getOperationType() != CGOpCode::Index)
+            return false;
+        const auto& iop = static_cast<const IndexOperationNode<Base>&> (*index);
+        if (&iop.getIndex() != &_currentLoops.back()->getIndex())
+            return false;
+
+        const IndexPattern* ip = _info->loopDependentIndexPatterns[node.getInfo()[0]];
+        if (ip->getType() != IndexPatternType::Linear)
+            return false;
+        const auto* lip = static_cast<const LinearIndexPattern*> (ip);
+        return lip->getLinearSlopeDx() == 1 && lip->getLinearSlopeDy() != 0;
+    }
+
 
     virtual size_t printLoopIndexDeps(const std::vector<Node*>& variableOrder,
                                       size_t pos);
@@ -1991,21 +2815,109 @@ protected:
         return id > _independentSize && id < _minTemporaryVarID;
     }
 
+    /**
+     * Prints a constant value.
+     * Floating point values are printed with the fewest digits (up to the
+     * parameter precision) which still allow to recover the same value.
+     */
     virtual void printParameter(const Base& value) {
+        printParameterValue(value, std::is_floating_point<Base>());
+    }
+
+    inline void printParameterValue(const Base& value,
+                                    std::true_type) {
+        // avoids the creation of a new stream for each value
+        char number[64];
+        int length = formatFloatingPoint(number, value, std::min<size_t>(_parameterPrecision, 40));
+
+        if (std::abs(value) > Base(0) && value != Base(1) && value != Base(-1)) {
+            if (std::memchr(number, '.', length) == nullptr && std::memchr(number, 'e', length) == nullptr &&
+                std::memchr(number, 'n', length) == nullptr) { // inf and nan
+                // also make sure there is always a '.' after the number in
+                // order to avoid integer overflows
+                number[length++] = '.';
+            }
+        }
+
+        printLiteral(number, length);
+    }
+
+    inline void printParameterValue(const Base& value,
+                                    std::false_type) {
         // make sure all digits of floating point values are printed
         std::ostringstream os;
         os << std::setprecision(_parameterPrecision) << value;
 
         std::string number = os.str();
-        _code << number;
 
         if (std::abs(value) > Base(0) && value != Base(1) && value != Base(-1)) {
             if (number.find('.') == std::string::npos && number.find('e') == std::string::npos) {
                 // also make sure there is always a '.' after the number in
                 // order to avoid integer overflows
-                _code << '.';
+                number += '.';
             }
         }
+
+        printLiteral(number.c_str(), number.size());
+    }
+
+    /**
+     * Prints a constant value directly or as an element of the constant
+     * array.
+     */
+    inline void printLiteral(const char* number,
+                             size_t length) {
+        if (_constantPool != nullptr && _constantPool->isPooled(number, length)) {
+            _code << _constantPool->getName() << "[" << _constantPool->add(std::string(number, length)) << "]";
+        } else {
+            _code.write(number, length);
+        }
+    }
+
+    static inline int printFloatingPoint(char* out, int precision, double value) {
+        return std::snprintf(out, 64, "%.*g", precision, value);
+    }
+
+    static inline int printFloatingPoint(char* out, int precision, long double value) {
+        return std::snprintf(out, 64, "%.*Lg", precision, value);
+    }
+
+    static inline bool isSameFloatingPoint(const char* number, float value) {
+        return std::strtof(number, nullptr) == value;
+    }
+
+    static inline bool isSameFloatingPoint(const char* number, double value) {
+        return std::strtod(number, nullptr) == value;
+    }
+
+    static inline bool isSameFloatingPoint(const char* number, long double value) {
+        return std::strtold(number, nullptr) == value;
+    }
+
+    /**
+     * Prints a floating point value with the fewest digits (up to the
+     * maximum precision) that round-trip.
+     * Values which are exact with digits10 digits (most of them) only
+     * require a single conversion.
+     *
+     * @return the number of characters
+     */
+    template<class T>
+    static inline int formatFloatingPoint(char* out,
+                                          T value,
+                                          size_t maxPrecision) {
+        using Print = typename std::conditional<std::is_same<T, long double>::value, long double, double>::type;
+
+        int precision = std::min<int>(std::numeric_limits<T>::digits10, maxPrecision);
+        int length = printFloatingPoint(out, precision, Print(value));
+
+        while (size_t(precision) < maxPrecision && precision < std::numeric_limits<T>::max_digits10 &&
+               value == value && !isSameFloatingPoint(out, value)) {
+            precision++;
+            length = printFloatingPoint(out, precision, Print(value));
+        }
+
+        return length;
     }
 
     virtual const std::string& getComparison(enum CGOpCode op) const {
@@ -101,6 +101,12 @@ inline const std::string& LanguageC<float>::tanFuncName() {
     return name;
 }
 
+template<>
+inline const std::string& LanguageC<float>::sincosFuncName() {
+    static const std::string name("sincosf"); // GNU extension
+    return name;
+}
+
 #if CPPAD_USE_CPLUSPLUS_2011
 template<>
 inline const std::string& LanguageC<float>::erfFuncName() {
@@ -151,6 +151,9 @@ inline size_t LanguageC<Base>::printLoopIndexedDepsUsingLoop(const std::vector<O
      * print the loop
      */
     size_t depVarCount = i - starti;
+    if (!_loopVectorization.empty()) {
+        _loopVectorization.back().vectorizable = false; // nested loop
+    }
     _code << _indentation << "for(i = 0; i < " << depVarCount << "; i++) ";
     _code << rightAssign.str() << " ";
     if (refAssignOrAdd == 1) {
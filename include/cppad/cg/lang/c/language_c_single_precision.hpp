@@ -0,0 +1,120 @@
+#ifndef CPPAD_CG_LANGUAGE_C_SINGLE_PRECISION_INCLUDED
+#define CPPAD_CG_LANGUAGE_C_SINGLE_PRECISION_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#define CPPAD_CG_C_LANG_FUNCNAME_FLOAT(fn) \
+inline const std::string& fn ## FuncName() override {\
+    static const std::string name(#fn "f");\
+    return name;\
+}
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Generates C code evaluated with single precision (float) from operations
+ * recorded with a different base type (e.g. double).
+ * Constant values are rounded to float and the float versions of the math
+ * functions are used (requires C99).
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class LanguageCSinglePrecision : public LanguageC<Base> {
+public:
+
+    /**
+     * Creates a C language source code generator for single precision
+     * evaluations
+     *
+     * @param spaces number of spaces for indentations
+     */
+    explicit LanguageCSinglePrecision(size_t spaces = 3) :
+        LanguageC<Base>("float", spaces) {
+        this->_parameterPrecision = std::numeric_limits<float>::max_digits10;
+    }
+
+    /**
+     * Defines the maximum precision used to print constant values
+     * (limited to the digits of a float).
+     *
+     * @param p the maximum number of digits
+     */
+    void setParameterPrecision(size_t p) override {
+        LanguageC<Base>::setParameterPrecision(std::min<size_t>(p, std::numeric_limits<float>::max_digits10));
+    }
+
+    /**
+     * Single precision values use a different type from the constant pool
+     * of the model library and therefore it is never used.
+     */
+    void setConstantPool(LangCConstantPool* pool) override {
+    }
+
+    /**
+     * C language function names
+     */
+    CPPAD_CG_C_LANG_FUNCNAME_FLOAT(acos)
+    CPPAD_CG_C_LANG_FUNCNAME_FLOAT(asin)
+    CPPAD_CG_C_LANG_FUNCNAME_FLOAT(atan)
+    CPPAD_CG_C_LANG_FUNCNAME_FLOAT(cosh)
+    CPPAD_CG_C_LANG_FUNCNAME_FLOAT(cos)
+    CPPAD_CG_C_LANG_FUNCNAME_FLOAT(exp)
+    CPPAD_CG_C_LANG_FUNCNAME_FLOAT(log)
+    CPPAD_CG_C_LANG_FUNCNAME_FLOAT(sinh)
+    CPPAD_CG_C_LANG_FUNCNAME_FLOAT(sin)
+    CPPAD_CG_C_LANG_FUNCNAME_FLOAT(sqrt)
+    CPPAD_CG_C_LANG_FUNCNAME_FLOAT(tanh)
+    CPPAD_CG_C_LANG_FUNCNAME_FLOAT(tan)
+    CPPAD_CG_C_LANG_FUNCNAME_FLOAT(pow)
+    CPPAD_CG_C_LANG_FUNCNAME_FLOAT(sincos)
+#if CPPAD_USE_CPLUSPLUS_2011
+    CPPAD_CG_C_LANG_FUNCNAME_FLOAT(erf)
+    CPPAD_CG_C_LANG_FUNCNAME_FLOAT(asinh)
+    CPPAD_CG_C_LANG_FUNCNAME_FLOAT(acosh)
+    CPPAD_CG_C_LANG_FUNCNAME_FLOAT(atanh)
+    CPPAD_CG_C_LANG_FUNCNAME_FLOAT(expm1)
+    CPPAD_CG_C_LANG_FUNCNAME_FLOAT(log1p)
+#endif
+
+    inline const std::string& absFuncName() override {
+        static const std::string name("fabsf");
+        return name;
+    }
+
+protected:
+
+    void printParameter(const Base& value) override {
+        char number[64];
+        int length = LanguageC<Base>::formatFloatingPoint(number, float(value), this->_parameterPrecision);
+
+        if (std::memchr(number, 'n', length) == nullptr) { // inf and nan
+            if (std::memchr(number, '.', length) == nullptr && std::memchr(number, 'e', length) == nullptr) {
+                number[length++] = '.';
+            }
+            // avoid the promotion of the operations to double
+            number[length++] = 'f';
+        }
+
+        this->_code.write(number, length);
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -0,0 +1,967 @@
+#ifndef CPPAD_CG_BYTECODE_MODEL_INCLUDED
+#define CPPAD_CG_BYTECODE_MODEL_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A model which is evaluated by interpreting bytecode programs created
+ * from the operation graphs of a tape (see LanguageBytecode).
+ * There is no source code generation nor compilation involved and,
+ * therefore, the model can be used almost immediately (e.g. while the
+ * compiled version of the model is still being created).
+ *
+ * The sparsity patterns and the order of the sparse elements are the same
+ * as the ones used by ModelCSourceGen.
+ * The directional derivatives are evaluated with dense programs (the
+ * sparse variants scatter/gather the provided elements).
+ * Atomic functions are not supported.
+ *
+ * The evaluation methods reuse internal buffers and must not be called
+ * concurrently by several threads.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class BytecodeModel : public GenericModel<Base> {
+public:
+    using CGBase = CG<Base>;
+    using SparsitySetType = std::vector<std::set<size_t> >;
+protected:
+    /**
+     * the tape (only used by compile())
+     */
+    ADFun<CGBase>& _fun;
+    const std::string _name;
+    const size_t _n;
+    const size_t _m;
+    /**
+     * which programs should be created
+     */
+    bool _zero;
+    bool _jacobian;
+    bool _hessian;
+    bool _sparseJacobian;
+    bool _sparseHessian;
+    bool _hessianByEquation;
+    bool _forwardOne;
+    bool _reverseOne;
+    bool _reverseTwo;
+    /**
+     * custom sparse elements
+     */
+    bool _customJac;
+    std::vector<size_t> _customJacRows;
+    std::vector<size_t> _customJacCols;
+    bool _customHess;
+    std::vector<size_t> _customHessRows;
+    std::vector<size_t> _customHessCols;
+    /**
+     * sparsity patterns
+     */
+    bool _jacSparsityAvailable;
+    bool _hessSparsityAvailable;
+    SparsitySetType _jacSparsity;
+    std::vector<size_t> _jacRows;
+    std::vector<size_t> _jacCols;
+    SparsitySetType _hessSparsity;
+    std::vector<size_t> _hessRows;
+    std::vector<size_t> _hessCols;
+    std::vector<std::vector<size_t> > _hessRowsEq;
+    std::vector<std::vector<size_t> > _hessColsEq;
+    /**
+     * the bytecode programs
+     */
+    std::unique_ptr<BytecodeProgram<Base> > _zeroProg;
+    std::unique_ptr<BytecodeProgram<Base> > _jacobianProg;
+    std::unique_ptr<BytecodeProgram<Base> > _hessianProg;
+    std::unique_ptr<BytecodeProgram<Base> > _sparseJacobianProg;
+    std::unique_ptr<BytecodeProgram<Base> > _sparseHessianProg;
+    std::unique_ptr<BytecodeProgram<Base> > _forwardOneProg;
+    std::unique_ptr<BytecodeProgram<Base> > _reverseOneProg;
+    std::unique_ptr<BytecodeProgram<Base> > _reverseTwoProg;
+    /**
+     * auxiliary buffers
+     */
+    std::vector<Base> _x;
+    std::vector<Base> _tx1;
+    std::vector<Base> _py;
+    std::vector<Base> _out;
+    const std::vector<std::string> _atomicFunctions; // always empty
+public:
+
+    /**
+     * Creates a new bytecode model.
+     * No programs are created until compile() is called.
+     *
+     * @param fun The tape (it must remain valid until compile() is called)
+     * @param name The model name
+     */
+    inline BytecodeModel(ADFun<CGBase>& fun,
+                         const std::string& name) :
+        _fun(fun),
+        _name(name),
+        _n(fun.Domain()),
+        _m(fun.Range()),
+        _zero(true),
+        _jacobian(false),
+        _hessian(false),
+        _sparseJacobian(false),
+        _sparseHessian(false),
+        _hessianByEquation(false),
+        _forwardOne(false),
+        _reverseOne(false),
+        _reverseTwo(false),
+        _customJac(false),
+        _customHess(false),
+        _jacSparsityAvailable(false),
+        _hessSparsityAvailable(false) {
+    }
+
+    BytecodeModel(const BytecodeModel& orig) = delete;
+    BytecodeModel& operator=(const BytecodeModel& rhs) = delete;
+
+    inline virtual ~BytecodeModel() = default;
+
+    inline void setCreateForwardZero(bool create) {
+        _zero = create;
+    }
+
+    inline bool isCreateForwardZero() const {
+        return _zero;
+    }
+
+    inline void setCreateJacobian(bool create) {
+        _jacobian = create;
+    }
+
+    inline bool isCreateJacobian() const {
+        return _jacobian;
+    }
+
+    inline void setCreateHessian(bool create) {
+        _hessian = create;
+    }
+
+    inline bool isCreateHessian() const {
+        return _hessian;
+    }
+
+    inline void setCreateSparseJacobian(bool create) {
+        _sparseJacobian = create;
+    }
+
+    inline bool isCreateSparseJacobian() const {
+        return _sparseJacobian;
+    }
+
+    inline void setCreateSparseHessian(bool create) {
+        _sparseHessian = create;
+    }
+
+    inline bool isCreateSparseHessian() const {
+        return _sparseHessian;
+    }
+
+    inline void setCreateHessianSparsityByEquation(bool create) {
+        _hessianByEquation = create;
+    }
+
+    inline bool isCreateHessianSparsityByEquation() const {
+        return _hessianByEquation;
+    }
+
+    /**
+     * Whether or not to create the program for the first-order forward
+     * mode (used by both the dense and the sparse variants).
+     */
+    inline void setCreateForwardOne(bool create) {
+        _forwardOne = create;
+    }
+
+    inline bool isCreateForwardOne() const {
+        return _forwardOne;
+    }
+
+    inline void setCreateReverseOne(bool create) {
+        _reverseOne = create;
+    }
+
+    inline bool isCreateReverseOne() const {
+        return _reverseOne;
+    }
+
+    inline void setCreateReverseTwo(bool create) {
+        _reverseTwo = create;
+    }
+
+    inline bool isCreateReverseTwo() const {
+        return _reverseTwo;
+    }
+
+    inline void setCustomSparseJacobianElements(const std::vector<size_t>& row,
+                                                const std::vector<size_t>& col) {
+        CPPADCG_ASSERT_KNOWN(row.size() == col.size(), "Invalid number of custom Jacobian elements");
+        _customJac = true;
+        _customJacRows = row;
+        _customJacCols = col;
+    }
+
+    inline void setCustomSparseHessianElements(const std::vector<size_t>& row,
+                                               const std::vector<size_t>& col) {
+        CPPADCG_ASSERT_KNOWN(row.size() == col.size(), "Invalid number of custom Hessian elements");
+        _customHess = true;
+        _customHessRows = row;
+        _customHessCols = col;
+    }
+
+    /**
+     * Determines the sparsity patterns and creates the bytecode programs
+     * for all the requested functions.
+     *
+     * @throws CGException if the tape contains operations which are not
+     *                     supported by the bytecode interpreter
+     */
+    virtual void compile() {
+        _x.resize(_n);
+        _tx1.resize(_n);
+        _py.resize(_m);
+
+        determineSparsity();
+
+        if (_zero) {
+            _zeroProg = createForwardZeroProgram();
+        }
+        if (_jacobian) {
+            _jacobianProg = createJacobianProgram();
+        }
+        if (_hessian) {
+            _hessianProg = createHessianProgram();
+        }
+        if (_sparseJacobian) {
+            _sparseJacobianProg = createSparseJacobianProgram();
+        }
+        if (_sparseHessian) {
+            _sparseHessianProg = createSparseHessianProgram();
+        }
+        if (_forwardOne) {
+            _forwardOneProg = createForwardOneProgram();
+        }
+        if (_reverseOne) {
+            _reverseOneProg = createReverseOneProgram();
+        }
+        if (_reverseTwo) {
+            _reverseTwoProg = createReverseTwoProgram();
+        }
+    }
+
+    const std::string& getName() const override {
+        return _name;
+    }
+
+    size_t Domain() const override {
+        return _n;
+    }
+
+    size_t Range() const override {
+        return _m;
+    }
+
+    const std::vector<std::string>& getAtomicFunctionNames() override {
+        return _atomicFunctions;
+    }
+
+    bool addAtomicFunction(atomic_base<Base>& atomic) override {
+        return false; // atomic functions are not supported
+    }
+
+    bool addExternalModel(GenericModel<Base>& atomic) override {
+        return false; // atomic functions are not supported
+    }
+
+    // Jacobian sparsity
+    bool isJacobianSparsityAvailable() override {
+        return _jacSparsityAvailable;
+    }
+
+    std::vector<std::set<size_t> > JacobianSparsitySet() override {
+        CPPADCG_ASSERT_KNOWN(_jacSparsityAvailable, "The bytecode model was not compiled");
+        return toSparsitySet(_m, _jacRows, _jacCols);
+    }
+
+    std::vector<bool> JacobianSparsityBool() override {
+        CPPADCG_ASSERT_KNOWN(_jacSparsityAvailable, "The bytecode model was not compiled");
+        return toSparsityBool(_m, _n, _jacRows, _jacCols);
+    }
+
+    void JacobianSparsity(std::vector<size_t>& equations,
+                          std::vector<size_t>& variables) override {
+        CPPADCG_ASSERT_KNOWN(_jacSparsityAvailable, "The bytecode model was not compiled");
+        equations = _jacRows;
+        variables = _jacCols;
+    }
+
+    // Hessian sparsity
+    bool isHessianSparsityAvailable() override {
+        return _hessSparsityAvailable;
+    }
+
+    std::vector<std::set<size_t> > HessianSparsitySet() override {
+        CPPADCG_ASSERT_KNOWN(isHessianSparsityAvailable(), "No Hessian sparsity available in the bytecode model");
+        return toSparsitySet(_n, _hessRows, _hessCols);
+    }
+
+    std::vector<bool> HessianSparsityBool() override {
+        CPPADCG_ASSERT_KNOWN(isHessianSparsityAvailable(), "No Hessian sparsity available in the bytecode model");
+        return toSparsityBool(_n, _n, _hessRows, _hessCols);
+    }
+
+    void HessianSparsity(std::vector<size_t>& rows,
+                         std::vector<size_t>& cols) override {
+        CPPADCG_ASSERT_KNOWN(isHessianSparsityAvailable(), "No Hessian sparsity available in the bytecode model");
+        rows = _hessRows;
+        cols = _hessCols;
+    }
+
+    bool isEquationHessianSparsityAvailable() override {
+        return _hessSparsityAvailable && _hessianByEquation;
+    }
+
+    std::vector<std::set<size_t> > HessianSparsitySet(size_t i) override {
+        CPPADCG_ASSERT_KNOWN(isEquationHessianSparsityAvailable(), "No Hessian sparsity by equation available in the bytecode model");
+        return toSparsitySet(_n, _hessRowsEq[i], _hessColsEq[i]);
+    }
+
+    std::vector<bool> HessianSparsityBool(size_t i) override {
+        CPPADCG_ASSERT_KNOWN(isEquationHessianSparsityAvailable(), "No Hessian sparsity by equation available in the bytecode model");
+        return toSparsityBool(_n, _n, _hessRowsEq[i], _hessColsEq[i]);
+    }
+
+    void HessianSparsity(size_t i,
+                         std::vector<size_t>& rows,
+                         std::vector<size_t>& cols) override {
+        CPPADCG_ASSERT_KNOWN(isEquationHessianSparsityAvailable(), "No Hessian sparsity by equation available in the bytecode model");
+        rows = _hessRowsEq[i];
+        cols = _hessColsEq[i];
+    }
+
+    /// calculate the dependent values (zero order)
+    bool isForwardZeroAvailable() override {
+        return _zeroProg != nullptr;
+    }
+
+    void ForwardZero(const CppAD::vector<bool>& vx,
+                     CppAD::vector<bool>& vy,
+                     ArrayView<const Base> tx,
+                     ArrayView<Base> ty) override {
+        ForwardZero(tx, ty);
+
+        if (vx.size() > 0) {
+            CPPADCG_ASSERT_KNOWN(vx.size() >= _n, "Invalid vx size");
+            CPPADCG_ASSERT_KNOWN(vy.size() >= _m, "Invalid vy size");
+            for (size_t e = 0; e < _jacRows.size(); e++) {
+                if (vx[_jacCols[e]]) {
+                    vy[_jacRows[e]] = true;
+                }
+            }
+        }
+    }
+
+    void ForwardZero(ArrayView<const Base> x,
+                     ArrayView<Base> dep) override {
+        CPPADCG_ASSERT_KNOWN(_zeroProg != nullptr, "No zero order forward program in the bytecode model");
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size");
+        CPPADCG_ASSERT_KNOWN(dep.size() == _m, "Invalid dependent array size");
+
+        _zeroProg->evaluate(x, dep);
+    }
+
+    void ForwardZero(const std::vector<const Base*>& x,
+                     ArrayView<Base> dep) override {
+        CPPADCG_ASSERT_KNOWN(x.size() == 1, "The number of independent variable arrays is invalid");
+
+        ForwardZero(ArrayView<const Base>(x[0], _n), dep);
+    }
+
+    /// calculate entire Jacobian
+    bool isJacobianAvailable() override {
+        return _jacobianProg != nullptr;
+    }
+
+    void Jacobian(ArrayView<const Base> x,
+                  ArrayView<Base> jac) override {
+        CPPADCG_ASSERT_KNOWN(_jacobianProg != nullptr, "No Jacobian program in the bytecode model");
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size");
+        CPPADCG_ASSERT_KNOWN(jac.size() == _m * _n, "Invalid Jacobian array size");
+
+        _jacobianProg->evaluate(x, jac);
+    }
+
+    /// calculate the Hessian of the weighted sum of all equations
+    bool isHessianAvailable() override {
+        return _hessianProg != nullptr;
+    }
+
+    void Hessian(ArrayView<const Base> x,
+                 ArrayView<const Base> w,
+                 ArrayView<Base> hess) override {
+        CPPADCG_ASSERT_KNOWN(_hessianProg != nullptr, "No Hessian program in the bytecode model");
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size");
+        CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size");
+        CPPADCG_ASSERT_KNOWN(hess.size() == _n * _n, "Invalid Hessian size");
+
+        const Base* in[2] = {x.data(), w.data()};
+        _hessianProg->evaluate(in, hess.data());
+    }
+
+    /// first-order forward mode
+    bool isForwardOneAvailable() override {
+        return _forwardOneProg != nullptr;
+    }
+
+    void ForwardOne(ArrayView<const Base> tx,
+                    ArrayView<Base> ty) override {
+        const size_t k = 1;
+
+        CPPADCG_ASSERT_KNOWN(_forwardOneProg != nullptr, "No forward one program in the bytecode model");
+        CPPADCG_ASSERT_KNOWN(tx.size() >= (k + 1) * _n, "Invalid tx size");
+        CPPADCG_ASSERT_KNOWN(ty.size() >= (k + 1) * _m, "Invalid ty size");
+
+        for (size_t j = 0; j < _n; j++) {
+            _x[j] = tx[j * (k + 1)];
+            _tx1[j] = tx[j * (k + 1) + 1];
+        }
+
+        _out.resize(2 * _m);
+        const Base* in[2] = {_x.data(), _tx1.data()};
+        _forwardOneProg->evaluate(in, _out.data());
+
+        for (size_t i = 0; i < _m; i++) {
+            ty[i * (k + 1)] = _out[i];
+            ty[i * (k + 1) + 1] = _out[_m + i];
+        }
+    }
+
+    bool isSparseForwardOneAvailable() override {
+        return _forwardOneProg != nullptr;
+    }
+
+    void ForwardOne(ArrayView<const Base> x,
+                    size_t tx1Nnz, const size_t idx[], const Base tx1[],
+                    ArrayView<Base> ty1) override {
+        CPPADCG_ASSERT_KNOWN(_forwardOneProg != nullptr, "No forward one program in the bytecode model");
+        CPPADCG_ASSERT_KNOWN(x.size() >= _n, "Invalid x size");
+        CPPADCG_ASSERT_KNOWN(ty1.size() >= _m, "Invalid ty1 size");
+
+        std::fill(ty1.data(), ty1.data() + _m, Base(0));
+        if (tx1Nnz == 0)
+            return; //nothing to do
+
+        std::fill(_tx1.begin(), _tx1.end(), Base(0));
+        for (size_t ej = 0; ej < tx1Nnz; ej++) {
+            _tx1[idx[ej]] = tx1[ej];
+        }
+
+        _out.resize(2 * _m);
+        const Base* in[2] = {x.data(), _tx1.data()};
+        _forwardOneProg->evaluate(in, _out.data());
+
+        std::copy(_out.begin() + _m, _out.end(), ty1.data());
+    }
+
+    /// first-order reverse mode
+    bool isReverseOneAvailable() override {
+        return _reverseOneProg != nullptr;
+    }
+
+    void ReverseOne(ArrayView<const Base> tx,
+                    ArrayView<const Base> ty,
+                    ArrayView<Base> px,
+                    ArrayView<const Base> py) override {
+        CPPADCG_ASSERT_KNOWN(_reverseOneProg != nullptr, "No reverse one program in the bytecode model");
+        CPPADCG_ASSERT_KNOWN(tx.size() >= _n, "Invalid tx size");
+        CPPADCG_ASSERT_KNOWN(ty.size() >= _m, "Invalid ty size");
+        CPPADCG_ASSERT_KNOWN(px.size() >= _n, "Invalid px size");
+        CPPADCG_ASSERT_KNOWN(py.size() >= _m, "Invalid py size");
+
+        const Base* in[2] = {tx.data(), py.data()};
+        _reverseOneProg->evaluate(in, px.data());
+    }
+
+    bool isSparseReverseOneAvailable() override {
+        return _reverseOneProg != nullptr;
+    }
+
+    void ReverseOne(ArrayView<const Base> x,
+                    ArrayView<Base> px,
+                    size_t pyNnz, const size_t idx[], const Base py[]) override {
+        CPPADCG_ASSERT_KNOWN(_reverseOneProg != nullptr, "No reverse one program in the bytecode model");
+        CPPADCG_ASSERT_KNOWN(x.size() >= _n, "Invalid x size");
+        CPPADCG_ASSERT_KNOWN(px.size() >= _n, "Invalid px size");
+
+        if (pyNnz == 0) {
+            std::fill(px.data(), px.data() + _n, Base(0));
+            return; //nothing to do
+        }
+
+        std::fill(_py.begin(), _py.end(), Base(0));
+        for (size_t ei = 0; ei < pyNnz; ei++) {
+            _py[idx[ei]] = py[ei];
+        }
+
+        const Base* in[2] = {x.data(), _py.data()};
+        _reverseOneProg->evaluate(in, px.data());
+    }
+
+    /// second-order reverse mode
+    bool isReverseTwoAvailable() override {
+        return _reverseTwoProg != nullptr;
+    }
+
+    void ReverseTwo(ArrayView<const Base> tx,
+                    ArrayView<const Base> ty,
+                    ArrayView<Base> px,
+                    ArrayView<const Base> py) override {
+        const size_t k = 1;
+        const size_t k1 = k + 1;
+
+        CPPADCG_ASSERT_KNOWN(_reverseTwoProg != nullptr, "No reverse two program in the bytecode model");
+        CPPADCG_ASSERT_KNOWN(tx.size() >= k1 * _n, "Invalid tx size");
+        CPPADCG_ASSERT_KNOWN(ty.size() >= k1 * _m, "Invalid ty size");
+        CPPADCG_ASSERT_KNOWN(px.size() >= k1 * _n, "Invalid px size");
+        CPPADCG_ASSERT_KNOWN(py.size() >= k1 * _m, "Invalid py size");
+
+        for (size_t i = 0; i < _m; i++) {
+            CPPADCG_ASSERT_KNOWN(py[i * k1] == Base(0), "Second-order reverse mode failed: py[2*i] (i=0...m) must be zero.");
+            _py[i] = py[i * k1 + 1];
+        }
+        for (size_t j = 0; j < _n; j++) {
+            _x[j] = tx[j * k1];
+            _tx1[j] = tx[j * k1 + 1];
+        }
+
+        _out.resize(_n);
+        const Base* in[3] = {_x.data(), _tx1.data(), _py.data()};
+        _reverseTwoProg->evaluate(in, _out.data());
+
+        // only px[j * (k+1)] is defined
+        for (size_t j = 0; j < _n; j++) {
+            px[j * k1] = _out[j];
+        }
+    }
+
+    bool isSparseReverseTwoAvailable() override {
+        return _reverseTwoProg != nullptr;
+    }
+
+    void ReverseTwo(ArrayView<const Base> x,
+                    size_t tx1Nnz, const size_t idx[], const Base tx1[],
+                    ArrayView<Base> px2,
+                    ArrayView<const Base> py2) override {
+        CPPADCG_ASSERT_KNOWN(_reverseTwoProg != nullptr, "No reverse two program in the bytecode model");
+        CPPADCG_ASSERT_KNOWN(x.size() >= _n, "Invalid x size");
+        CPPADCG_ASSERT_KNOWN(px2.size() >= _n, "Invalid px2 size");
+        CPPADCG_ASSERT_KNOWN(py2.size() >= _m, "Invalid py2 size");
+
+        if (tx1Nnz == 0) {
+            std::fill(px2.data(), px2.data() + _n, Base(0));
+            return; //nothing to do
+        }
+
+        std::fill(_tx1.begin(), _tx1.end(), Base(0));
+        for (size_t ej = 0; ej < tx1Nnz; ej++) {
+            _tx1[idx[ej]] = tx1[ej];
+        }
+
+        const Base* in[3] = {x.data(), _tx1.data(), py2.data()};
+        _reverseTwoProg->evaluate(in, px2.data());
+    }
+
+    /// calculate sparse Jacobians
+    bool isSparseJacobianAvailable() override {
+        return _sparseJacobianProg != nullptr;
+    }
+
+    void SparseJacobian(ArrayView<const Base> x,
+                        ArrayView<Base> jac) override {
+        CPPADCG_ASSERT_KNOWN(_sparseJacobianProg != nullptr, "No sparse Jacobian program in the bytecode model");
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size");
+        CPPADCG_ASSERT_KNOWN(jac.size() == _m * _n, "Invalid Jacobian size");
+
+        _out.resize(_jacRows.size());
+        _sparseJacobianProg->evaluate(x, _out);
+
+        createDenseFromSparse(_out, _m, _n, _jacRows, _jacCols, jac);
+    }
+
+    void SparseJacobian(const std::vector<Base>& x,
+                        std::vector<Base>& jac,
+                        std::vector<size_t>& row,
+                        std::vector<size_t>& col) override {
+        CPPADCG_ASSERT_KNOWN(_sparseJacobianProg != nullptr, "No sparse Jacobian program in the bytecode model");
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size");
+
+        jac.resize(_jacRows.size());
+        _sparseJacobianProg->evaluate(x, jac);
+        row = _jacRows;
+        col = _jacCols;
+    }
+
+    void SparseJacobian(ArrayView<const Base> x,
+                        ArrayView<Base> jac,
+                        size_t const** row,
+                        size_t const** col) override {
+        CPPADCG_ASSERT_KNOWN(_sparseJacobianProg != nullptr, "No sparse Jacobian program in the bytecode model");
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size");
+        CPPADCG_ASSERT_KNOWN(jac.size() == _jacRows.size(), "Invalid number of non-zero elements in Jacobian");
+
+        _sparseJacobianProg->evaluate(x, jac);
+        *row = _jacRows.data();
+        *col = _jacCols.data();
+    }
+
+    void SparseJacobian(const std::vector<const Base*>& x,
+                        ArrayView<Base> jac,
+                        size_t const** row,
+                        size_t const** col) override {
+        CPPADCG_ASSERT_KNOWN(x.size() == 1, "The number of independent variable arrays is invalid");
+
+        SparseJacobian(ArrayView<const Base>(x[0], _n), jac, row, col);
+    }
+
+    /// calculate sparse Hessians
+    bool isSparseHessianAvailable() override {
+        return _sparseHessianProg != nullptr;
+    }
+
+    void SparseHessian(ArrayView<const Base> x,
+                       ArrayView<const Base> w,
+                       ArrayView<Base> hess) override {
+        CPPADCG_ASSERT_KNOWN(_sparseHessianProg != nullptr, "No sparse Hessian program in the bytecode model");
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size");
+        CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size");
+
+        _out.resize(_hessRows.size());
+        const Base* in[2] = {x.data(), w.data()};
+        _sparseHessianProg->evaluate(in, _out.data());
+
+        createDenseFromSparse(_out, _n, _n, _hessRows, _hessCols, hess);
+    }
+
+    void SparseHessian(const std::vector<Base>& x,
+                       const std::vector<Base>& w,
+                       std::vector<Base>& hess,
+                       std::vector<size_t>& row,
+                       std::vector<size_t>& col) override {
+        CPPADCG_ASSERT_KNOWN(_sparseHessianProg != nullptr, "No sparse Hessian program in the bytecode model");
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size");
+        CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size");
+
+        hess.resize(_hessRows.size());
+        const Base* in[2] = {x.data(), w.data()};
+        _sparseHessianProg->evaluate(in, hess.data());
+        row = _hessRows;
+        col = _hessCols;
+    }
+
+    void SparseHessian(ArrayView<const Base> x,
+                       ArrayView<const Base> w,
+                       ArrayView<Base> hess,
+                       size_t const** row,
+                       size_t const** col) override {
+        CPPADCG_ASSERT_KNOWN(_sparseHessianProg != nullptr, "No sparse Hessian program in the bytecode model");
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size");
+        CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size");
+        CPPADCG_ASSERT_KNOWN(hess.size() == _hessRows.size(), "Invalid number of non-zero elements in Hessian");
+
+        const Base* in[2] = {x.data(), w.data()};
+        _sparseHessianProg->evaluate(in, hess.data());
+        *row = _hessRows.data();
+        *col = _hessCols.data();
+    }
+
+    void SparseHessian(const std::vector<const Base*>& x,
+                       ArrayView<const Base> w,
+                       ArrayView<Base> hess,
+                       size_t const** row,
+                       size_t const** col) override {
+        CPPADCG_ASSERT_KNOWN(x.size() == 1, "The number of independent variable arrays is invalid");
+
+        SparseHessian(ArrayView<const Base>(x[0], _n), w, hess, row, col);
+    }
+
+protected:
+
+    virtual void determineSparsity() {
+        _jacSparsity = jacobianSparsitySet<SparsitySetType, CGBase>(_fun);
+        if (!_customJac) {
+            generateSparsityIndexes(_jacSparsity, _jacRows, _jacCols);
+        } else {
+            _jacRows = _customJacRows;
+            _jacCols = _customJacCols;
+        }
+
+        if (_hessian || _sparseHessian || _reverseTwo || _hessianByEquation) {
+            _hessSparsity = hessianSparsitySet<SparsitySetType, CGBase>(_fun);
+            if (!_customHess) {
+                generateSparsityIndexes(_hessSparsity, _hessRows, _hessCols);
+            } else {
+                _hessRows = _customHessRows;
+                _hessCols = _customHessCols;
+            }
+            _hessSparsityAvailable = true;
+        }
+
+        if (_hessianByEquation) {
+            _hessRowsEq.resize(_m);
+            _hessColsEq.resize(_m);
+            for (size_t i = 0; i < _m; i++) {
+                SparsitySetType sparsity = hessianSparsitySet<SparsitySetType, CGBase>(_fun, i);
+                if (!_customHess) {
+                    generateSparsityIndexes(sparsity, _hessRowsEq[i], _hessColsEq[i]);
+                } else {
+                    for (size_t e = 0; e < _customHessRows.size(); e++) {
+                        size_t j1 = _customHessRows[e];
+                        size_t j2 = _customHessCols[e];
+                        if (sparsity[j1].find(j2) != sparsity[j1].end()) {
+                            _hessRowsEq[i].push_back(j1);
+                            _hessColsEq[i].push_back(j2);
+                        }
+                    }
+                }
+            }
+        }
+
+        _jacSparsityAvailable = true;
+    }
+
+    virtual std::unique_ptr<BytecodeProgram<Base> > createForwardZeroProgram() {
+        CodeHandler<Base> handler;
+
+        std::vector<CGBase> indVars(_n);
+        handler.makeVariables(indVars);
+
+        std::vector<CGBase> dep = _fun.Forward(0, indVars);
+
+        return createProgram(handler, dep, {_n}, "model");
+    }
+
+    virtual std::unique_ptr<BytecodeProgram<Base> > createJacobianProgram() {
+        CodeHandler<Base> handler;
+
+        std::vector<CGBase> indVars(_n);
+        handler.makeVariables(indVars);
+
+        std::vector<CGBase> jac = _fun.Jacobian(indVars);
+
+        return createProgram(handler, jac, {_n}, "Jacobian");
+    }
+
+    virtual std::unique_ptr<BytecodeProgram<Base> > createHessianProgram() {
+        CodeHandler<Base> handler;
+
+        std::vector<CGBase> indVars(_n);
+        handler.makeVariables(indVars);
+        std::vector<CGBase> w(_m);
+        handler.makeVariables(w);
+
+        std::vector<CGBase> hess = _fun.Hessian(indVars, w);
+
+        return createProgram(handler, hess, {_n, _m}, "Hessian");
+    }
+
+    virtual std::unique_ptr<BytecodeProgram<Base> > createSparseJacobianProgram() {
+        CodeHandler<Base> handler;
+
+        std::vector<CGBase> indVars(_n);
+        handler.makeVariables(indVars);
+
+        std::vector<CGBase> jac(_jacRows.size());
+        if (!jac.empty()) {
+            CppAD::sparse_jacobian_work work;
+            if (estimateBestJacobianADMode(_jacRows, _jacCols)) {
+                _fun.SparseJacobianForward(indVars, _jacSparsity, _jacRows, _jacCols, jac, work);
+            } else {
+                _fun.SparseJacobianReverse(indVars, _jacSparsity, _jacRows, _jacCols, jac, work);
+            }
+        }
+
+        return createProgram(handler, jac, {_n}, "sparse Jacobian");
+    }
+
+    virtual std::unique_ptr<BytecodeProgram<Base> > createSparseHessianProgram() {
+        CodeHandler<Base> handler;
+
+        std::vector<CGBase> indVars(_n);
+        handler.makeVariables(indVars);
+        std::vector<CGBase> w(_m);
+        handler.makeVariables(w);
+
+        /**
+         * make use of the symmetry of the Hessian in order to reduce
+         * operations (atomic functions are not supported and therefore
+         * the Hessian sparsity is always symmetric)
+         */
+        const size_t nnz = _hessRows.size();
+        std::map<std::pair<size_t, size_t>, size_t> evaluated;
+        std::vector<size_t> location(nnz);
+        std::vector<size_t> evalRows, evalCols;
+        for (size_t e = 0; e < nnz; e++) {
+            size_t j1 = _hessRows[e];
+            size_t j2 = _hessCols[e];
+            auto key = std::make_pair(std::max(j1, j2), std::min(j1, j2));
+            auto it = evaluated.find(key);
+            if (it != evaluated.end()) {
+                location[e] = it->second;
+            } else {
+                location[e] = evalRows.size();
+                evaluated[key] = location[e];
+                evalRows.push_back(j1);
+                evalCols.push_back(j2);
+            }
+        }
+
+        std::vector<CGBase> hess(nnz);
+        if (!evalRows.empty()) {
+            CppAD::sparse_hessian_work work;
+            work.color_method = "cppad.general";
+            std::vector<CGBase> evalHess(evalRows.size());
+            _fun.SparseHessian(indVars, w, _hessSparsity, evalRows, evalCols, evalHess, work);
+
+            for (size_t e = 0; e < nnz; e++) {
+                hess[e] = evalHess[location[e]];
+            }
+        }
+
+        return createProgram(handler, hess, {_n, _m}, "sparse Hessian");
+    }
+
+    virtual std::unique_ptr<BytecodeProgram<Base> > createForwardOneProgram() {
+        CodeHandler<Base> handler;
+
+        std::vector<CGBase> indVars(_n);
+        handler.makeVariables(indVars);
+        std::vector<CGBase> tx1(_n);
+        handler.makeVariables(tx1);
+
+        std::vector<CGBase> y = _fun.Forward(0, indVars);
+        std::vector<CGBase> ty1 = _fun.Forward(1, tx1);
+
+        // the zero order values followed by the first-order values
+        y.insert(y.end(), ty1.begin(), ty1.end());
+
+        return createProgram(handler, y, {_n, _n}, "forward one");
+    }
+
+    virtual std::unique_ptr<BytecodeProgram<Base> > createReverseOneProgram() {
+        CodeHandler<Base> handler;
+
+        std::vector<CGBase> indVars(_n);
+        handler.makeVariables(indVars);
+        std::vector<CGBase> py(_m);
+        handler.makeVariables(py);
+
+        _fun.Forward(0, indVars);
+        std::vector<CGBase> px = _fun.Reverse(1, py);
+
+        return createProgram(handler, px, {_n, _m}, "reverse one");
+    }
+
+    virtual std::unique_ptr<BytecodeProgram<Base> > createReverseTwoProgram() {
+        CodeHandler<Base> handler;
+
+        std::vector<CGBase> indVars(_n);
+        handler.makeVariables(indVars);
+        std::vector<CGBase> tx1(_n);
+        handler.makeVariables(tx1);
+        std::vector<CGBase> py1(_m);
+        handler.makeVariables(py1);
+
+        std::vector<CGBase> py(2 * _m);
+        for (size_t i = 0; i < _m; i++) {
+            py[2 * i] = Base(0);
+            py[2 * i + 1] = py1[i];
+        }
+
+        _fun.Forward(0, indVars);
+        _fun.Forward(1, tx1);
+        std::vector<CGBase> pxAll = _fun.Reverse(2, py);
+
+        std::vector<CGBase> px(_n);
+        for (size_t j = 0; j < _n; j++) {
+            px[j] = pxAll[j * 2];
+        }
+
+        return createProgram(handler, px, {_n, _n, _m}, "reverse two");
+    }
+
+    inline std::unique_ptr<BytecodeProgram<Base> > createProgram(CodeHandler<Base>& handler,
+                                                                 std::vector<CGBase>& dependents,
+                                                                 const std::vector<size_t>& inputSizes,
+                                                                 const std::string& jobName) {
+        LanguageBytecode<Base> lang;
+        LangCDefaultVariableNameGenerator<Base> nameGen;
+        std::ostringstream code; // not used
+
+        handler.generateCode(code, lang, dependents, nameGen, jobName);
+
+        std::unique_ptr<BytecodeProgram<Base> > program = lang.releaseProgram();
+        program->setInputSizes(inputSizes);
+        return program;
+    }
+
+    static inline std::vector<std::set<size_t> > toSparsitySet(size_t nrows,
+                                                               const std::vector<size_t>& rows,
+                                                               const std::vector<size_t>& cols) {
+        std::vector<std::set<size_t> > s(nrows);
+        for (size_t e = 0; e < rows.size(); e++) {
+            s[rows[e]].insert(cols[e]);
+        }
+        return s;
+    }
+
+    static inline std::vector<bool> toSparsityBool(size_t nrows,
+                                                   size_t ncols,
+                                                   const std::vector<size_t>& rows,
+                                                   const std::vector<size_t>& cols) {
+        std::vector<bool> s(nrows * ncols, false);
+        for (size_t e = 0; e < rows.size(); e++) {
+            s[rows[e] * ncols + cols[e]] = true;
+        }
+        return s;
+    }
+
+    static inline void createDenseFromSparse(const std::vector<Base>& compressed,
+                                             size_t nrows,
+                                             size_t ncols,
+                                             const std::vector<size_t>& rows,
+                                             const std::vector<size_t>& cols,
+                                             ArrayView<Base> mat) {
+        CPPADCG_ASSERT_KNOWN(mat.size() == nrows * ncols, "Invalid matrix size");
+        mat.fill(Base(0));
+
+        for (size_t e = 0; e < rows.size(); e++) {
+            mat[rows[e] * ncols + cols[e]] = compressed[e];
+        }
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
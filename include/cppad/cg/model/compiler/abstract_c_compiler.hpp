@@ -27,25 +27,51 @@ namespace cg {
  */
 template<class Base>
 class AbstractCCompiler : public CCompiler<Base> {
+public:
+    /**
+     * Information on the compilation of a source file
+     */
+    struct CompilationInfo {
+        std::string source;
+        SourceStatistics statistics;
+        std::vector<std::string> flags; // the flags added for this file
+        double time; // compilation time (in seconds)
+    };
 protected:
     std::string _path; // the path to the gcc executable
     std::string _tmpFolder;
     std::string _sourcesFolder; // path where source files are saved
     std::set<std::string> _ofiles; // compiled object files
     std::set<std::string> _sfiles; // compiled source files
+    std::set<std::string> _precompiledOfiles; // object files compiled previously (not deleted)
     std::vector<std::string> _compileFlags;
     std::vector<std::string> _compileLibFlags;
     std::vector<std::string> _linkFlags;
+    std::vector<std::string> _profileFlags; // used to compile and link with profile guided optimizations
+    std::vector<std::string> _sourceFlags; // additional flags for the source file being compiled
+    bool _adaptiveOptimization;
+    size_t _largeSourceAssignments;
+    std::vector<std::string> _largeSourceFlags;
+    std::vector<std::string> _hotSourceFlags;
+    std::map<std::string, SourceStatistics> _sourceStats;
+    std::vector<CompilationInfo> _compilationReport;
     bool _verbose;
     bool _saveToDiskFirst;
+    bool _memoryFiles;
+    std::map<std::string, int> _memoryFileDescriptors; // output files in memory
 public:
 
     AbstractCCompiler(const std::string& compilerPath) :
         _path(compilerPath),
         _tmpFolder("cppadcg_tmp"),
         _sourcesFolder("cppadcg_sources"),
+        _adaptiveOptimization(false),
+        _largeSourceAssignments(50000),
+        _largeSourceFlags({"-O1"}),
+        _hotSourceFlags({"-O3", "-march=native"}),
         _verbose(false),
-        _saveToDiskFirst(false) {
+        _saveToDiskFirst(false),
+        _memoryFiles(false) {
     }
 
     AbstractCCompiler(const AbstractCCompiler& orig) = delete;
@@ -75,6 +101,25 @@ public:
         _saveToDiskFirst = saveToDiskFirst;
     }
 
+    bool isUseMemoryFiles() const {
+        return _memoryFiles;
+    }
+
+    /**
+     * Defines whether or not the compiled object files are kept only in
+     * memory (Linux memfd) instead of being saved in the temporary folder.
+     * This avoids file system accesses which can be slow, for instance, on
+     * network-mounted folders.
+     * The linker must be able to write its output to the provided path
+     * (e.g. the GNU linker).
+     * Profile guided optimizations require object files saved to disk.
+     *
+     * @param memoryFiles true to save the object files in memory
+     */
+    void setUseMemoryFiles(bool memoryFiles) {
+        _memoryFiles = memoryFiles;
+    }
+
     const std::string& getSourcesFolder() const override {
         return _sourcesFolder;
     }
@@ -127,6 +172,171 @@ public:
         _compileLibFlags.push_back(compileLibFlag);
     }
 
+    const std::vector<std::string>& getProfileFlags() const {
+        return _profileFlags;
+    }
+
+    void clearProfile() override {
+        _profileFlags.clear();
+    }
+
+    bool isAdaptiveOptimization() const {
+        return _adaptiveOptimization;
+    }
+
+    /**
+     * Defines whether or not the compilation flags are adapted to each
+     * source file using the statistics provided with
+     * setSourceStatistics():
+     *  - large files (see setLargeSourceAssignments()) are compiled with
+     *    the large source flags (default -O1) since higher optimization
+     *    levels take too long to compile for little benefit;
+     *  - hot files are compiled with the hot source flags
+     *    (default -O3 -march=native).
+     * These flags are added after the default compile flags.
+     *
+     * @param adaptive true to adapt the flags to each file
+     */
+    void setAdaptiveOptimization(bool adaptive) {
+        _adaptiveOptimization = adaptive;
+    }
+
+    size_t getLargeSourceAssignments() const {
+        return _largeSourceAssignments;
+    }
+
+    /**
+     * Defines the minimum number of assignments of a source file for it
+     * to be considered large when adaptive optimization is used.
+     */
+    void setLargeSourceAssignments(size_t assignments) {
+        _largeSourceAssignments = assignments;
+    }
+
+    const std::vector<std::string>& getLargeSourceFlags() const {
+        return _largeSourceFlags;
+    }
+
+    void setLargeSourceFlags(const std::vector<std::string>& flags) {
+        _largeSourceFlags = flags;
+    }
+
+    const std::vector<std::string>& getHotSourceFlags() const {
+        return _hotSourceFlags;
+    }
+
+    void setHotSourceFlags(const std::vector<std::string>& flags) {
+        _hotSourceFlags = flags;
+    }
+
+    void setSourceStatistics(const std::map<std::string, SourceStatistics>& statistics) override {
+        _sourceStats = statistics;
+    }
+
+    /**
+     * Provides information on the source files compiled so far
+     * (e.g. to compare the compilation time with the evaluation time
+     * obtained with different options).
+     */
+    const std::vector<CompilationInfo>& getCompilationReport() const {
+        return _compilationReport;
+    }
+
+    void clearCompilationReport() {
+        _compilationReport.clear();
+    }
+
+    /**
+     * Prints the compilation time of each source file and the totals
+     * for each set of added flags.
+     */
+    void printCompilationReport(std::ostream& out) const {
+        std::map<std::string, std::pair<size_t, double> > totals;
+
+        out << "source, size, assignments, hot, flags, compilation time (s)\n";
+        for (const CompilationInfo& info : _compilationReport) {
+            std::string flags = implode(info.flags, " ");
+            out << info.source << ", " << info.statistics.size << ", " << info.statistics.assignments << ", "
+                    << (info.statistics.hot ? "yes" : "no") << ", " << flags << ", " << info.time << "\n";
+
+            auto& t = totals[flags];
+            t.first++;
+            t.second += info.time;
+        }
+
+        out << "\nflags, files, total compilation time (s)\n";
+        for (const auto& it : totals) {
+            out << it.first << ", " << it.second.first << ", " << it.second.second << "\n";
+        }
+        out.flush();
+    }
+
+    /**
+     * Estimates a suitable maximum number of assignments per generated
+     * function (see ModelCSourceGen::setMaxAssignmentsPerFunc()) by
+     * compiling synthetic functions with increasing sizes.
+     * The compilation time of very large functions grows super-linearly;
+     * the selected size is the largest one whose compilation time per
+     * assignment is not higher than the lowest measured value by more than
+     * the provided tolerance.
+     *
+     * @param sizes the number of assignments of the synthetic functions
+     *              (in increasing order)
+     * @param tolerance the accepted relative increase in the compilation
+     *                  time per assignment
+     * @return the selected number of assignments
+     */
+    virtual size_t measureMaxAssignmentsPerFunction(const std::vector<size_t>& sizes = {1000, 4000, 16000, 64000},
+                                                    double tolerance = 0.25) {
+        using namespace std::chrono;
+
+        CPPADCG_ASSERT_KNOWN(!sizes.empty(), "At least one function size must be provided");
+
+        system::createFolder(this->_tmpFolder);
+
+        std::vector<double> timePerAssign(sizes.size());
+        for (size_t s = 0; s < sizes.size(); s++) {
+            const size_t n = sizes[s];
+            std::ostringstream code;
+            code << "#include <math.h>\n\n"
+                    "void cppadcg_calibration(double const* x, double* y, double* v) {\n"
+                    "   v[0] = x[0];\n";
+            for (size_t i = 1; i < n; i++) {
+                code << "   v[" << i << "] = ";
+                if (i % 16 == 0)
+                    code << "exp(v[" << (i - 1) << "] * 0.001)";
+                else
+                    code << "v[" << (i - 1) << "] * x[" << (i % 8) << "] + v[" << (i > 7 ? i - 7 : 0) << "]";
+                code << ";\n";
+            }
+            code << "   y[0] = v[" << (n - 1) << "];\n"
+                    "}\n";
+
+            std::string file = system::createPath(this->_tmpFolder, "cppadcg_calibration.o");
+
+            steady_clock::time_point beginTime = steady_clock::now();
+            compileSource(code.str(), file, true);
+            duration<double> dt = steady_clock::now() - beginTime;
+            remove(file.c_str());
+
+            timePerAssign[s] = dt.count() / n;
+
+            if (_verbose) {
+                std::cout << "compiled function with " << n << " assignments in " << dt.count() << "s" << std::endl;
+            }
+        }
+
+        remove(this->_tmpFolder.c_str());
+
+        double best = *std::min_element(timePerAssign.begin(), timePerAssign.end());
+        size_t selected = sizes[0];
+        for (size_t s = 0; s < sizes.size(); s++) {
+            if (timePerAssign[s] <= best * (1 + tolerance))
+                selected = sizes[s];
+        }
+        return selected;
+    }
+
     bool isVerbose() const override {
         return _verbose;
     }
@@ -159,7 +369,8 @@ public:
         if (sources.empty())
             return; // nothing to do
 
-        system::createFolder(this->_tmpFolder);
+        if (!_memoryFiles)
+            system::createFolder(this->_tmpFolder);
 
         // determine the maximum file name length
         size_t maxsize = 0;
@@ -191,10 +402,21 @@ public:
         // compile each source code file into a different object file
         for (it = sources.begin(); it != sources.end(); ++it) {
             count++;
-            std::string file = system::createPath(this->_tmpFolder, it->first + outputExtension);
+            std::string file;
+            if (_memoryFiles) {
+                int fd = system::createMemoryFile(it->first + outputExtension);
+                file = system::memoryFilePath(fd);
+                _memoryFileDescriptors[file] = fd;
+            } else {
+                file = system::createPath(this->_tmpFolder, it->first + outputExtension);
+            }
             outputFiles.insert(file);
 
-            steady_clock::time_point beginTime;
+            _sourceFlags = selectSourceFlags(it->first);
+            SourceStatistics stats;
+            auto itStats = _sourceStats.find(it->first);
+            if (itStats != _sourceStats.end())
+                stats = itStats->second;
 
             if (timer != nullptr || _verbose) {
                 os << "[" << std::setw(countWidth) << std::setfill(' ') << std::right << count
@@ -205,7 +427,6 @@ public:
                 timer->startingJob("'" + file + "'", JobTypeHolder<>::COMPILING, os.str());
                 os.str("");
             } else if (_verbose) {
-                beginTime = steady_clock::now();
                 char f = std::cout.fill();
                 std::cout << os.str() << " compiling "
                         << std::setw(maxsize + 9) << std::setfill('.') << std::left
@@ -215,6 +436,8 @@ public:
                 std::cout.fill(f); // restore fill character
             }
 
+            steady_clock::time_point beginTime = steady_clock::now();
+
             if (_saveToDiskFirst) {
                 // save a new source file to disk
                 std::ofstream sourceFile;
@@ -230,17 +453,20 @@ public:
                 compileSource(it->second, file, posIndepCode);
             }
 
+            duration<double> dt = steady_clock::now() - beginTime;
+            _compilationReport.push_back(CompilationInfo{it->first, stats, _sourceFlags, dt.count()});
+
             if (timer != nullptr) {
                 timer->finishedJob();
             } else if (_verbose) {
-                steady_clock::time_point endTime = steady_clock::now();
-                duration<float> dt = endTime - beginTime;
                 std::cout << "done [" << std::fixed << std::setprecision(3)
                         << dt.count() << "]" << std::endl;
             }
 
         }
 
+        _sourceFlags.clear();
+
     }
 
     /**
@@ -251,16 +477,40 @@ public:
     virtual void buildDynamic(const std::string& library,
                               JobTimer* timer = nullptr) override = 0;
 
+    void addPrecompiledObjectFile(const std::string& file) override {
+        _precompiledOfiles.insert(file);
+    }
+
+    const std::set<std::string>& getPrecompiledObjectFiles() const {
+        return _precompiledOfiles;
+    }
+
+    std::string getCompilationSettings() const override {
+        if (!_profileFlags.empty())
+            return ""; // the object files depend on the profile data
+
+        std::ostringstream os;
+        os << _path << "\n" << implode(_compileFlags, " ") << "\n";
+        if (_adaptiveOptimization) {
+            os << _largeSourceAssignments << "\n"
+                    << implode(_largeSourceFlags, " ") << "\n"
+                    << implode(_hotSourceFlags, " ") << "\n";
+        }
+        return os.str();
+    }
+
     void cleanup() override {
         // clean up;
         for (const std::string& it : _ofiles) {
-            if (remove(it.c_str()) != 0)
-                std::cerr << "Failed to delete temporary file '" << it << "'" << std::endl;
+            deleteFile(it);
         }
         _ofiles.clear();
         _sfiles.clear();
+        _precompiledOfiles.clear();
+        _sourceFlags.clear();
 
-        remove(this->_tmpFolder.c_str());
+        if (!_memoryFiles)
+            remove(this->_tmpFolder.c_str());
     }
 
     virtual ~AbstractCCompiler() {
@@ -269,6 +519,43 @@ public:
 
 protected:
 
+    /**
+     * Deletes a compiled file (saved to disk or in memory).
+     *
+     * @param file the file path
+     */
+    virtual void deleteFile(const std::string& file) {
+        auto it = _memoryFileDescriptors.find(file);
+        if (it != _memoryFileDescriptors.end()) {
+            system::closeMemoryFile(it->second);
+            _memoryFileDescriptors.erase(it);
+        } else if (remove(file.c_str()) != 0) {
+            std::cerr << "Failed to delete temporary file '" << file << "'" << std::endl;
+        }
+    }
+
+    /**
+     * Determines the flags added to the compile flags for a source file.
+     *
+     * @param source the source file name
+     */
+    virtual std::vector<std::string> selectSourceFlags(const std::string& source) const {
+        if (!_adaptiveOptimization)
+            return std::vector<std::string>();
+
+        auto it = _sourceStats.find(source);
+        if (it == _sourceStats.end())
+            return std::vector<std::string>();
+
+        const SourceStatistics& stats = it->second;
+        if (stats.assignments >= _largeSourceAssignments)
+            return _largeSourceFlags; // even if hot: avoid very long compilation times
+        else if (stats.hot)
+            return _hotSourceFlags;
+
+        return std::vector<std::string>();
+    }
+
     /**
      * Compiles a single source file into an object file.
      *
@@ -97,6 +97,71 @@ public:
      */
     virtual void cleanup() = 0;
 
+    /**
+     * Adds an object file compiled previously (e.g. by a previous build of
+     * the same library) to the next dynamic library.
+     * These files are not deleted by cleanup().
+     *
+     * @param file the path to the object file
+     */
+    virtual void addPrecompiledObjectFile(const std::string& file) {
+        throw CGException("Compiler does not support the use of precompiled object files");
+    }
+
+    /**
+     * Provides a description of all the settings which affect the compiled
+     * object files (e.g. the compiler path and flags).
+     * It is used to decide whether or not previously compiled object files
+     * can be reused.
+     * An empty string means that object files should never be reused.
+     */
+    virtual std::string getCompilationSettings() const {
+        return "";
+    }
+
+    /**
+     * Provides information on the sources which will be compiled next
+     * (e.g. used to select the compilation options for each file).
+     *
+     * @param statistics maps the source file names to their statistics
+     */
+    virtual void setSourceStatistics(const std::map<std::string, SourceStatistics>& statistics) {
+    }
+
+    /**
+     * Whether or not this compiler can perform profile guided optimizations.
+     */
+    virtual bool isProfileGuidedOptimizationSupported() const {
+        return false;
+    }
+
+    /**
+     * The following sources and dynamic libraries will be instrumented in
+     * order to collect profile data into the provided folder when they are
+     * executed.
+     *
+     * @param profileFolder the folder where the profile data is saved
+     */
+    virtual void setProfileGeneration(const std::string& profileFolder) {
+        throw CGException("Compiler does not support profile guided optimization");
+    }
+
+    /**
+     * The following sources and dynamic libraries will be optimized using
+     * the profile data previously collected into the provided folder.
+     *
+     * @param profileFolder the folder where the profile data was saved
+     */
+    virtual void setProfileUse(const std::string& profileFolder) {
+        throw CGException("Compiler does not support profile guided optimization");
+    }
+
+    /**
+     * Stops the instrumentation or the use of profile data.
+     */
+    virtual void clearProfile() {
+    }
+
     inline virtual ~CCompiler() = default;
 
 };
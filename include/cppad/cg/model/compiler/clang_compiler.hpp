@@ -29,10 +29,12 @@ class ClangCompiler : public AbstractCCompiler<Base> {
 protected:
     std::set<std::string> _bcfiles; // bitcode files
     std::string _version;
+    std::string _profdataPath; // the path to the llvm-profdata executable
 public:
 
     ClangCompiler(const std::string& clangPath = "/usr/bin/clang") :
-        AbstractCCompiler<Base>(clangPath) {
+        AbstractCCompiler<Base>(clangPath),
+        _profdataPath(system::directoryFromPath(clangPath) + "llvm-profdata") {
 
         this->_compileFlags.push_back("-O2"); // Optimization level
         this->_compileLibFlags.push_back("-O2"); // Optimization level
@@ -65,6 +67,38 @@ public:
         return _version;
     }
 
+    const std::string& getProfileDataToolPath() const {
+        return _profdataPath;
+    }
+
+    /**
+     * Defines the path to the llvm-profdata executable which is used to
+     * prepare the profile data for profile guided optimizations.
+     */
+    void setProfileDataToolPath(const std::string& profdataPath) {
+        _profdataPath = profdataPath;
+    }
+
+    bool isProfileGuidedOptimizationSupported() const override {
+        return true;
+    }
+
+    void setProfileGeneration(const std::string& profileFolder) override {
+        this->_profileFlags = {"-fprofile-instr-generate=" + system::createPath(profileFolder, "cppadcg.profraw")};
+    }
+
+    void setProfileUse(const std::string& profileFolder) override {
+        std::string profdata = system::createPath(profileFolder, "cppadcg.profdata");
+
+        std::vector<std::string> args {"merge",
+                                       "-output=" + profdata,
+                                       system::createPath(profileFolder, "cppadcg.profraw")};
+        system::callExecutable(_profdataPath, args);
+
+        this->_profileFlags = {"-fprofile-instr-use=" + profdata,
+                               "-Wno-profile-instr-unprofiled"}; // not all functions are evaluated
+    }
+
     virtual const std::set<std::string>& getBitCodeFiles() const {
         return _bcfiles;
     }
@@ -95,6 +129,7 @@ public:
 
         std::vector<std::string> args;
         args.insert(args.end(), this->_compileLibFlags.begin(), this->_compileLibFlags.end());
+        args.insert(args.end(), this->_profileFlags.begin(), this->_profileFlags.end());
         args.push_back(linkerFlags); // Pass suitable options to linker
         args.push_back("-o"); // Output file name
         args.push_back(library); // Output file name
@@ -102,6 +137,9 @@ public:
         for (const std::string& it : this->_ofiles) {
             args.push_back(it);
         }
+        for (const std::string& it : this->_precompiledOfiles) {
+            args.push_back(it);
+        }
 
         if (timer != nullptr) {
             timer->startingJob("'" + library + "'", JobTimer::COMPILING_DYNAMIC_LIBRARY);
@@ -119,8 +157,7 @@ public:
     void cleanup() override {
         // clean up
         for (const std::string& it : _bcfiles) {
-            if (remove(it.c_str()) != 0)
-                std::cerr << "Failed to delete temporary file '" << it << "'" << std::endl;
+            this->deleteFile(it);
         }
         _bcfiles.clear();
 
@@ -160,6 +197,8 @@ protected:
         args.push_back("-x");
         args.push_back("c"); // C source files
         args.insert(args.end(), this->_compileFlags.begin(), this->_compileFlags.end());
+        args.insert(args.end(), this->_profileFlags.begin(), this->_profileFlags.end());
+        args.insert(args.end(), this->_sourceFlags.begin(), this->_sourceFlags.end());
         args.push_back("-c");
         args.push_back("-");
         if (posIndepCode) {
@@ -178,6 +217,8 @@ protected:
         args.push_back("-x");
         args.push_back("c"); // C source files
         args.insert(args.end(), this->_compileFlags.begin(), this->_compileFlags.end());
+        args.insert(args.end(), this->_profileFlags.begin(), this->_profileFlags.end());
+        args.insert(args.end(), this->_sourceFlags.begin(), this->_sourceFlags.end());
         if (posIndepCode) {
             args.push_back("-fPIC"); // position-independent code for dynamic linking
         }
@@ -26,6 +26,9 @@ namespace cg {
  */
 template<class Base>
 class GccCompiler : public AbstractCCompiler<Base> {
+protected:
+    std::vector<std::string> _vectorMathFlags; // used to vectorize loops with calls to math functions
+    std::vector<std::string> _vectorMathLibs; // libraries with the vector versions of math functions
 public:
 
     GccCompiler(const std::string& gccPath = "/usr/bin/gcc") :
@@ -40,6 +43,58 @@ public:
     GccCompiler(const GccCompiler& orig) = delete;
     GccCompiler& operator=(const GccCompiler& rhs) = delete;
 
+    bool isProfileGuidedOptimizationSupported() const override {
+        return true;
+    }
+
+    void setProfileGeneration(const std::string& profileFolder) override {
+        this->_profileFlags = {"-fprofile-generate=" + profileFolder,
+                               "-fprofile-update=atomic"}; // models can be evaluated in parallel
+    }
+
+    void setProfileUse(const std::string& profileFolder) override {
+        this->_profileFlags = {"-fprofile-use=" + profileFolder,
+                               "-fprofile-correction",
+                               "-Wno-missing-profile"}; // not all functions are evaluated
+    }
+
+    inline bool isVectorMathLibrary() const {
+        return !_vectorMathFlags.empty();
+    }
+
+    /**
+     * Allows loops with calls to mathematical functions (e.g. exp, log,
+     * pow, sin) to be vectorized using the vector math library of glibc
+     * (libmvec).
+     * The sources should be generated with loops prepared for vectorization
+     * (see LanguageC::setVectorizeLoops()).
+     * This relaxes the IEEE semantics of floating point operations
+     * (-ffast-math), which is required by glibc to declare the vector
+     * variants of the math functions.
+     * These flags are only used to compile the generated sources and not
+     * when the dynamic library is linked.
+     *
+     * @param vectorize true to compile with the vector math library
+     */
+    inline void setVectorMathLibrary(bool vectorize) {
+        if (vectorize) {
+            _vectorMathFlags = {"-ftree-vectorize",
+                                "-fopenmp-simd", // uses the '#pragma omp simd' without OpenMP threads
+                                "-ffast-math"};
+            _vectorMathLibs = {"-lmvec", "-lm"};
+        } else {
+            _vectorMathFlags.clear();
+            _vectorMathLibs.clear();
+        }
+    }
+
+    std::string getCompilationSettings() const override {
+        std::string settings = AbstractCCompiler<Base>::getCompilationSettings();
+        if (settings.empty())
+            return settings;
+        return settings + implode(_vectorMathFlags, " ") + "\n";
+    }
+
     /**
      * Creates a dynamic library from a set of object files
      *
@@ -54,12 +109,21 @@ public:
 
         std::vector<std::string> args;
         args.insert(args.end(), this->_compileLibFlags.begin(), this->_compileLibFlags.end());
+        args.insert(args.end(), this->_profileFlags.begin(), this->_profileFlags.end());
+        // the vector math flags are only used to compile the sources
+        // (-ffast-math would also link crtfastmath.o which changes the
+        //  floating point environment of the whole process)
         args.push_back(linkerFlags); // Pass suitable options to linker
         args.push_back("-o"); // Output file name
         args.push_back(library); // Output file name
         for (const std::string& it : this->_ofiles) {
             args.push_back(it);
         }
+        for (const std::string& it : this->_precompiledOfiles) {
+            args.push_back(it);
+        }
+        // libraries must follow the object files which use them
+        args.insert(args.end(), _vectorMathLibs.begin(), _vectorMathLibs.end());
 
         if (timer != nullptr) {
             timer->startingJob("'" + library + "'", JobTimer::COMPILING_DYNAMIC_LIBRARY);
@@ -91,6 +155,9 @@ protected:
         args.push_back("-x");
         args.push_back("c"); // C source files
         args.insert(args.end(), this->_compileFlags.begin(), this->_compileFlags.end());
+        args.insert(args.end(), this->_profileFlags.begin(), this->_profileFlags.end());
+        args.insert(args.end(), _vectorMathFlags.begin(), _vectorMathFlags.end());
+        args.insert(args.end(), this->_sourceFlags.begin(), this->_sourceFlags.end());
         args.push_back("-c");
         args.push_back("-");
         if (posIndepCode) {
@@ -109,6 +176,9 @@ protected:
         args.push_back("-x");
         args.push_back("c"); // C source files
         args.insert(args.end(), this->_compileFlags.begin(), this->_compileFlags.end());
+        args.insert(args.end(), this->_profileFlags.begin(), this->_profileFlags.end());
+        args.insert(args.end(), _vectorMathFlags.begin(), _vectorMathFlags.end());
+        args.insert(args.end(), this->_sourceFlags.begin(), this->_sourceFlags.end());
         if (posIndepCode) {
             args.push_back("-fPIC"); // position-independent code for dynamic linking
         }
@@ -0,0 +1,71 @@
+#ifndef CPPAD_CG_SOURCE_STATISTICS_INCLUDED
+#define CPPAD_CG_SOURCE_STATISTICS_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Information about a generated source file which can be used to select
+ * the compilation options for that file.
+ *
+ * @author Joao Leal
+ */
+class SourceStatistics {
+public:
+    /**
+     * the number of characters in the source file
+     */
+    size_t size;
+    /**
+     * the number of statements (assignments) in the source file
+     */
+    size_t assignments;
+    /**
+     * whether or not the functions in the source file are expected to be
+     * evaluated often
+     */
+    bool hot;
+public:
+
+    inline SourceStatistics(size_t size = 0,
+                            size_t assignments = 0,
+                            bool hot = false) :
+        size(size),
+        assignments(assignments),
+        hot(hot) {
+    }
+
+    /**
+     * Determines the statistics for the provided source code.
+     *
+     * @param source the source code
+     * @param hot whether or not the source is expected to be evaluated often
+     */
+    static inline SourceStatistics create(const std::string& source,
+                                          bool hot = false) {
+        size_t assignments = 0;
+        for (size_t pos = source.find(";\n"); pos != std::string::npos; pos = source.find(";\n", pos + 2)) {
+            assignments++;
+        }
+        return SourceStatistics(source.size(), assignments, hot);
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
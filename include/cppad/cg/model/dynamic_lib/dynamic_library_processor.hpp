@@ -39,6 +39,31 @@ protected:
      * System dependent custom options
      */
     std::map<std::string, std::string> _options;
+    /**
+     * whether or not to use profile guided optimizations
+     */
+    bool _profileGuided;
+    /**
+     * the folder where profile data is saved
+     */
+    std::string _profileFolder;
+    /**
+     * whether or not the dynamic library is created only in memory
+     */
+    bool _inMemory;
+    /**
+     * the folder where the object files of each model are kept between
+     * builds (empty to always compile all the models)
+     */
+    std::string _incrementalFolder;
+    /**
+     * the models whose object files were reused in the last build
+     */
+    std::set<std::string> _reusedModels;
+    /**
+     * whether or not each model is placed in its own dynamic library
+     */
+    bool _splitModels;
 public:
 
     /**
@@ -53,7 +78,11 @@ public:
                                         const std::string& libraryName = "cppad_cg_model") :
         ModelLibraryProcessor<Base>(modelLibGen),
         _libraryName(libraryName),
-        _customLibExtension(nullptr) {
+        _customLibExtension(nullptr),
+        _profileGuided(false),
+        _profileFolder("cppadcg_profile"),
+        _inMemory(false),
+        _splitModels(false) {
     }
 
     inline const std::string& getLibraryName() const {
@@ -94,7 +123,10 @@ public:
     }
 
     /**
-     * System dependent custom options
+     * System dependent custom options.
+     * On Linux, "dlOpenMode" defines the flags used to load the dynamic
+     * libraries with dlopen (e.g. std::to_string(RTLD_LAZY) to only
+     * resolve the symbols when they are first used).
      */
     inline std::map<std::string, std::string>& getOptions() {
         return _options;
@@ -107,6 +139,128 @@ public:
         return _options;
     }
 
+    inline bool isProfileGuidedOptimization() const {
+        return _profileGuided;
+    }
+
+    /**
+     * Defines whether or not dynamic libraries are created using profile
+     * guided optimizations.
+     * The library is first compiled with instrumentation and the available
+     * entry points (forward zero, sparse Jacobian, and sparse Hessian) of
+     * each model are evaluated at the typical independent variable values
+     * (see ModelCSourceGen::setTypicalIndependentValues()).
+     * The library is then compiled again using the collected profile data.
+     * Models without typical values are not evaluated.
+     * The creation of the library fails if a model cannot be evaluated
+     * (e.g. due to missing atomic functions).
+     *
+     * @param profileGuided true to use profile guided optimizations
+     */
+    inline void setProfileGuidedOptimization(bool profileGuided) {
+        _profileGuided = profileGuided;
+    }
+
+    inline const std::string& getProfileFolder() const {
+        return _profileFolder;
+    }
+
+    /**
+     * Defines the folder where the profile data is saved when profile
+     * guided optimizations are used.
+     */
+    inline void setProfileFolder(const std::string& profileFolder) {
+        CPPADCG_ASSERT_KNOWN(!profileFolder.empty(), "Profile folder name cannot be empty");
+
+        _profileFolder = profileFolder;
+    }
+
+    inline bool isCreateInMemory() const {
+        return _inMemory;
+    }
+
+    /**
+     * Defines whether or not the dynamic library is created in a file which
+     * only exists in memory (Linux memfd) and loaded directly from it.
+     * The library must be loaded when it is created and it cannot use
+     * profile guided optimizations.
+     * Use AbstractCCompiler::setUseMemoryFiles() to also keep the object
+     * files in memory.
+     *
+     * @param inMemory true to create the library in memory
+     */
+    inline void setCreateInMemory(bool inMemory) {
+        _inMemory = inMemory;
+    }
+
+    inline bool isSplitModels() const {
+        return _splitModels;
+    }
+
+    /**
+     * Defines whether or not each model is compiled into its own dynamic
+     * library (see getModelLibraryPath()) instead of a single library with
+     * all the models.
+     * The library with the name provided by getLibraryName() then only
+     * contains the library level sources, the custom sources, and the
+     * list of model libraries, which are only loaded when a model is
+     * requested (e.g. ModelLibrary::model()).
+     * The model libraries must remain in the same folder as the main
+     * library.
+     * It cannot be used for libraries created in memory nor when nested
+     * models are linked directly.
+     *
+     * @param split true to create a dynamic library for each model
+     */
+    inline void setSplitModels(bool split) {
+        _splitModels = split;
+    }
+
+    /**
+     * The path of the dynamic library of a model when models are split
+     * into their own libraries (see setSplitModels()).
+     *
+     * @param modelName the model name
+     */
+    inline std::string getModelLibraryPath(const std::string& modelName) const {
+        std::string libname = _libraryName + "_" + modelName;
+        if (_customLibExtension != nullptr)
+            libname += *_customLibExtension;
+        else
+            libname += system::SystemInfo<>::DYNAMIC_LIB_EXTENSION;
+        return libname;
+    }
+
+    inline const std::string& getIncrementalBuildFolder() const {
+        return _incrementalFolder;
+    }
+
+    /**
+     * Defines a folder where the compiled object files of each model are
+     * kept so that they can be reused by the next builds of the library.
+     * A model is only generated and compiled again if its fingerprint
+     * (see ModelCSourceGen::getFingerprint()) or the compiler settings
+     * changed; the library level sources are always compiled and the
+     * library is linked again.
+     * All the models are compiled when the models use a constant pool,
+     * when nested models are linked directly, and when profile guided
+     * optimizations are used.
+     *
+     * @param folder the folder where the object files are saved (empty to
+     *               always compile all the models)
+     */
+    inline void setIncrementalBuildFolder(const std::string& folder) {
+        _incrementalFolder = folder;
+    }
+
+    /**
+     * Provides the names of the models whose previously compiled object
+     * files were reused in the last build of the dynamic library.
+     */
+    inline const std::set<std::string>& getReusedModels() const {
+        return _reusedModels;
+    }
+
     /**
      * Compiles all models and generates a dynamic library.
      * 
@@ -120,37 +274,47 @@ public:
         // backup output format so that it can be restored
         OStreamConfigRestore coutb(std::cout);
 
-        this->modelLibraryHelper_->startingJob("", JobTimer::DYNAMIC_MODEL_LIBRARY);
+        if (_splitModels) {
+            if (_inMemory)
+                throw CGException("Models cannot be split into several dynamic libraries created in memory");
+            if (this->modelLibraryHelper_->isDirectlyLinkNestedModels())
+                throw CGException("Models cannot be split into several dynamic libraries when nested models are linked directly");
+        }
 
-        const std::map<std::string, ModelCSourceGen<Base>*>& models = this->modelLibraryHelper_->getModels();
-        try {
-            for (const auto& p : models) {
-                const std::map<std::string, std::string>& modelSources = this->getSources(*p.second);
+        if (_inMemory) {
+            if (!loadLib)
+                throw CGException("A dynamic library created in memory must be loaded");
+            if (_profileGuided)
+                throw CGException("Profile guided optimizations cannot be used with dynamic libraries created in memory");
+            return createDynamicLibraryInMemory(compiler);
+        }
 
-                this->modelLibraryHelper_->startingJob("", JobTimer::COMPILING_FOR_MODEL);
-                compiler.compileSources(modelSources, true, this->modelLibraryHelper_);
-                this->modelLibraryHelper_->finishedJob();
-            }
+        this->modelLibraryHelper_->startingJob("", JobTimer::DYNAMIC_MODEL_LIBRARY);
 
-            const std::map<std::string, std::string>& sources = this->getLibrarySources();
-            compiler.compileSources(sources, true, this->modelLibraryHelper_);
+        if (_profileGuided) {
+            if (!compiler.isProfileGuidedOptimizationSupported())
+                throw CGException("The compiler does not support profile guided optimizations");
 
-            const std::map<std::string, std::string>& customSource = this->modelLibraryHelper_->getCustomSources();
-            compiler.compileSources(customSource, true, this->modelLibraryHelper_);
+            system::createFolder(_profileFolder);
 
-            std::string libname = _libraryName;
-            if (_customLibExtension != nullptr)
-                libname += *_customLibExtension;
-            else
-                libname += system::SystemInfo<>::DYNAMIC_LIB_EXTENSION;
+            try {
+                // instrumented library
+                compiler.setProfileGeneration(_profileFolder);
+                buildDynamicLibrary(compiler, getLibraryPath());
 
-            compiler.buildDynamic(libname, this->modelLibraryHelper_);
+                collectProfileData();
 
-        } catch (...) {
-            compiler.cleanup();
-            throw;
+                // optimized library
+                compiler.setProfileUse(_profileFolder);
+                buildDynamicLibrary(compiler, getLibraryPath());
+            } catch (...) {
+                compiler.clearProfile();
+                throw;
+            }
+            compiler.clearProfile();
+        } else {
+            buildDynamicLibrary(compiler, getLibraryPath());
         }
-        compiler.cleanup();
 
         this->modelLibraryHelper_->finishedJob();
 
@@ -184,11 +348,15 @@ public:
             for (const auto& p : models) {
                 const std::map<std::string, std::string>& modelSources = this->getSources(*p.second);
 
+                compiler.setSourceStatistics(p.second->getSourceStatistics());
+
                 this->modelLibraryHelper_->startingJob("", JobTimer::COMPILING_FOR_MODEL);
                 compiler.compileSources(modelSources, posIndepCode, this->modelLibraryHelper_);
                 this->modelLibraryHelper_->finishedJob();
             }
 
+            compiler.setSourceStatistics(std::map<std::string, SourceStatistics>());
+
             const std::map<std::string, std::string>& sources = this->getLibrarySources();
             compiler.compileSources(sources, posIndepCode, this->modelLibraryHelper_);
 
@@ -217,8 +385,344 @@ public:
 
 protected:
 
+    /**
+     * The path of the dynamic library file saved to disk.
+     */
+    inline std::string getLibraryPath() const {
+        std::string libname = _libraryName;
+        if (_customLibExtension != nullptr)
+            libname += *_customLibExtension;
+        else
+            libname += system::SystemInfo<>::DYNAMIC_LIB_EXTENSION;
+        return libname;
+    }
+
+    std::unique_ptr<DynamicLib<Base>> createDynamicLibraryInMemory(CCompiler<Base>& compiler) {
+        this->modelLibraryHelper_->startingJob("", JobTimer::DYNAMIC_MODEL_LIBRARY);
+
+        int fd = system::createMemoryFile(system::filenameFromPath(getLibraryPath()));
+        std::string path = system::memoryFilePath(fd);
+
+        std::unique_ptr<DynamicLib<Base>> lib;
+        try {
+            buildDynamicLibrary(compiler, path);
+
+            this->modelLibraryHelper_->finishedJob();
+
+            lib = loadDynamicLibrary(path);
+        } catch (...) {
+            system::closeMemoryFile(fd);
+            throw;
+        }
+        system::closeMemoryFile(fd); // the library remains loaded
+
+        return lib;
+    }
+
+    virtual void buildDynamicLibrary(CCompiler<Base>& compiler,
+                                     const std::string& libname) {
+        if (_splitModels) {
+            buildSplitDynamicLibraries(compiler, libname);
+            return;
+        }
+
+        const std::map<std::string, ModelCSourceGen<Base>*>& models = this->modelLibraryHelper_->getModels();
+
+        _reusedModels.clear();
+        bool incremental = isIncrementalBuild(compiler);
+
+        try {
+            for (const auto& p : models) {
+                if (incremental)
+                    compileModelIncrementally(compiler, *p.second);
+                else
+                    compileModel(compiler, *p.second);
+            }
+
+            compiler.setSourceStatistics(std::map<std::string, SourceStatistics>());
+
+            const std::map<std::string, std::string>& sources = this->getLibrarySources();
+            compiler.compileSources(sources, true, this->modelLibraryHelper_);
+
+            const std::map<std::string, std::string>& customSource = this->modelLibraryHelper_->getCustomSources();
+            compiler.compileSources(customSource, true, this->modelLibraryHelper_);
+
+            compiler.buildDynamic(libname, this->modelLibraryHelper_);
+
+        } catch (...) {
+            compiler.cleanup();
+            throw;
+        }
+        compiler.cleanup();
+    }
+
+    /**
+     * Creates a main dynamic library with the library level sources and a
+     * dynamic library for each model.
+     * The model libraries are linked against the main library which
+     * defines the symbols they share (e.g. the thread pool and the custom
+     * sources).
+     * The constant pool is not visible outside a library and therefore
+     * each model library also receives its own copy.
+     */
+    virtual void buildSplitDynamicLibraries(CCompiler<Base>& compiler,
+                                            const std::string& libname) {
+        const std::map<std::string, ModelCSourceGen<Base>*>& models = this->modelLibraryHelper_->getModels();
+
+        _reusedModels.clear();
+        bool incremental = isIncrementalBuild(compiler);
+
+        try {
+            /**
+             * the main library
+             */
+            std::map<std::string, std::string> sources = this->getLibrarySources();
+            generateModelLibrariesSource(sources);
+
+            compiler.setSourceStatistics(std::map<std::string, SourceStatistics>());
+            compiler.compileSources(sources, true, this->modelLibraryHelper_);
+
+            const std::map<std::string, std::string>& customSource = this->modelLibraryHelper_->getCustomSources();
+            compiler.compileSources(customSource, true, this->modelLibraryHelper_);
+
+            compiler.buildDynamic(libname, this->modelLibraryHelper_);
+            compiler.cleanup();
+
+            std::map<std::string, std::string> poolSources;
+            if (this->modelLibraryHelper_->isUseConstantPool()) {
+                std::string poolFile = this->modelLibraryHelper_->getConstantPool().getName() + ".c";
+                auto itPool = sources.find(poolFile);
+                if (itPool != sources.end())
+                    poolSources[poolFile] = itPool->second;
+            }
+
+            /**
+             * the model libraries
+             */
+            for (const auto& p : models) {
+                if (incremental)
+                    compileModelIncrementally(compiler, *p.second);
+                else
+                    compileModel(compiler, *p.second);
+
+                if (!poolSources.empty())
+                    compiler.compileSources(poolSources, true, this->modelLibraryHelper_);
+
+                compiler.addPrecompiledObjectFile(libname); // the shared symbols
+                compiler.buildDynamic(getModelLibraryPath(p.first), this->modelLibraryHelper_);
+                compiler.cleanup();
+            }
+
+        } catch (...) {
+            compiler.cleanup();
+            throw;
+        }
+        compiler.cleanup();
+    }
+
+    /**
+     * Generates the function which provides the file names of the
+     * dynamic libraries of each model (relative to the main library).
+     */
+    virtual void generateModelLibrariesSource(std::map<std::string, std::string>& sources) {
+        const std::map<std::string, ModelCSourceGen<Base>*>& models = this->modelLibraryHelper_->getModels();
+        const std::string& function = ModelLibraryCSourceGen<Base>::FUNCTION_MODELLIBRARIES;
+
+        std::ostringstream code;
+        LanguageC<Base>::printFunctionDeclaration(code, "void", function, {"char const *const** names",
+                                                                            "char const *const** files",
+                                                                            "int* count"});
+        code << " {\n"
+                "   static const char* const m[] = {\n";
+        for (auto it = models.begin(); it != models.end(); ++it) {
+            if (it != models.begin())
+                code << ",\n";
+            code << "      \"" << it->first << "\"";
+        }
+        code << "};\n"
+                "   static const char* const f[] = {\n";
+        for (auto it = models.begin(); it != models.end(); ++it) {
+            if (it != models.begin())
+                code << ",\n";
+            code << "      \"" << system::filenameFromPath(getModelLibraryPath(it->first)) << "\"";
+        }
+        code << "};\n"
+                "   *names = m;\n"
+                "   *files = f;\n"
+                "   *count = " << models.size() << ";\n"
+                "}\n\n";
+
+        sources[function + ".c"] = code.str();
+    }
+
+    /**
+     * Whether or not previously compiled object files of the models can be
+     * reused in the next build.
+     */
+    virtual bool isIncrementalBuild(const CCompiler<Base>& compiler) const {
+        return !_incrementalFolder.empty() &&
+                !this->modelLibraryHelper_->isUseConstantPool() &&
+                !this->modelLibraryHelper_->isDirectlyLinkNestedModels() &&
+                !compiler.getCompilationSettings().empty();
+    }
+
+    virtual void compileModel(CCompiler<Base>& compiler,
+                              ModelCSourceGen<Base>& model) {
+        const std::map<std::string, std::string>& modelSources = this->getSources(model);
+
+        compiler.setSourceStatistics(model.getSourceStatistics());
+
+        this->modelLibraryHelper_->startingJob("", JobTimer::COMPILING_FOR_MODEL);
+        compiler.compileSources(modelSources, true, this->modelLibraryHelper_);
+        this->modelLibraryHelper_->finishedJob();
+    }
+
+    /**
+     * Reuses the object files of a model from a previous build if its
+     * fingerprint did not change, otherwise the model is compiled and its
+     * object files are saved in the incremental build folder.
+     */
+    virtual void compileModelIncrementally(CCompiler<Base>& compiler,
+                                           ModelCSourceGen<Base>& model) {
+        const std::string& name = model.getName();
+
+        ModelFingerprint fp;
+        fp << model.getFingerprint(this->modelLibraryHelper_->getMultiThreading());
+        fp << compiler.getCompilationSettings();
+        const std::string fingerprint = fp.toString();
+
+        const std::string manifest = system::createPath(_incrementalFolder, name + ".fingerprint");
+
+        std::vector<std::string> objectFiles;
+        if (readManifest(manifest, fingerprint, objectFiles)) {
+            this->modelLibraryHelper_->startingJob("'" + name + "'", JobTimer::REUSING_FOR_MODEL);
+            for (const std::string& file : objectFiles) {
+                compiler.addPrecompiledObjectFile(file);
+            }
+            this->modelLibraryHelper_->finishedJob();
+
+            _reusedModels.insert(name);
+            return;
+        }
+
+        const std::set<std::string> previous = compiler.getObjectFiles();
+
+        compileModel(compiler, model);
+
+        /**
+         * keep a copy of the new object files
+         */
+        system::createFolder(_incrementalFolder);
+        remove(manifest.c_str()); // not valid until all files are copied
+
+        objectFiles.clear();
+        for (const std::string& file : compiler.getObjectFiles()) {
+            if (previous.find(file) != previous.end())
+                continue;
+
+            std::string copy = system::createPath(_incrementalFolder, name + "_" + std::to_string(objectFiles.size()) + ".o");
+            copyFile(file, copy);
+            objectFiles.push_back(copy);
+        }
+
+        std::ofstream out(manifest.c_str());
+        out << fingerprint << "\n";
+        for (const std::string& file : objectFiles) {
+            out << file << "\n";
+        }
+        out.close();
+        if (!out)
+            throw CGException("Failed to save the object files list of model '", name, "' to '", manifest, "'");
+    }
+
+    /**
+     * Reads the list of object files saved for a model in a previous build.
+     *
+     * @param manifest the path to the file with the fingerprint and the
+     *                 list of object files
+     * @param fingerprint the current fingerprint of the model
+     * @param objectFiles the object files (output)
+     * @return true if the object files can be reused
+     */
+    static bool readManifest(const std::string& manifest,
+                             const std::string& fingerprint,
+                             std::vector<std::string>& objectFiles) {
+        if (!system::isFile(manifest))
+            return false;
+
+        std::ifstream in(manifest.c_str());
+        std::string line;
+        if (!std::getline(in, line) || line != fingerprint)
+            return false;
+
+        while (std::getline(in, line)) {
+            if (line.empty())
+                continue;
+            if (!system::isFile(line))
+                return false; // deleted by the user
+            objectFiles.push_back(line);
+        }
+
+        return !objectFiles.empty();
+    }
+
+    static void copyFile(const std::string& source,
+                         const std::string& destination) {
+        std::ifstream in(source.c_str(), std::ios::binary);
+        std::ofstream out(destination.c_str(), std::ios::binary | std::ios::trunc);
+        if (!in || !out)
+            throw CGException("Failed to copy '", source, "' to '", destination, "'");
+
+        out << in.rdbuf();
+        out.close();
+        if (!out)
+            throw CGException("Failed to copy '", source, "' to '", destination, "'");
+    }
+
+    /**
+     * Evaluates the models in the instrumented dynamic library at their
+     * typical values.
+     * The profile data is saved when the library is unloaded.
+     *
+     * @throws CGException if a model cannot be evaluated
+     */
+    virtual void collectProfileData() {
+        std::unique_ptr<DynamicLib<Base>> lib = loadDynamicLibrary();
+
+        const std::map<std::string, ModelCSourceGen<Base>*>& models = this->modelLibraryHelper_->getModels();
+        for (const auto& p : models) {
+            const std::vector<Base>& x = p.second->getTypicalIndependentValues();
+            if (x.empty())
+                continue; // no representative values
+
+            this->modelLibraryHelper_->startingJob("'" + p.first + "'", JobTimer::PROFILING);
+
+            std::unique_ptr<GenericModel<Base>> model = lib->model(p.first);
+            try {
+                if (model->isForwardZeroAvailable())
+                    model->ForwardZero(x);
+
+                if (model->isSparseJacobianAvailable())
+                    model->SparseJacobian(x);
+
+                if (model->isSparseHessianAvailable()) {
+                    std::vector<Base> w(model->Range(), Base(1));
+                    model->SparseHessian(x, w);
+                }
+            } catch (const CGException& e) {
+                // e.g. missing atomic functions
+                throw CGException("Failed to collect profile data for model '", p.first, "' "
+                                  "(typical independent values can be removed to skip it): ", e.what());
+            }
+
+            this->modelLibraryHelper_->finishedJob();
+        }
+    }
+
     virtual std::unique_ptr<DynamicLib<Base>> loadDynamicLibrary();
 
+    virtual std::unique_ptr<DynamicLib<Base>> loadDynamicLibrary(const std::string& path);
+
 };
 
 } // END cg namespace
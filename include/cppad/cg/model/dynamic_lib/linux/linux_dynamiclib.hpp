@@ -27,6 +27,10 @@ namespace cg {
  * Useful class to call the compiled source code in a dynamic library.
  * For the Linux Operating System only.
  *
+ * When each model is in its own dynamic library (see
+ * DynamicModelLibraryProcessor::setSplitModels()) the library of a model
+ * is only loaded when the model is requested.
+ *
  * @author Joao Leal
  */
 template<class Base>
@@ -35,23 +39,30 @@ protected:
     const std::string _dynLibName;
     /// the dynamic library handler
     void* _dynLibHandle;
+    /// the flags used to open the dynamic libraries (e.g. RTLD_NOW or RTLD_LAZY)
+    int _dlOpenMode;
+    /// the paths of the dynamic libraries of each model (if models are split)
+    std::map<std::string, std::string> _modelLibraries;
+    /// the dynamic library handlers of each model (if models are split)
+    std::map<std::string, void*> _modelLibHandles;
     std::set<LinuxDynamicLibModel<Base>*> _models;
 public:
 
+    /**
+     * Loads a dynamic library.
+     *
+     * @param dynLibName the path to the dynamic library
+     * @param dlOpenMode the flags passed to dlopen (RTLD_LAZY avoids
+     *                   resolving all the symbols when the library is
+     *                   loaded)
+     */
     LinuxDynamicLib(const std::string& dynLibName,
                     int dlOpenMode = RTLD_NOW) :
         _dynLibName(dynLibName),
-        _dynLibHandle(nullptr) {
+        _dynLibHandle(nullptr),
+        _dlOpenMode(dlOpenMode) {
 
-        std::string path;
-        if (dynLibName[0] == '/') {
-            path = dynLibName; // absolute path
-        } else if (!(dynLibName[0] == '.' && dynLibName[1] == '/') &&
-                !(dynLibName[0] == '.' && dynLibName[1] == '.')) {
-            path = "./" + dynLibName; // relative path
-        } else {
-            path = dynLibName;
-        }
+        std::string path = loadPath(dynLibName);
 
         // load the dynamic library
         _dynLibHandle = dlopen(path.c_str(), dlOpenMode);
@@ -59,6 +70,21 @@ public:
 
         // validate the dynamic library
         this->validate();
+
+        // the libraries of each model (optional)
+        void (*librariesFunc)(char const *const**, char const *const**, int*);
+        librariesFunc = reinterpret_cast<decltype(librariesFunc)> (loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_MODELLIBRARIES, false));
+        if (librariesFunc != nullptr) {
+            char const*const* names = nullptr;
+            char const*const* files = nullptr;
+            int count;
+            (*librariesFunc)(&names, &files, &count);
+
+            std::string folder = system::directoryFromPath(path);
+            for (int i = 0; i < count; i++) {
+                _modelLibraries[names[i]] = system::createPath(folder, files[i]);
+            }
+        }
     }
 
     LinuxDynamicLib(const LinuxDynamicLib&) = delete;
@@ -70,6 +96,8 @@ public:
         if (it == this->_modelNames.end()) {
             return m;
         }
+        loadModelLibrary(modelName);
+
         m.reset(new LinuxDynamicLibModel<Base> (this, modelName));
         _models.insert(m.get());
         return m;
@@ -80,15 +108,43 @@ public:
     }
 
     void* loadFunction(const std::string& functionName, bool required = true) override {
-        void* functor = dlsym(_dynLibHandle, functionName.c_str());
+        return loadSymbol(_dynLibHandle, functionName, required);
+    }
 
-        if (required) {
-            char *err = dlerror();
-            if (err != nullptr)
-                throw CGException("Failed to load function '", functionName, "': ", err);
+    /**
+     * Provides a pointer to a function of a model, which can be in the
+     * model's own dynamic library.
+     *
+     * @param modelName the model name
+     * @param functionName the name of the function in the dynamic library
+     * @param required whether or not the function symbol must exist
+     * @return a pointer to the function symbol if it exists, nullptr
+     *         otherwise
+     */
+    virtual void* loadModelFunction(const std::string& modelName,
+                                    const std::string& functionName,
+                                    bool required = true) {
+        auto it = _modelLibHandles.find(modelName);
+        if (it != _modelLibHandles.end()) {
+            return loadSymbol(it->second, functionName, required);
+        } else {
+            return loadSymbol(_dynLibHandle, functionName, required);
         }
+    }
 
-        return functor;
+    /**
+     * Whether or not each model is in its own dynamic library.
+     */
+    inline bool isSplitModels() const {
+        return !_modelLibraries.empty();
+    }
+
+    /**
+     * Whether or not the dynamic library of a model is already loaded
+     * (always true if the models are not split into several libraries).
+     */
+    inline bool isModelLibraryLoaded(const std::string& modelName) const {
+        return !isSplitModels() || _modelLibHandles.find(modelName) != _modelLibHandles.end();
     }
 
     virtual ~LinuxDynamicLib() {
@@ -101,6 +157,11 @@ public:
                 (*this->_onClose)();
             }
 
+            for (const auto& it : _modelLibHandles) {
+                dlclose(it.second);
+            }
+            _modelLibHandles.clear();
+
             dlclose(_dynLibHandle);
             _dynLibHandle = nullptr;
         }
@@ -112,6 +173,53 @@ protected:
         _models.erase(model);
     }
 
+    /**
+     * Loads the dynamic library of a model if the models are split into
+     * several libraries and it was not loaded yet.
+     */
+    virtual void loadModelLibrary(const std::string& modelName) {
+        auto it = _modelLibraries.find(modelName);
+        if (it == _modelLibraries.end() || _modelLibHandles.find(modelName) != _modelLibHandles.end()) {
+            return;
+        }
+
+        void* handle = dlopen(loadPath(it->second).c_str(), _dlOpenMode);
+        if (handle == nullptr) {
+            throw CGException("Failed to dynamically load library '", it->second, "' for model '", modelName, "': ", dlerror());
+        }
+        _modelLibHandles[modelName] = handle;
+    }
+
+    static void* loadSymbol(void* handle,
+                            const std::string& functionName,
+                            bool required) {
+        dlerror(); // clear any previous error
+        void* functor = dlsym(handle, functionName.c_str());
+
+        if (required) {
+            char *err = dlerror();
+            if (err != nullptr)
+                throw CGException("Failed to load function '", functionName, "': ", err);
+        }
+
+        return functor;
+    }
+
+    /**
+     * The path provided to dlopen (relative paths must start with "./" or
+     * "../" otherwise the library is searched in the system folders).
+     */
+    static std::string loadPath(const std::string& dynLibName) {
+        if (dynLibName[0] == '/') {
+            return dynLibName; // absolute path
+        } else if (!(dynLibName[0] == '.' && dynLibName[1] == '/') &&
+                   !(dynLibName[0] == '.' && dynLibName[1] == '.')) {
+            return "./" + dynLibName; // relative path
+        } else {
+            return dynLibName;
+        }
+    }
+
     friend class LinuxDynamicLibModel<Base>;
 
 };
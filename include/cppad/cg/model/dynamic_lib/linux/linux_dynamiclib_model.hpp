@@ -63,7 +63,7 @@ protected:
     LinuxDynamicLibModel& operator=(const LinuxDynamicLibModel&) = delete;
 
     void* loadFunction(const std::string& functionName, bool required = true) override {
-        return _dynLib->loadFunction(functionName, required);
+        return _dynLib->loadModelFunction(this->_name, functionName, required);
     }
 
     void modelLibraryClosed() override {
@@ -44,6 +44,10 @@ protected:
     LangCAtomicFun _atomicFuncArg;
     std::vector<std::string> _atomicNames; // names of the atomic/external functions required by this model
     std::vector<ExternalFunctionWrapper<Base>* > _atomic;
+    // whether or not each atomic function is called directly by the compiled code
+    std::vector<bool> _atomicLinked;
+    // the callbacks to the external functions used by atomic functions which are not linked directly
+    LangCAtomicFun _atomicCallbackArg;
     size_t _missingAtomicFunctions;
     CppAD::vector<Base> _tx, _ty, _px, _py;
     // original model function
@@ -68,6 +72,10 @@ protected:
     void (*_sparseJacobian)(Base const*const*, Base * const*, LangCAtomicFun);
     // sparse hessian function in the dynamic library
     void (*_sparseHessian)(Base const*const*, Base * const*, LangCAtomicFun);
+    // single precision versions of the model, sparse Jacobian, and sparse Hessian
+    void (*_zeroFloat)(float const*const*, float * const*, LangCAtomicFun);
+    void (*_sparseJacobianFloat)(float const*const*, float * const*, LangCAtomicFun);
+    void (*_sparseHessianFloat)(float const*const*, float * const*, LangCAtomicFun);
     //
     void (*_forwardOneSparsity)(unsigned long, unsigned long const**, unsigned long*);
     //
@@ -88,6 +96,30 @@ protected:
             unsigned long * nnz);
     void (*_atomicFunctions)(const char*** names,
             unsigned long * n);
+    // atomic functions which call other models in the same library directly
+    int (*_atomicForward)(void*, int, int, int, const Array[], Array*);
+    int (*_atomicReverse)(void*, int, int, const Array[], Array*, const Array[]);
+    void (*_atomicLinkedFunctions)(int const** linked,
+            unsigned long * n);
+    // evaluation of the operations which only depend on parameters
+    void (*_precomputeParameters)(Base const*const*, Base*, LangCAtomicFun);
+    void (*_parameterInfo)(unsigned long const** indexes,
+            unsigned long * n,
+            unsigned long * cacheSize,
+            const char*** functions,
+            unsigned long const** offsets,
+            unsigned long * nFunctions);
+    // the indexes of the parameters in the independent vector
+    std::vector<size_t> _parameterIndexes;
+    // the values of the parameters used to evaluate the parameter cache
+    std::vector<Base> _parameterValues;
+    std::vector<Base> _parameterCache;
+    // the location of the cached values of each function in the cache
+    size_t _parameterCacheZero;
+    size_t _parameterCacheJac;
+    size_t _parameterCacheHess;
+    bool _parameterCacheValid;
+    std::vector<const Base*> _inParam;
 
 public:
 
@@ -109,6 +141,13 @@ public:
     }
 
     bool addAtomicFunction(atomic_base<Base>& atomic) override {
+        auto* atomicModel = dynamic_cast<CGAtomicGenericModel<Base>*> (&atomic);
+        if (atomicModel != nullptr && isSparseDirectionalAvailable(atomicModel->getModel())) {
+            // avoid the conversion to dense Taylor coefficient arrays
+            return addExternalFunction<GenericModel<Base>, GenericModelExternalFunctionWrapper<Base> >
+                    (atomicModel->getModel(), atomic.afun_name());
+        }
+
         return addExternalFunction<atomic_base<Base>, AtomicExternalFunctionWrapper<Base> >
                 (atomic, atomic.afun_name());
     }
@@ -118,6 +157,24 @@ public:
                 (atomic, atomic.getName());
     }
 
+    /**
+     * Provides the indexes of the independent variables which were defined
+     * as parameters in the model (see ModelCSourceGen::setParameterIndependents()).
+     */
+    inline const std::vector<size_t>& getParameterIndependents() const {
+        return _parameterIndexes;
+    }
+
+    /**
+     * Forces the reevaluation of the parameter dependent operations in the
+     * next model evaluation.
+     * The cache is already updated automatically when the values of the
+     * parameters change.
+     */
+    inline void invalidateParameterCache() {
+        _parameterCacheValid = false;
+    }
+
     // Jacobian sparsity
     bool isJacobianSparsityAvailable() override {
         return _jacobianSparsity != nullptr;
@@ -306,7 +363,7 @@ public:
         _in[0] = x.data();
         _out[0] = dep.data();
 
-        (*_zero)(&_in[0], &_out[0], _atomicFuncArg);
+        (*_zero)(parameterCachedInput(_in, 1, _parameterCacheZero), &_out[0], _atomicFuncArg);
     }
 
     void ForwardZero(const std::vector<const Base*> &x,
@@ -319,6 +376,7 @@ public:
 
         _out[0] = dep.data();
 
+        CPPADCG_ASSERT_KNOWN(_precomputeParameters == nullptr, "Parameter caches are not supported with multiple independent variable arrays");
         (*_zero)(&x[0], &_out[0], _atomicFuncArg);
     }
 
@@ -337,7 +395,7 @@ public:
         _in[0] = tx.data();
         _out[0] = ty.data();
 
-        (*_zero)(&_in[0], &_out[0], _atomicFuncArg);
+        (*_zero)(parameterCachedInput(_in, 1, _parameterCacheZero), &_out[0], _atomicFuncArg);
 
         if (vx.size() > 0) {
             CPPADCG_ASSERT_KNOWN(vx.size() >= _n, "Invalid vx size");
@@ -626,7 +684,7 @@ public:
             _in[0] = x.data();
             _out[0] = &compressed[0];
 
-            (*_sparseJacobian)(&_in[0], &_out[0], _atomicFuncArg);
+            (*_sparseJacobian)(parameterCachedInput(_in, 1, _parameterCacheJac), &_out[0], _atomicFuncArg);
         }
 
         createDenseFromSparse(compressed,
@@ -659,7 +717,7 @@ public:
             _in[0] = &x[0];
             _out[0] = &jac[0];
 
-            (*_sparseJacobian)(&_in[0], &_out[0], _atomicFuncArg);
+            (*_sparseJacobian)(parameterCachedInput(_in, 1, _parameterCacheJac), &_out[0], _atomicFuncArg);
             std::copy(drow, drow + nnz, row.begin());
             std::copy(dcol, dcol + nnz, col.begin());
         }
@@ -688,7 +746,7 @@ public:
             _in[0] = x.data();
             _out[0] = jac.data();
 
-            (*_sparseJacobian)(&_in[0], &_out[0], _atomicFuncArg);
+            (*_sparseJacobian)(parameterCachedInput(_in, 1, _parameterCacheJac), &_out[0], _atomicFuncArg);
         }
     }
 
@@ -712,6 +770,7 @@ public:
         if (nnz > 0) {
             _out[0] = jac.data();
 
+            CPPADCG_ASSERT_KNOWN(_precomputeParameters == nullptr, "Parameter caches are not supported with multiple independent variable arrays");
             (*_sparseJacobian)(&x[0], &_out[0], _atomicFuncArg);
         }
     }
@@ -744,7 +803,7 @@ public:
             _inHess[1] = w.data();
             _out[0] = &compressed[0];
 
-            (*_sparseHessian)(&_inHess[0], &_out[0], _atomicFuncArg);
+            (*_sparseHessian)(parameterCachedInput(_inHess, 2, _parameterCacheHess), &_out[0], _atomicFuncArg);
         }
 
         createDenseFromSparse(compressed,
@@ -783,7 +842,7 @@ public:
             _inHess[1] = &w[0];
             _out[0] = &hess[0];
 
-            (*_sparseHessian)(&_inHess[0], &_out[0], _atomicFuncArg);
+            (*_sparseHessian)(parameterCachedInput(_inHess, 2, _parameterCacheHess), &_out[0], _atomicFuncArg);
         }
     }
 
@@ -812,7 +871,7 @@ public:
             _inHess[1] = w.data();
             _out[0] = hess.data();
 
-            (*_sparseHessian)(&_inHess[0], &_out[0], _atomicFuncArg);
+            (*_sparseHessian)(parameterCachedInput(_inHess, 2, _parameterCacheHess), &_out[0], _atomicFuncArg);
         }
     }
 
@@ -835,6 +894,7 @@ public:
         *col = dcol;
 
         if (nnz > 0) {
+            CPPADCG_ASSERT_KNOWN(_precomputeParameters == nullptr, "Parameter caches are not supported with multiple independent variable arrays");
             std::copy(x.begin(), x.end(), _inHess.begin());
             _inHess.back() = w.data(); // the index might not be 1
             _out[0] = hess.data();
@@ -843,6 +903,88 @@ public:
         }
     }
 
+    /// single precision evaluations
+
+    bool isForwardZeroFloatAvailable() override {
+        return _zeroFloat != nullptr;
+    }
+
+    void ForwardZeroFloat(ArrayView<const float> x,
+                          ArrayView<float> dep) override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, "Model library is not ready (possibly closed)");
+        CPPADCG_ASSERT_KNOWN(_zeroFloat != nullptr, "No single precision zero order forward mode function defined in the dynamic library");
+        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+                             " please use the variable size methods");
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size");
+        CPPADCG_ASSERT_KNOWN(dep.size() == _m, "Invalid dependent array size");
+
+        const float* in[1] = {x.data()};
+        float* out[1] = {dep.data()};
+
+        (*_zeroFloat)(in, out, _atomicFuncArg);
+    }
+
+    bool isSparseJacobianFloatAvailable() override {
+        return _sparseJacobianFloat != nullptr;
+    }
+
+    void SparseJacobianFloat(ArrayView<const float> x,
+                             ArrayView<float> jac,
+                             size_t const** row,
+                             size_t const** col) override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, "Model library is not ready (possibly closed)");
+        CPPADCG_ASSERT_KNOWN(_sparseJacobianFloat != nullptr, "No single precision sparse Jacobian function defined in the dynamic library");
+        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+                             " please use the variable size methods");
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size");
+
+        unsigned long const* drow;
+        unsigned long const* dcol;
+        unsigned long nnz;
+        (*_jacobianSparsity)(&drow, &dcol, &nnz);
+        CPPADCG_ASSERT_KNOWN(nnz == jac.size(), "Invalid number of non-zero elements in Jacobian");
+        *row = drow;
+        *col = dcol;
+
+        if (nnz > 0) {
+            const float* in[1] = {x.data()};
+            float* out[1] = {jac.data()};
+
+            (*_sparseJacobianFloat)(in, out, _atomicFuncArg);
+        }
+    }
+
+    bool isSparseHessianFloatAvailable() override {
+        return _sparseHessianFloat != nullptr;
+    }
+
+    void SparseHessianFloat(ArrayView<const float> x,
+                            ArrayView<const float> w,
+                            ArrayView<float> hess,
+                            size_t const** row,
+                            size_t const** col) override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, "Model library is not ready (possibly closed)");
+        CPPADCG_ASSERT_KNOWN(_sparseHessianFloat != nullptr, "No single precision sparse Hessian function defined in the dynamic library");
+        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+                             " please use the variable size methods");
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size");
+        CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size");
+
+        unsigned long const* drow, *dcol;
+        unsigned long nnz;
+        (*_hessianSparsity)(&drow, &dcol, &nnz);
+        CPPADCG_ASSERT_KNOWN(nnz == hess.size(), "Invalid number of non-zero elements in Hessian");
+        *row = drow;
+        *col = dcol;
+
+        if (nnz > 0) {
+            const float* in[2] = {x.data(), w.data()};
+            float* out[1] = {hess.data()};
+
+            (*_sparseHessianFloat)(in, out, _atomicFuncArg);
+        }
+    }
+
 protected:
 
     /**
@@ -856,6 +998,7 @@ protected:
         _m(0),
         _n(0),
         _atomicFuncArg{nullptr}, // not really required
+        _atomicCallbackArg{nullptr},
         _missingAtomicFunctions(0),
         _zero(nullptr),
         _forwardOne(nullptr),
@@ -868,12 +1011,25 @@ protected:
         _sparseReverseTwo(nullptr),
         _sparseJacobian(nullptr),
         _sparseHessian(nullptr),
+        _zeroFloat(nullptr),
+        _sparseJacobianFloat(nullptr),
+        _sparseHessianFloat(nullptr),
         _forwardOneSparsity(nullptr),
         _reverseOneSparsity(nullptr),
         _reverseTwoSparsity(nullptr),
         _jacobianSparsity(nullptr),
         _hessianSparsity(nullptr),
-        _hessianSparsity2(nullptr) {
+        _hessianSparsity2(nullptr),
+        _atomicFunctions(nullptr),
+        _atomicForward(nullptr),
+        _atomicReverse(nullptr),
+        _atomicLinkedFunctions(nullptr),
+        _precomputeParameters(nullptr),
+        _parameterInfo(nullptr),
+        _parameterCacheZero(0),
+        _parameterCacheJac(0),
+        _parameterCacheHess(0),
+        _parameterCacheValid(false) {
 
     }
 
@@ -932,6 +1088,9 @@ protected:
         _sparseReverseTwo = reinterpret_cast<decltype(_sparseReverseTwo)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_SPARSE_REVERSE_TWO, false));
         _sparseJacobian = reinterpret_cast<decltype(_sparseJacobian)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_SPARSE_JACOBIAN, false));
         _sparseHessian = reinterpret_cast<decltype(_sparseHessian)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_SPARSE_HESSIAN, false));
+        _zeroFloat = reinterpret_cast<decltype(_zeroFloat)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_FORWAD_ZERO + ModelCSourceGen<Base>::SINGLE_PRECISION_SUFFIX, false));
+        _sparseJacobianFloat = reinterpret_cast<decltype(_sparseJacobianFloat)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_SPARSE_JACOBIAN + ModelCSourceGen<Base>::SINGLE_PRECISION_SUFFIX, false));
+        _sparseHessianFloat = reinterpret_cast<decltype(_sparseHessianFloat)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_SPARSE_HESSIAN + ModelCSourceGen<Base>::SINGLE_PRECISION_SUFFIX, false));
         _forwardOneSparsity = reinterpret_cast<decltype(_forwardOneSparsity)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_FORWARD_ONE_SPARSITY, false));
         _reverseOneSparsity = reinterpret_cast<decltype(_reverseOneSparsity)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_REVERSE_ONE_SPARSITY, false));
         _reverseTwoSparsity = reinterpret_cast<decltype(_reverseTwoSparsity)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_REVERSE_TWO_SPARSITY, false));
@@ -939,6 +1098,11 @@ protected:
         _hessianSparsity = reinterpret_cast<decltype(_hessianSparsity)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_HESSIAN_SPARSITY, false));
         _hessianSparsity2 = reinterpret_cast<decltype(_hessianSparsity2)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_HESSIAN_SPARSITY2, false));
         _atomicFunctions = reinterpret_cast<decltype(_atomicFunctions)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_ATOMIC_FUNC_NAMES, true));
+        _atomicForward = reinterpret_cast<decltype(_atomicForward)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_ATOMIC_FORWARD, false));
+        _atomicReverse = reinterpret_cast<decltype(_atomicReverse)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_ATOMIC_REVERSE, false));
+        _atomicLinkedFunctions = reinterpret_cast<decltype(_atomicLinkedFunctions)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_ATOMIC_LINKED, false));
+        _precomputeParameters = reinterpret_cast<decltype(_precomputeParameters)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_PRECOMPUTE_PARAMETERS, false));
+        _parameterInfo = reinterpret_cast<decltype(_parameterInfo)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_PARAMETER_INFO, false));
 
         CPPADCG_ASSERT_KNOWN((_sparseForwardOne == nullptr) == (_forwardOneSparsity == nullptr), "Missing functions in the dynamic library");
         CPPADCG_ASSERT_KNOWN((_sparseForwardOne == nullptr) == (_forwardOne == nullptr), "Missing functions in the dynamic library");
@@ -948,6 +1112,38 @@ protected:
         CPPADCG_ASSERT_KNOWN((_sparseReverseTwo == nullptr) == (_reverseTwo == nullptr), "Missing functions in the dynamic library");
         CPPADCG_ASSERT_KNOWN((_sparseJacobian == nullptr) || (_jacobianSparsity != nullptr), "Missing functions in the dynamic library");
         CPPADCG_ASSERT_KNOWN((_sparseHessian == nullptr) || (_hessianSparsity != nullptr), "Missing functions in the dynamic library");
+        CPPADCG_ASSERT_KNOWN((_sparseJacobianFloat == nullptr) || (_jacobianSparsity != nullptr), "Missing functions in the dynamic library");
+        CPPADCG_ASSERT_KNOWN((_sparseHessianFloat == nullptr) || (_hessianSparsity != nullptr), "Missing functions in the dynamic library");
+        CPPADCG_ASSERT_KNOWN((_atomicForward == nullptr) == (_atomicReverse == nullptr), "Missing functions in the dynamic library");
+        CPPADCG_ASSERT_KNOWN((_atomicForward == nullptr) == (_atomicLinkedFunctions == nullptr), "Missing functions in the dynamic library");
+        CPPADCG_ASSERT_KNOWN((_precomputeParameters == nullptr) == (_parameterInfo == nullptr), "Missing functions in the dynamic library");
+
+        /**
+         * Prepare the parameter cache
+         */
+        _parameterCacheValid = false;
+        if (_parameterInfo != nullptr) {
+            unsigned long const* indexes;
+            unsigned long nParam;
+            unsigned long cacheSize;
+            const char** functions;
+            unsigned long const* offsets;
+            unsigned long nFunctions;
+            (*_parameterInfo)(&indexes, &nParam, &cacheSize, &functions, &offsets, &nFunctions);
+            _parameterIndexes.assign(indexes, indexes + nParam);
+            _parameterValues.resize(nParam);
+            _parameterCache.resize(cacheSize);
+
+            for (unsigned long f = 0; f < nFunctions; f++) {
+                if (functions[f] == ModelCSourceGen<Base>::FUNCTION_FORWAD_ZERO) {
+                    _parameterCacheZero = offsets[f];
+                } else if (functions[f] == ModelCSourceGen<Base>::FUNCTION_SPARSE_JACOBIAN) {
+                    _parameterCacheJac = offsets[f];
+                } else if (functions[f] == ModelCSourceGen<Base>::FUNCTION_SPARSE_HESSIAN) {
+                    _parameterCacheHess = offsets[f];
+                }
+            }
+        }
 
         /**
          * Prepare the atomic functions argument
@@ -961,11 +1157,37 @@ protected:
             _atomicNames[i] = std::string(names[i]);
         }
 
-        _atomicFuncArg.libModel = this;
-        _atomicFuncArg.forward = &atomicForward;
-        _atomicFuncArg.reverse = &atomicReverse;
+        _atomicCallbackArg.libModel = this;
+        _atomicCallbackArg.forward = &atomicForward;
+        _atomicCallbackArg.reverse = &atomicReverse;
 
         _missingAtomicFunctions = n;
+        _atomicLinked.assign(n, false);
+
+        if (_atomicLinkedFunctions != nullptr) {
+            /**
+             * some atomic functions are other models in the same library
+             * which are called directly by the compiled code
+             */
+            int const* linked;
+            unsigned long nLinked;
+            (*_atomicLinkedFunctions)(&linked, &nLinked);
+            CPPADCG_ASSERT_KNOWN(nLinked == n, "Invalid number of atomic functions in the dynamic library");
+
+            for (unsigned long i = 0; i < n; ++i) {
+                if (linked[i] != 0) {
+                    _atomicLinked[i] = true;
+                    _missingAtomicFunctions--;
+                }
+            }
+
+            // the remaining atomic functions are evaluated through the usual callbacks
+            _atomicFuncArg.libModel = &_atomicCallbackArg;
+            _atomicFuncArg.forward = _atomicForward;
+            _atomicFuncArg.reverse = _atomicReverse;
+        } else {
+            _atomicFuncArg = _atomicCallbackArg;
+        }
     }
 
     template <class VectorSet>
@@ -1028,6 +1250,56 @@ protected:
         _jacobianSparsity = nullptr;
         _hessianSparsity = nullptr;
         _hessianSparsity2 = nullptr;
+        _atomicFunctions = nullptr;
+        _atomicForward = nullptr;
+        _atomicReverse = nullptr;
+        _atomicLinkedFunctions = nullptr;
+        _precomputeParameters = nullptr;
+        _parameterInfo = nullptr;
+        _parameterCacheZero = 0;
+        _parameterCacheJac = 0;
+        _parameterCacheHess = 0;
+        _parameterCacheValid = false;
+    }
+
+    /**
+     * Provides the input arrays for a model function which might use the
+     * parameter cache.
+     * The cache is reevaluated only if the parameter values changed since
+     * its last evaluation.
+     *
+     * @param in the input arrays (the first array must be the independent
+     *           variables)
+     * @param nIn the number of input arrays used by the model function
+     * @param offset the location in the cache of the values used by the
+     *               model function
+     * @return the input arrays with the parameter cache as the last array
+     *         (if required)
+     */
+    inline Base const*const* parameterCachedInput(const std::vector<const Base*>& in,
+                                                  size_t nIn,
+                                                  size_t offset) {
+        if (_precomputeParameters == nullptr)
+            return &in[0];
+
+        const Base* x = in[0];
+        bool changed = !_parameterCacheValid;
+        for (size_t k = 0; k < _parameterIndexes.size(); ++k) {
+            const Base& v = x[_parameterIndexes[k]];
+            if (_parameterValues[k] != v) {
+                _parameterValues[k] = v;
+                changed = true;
+            }
+        }
+
+        if (changed) {
+            (*_precomputeParameters)(&in[0], _parameterCache.data(), _atomicFuncArg);
+            _parameterCacheValid = true;
+        }
+
+        _inParam.assign(in.begin(), in.begin() + nIn);
+        _inParam.push_back(_parameterCache.data() + offset);
+        return &_inParam[0];
     }
 
 private:
@@ -1039,7 +1311,8 @@ private:
         for (size_t i = 0; i < n; i++) {
             if (name == _atomicNames[i]) {
                 if (_atomic[i] == nullptr) {
-                    _missingAtomicFunctions--;
+                    if (!_atomicLinked[i])
+                        _missingAtomicFunctions--;
                 } else {
                     delete _atomic[i];
                 }
@@ -1050,6 +1323,17 @@ private:
         return false;
     }
 
+    /**
+     * Whether or not a model provides the sparse versions of all the
+     * directional methods which it can evaluate
+     * (required by GenericModelExternalFunctionWrapper).
+     */
+    static inline bool isSparseDirectionalAvailable(GenericModel<Base>& model) {
+        return (model.isSparseForwardOneAvailable() || !model.isForwardOneAvailable()) &&
+                (model.isSparseReverseOneAvailable() || !model.isReverseOneAvailable()) &&
+                (model.isSparseReverseTwoAvailable() || !model.isReverseTwoAvailable());
+    }
+
     static int atomicForward(void* libModelIn,
                              int atomicIndex,
                              int q,
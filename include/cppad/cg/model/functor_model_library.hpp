@@ -42,6 +42,13 @@ protected:
     float (*_getThreadPoolGuidedMaxWork)();
     void (*_setThreadPoolNumberOfTimeMeas)(unsigned int n);
     unsigned int (*_getThreadPoolNumberOfTimeMeas)();
+    void (*_setThreadPoolAffinity)(int policy, const int* cpus, int n);
+    int (*_getThreadPoolAffinityPolicy)();
+    int (*_getThreadPoolAffinityCpus)(int* cpus, int max);
+    void (*_setThreadPoolStickyJobs)(int sticky);
+    int (*_isThreadPoolStickyJobs)();
+    void (*_setThreadPoolSpinWait)(unsigned int n);
+    unsigned int (*_getThreadPoolSpinWait)();
 public:
 
     std::set<std::string> getModelNames() override {
@@ -166,6 +173,55 @@ public:
         return 0;
     }
 
+    void setThreadPoolAffinity(ThreadPoolAffinityPolicy policy,
+                               const std::vector<int>& cpus = std::vector<int>()) override {
+        if (_setThreadPoolAffinity != nullptr) {
+            (*_setThreadPoolAffinity)(int(policy), cpus.data(), int(cpus.size()));
+        }
+    }
+
+    ThreadPoolAffinityPolicy getThreadPoolAffinityPolicy() const override {
+        if (_getThreadPoolAffinityPolicy != nullptr) {
+            return ThreadPoolAffinityPolicy((*_getThreadPoolAffinityPolicy)());
+        }
+        return ThreadPoolAffinityPolicy::NONE;
+    }
+
+    std::vector<int> getThreadPoolAffinityCpus() const override {
+        std::vector<int> cpus;
+        if (_getThreadPoolAffinityCpus != nullptr) {
+            cpus.resize((*_getThreadPoolAffinityCpus)(nullptr, 0));
+            (*_getThreadPoolAffinityCpus)(cpus.data(), int(cpus.size()));
+        }
+        return cpus;
+    }
+
+    void setThreadPoolStickyJobs(bool sticky) override {
+        if (_setThreadPoolStickyJobs != nullptr) {
+            (*_setThreadPoolStickyJobs)(int(sticky));
+        }
+    }
+
+    bool isThreadPoolStickyJobs() const override {
+        if (_isThreadPoolStickyJobs != nullptr) {
+            return bool((*_isThreadPoolStickyJobs)());
+        }
+        return false;
+    }
+
+    void setThreadPoolSpinWait(unsigned int iterations) override {
+        if (_setThreadPoolSpinWait != nullptr) {
+            (*_setThreadPoolSpinWait)(iterations);
+        }
+    }
+
+    unsigned int getThreadPoolSpinWait() const override {
+        if (_getThreadPoolSpinWait != nullptr) {
+            return (*_getThreadPoolSpinWait)();
+        }
+        return 0;
+    }
+
     inline virtual ~FunctorModelLibrary() = default;
 
 protected:
@@ -183,7 +239,14 @@ protected:
             _setThreadPoolGuidedMaxWork(nullptr),
             _getThreadPoolGuidedMaxWork(nullptr),
             _setThreadPoolNumberOfTimeMeas(nullptr),
-            _getThreadPoolNumberOfTimeMeas(nullptr) {
+            _getThreadPoolNumberOfTimeMeas(nullptr),
+            _setThreadPoolAffinity(nullptr),
+            _getThreadPoolAffinityPolicy(nullptr),
+            _getThreadPoolAffinityCpus(nullptr),
+            _setThreadPoolStickyJobs(nullptr),
+            _isThreadPoolStickyJobs(nullptr),
+            _setThreadPoolSpinWait(nullptr),
+            _getThreadPoolSpinWait(nullptr) {
     }
 
     inline void validate() {
@@ -233,6 +296,13 @@ protected:
         _getThreadPoolGuidedMaxWork = reinterpret_cast<decltype(_getThreadPoolGuidedMaxWork)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLGUIDEDMAXGROUPWORK, false));
         _setThreadPoolNumberOfTimeMeas = reinterpret_cast<decltype(_setThreadPoolNumberOfTimeMeas)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLNUMBEROFTIMEMEAS, false));
         _getThreadPoolNumberOfTimeMeas = reinterpret_cast<decltype(_getThreadPoolNumberOfTimeMeas)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLNUMBEROFTIMEMEAS, false));
+        _setThreadPoolAffinity = reinterpret_cast<decltype(_setThreadPoolAffinity)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLAFFINITY, false));
+        _getThreadPoolAffinityPolicy = reinterpret_cast<decltype(_getThreadPoolAffinityPolicy)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLAFFINITYPOLICY, false));
+        _getThreadPoolAffinityCpus = reinterpret_cast<decltype(_getThreadPoolAffinityCpus)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLAFFINITYCPUS, false));
+        _setThreadPoolStickyJobs = reinterpret_cast<decltype(_setThreadPoolStickyJobs)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLSTICKYJOBS, false));
+        _isThreadPoolStickyJobs = reinterpret_cast<decltype(_isThreadPoolStickyJobs)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_ISTHREADPOOLSTICKYJOBS, false));
+        _setThreadPoolSpinWait = reinterpret_cast<decltype(_setThreadPoolSpinWait)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLSPINWAIT, false));
+        _getThreadPoolSpinWait = reinterpret_cast<decltype(_getThreadPoolSpinWait)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLSPINWAIT, false));
 
         if(_setThreads != nullptr) {
             (*_setThreads)(std::thread::hardware_concurrency());
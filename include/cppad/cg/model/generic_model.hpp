@@ -744,6 +744,81 @@ public:
                                size_t const** row,
                                size_t const** col) = 0;
 
+    /***********************************************************************
+     *                        Single precision
+     **********************************************************************/
+
+    /**
+     * Determines whether or not the model can be evaluated with single
+     * precision (see ModelCSourceGen::setSinglePrecisionFunctions()).
+     */
+    virtual bool isForwardZeroFloatAvailable() {
+        return false;
+    }
+
+    /**
+     * Evaluates the dependent model variables (zero-order) using single
+     * precision.
+     *
+     * @param x The independent variable array (must have n elements)
+     * @param dep The dependent variable array (must have m elements)
+     */
+    virtual void ForwardZeroFloat(ArrayView<const float> x,
+                                  ArrayView<float> dep) {
+        throw CGException("No single precision model evaluation available for model '", getName(), "'");
+    }
+
+    /**
+     * Determines whether or not the sparse Jacobian can be evaluated with
+     * single precision (see ModelCSourceGen::setSinglePrecisionFunctions()).
+     */
+    virtual bool isSparseJacobianFloatAvailable() {
+        return false;
+    }
+
+    /**
+     * Calculates the sparse Jacobian using single precision.
+     *
+     * @param x The independent variable array (must have n elements)
+     * @param jac The values of the sparse Jacobian in the order provided by
+     *            row and col
+     * @param row The row indices of the Jacobian values
+     * @param col The column indices of the Jacobian values
+     */
+    virtual void SparseJacobianFloat(ArrayView<const float> x,
+                                     ArrayView<float> jac,
+                                     size_t const** row,
+                                     size_t const** col) {
+        throw CGException("No single precision sparse Jacobian available for model '", getName(), "'");
+    }
+
+    /**
+     * Determines whether or not the sparse Hessian can be evaluated with
+     * single precision (see ModelCSourceGen::setSinglePrecisionFunctions()).
+     */
+    virtual bool isSparseHessianFloatAvailable() {
+        return false;
+    }
+
+    /**
+     * Calculates the sparse weighted sum of the Hessians using single
+     * precision.
+     *
+     * @param x The independent variable array (must have n elements)
+     * @param w The equation multipliers (must have m elements)
+     * @param hess The values of the sparse Hessian in the order provided by
+     *             row and col
+     * @param row The row indices of the Hessian values
+     * @param col The column indices of the Hessian values
+     */
+    virtual void SparseHessianFloat(ArrayView<const float> x,
+                                    ArrayView<const float> w,
+                                    ArrayView<float> hess,
+                                    size_t const** row,
+                                    size_t const** col) {
+        throw CGException("No single precision sparse Hessian available for model '", getName(), "'");
+    }
+
     /**
      * Provides a wrapper for this compiled model allowing it to be used as
      * an atomic function. The model must not be deleted while the atomic
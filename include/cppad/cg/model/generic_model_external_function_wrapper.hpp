@@ -18,10 +18,29 @@
 namespace CppAD {
 namespace cg {
 
+/**
+ * Calls a generic model from the compiled code of another model.
+ *
+ * The arrays provided by the compiled code are passed directly to the
+ * sparse forward/reverse methods of the generic model.
+ * Intermediate buffers are only used when the layout of an array
+ * (dense or sparse) differs from the one expected by the generic model and,
+ * even then, only the non-zero elements are copied.
+ */
 template<class Base>
 class GenericModelExternalFunctionWrapper : public ExternalFunctionWrapper<Base> {
 private:
     GenericModel<Base>* model_;
+    /**
+     * used to provide a dense version of sparse arrays
+     */
+    std::vector<Base> denseX_;
+    std::vector<Base> densePy_;
+    /**
+     * used to provide indexes for dense arrays which are used as sparse
+     * arrays (0, 1, 2, ...)
+     */
+    std::vector<size_t> allIdx_;
 public:
 
     inline GenericModelExternalFunctionWrapper(GenericModel<Base>& model) :
@@ -36,8 +55,7 @@ public:
                          int p,
                          const Array tx[],
                          Array& ty) {
-        CPPADCG_ASSERT_KNOWN(!tx[0].sparse, "independent array must be dense");
-        ArrayView<const Base> x(static_cast<const Base*> (tx[0].data), tx[0].size);
+        ArrayView<const Base> x = asDense(tx[0], denseX_);
 
         CPPADCG_ASSERT_KNOWN(!ty.sparse, "dependent array must be dense");
         ArrayView<Base> y(static_cast<Base*> (ty.data), ty.size);
@@ -48,11 +66,10 @@ public:
             return true;
 
         } else if (p == 1) {
-            CPPADCG_ASSERT_KNOWN(tx[1].sparse, "independent Taylor array must be sparse");
-            Base* tx1 = static_cast<Base*> (tx[1].data);
+            const Base* tx1 = static_cast<const Base*> (tx[1].data);
 
             model_->ForwardOne(x,
-                               tx[1].nnz, tx[1].idx, tx1,
+                               nnz(tx[1]), indexes(tx[1]), tx1,
                                y);
             return true;
         }
@@ -65,31 +82,27 @@ public:
                          const Array tx[],
                          Array& px,
                          const Array py[]) {
-        CPPADCG_ASSERT_KNOWN(!tx[0].sparse, "independent array must be dense");
-        ArrayView<const Base> x(static_cast<const Base*> (tx[0].data), tx[0].size);
+        ArrayView<const Base> x = asDense(tx[0], denseX_);
 
         CPPADCG_ASSERT_KNOWN(!px.sparse, "independent partials array must be dense");
         ArrayView<Base> pxb(static_cast<Base*> (px.data), px.size);
 
         if (p == 0) {
-            CPPADCG_ASSERT_KNOWN(py[0].sparse, "dependent partials array must be sparse");
-            Base* pyb = static_cast<Base*> (py[0].data);
+            const Base* pyb = static_cast<const Base*> (py[0].data);
 
             model_->ReverseOne(x,
                                pxb,
-                               py[0].nnz, py[0].idx, pyb);
+                               nnz(py[0]), indexes(py[0]), pyb);
             return true;
 
         } else if (p == 1) {
-            CPPADCG_ASSERT_KNOWN(tx[1].sparse, "independent array must be sparse");
             const Base* tx1 = static_cast<const Base*> (tx[1].data);
             CPPADCG_ASSERT_KNOWN(py[0].sparse, "dependent partials array must be sparse");
             CPPADCG_ASSERT_KNOWN(py[0].nnz == 0, "first order dependent partials must be zero");
-            CPPADCG_ASSERT_KNOWN(!py[1].sparse, "independent partials array must be dense");
-            ArrayView<const Base> py2(static_cast<Base*> (py[1].data), py[1].size);
+            ArrayView<const Base> py2 = asDense(py[1], densePy_);
 
             model_->ReverseTwo(x,
-                               tx[1].nnz, tx[1].idx, tx1,
+                               nnz(tx[1]), indexes(tx[1]), tx1,
                                pxb,
                                py2);
             return true;
@@ -98,6 +111,51 @@ public:
         return false;
     }
 
+private:
+
+    /**
+     * Provides a dense view of an array.
+     * Dense arrays are used directly while the non-zeros of sparse arrays
+     * are copied into the provided buffer.
+     */
+    static inline ArrayView<const Base> asDense(const Array& a,
+                                                std::vector<Base>& buffer) {
+        const Base* values = static_cast<const Base*> (a.data);
+        if (!a.sparse) {
+            return ArrayView<const Base>(values, a.size);
+        }
+
+        buffer.resize(a.size);
+        std::fill(buffer.begin(), buffer.end(), Base(0));
+        for (size_t e = 0; e < a.nnz; e++) {
+            buffer[a.idx[e]] = values[e];
+        }
+        return ArrayView<const Base>(buffer.data(), buffer.size());
+    }
+
+    /**
+     * The number of elements of an array when used as a sparse array.
+     */
+    static inline size_t nnz(const Array& a) {
+        return a.sparse ? a.nnz : a.size;
+    }
+
+    /**
+     * The indexes of the elements of an array when used as a sparse array.
+     */
+    inline const size_t* indexes(const Array& a) {
+        if (a.sparse)
+            return a.idx;
+
+        if (allIdx_.size() < a.size) {
+            size_t j = allIdx_.size();
+            allIdx_.resize(a.size);
+            for (; j < a.size; j++)
+                allIdx_[j] = j;
+        }
+        return allIdx_.data();
+    }
+
 };
 
 } // END cg namespace
@@ -0,0 +1,622 @@
+#ifndef CPPAD_CG_HOT_SWAP_MODEL_INCLUDED
+#define CPPAD_CG_HOT_SWAP_MODEL_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A model which starts by evaluating an initial model which is available
+ * immediately (e.g. a BytecodeModel) while a model library is created in
+ * a background thread (e.g. with DynamicModelLibraryProcessor or with the
+ * LLVM JIT).
+ * Once the library is loaded, all the following calls are redirected to
+ * the compiled model.
+ *
+ * The initial model must use the same options as the compiled model
+ * (namely the same sparsity and custom sparse elements) and the compiled
+ * model must provide every function provided by the initial model,
+ * otherwise the compiled model is rejected and the initial model
+ * continues to be used.
+ *
+ * The objects used to create the library (the tape, the source generators,
+ * and the compiler) must not be used by other threads until the
+ * compilation finishes (see waitForCompiledModel()).
+ * Evaluations are not synchronized, just like for the other models, and
+ * therefore the same model must not be evaluated concurrently.
+ *
+ * The background thread only creates the library. The compiled model is
+ * loaded, compared with the initial model, and activated by the thread
+ * evaluating this model (in its next evaluation or in
+ * waitForCompiledModel()).
+ *
+ * Creating a library with CppADCodeGen uses CppAD in the background
+ * thread. CppAD must therefore be prepared for multiple threads before
+ * this model is created:
+ *  - thread_alloc::parallel_setup() must be called with a thread_num()
+ *    which distinguishes the background thread from the other threads
+ *    using CppAD and an in_parallel() which is true while the library is
+ *    created;
+ *  - parallel_ad<CG<Base> >() must be called.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class HotSwapModel : public GenericModel<Base> {
+public:
+    using LibraryCreator = std::function<std::unique_ptr<ModelLibrary<Base>>()>;
+protected:
+    const std::string _name;
+    // the model used until the compiled model is available
+    std::unique_ptr<GenericModel<Base> > _initial;
+    // the library with the compiled model (must outlive _compiled)
+    std::unique_ptr<ModelLibrary<Base> > _library;
+    // the compiled model
+    std::unique_ptr<GenericModel<Base> > _compiled;
+    // the library created by the background thread which was not used yet
+    std::unique_ptr<ModelLibrary<Base> > _createdLibrary;
+    // whether or not the created library must still be used
+    std::atomic<bool> _swapPending;
+    // the model currently used for evaluations
+    GenericModel<Base>* _active;
+    // atomic functions which must also be provided to the compiled model
+    std::vector<atomic_base<Base>*> _atomics;
+    std::vector<GenericModel<Base>*> _externalModels;
+    // compilation state
+    mutable std::mutex _mutex;
+    std::condition_variable _finishedCond;
+    bool _finished;
+    std::exception_ptr _error;
+    std::thread _thread;
+public:
+
+    /**
+     * Creates a new model which immediately starts using the initial model
+     * and the creation of the model library in a background thread.
+     *
+     * @param initialModel the model used while the library is not ready
+     * @param libraryCreator creates and loads the library containing a
+     *                       model with the same name as the initial model
+     */
+    inline HotSwapModel(std::unique_ptr<GenericModel<Base> > initialModel,
+                        LibraryCreator libraryCreator) :
+        _name(initialModel->getName()),
+        _initial(std::move(initialModel)),
+        _swapPending(false),
+        _active(_initial.get()),
+        _finished(false) {
+        _thread = std::thread(&HotSwapModel::createLibrary, this, std::move(libraryCreator));
+    }
+
+    /**
+     * Creates a new model which immediately starts using the initial model
+     * and the creation of a dynamic library in a background thread.
+     *
+     * @param initialModel the model used while the library is not ready
+     * @param processor creates the dynamic library (must only be deleted
+     *                  after the compilation finishes)
+     * @param compiler the compiler used to create the dynamic library
+     *                 (must only be deleted after the compilation finishes)
+     */
+    inline HotSwapModel(std::unique_ptr<GenericModel<Base> > initialModel,
+                        DynamicModelLibraryProcessor<Base>& processor,
+                        CCompiler<Base>& compiler) :
+        HotSwapModel(std::move(initialModel),
+                     [&processor, &compiler]() {
+                         return std::unique_ptr<ModelLibrary<Base> >(processor.createDynamicLibrary(compiler));
+                     }) {
+    }
+
+    HotSwapModel(const HotSwapModel& orig) = delete;
+    HotSwapModel& operator=(const HotSwapModel& rhs) = delete;
+
+    /**
+     * Waits for the background compilation to finish (it cannot be
+     * interrupted).
+     */
+    inline virtual ~HotSwapModel() {
+        if (_thread.joinable()) {
+            _thread.join();
+        }
+    }
+
+    /**
+     * @return true if the evaluations are already performed by the
+     *         compiled model
+     */
+    inline bool isUsingCompiledModel() const {
+        return _active != _initial.get();
+    }
+
+    /**
+     * @return true if the background compilation has finished (with or
+     *         without success)
+     */
+    inline bool isCompilationFinished() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _finished;
+    }
+
+    /**
+     * Blocks until the background compilation finishes and starts using
+     * the compiled model.
+     *
+     * @throws the exception thrown while creating the compiled model
+     */
+    inline void waitForCompiledModel() {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _finishedCond.wait(lock, [this] {
+                return _finished;
+            });
+        }
+
+        swapToCompiledModel();
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_error) {
+            std::rethrow_exception(_error);
+        }
+    }
+
+    inline GenericModel<Base>& getInitialModel() {
+        return *_initial;
+    }
+
+    /**
+     * @return the compiled model or nullptr if it is not available yet
+     */
+    inline GenericModel<Base>* getCompiledModel() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _compiled.get();
+    }
+
+    const std::string& getName() const override {
+        return _name;
+    }
+
+    size_t Domain() const override {
+        return _initial->Domain();
+    }
+
+    size_t Range() const override {
+        return _initial->Range();
+    }
+
+    const std::vector<std::string>& getAtomicFunctionNames() override {
+        return active().getAtomicFunctionNames();
+    }
+
+    bool addAtomicFunction(atomic_base<Base>& atomic) override {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_compiled != nullptr) {
+            return _compiled->addAtomicFunction(atomic);
+        }
+        _atomics.push_back(&atomic); // also added to the compiled model once it is loaded
+        return _initial->addAtomicFunction(atomic);
+    }
+
+    bool addExternalModel(GenericModel<Base>& atomic) override {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_compiled != nullptr) {
+            return _compiled->addExternalModel(atomic);
+        }
+        _externalModels.push_back(&atomic); // also added to the compiled model once it is loaded
+        return _initial->addExternalModel(atomic);
+    }
+
+    // Jacobian sparsity
+    bool isJacobianSparsityAvailable() override {
+        return active().isJacobianSparsityAvailable();
+    }
+
+    std::vector<std::set<size_t> > JacobianSparsitySet() override {
+        return active().JacobianSparsitySet();
+    }
+
+    std::vector<bool> JacobianSparsityBool() override {
+        return active().JacobianSparsityBool();
+    }
+
+    void JacobianSparsity(std::vector<size_t>& equations,
+                          std::vector<size_t>& variables) override {
+        active().JacobianSparsity(equations, variables);
+    }
+
+    // Hessian sparsity
+    bool isHessianSparsityAvailable() override {
+        return active().isHessianSparsityAvailable();
+    }
+
+    std::vector<std::set<size_t> > HessianSparsitySet() override {
+        return active().HessianSparsitySet();
+    }
+
+    std::vector<bool> HessianSparsityBool() override {
+        return active().HessianSparsityBool();
+    }
+
+    void HessianSparsity(std::vector<size_t>& rows,
+                         std::vector<size_t>& cols) override {
+        active().HessianSparsity(rows, cols);
+    }
+
+    bool isEquationHessianSparsityAvailable() override {
+        return active().isEquationHessianSparsityAvailable();
+    }
+
+    std::vector<std::set<size_t> > HessianSparsitySet(size_t i) override {
+        return active().HessianSparsitySet(i);
+    }
+
+    std::vector<bool> HessianSparsityBool(size_t i) override {
+        return active().HessianSparsityBool(i);
+    }
+
+    void HessianSparsity(size_t i,
+                         std::vector<size_t>& rows,
+                         std::vector<size_t>& cols) override {
+        active().HessianSparsity(i, rows, cols);
+    }
+
+    /// zero order
+    bool isForwardZeroAvailable() override {
+        return active().isForwardZeroAvailable();
+    }
+
+    void ForwardZero(const CppAD::vector<bool>& vx,
+                     CppAD::vector<bool>& vy,
+                     ArrayView<const Base> tx,
+                     ArrayView<Base> ty) override {
+        active().ForwardZero(vx, vy, tx, ty);
+    }
+
+    void ForwardZero(ArrayView<const Base> x,
+                     ArrayView<Base> dep) override {
+        active().ForwardZero(x, dep);
+    }
+
+    void ForwardZero(const std::vector<const Base*>& x,
+                     ArrayView<Base> dep) override {
+        active().ForwardZero(x, dep);
+    }
+
+    /// dense Jacobian and Hessian
+    bool isJacobianAvailable() override {
+        return active().isJacobianAvailable();
+    }
+
+    void Jacobian(ArrayView<const Base> x,
+                  ArrayView<Base> jac) override {
+        active().Jacobian(x, jac);
+    }
+
+    bool isHessianAvailable() override {
+        return active().isHessianAvailable();
+    }
+
+    void Hessian(ArrayView<const Base> x,
+                 ArrayView<const Base> w,
+                 ArrayView<Base> hess) override {
+        active().Hessian(x, w, hess);
+    }
+
+    /// directional derivatives
+    bool isForwardOneAvailable() override {
+        return active().isForwardOneAvailable();
+    }
+
+    void ForwardOne(ArrayView<const Base> tx,
+                    ArrayView<Base> ty) override {
+        active().ForwardOne(tx, ty);
+    }
+
+    bool isSparseForwardOneAvailable() override {
+        return active().isSparseForwardOneAvailable();
+    }
+
+    void ForwardOne(ArrayView<const Base> x,
+                    size_t tx1Nnz, const size_t idx[], const Base tx1[],
+                    ArrayView<Base> ty1) override {
+        active().ForwardOne(x, tx1Nnz, idx, tx1, ty1);
+    }
+
+    bool isReverseOneAvailable() override {
+        return active().isReverseOneAvailable();
+    }
+
+    void ReverseOne(ArrayView<const Base> tx,
+                    ArrayView<const Base> ty,
+                    ArrayView<Base> px,
+                    ArrayView<const Base> py) override {
+        active().ReverseOne(tx, ty, px, py);
+    }
+
+    bool isSparseReverseOneAvailable() override {
+        return active().isSparseReverseOneAvailable();
+    }
+
+    void ReverseOne(ArrayView<const Base> x,
+                    ArrayView<Base> px,
+                    size_t pyNnz, const size_t idx[], const Base py[]) override {
+        active().ReverseOne(x, px, pyNnz, idx, py);
+    }
+
+    bool isReverseTwoAvailable() override {
+        return active().isReverseTwoAvailable();
+    }
+
+    void ReverseTwo(ArrayView<const Base> tx,
+                    ArrayView<const Base> ty,
+                    ArrayView<Base> px,
+                    ArrayView<const Base> py) override {
+        active().ReverseTwo(tx, ty, px, py);
+    }
+
+    bool isSparseReverseTwoAvailable() override {
+        return active().isSparseReverseTwoAvailable();
+    }
+
+    void ReverseTwo(ArrayView<const Base> x,
+                    size_t tx1Nnz, const size_t idx[], const Base tx1[],
+                    ArrayView<Base> px2,
+                    ArrayView<const Base> py2) override {
+        active().ReverseTwo(x, tx1Nnz, idx, tx1, px2, py2);
+    }
+
+    /// sparse Jacobian
+    bool isSparseJacobianAvailable() override {
+        return active().isSparseJacobianAvailable();
+    }
+
+    void SparseJacobian(ArrayView<const Base> x,
+                        ArrayView<Base> jac) override {
+        active().SparseJacobian(x, jac);
+    }
+
+    void SparseJacobian(const std::vector<Base>& x,
+                        std::vector<Base>& jac,
+                        std::vector<size_t>& row,
+                        std::vector<size_t>& col) override {
+        active().SparseJacobian(x, jac, row, col);
+    }
+
+    void SparseJacobian(ArrayView<const Base> x,
+                        ArrayView<Base> jac,
+                        size_t const** row,
+                        size_t const** col) override {
+        active().SparseJacobian(x, jac, row, col);
+    }
+
+    void SparseJacobian(const std::vector<const Base*>& x,
+                        ArrayView<Base> jac,
+                        size_t const** row,
+                        size_t const** col) override {
+        active().SparseJacobian(x, jac, row, col);
+    }
+
+    /// sparse Hessian
+    bool isSparseHessianAvailable() override {
+        return active().isSparseHessianAvailable();
+    }
+
+    void SparseHessian(ArrayView<const Base> x,
+                       ArrayView<const Base> w,
+                       ArrayView<Base> hess) override {
+        active().SparseHessian(x, w, hess);
+    }
+
+    void SparseHessian(const std::vector<Base>& x,
+                       const std::vector<Base>& w,
+                       std::vector<Base>& hess,
+                       std::vector<size_t>& row,
+                       std::vector<size_t>& col) override {
+        active().SparseHessian(x, w, hess, row, col);
+    }
+
+    void SparseHessian(ArrayView<const Base> x,
+                       ArrayView<const Base> w,
+                       ArrayView<Base> hess,
+                       size_t const** row,
+                       size_t const** col) override {
+        active().SparseHessian(x, w, hess, row, col);
+    }
+
+    void SparseHessian(const std::vector<const Base*>& x,
+                       ArrayView<const Base> w,
+                       ArrayView<Base> hess,
+                       size_t const** row,
+                       size_t const** col) override {
+        active().SparseHessian(x, w, hess, row, col);
+    }
+
+    /// single precision evaluations
+    bool isForwardZeroFloatAvailable() override {
+        return active().isForwardZeroFloatAvailable();
+    }
+
+    void ForwardZeroFloat(ArrayView<const float> x,
+                          ArrayView<float> dep) override {
+        active().ForwardZeroFloat(x, dep);
+    }
+
+    bool isSparseJacobianFloatAvailable() override {
+        return active().isSparseJacobianFloatAvailable();
+    }
+
+    void SparseJacobianFloat(ArrayView<const float> x,
+                             ArrayView<float> jac,
+                             size_t const** row,
+                             size_t const** col) override {
+        active().SparseJacobianFloat(x, jac, row, col);
+    }
+
+    bool isSparseHessianFloatAvailable() override {
+        return active().isSparseHessianFloatAvailable();
+    }
+
+    void SparseHessianFloat(ArrayView<const float> x,
+                            ArrayView<const float> w,
+                            ArrayView<float> hess,
+                            size_t const** row,
+                            size_t const** col) override {
+        active().SparseHessianFloat(x, w, hess, row, col);
+    }
+
+protected:
+
+    inline GenericModel<Base>& active() {
+        if (_swapPending.load(std::memory_order_acquire)) {
+            swapToCompiledModel();
+        }
+        return *_active;
+    }
+
+    /**
+     * Executed by the background thread
+     */
+    inline void createLibrary(LibraryCreator libraryCreator) {
+        try {
+            std::unique_ptr<ModelLibrary<Base> > library = libraryCreator();
+            if (library == nullptr) {
+                throw CGException("Failed to create the library for model '", _name, "'");
+            }
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            _createdLibrary = std::move(library);
+            _swapPending.store(true, std::memory_order_release);
+
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _error = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _finished = true;
+        }
+        _finishedCond.notify_all();
+    }
+
+    /**
+     * Loads the compiled model from the created library and starts using
+     * it.
+     * Executed by the thread evaluating this model since the initial model
+     * is also used.
+     */
+    inline void swapToCompiledModel() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_swapPending.load(std::memory_order_relaxed))
+            return;
+        _swapPending.store(false, std::memory_order_relaxed);
+
+        std::unique_ptr<ModelLibrary<Base> > library = std::move(_createdLibrary);
+        try {
+            std::unique_ptr<GenericModel<Base> > compiled = library->model(_name);
+            if (compiled == nullptr) {
+                throw CGException("Model '", _name, "' not found in the compiled library");
+            }
+
+            checkCompatibility(*compiled);
+
+            for (atomic_base<Base>* atomic : _atomics) {
+                compiled->addAtomicFunction(*atomic);
+            }
+            for (GenericModel<Base>* external : _externalModels) {
+                compiled->addExternalModel(*external);
+            }
+
+            _library = std::move(library);
+            _compiled = std::move(compiled);
+            _active = _compiled.get();
+
+        } catch (...) {
+            _error = std::current_exception(); // the initial model continues to be used
+        }
+    }
+
+    /**
+     * Makes sure that the results from the compiled model are provided
+     * in the same format as the initial model.
+     */
+    inline void checkCompatibility(GenericModel<Base>& compiled) {
+        GenericModel<Base>& initial = *_initial;
+
+        if (compiled.Domain() != initial.Domain() || compiled.Range() != initial.Range()) {
+            throw CGException("The compiled model '", _name, "' has different dimensions from the initial model");
+        }
+
+        using Available = bool (GenericModel<Base>::*)();
+        const std::pair<Available, const char*> functions[] = {
+                {&GenericModel<Base>::isJacobianSparsityAvailable, "the Jacobian sparsity"},
+                {&GenericModel<Base>::isHessianSparsityAvailable, "the Hessian sparsity"},
+                {&GenericModel<Base>::isEquationHessianSparsityAvailable, "the equation Hessian sparsity"},
+                {&GenericModel<Base>::isForwardZeroAvailable, "ForwardZero"},
+                {&GenericModel<Base>::isJacobianAvailable, "Jacobian"},
+                {&GenericModel<Base>::isHessianAvailable, "Hessian"},
+                {&GenericModel<Base>::isForwardOneAvailable, "ForwardOne"},
+                {&GenericModel<Base>::isSparseForwardOneAvailable, "sparse ForwardOne"},
+                {&GenericModel<Base>::isReverseOneAvailable, "ReverseOne"},
+                {&GenericModel<Base>::isSparseReverseOneAvailable, "sparse ReverseOne"},
+                {&GenericModel<Base>::isReverseTwoAvailable, "ReverseTwo"},
+                {&GenericModel<Base>::isSparseReverseTwoAvailable, "sparse ReverseTwo"},
+                {&GenericModel<Base>::isSparseJacobianAvailable, "SparseJacobian"},
+                {&GenericModel<Base>::isSparseHessianAvailable, "SparseHessian"},
+                {&GenericModel<Base>::isForwardZeroFloatAvailable, "ForwardZero in single precision"},
+                {&GenericModel<Base>::isSparseJacobianFloatAvailable, "SparseJacobian in single precision"},
+                {&GenericModel<Base>::isSparseHessianFloatAvailable, "SparseHessian in single precision"}
+        };
+
+        for (const auto& f : functions) {
+            if ((initial.*f.first)() && !(compiled.*f.first)()) {
+                throw CGException("The compiled model '", _name, "' does not provide ", f.second, " like the initial model");
+            }
+        }
+
+        std::vector<size_t> rows1, cols1, rows2, cols2;
+        if (initial.isJacobianSparsityAvailable()) {
+            compiled.JacobianSparsity(rows1, cols1);
+            initial.JacobianSparsity(rows2, cols2);
+            if (rows1 != rows2 || cols1 != cols2) {
+                throw CGException("The compiled model '", _name, "' has a different Jacobian sparsity from the initial model");
+            }
+        }
+
+        if (initial.isHessianSparsityAvailable()) {
+            compiled.HessianSparsity(rows1, cols1);
+            initial.HessianSparsity(rows2, cols2);
+            if (rows1 != rows2 || cols1 != cols2) {
+                throw CGException("The compiled model '", _name, "' has a different Hessian sparsity from the initial model");
+            }
+        }
+
+        if (initial.isEquationHessianSparsityAvailable()) {
+            for (size_t i = 0; i < initial.Range(); i++) {
+                compiled.HessianSparsity(i, rows1, cols1);
+                initial.HessianSparsity(i, rows2, cols2);
+                if (rows1 != rows2 || cols1 != cols2) {
+                    throw CGException("The compiled model '", _name, "' has a different Hessian sparsity for equation ", i, " from the initial model");
+                }
+            }
+        }
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
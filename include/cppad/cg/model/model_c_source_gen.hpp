@@ -59,8 +59,22 @@ public:
     static const std::string FUNCTION_REVERSE_TWO_SPARSITY;
     static const std::string FUNCTION_INFO;
     static const std::string FUNCTION_ATOMIC_FUNC_NAMES;
+    static const std::string FUNCTION_DIRECT_FORWARD;
+    static const std::string FUNCTION_DIRECT_REVERSE;
+    static const std::string FUNCTION_ATOMIC_FORWARD;
+    static const std::string FUNCTION_ATOMIC_REVERSE;
+    static const std::string FUNCTION_ATOMIC_LINKED;
+    static const std::string FUNCTION_PRECOMPUTE_PARAMETERS;
+    static const std::string FUNCTION_PARAMETER_INFO;
+    static const std::string SINGLE_PRECISION_SUFFIX;
 protected:
     static const std::string CONST;
+    static const std::string PARAMETER_CACHE_NAME;
+    /**
+     * rough estimate of the time (in seconds) for an operation with a
+     * unit cost (used before the elapsed times of the jobs are measured)
+     */
+    static const double ESTIMATED_SECONDS_PER_COST;
 
     /**
      * Useful class for storing matrix indexes
@@ -164,12 +178,41 @@ protected:
      * Typical values of the independent vector
      */
     std::vector<Base> _x;
+    /**
+     * Independent variables which are replaced by constant values in the
+     * generated source code (maps the independent index to its value)
+     */
+    std::map<size_t, Base> _frozenIndep;
+    /**
+     * Independent variables which are considered parameters (rarely
+     * changed) and whose dependent operations are cached
+     */
+    std::set<size_t> _parameterIndep;
+    /**
+     * The model functions (e.g. FUNCTION_SPARSE_JACOBIAN) which use cached
+     * parameter dependent values and the number of cached values for each
+     * one of them (their values are stored consecutively in the cache)
+     */
+    std::vector<std::pair<std::string, size_t> > _parameterCacheFunctions;
     /**
      * Whether or not to enable the generation of multithreaded code for the
      * sparse Jacobian and sparse Hessian if possible and requested by the
      * model library (experimental).
      */
     bool _multiThreading;
+    /**
+     * the maximum number of jobs submitted to the thread pool in each call
+     * (zero for one job per function)
+     */
+    size_t _maxMultiThreadingJobs;
+    /**
+     * the minimum estimated cost of a job submitted to the thread pool
+     */
+    double _minMultiThreadingJobCost;
+    /**
+     * the estimated cost of the generated functions
+     */
+    std::map<std::string, double> _functionCosts;
     /// generate source code for the zero order model evaluation
     bool _zero;
     bool _zeroEvaluated;
@@ -233,6 +276,42 @@ protected:
      * maximum number of assignments per function (~ lines)
      */
     size_t _maxAssignPerFunc;
+    /**
+     * whether or not to apply algebraic simplifications to the operation
+     * graphs before generating source code
+     */
+    bool _simplifyOperations;
+    /**
+     * whether or not the simplifications replace divisions by constants
+     * with multiplications
+     */
+    bool _divByConstAsMult;
+    /**
+     * whether or not transcendental functions with the same argument are
+     * evaluated together in the generated code
+     */
+    bool _fuseTranscendentals;
+    /**
+     * whether or not functions are split where few temporary variables
+     * are alive
+     */
+    bool _splitMinimizeLive;
+    /**
+     * functions expected to be evaluated often (e.g. "forward_zero")
+     */
+    std::set<std::string> _hotFunctions;
+    /**
+     * table for the long constant values (not owned)
+     */
+    LangCConstantPool* _constantPool;
+    /**
+     * whether or not the loops are prepared to be vectorized
+     */
+    bool _vectorizeLoops;
+    /**
+     * functions which are also generated with single precision
+     */
+    std::set<std::string> _singlePrecisionFunctions;
     /**
      *
      */
@@ -292,6 +371,8 @@ public:
         _baseTypeName(ModelCSourceGen<Base>::baseTypeName()),
         _parameterPrecision(std::numeric_limits<Base>::digits10),
         _multiThreading(true),
+        _maxMultiThreadingJobs(256),
+        _minMultiThreadingJobCost(0),
         _zero(true),
         _zeroEvaluated(false),
         _jacobian(false),
@@ -307,6 +388,12 @@ public:
         _jacMode(JacobianADMode::Automatic),
         _atomicsInfo(nullptr),
         _maxAssignPerFunc(20000),
+        _simplifyOperations(false),
+        _divByConstAsMult(false),
+        _fuseTranscendentals(false),
+        _splitMinimizeLive(false),
+        _constantPool(nullptr),
+        _vectorizeLoops(false),
         _jobTimer(nullptr) {
 
         CPPADCG_ASSERT_KNOWN(!_name.empty(), "Model name cannot be empty");
@@ -353,6 +440,93 @@ public:
         }
     }
 
+    /**
+     * Provides the typical values for the independent variable vector.
+     *
+     * @return the typical values (empty if none were defined)
+     */
+    inline const std::vector<Base>& getTypicalIndependentValues() const {
+        return _x;
+    }
+
+    /**
+     * Defines an independent variable as frozen, meaning that it is
+     * replaced by a constant value in the generated source code.
+     * All the operations which only depend on frozen independent variables
+     * are evaluated during the source generation and are not present in
+     * the generated code.
+     * The values provided at runtime for frozen independent variables are
+     * ignored, however the dimension of the independent vector is not
+     * changed and derivative information is still generated for them
+     * (evaluated at the frozen value).
+     * Frozen independent variables cannot be used with loop detection.
+     *
+     * @param j the index of the independent variable
+     * @param value the constant value used for the independent variable
+     */
+    inline void setFrozenIndependent(size_t j, const Base& value) {
+        CPPADCG_ASSERT_KNOWN(j < _fun.Domain(), "Invalid independent variable index");
+        _frozenIndep[j] = value;
+    }
+
+    /**
+     * Defines several independent variables as frozen (replaced by
+     * constant values in the generated source code).
+     * Any previously defined frozen independent variables are removed.
+     *
+     * @param values maps the independent variable indexes to their values
+     */
+    inline void setFrozenIndependents(const std::map<size_t, Base>& values) {
+        _frozenIndep.clear();
+        for (const auto& it : values) {
+            setFrozenIndependent(it.first, it.second);
+        }
+    }
+
+    /**
+     * Provides the independent variables which are replaced by constant
+     * values in the generated source code.
+     *
+     * @return maps the independent variable indexes to their values
+     */
+    inline const std::map<size_t, Base>& getFrozenIndependents() const {
+        return _frozenIndep;
+    }
+
+    /**
+     * Defines which independent variables are parameters, which are
+     * expected to change much less often than the remaining independent
+     * variables (states).
+     * The operations in the zero order forward mode, sparse Jacobian, and
+     * sparse Hessian which only depend on parameters are moved into a
+     * separate function which fills a cache
+     * (FUNCTION_PRECOMPUTE_PARAMETERS) and the cache is then used by those
+     * functions.
+     * FunctorGenericModel only updates the cache when the values of the
+     * parameters change.
+     * When parameters are defined, the sparse Jacobian and the sparse
+     * Hessian do not reuse the directional functions and multithreading
+     * is not used for them.
+     * Parameters cannot be used with loop detection.
+     *
+     * @param params the indexes of the parameters in the independent vector
+     */
+    inline void setParameterIndependents(const std::set<size_t>& params) {
+        for (size_t j : params) {
+            CPPADCG_ASSERT_KNOWN(j < _fun.Domain(), "Invalid independent variable index");
+        }
+        _parameterIndep = params;
+    }
+
+    /**
+     * Provides the independent variables which are considered parameters.
+     *
+     * @return the indexes of the parameters in the independent vector
+     */
+    inline const std::set<size_t>& getParameterIndependents() const {
+        return _parameterIndep;
+    }
+
     inline void setRelatedDependents(const std::vector<std::set<size_t> >& relatedDepCandidates) {
         _relatedDepCandidates = relatedDepCandidates;
     }
@@ -414,12 +588,52 @@ public:
         _multiThreading = multiThreading;
     }
 
+    inline size_t getMaxMultiThreadingJobs() const {
+        return _maxMultiThreadingJobs;
+    }
+
+    /**
+     * Defines the maximum number of jobs submitted to the thread pool
+     * (PThreads) by each call to the sparse Jacobian or sparse Hessian.
+     * Consecutive functions are grouped into jobs with similar numbers of
+     * functions.
+     * The job arguments are placed in the stack of the calling thread and
+     * therefore a very large number of jobs should be avoided.
+     *
+     * @param maxJobs the maximum number of jobs per call or zero to
+     *                use one job per function
+     */
+    inline void setMaxMultiThreadingJobs(size_t maxJobs) {
+        _maxMultiThreadingJobs = maxJobs;
+    }
+
+    inline double getMinMultiThreadingJobCost() const {
+        return _minMultiThreadingJobCost;
+    }
+
+    /**
+     * Defines the minimum estimated cost of a job submitted to the thread
+     * pool (PThreads) by the sparse Jacobian or sparse Hessian.
+     * The cost of each function is estimated from the operations it
+     * evaluates (an addition has a cost of 1, see getOperationCost()) and
+     * small functions are grouped so that the dispatch overhead is not
+     * larger than the work performed by each job.
+     *
+     * By default the cost is not used (zero).
+     *
+     * @param minCost the minimum cost of a job (zero to only use the
+     *                maximum number of jobs)
+     */
+    inline void setMinMultiThreadingJobCost(double minCost) {
+        _minMultiThreadingJobCost = minCost;
+    }
+
     inline bool isJacobianMultiThreadingEnabled() const {
-        return _multiThreading && _loopTapes.empty() && _sparseJacobian && _sparseJacobianReusesOne && (_forwardOne || _reverseOne);
+        return _multiThreading && _loopTapes.empty() && _parameterIndep.empty() && _sparseJacobian && _sparseJacobianReusesOne && (_forwardOne || _reverseOne);
     }
 
     inline bool isHessianMultiThreadingEnabled() const {
-        return _multiThreading && _loopTapes.empty() && _sparseHessian && _sparseHessianReusesRev2 && _reverseTwo;
+        return _multiThreading && _loopTapes.empty() && _parameterIndep.empty() && _sparseHessian && _sparseHessianReusesRev2 && _reverseTwo;
     }
 
     /**
@@ -811,6 +1025,194 @@ public:
         _maxAssignPerFunc = maxAssignPerFunc;
     }
 
+    inline bool isSplitMinimizingLiveVariables() const {
+        return _splitMinimizeLive;
+    }
+
+    /**
+     * Defines whether or not large functions are split into smaller
+     * functions at positions where few temporary variables are required
+     * by the following functions (instead of only using the maximum number
+     * of assignments per function).
+     * A suitable maximum number of assignments per function can be
+     * determined with AbstractCCompiler::measureMaxAssignmentsPerFunction().
+     *
+     * @param minimize true to minimize the variables shared between functions
+     * @see LanguageC::setSplitMinimizingLiveVariables()
+     */
+    inline void setSplitMinimizingLiveVariables(bool minimize) {
+        _splitMinimizeLive = minimize;
+    }
+
+    inline LangCConstantPool* getConstantPool() const {
+        return _constantPool;
+    }
+
+    /**
+     * Defines the table where long constant values used by the generated
+     * source code are saved.
+     * This is usually defined by ModelLibraryCSourceGen so that a single
+     * table is shared by all the models in a library.
+     *
+     * @param pool the constant table (not owned) or nullptr to print all
+     *             values directly in the generated code
+     * @see LanguageC::setConstantPool()
+     */
+    inline void setConstantPool(LangCConstantPool* pool) {
+        _constantPool = pool;
+    }
+
+    inline bool isVectorizeLoops() const {
+        return _vectorizeLoops;
+    }
+
+    /**
+     * Defines whether or not the loops created for repeated patterns
+     * (see setRelatedDependents()) are prepared to be vectorized by the
+     * compiler.
+     *
+     * @param vectorize true to annotate the loops and arrays
+     * @see LanguageC::setVectorizeLoops()
+     */
+    inline void setVectorizeLoops(bool vectorize) {
+        _vectorizeLoops = vectorize;
+    }
+
+    inline bool isSimplifyOperations() const {
+        return _simplifyOperations;
+    }
+
+    /**
+     * Defines whether or not to apply algebraic simplifications (constant
+     * folding, removal of identities, and strength reduction of pow) to the
+     * operation graphs before generating the source code.
+     *
+     * @param simplify true to enable the simplifications
+     * @see CodeHandler::setSimplifyOperations()
+     */
+    inline void setSimplifyOperations(bool simplify) {
+        _simplifyOperations = simplify;
+    }
+
+    inline bool isDivisionByConstantAsMultiplication() const {
+        return _divByConstAsMult;
+    }
+
+    /**
+     * Defines whether or not the algebraic simplifications replace divisions
+     * by constants with multiplications by their reciprocal.
+     * This can change the results due to different rounding.
+     *
+     * @param divAsMult true to enable this replacement
+     * @see CodeHandler::setDivisionByConstantAsMultiplication()
+     */
+    inline void setDivisionByConstantAsMultiplication(bool divAsMult) {
+        _divByConstAsMult = divAsMult;
+    }
+
+    inline bool isFuseTranscendentalFunctions() const {
+        return _fuseTranscendentals;
+    }
+
+    /**
+     * Defines whether or not transcendental functions with the same argument
+     * are evaluated together in the generated code (e.g. sin() and cos()
+     * with a single call to sincos()).
+     *
+     * @param fuse true to enable fused evaluations
+     * @see LanguageC::setFuseTranscendentalFunctions()
+     */
+    inline void setFuseTranscendentalFunctions(bool fuse) {
+        _fuseTranscendentals = fuse;
+    }
+
+    inline const std::set<std::string>& getSinglePrecisionFunctions() const {
+        return _singlePrecisionFunctions;
+    }
+
+    /**
+     * Defines the functions for which an additional single precision (float)
+     * version is generated, e.g. for parts of an algorithm which tolerate
+     * a lower precision such as preconditioners.
+     * These functions use the same operations as the original ones but all
+     * values are floats (see LanguageCSinglePrecision).
+     * They are named with the suffix SINGLE_PRECISION_SUFFIX and can be
+     * evaluated with GenericModel::ForwardZeroFloat(),
+     * GenericModel::SparseJacobianFloat(), and
+     * GenericModel::SparseHessianFloat().
+     * The sparse Jacobian and the sparse Hessian are then generated directly
+     * (without reusing the forward/reverse mode functions).
+     * Single precision functions cannot be used with atomic functions.
+     *
+     * @param functions the function types (FUNCTION_FORWAD_ZERO,
+     *                  FUNCTION_SPARSE_JACOBIAN, and/or
+     *                  FUNCTION_SPARSE_HESSIAN)
+     */
+    inline void setSinglePrecisionFunctions(const std::set<std::string>& functions) {
+        for (const std::string& f : functions) {
+            if (f != FUNCTION_FORWAD_ZERO && f != FUNCTION_SPARSE_JACOBIAN && f != FUNCTION_SPARSE_HESSIAN) {
+                throw CGException("Single precision is not supported for '", f, "'");
+            }
+        }
+        _singlePrecisionFunctions = functions;
+    }
+
+    inline bool isSinglePrecision(const std::string& function) const {
+        return _singlePrecisionFunctions.find(function) != _singlePrecisionFunctions.end();
+    }
+
+    inline const std::set<std::string>& getHotFunctions() const {
+        return _hotFunctions;
+    }
+
+    /**
+     * Defines the functions which are expected to be evaluated often and
+     * whose sources should be compiled with more aggressive optimizations
+     * (see AbstractCCompiler::setAdaptiveOptimization()).
+     *
+     * @param functions the function types (e.g. FUNCTION_FORWAD_ZERO,
+     *                  FUNCTION_SPARSE_JACOBIAN)
+     */
+    inline void setHotFunctions(const std::set<std::string>& functions) {
+        _hotFunctions = functions;
+    }
+
+    /**
+     * Provides information on each of the previously generated source files
+     * (size, number of assignments, and whether or not it is hot).
+     *
+     * @return maps the source file names to their statistics
+     */
+    inline std::map<std::string, SourceStatistics> getSourceStatistics() const {
+        std::map<std::string, SourceStatistics> stats;
+        for (const auto& it : _sources) {
+            bool hot = false;
+            for (const std::string& f : _hotFunctions) {
+                const std::string prefix = _name + "_" + f;
+                if (it.first.compare(0, prefix.size(), prefix) == 0) {
+                    hot = true;
+                    break;
+                }
+            }
+            stats[it.first] = SourceStatistics::create(it.second, hot);
+        }
+        return stats;
+    }
+
+    /**
+     * Determines a fingerprint of the model which changes when the
+     * generated source code might change, that is, when the zero order
+     * operation graph of the tape (including the names of the atomic
+     * functions) or any of the source generation options change.
+     * The sources are not generated but the model is evaluated once
+     * using CG variables.
+     *
+     * @param multiThreadingType the multithreading type used by the model
+     *                           library
+     * @return an hexadecimal hash value
+     */
+    virtual std::string getFingerprint(MultiThreadingType multiThreadingType);
+
     inline virtual ~ModelCSourceGen() {
         delete _funNoLoops;
         delete _atomicsInfo;
@@ -832,6 +1234,48 @@ public:
 
 protected:
 
+    /**
+     * Creates the independent variables in a code handler using the
+     * typical values (if defined) and replaces frozen independent
+     * variables by their constant values.
+     */
+    template<class VectorCG>
+    inline void makeIndependentVariables(CodeHandler<Base>& handler,
+                                         VectorCG& x) {
+        handler.makeVariables(x);
+        if (_x.size() > 0) {
+            for (size_t i = 0; i < x.size(); i++) {
+                x[i].setValue(_x[i]);
+            }
+        }
+
+        for (const auto& it : _frozenIndep) {
+            x[it.first] = CGBase(it.second);
+        }
+    }
+
+    /**
+     * Moves the operations which only depend on parameters into a new
+     * function which saves their values in a cache.
+     * The cached operations are replaced by new independent variables
+     * (registered after all the existing independent variables).
+     *
+     * @param handler the code handler with the operation graph
+     * @param indVars the independent variables
+     * @param dependents the dependent variables of the function
+     * @param function the name of the function (without the model name)
+     * @return true if some operations are cached
+     */
+    template<class VectorCG>
+    bool generateParameterCacheSource(CodeHandler<Base>& handler,
+                                      const VectorCG& indVars,
+                                      VectorCG& dependents,
+                                      const std::string& function);
+
+    virtual void generateParameterCacheSources();
+
+    static inline bool isParameterCacheable(CGOpCode op);
+
     virtual VariableNameGenerator<Base>* createVariableNameGenerator(const std::string& depName = "y",
                                                                      const std::string& indepName = "x",
                                                                      const std::string& tmpName = "v",
@@ -843,6 +1287,11 @@ protected:
     virtual void generateSources(MultiThreadingType multiThreadingType,
                                  JobTimer* timer = nullptr);
 
+    /**
+     * Adds the zero order operation graph of the model to a fingerprint.
+     */
+    virtual void addOperationGraph(ModelFingerprint& fingerprint);
+
     virtual void generateLoops();
 
     virtual void generateInfoSource();
@@ -1197,8 +1646,41 @@ protected:
     static void printFileStartPThreads(std::ostringstream& cache,
                                        const std::string& baseTypeName);
 
+    /**
+     * Provides a rough estimate of the relative cost of evaluating an
+     * operation (an addition has a cost of 1).
+     */
+    virtual double getOperationCost(CGOpCode op) const;
+
+    /**
+     * Saves the estimated cost of a generated function which evaluates
+     * the provided dependent variables.
+     */
+    virtual void estimateFunctionCost(const std::string& function,
+                                      const std::vector<CGBase>& dependents);
+
+    /**
+     * Groups consecutive functions into jobs for the thread pool so that
+     * the jobs have similar estimated costs.
+     *
+     * @param functions the names of the functions called in each job
+     * @param jobStart the index of the first function of each job followed
+     *                 by the number of functions (output)
+     * @param jobCost the estimated cost of each job (output)
+     */
+    virtual void determineJobs(const std::vector<std::string>& functions,
+                               std::vector<size_t>& jobStart,
+                               std::vector<double>& jobCost) const;
+
     static void printFunctionStartPThreads(std::ostringstream& cache,
-                                           size_t size);
+                                           const std::vector<size_t>& jobStart,
+                                           const std::vector<double>& jobCost);
+
+    static void printJobArgumentsPThreads(std::ostringstream& cache,
+                                          const std::string& in,
+                                          const std::string& out,
+                                          const std::string& atomicFun,
+                                          size_t size);
 
     static void printFunctionEndPThreads(std::ostringstream& cache,
                                          size_t size);
@@ -1214,6 +1696,21 @@ protected:
     static void printLoopEndOpenMP(std::ostringstream& cache,
                                    size_t size);
 
+    virtual void generateSinglePrecisionSource(CodeHandler<Base>& handler,
+                                               std::vector<CGBase>& dependents,
+                                               VariableNameGenerator<Base>& nameGen,
+                                               const std::string& function,
+                                               const std::string& jobName);
+
+    /**
+     * Applies the common configuration to a new code handler
+     */
+    inline void prepareCodeHandler(CodeHandler<Base>& handler) {
+        handler.setJobTimer(_jobTimer);
+        handler.setSimplifyOperations(_simplifyOperations);
+        handler.setDivisionByConstantAsMultiplication(_divByConstAsMult);
+    }
+
     /**
      *
      */
@@ -0,0 +1,152 @@
+#ifndef CPPAD_CG_MODEL_C_SOURCE_GEN_FINGERPRINT_INCLUDED
+#define CPPAD_CG_MODEL_C_SOURCE_GEN_FINGERPRINT_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+template<class Base>
+std::string ModelCSourceGen<Base>::getFingerprint(MultiThreadingType multiThreadingType) {
+    ModelFingerprint fp;
+
+    fp << size_t(ModelLibraryCSourceGen<Base>::API_VERSION);
+    fp << _name << _baseTypeName << _parameterPrecision;
+    fp << size_t(multiThreadingType);
+
+    /**
+     * source generation options
+     */
+    fp << _x.size();
+    for (const Base& v : _x)
+        fp.addBytes(&v, sizeof(Base));
+    fp << _frozenIndep.size();
+    for (const auto& it : _frozenIndep) {
+        fp << it.first;
+        fp.addBytes(&it.second, sizeof(Base));
+    }
+    fp << _parameterIndep;
+    fp << _multiThreading << _maxMultiThreadingJobs << _minMultiThreadingJobCost;
+    fp << _zero << _jacobian << _hessian << _sparseJacobian << _sparseHessian << _hessianByEquation;
+    fp << _forwardOne << _reverseOne << _reverseTwo;
+    fp << _sparseJacobianReusesOne << _sparseHessianReusesRev2 << size_t(_jacMode);
+    fp << _custom_jac.defined << _custom_jac.row << _custom_jac.col;
+    fp << _custom_hess.defined << _custom_hess.row << _custom_hess.col;
+    fp << _maxAssignPerFunc << _simplifyOperations << _divByConstAsMult;
+    fp << _fuseTranscendentals << _splitMinimizeLive << _vectorizeLoops;
+    fp << (_constantPool != nullptr);
+    fp << _hotFunctions << _singlePrecisionFunctions;
+    fp << _relatedDepCandidates;
+
+    /**
+     * the model
+     */
+    addOperationGraph(fp);
+
+    return fp.toString();
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::addOperationGraph(ModelFingerprint& fp) {
+    using Node = OperationNode<Base>;
+
+    CodeHandler<Base> handler;
+    handler.setSimplifyOperations(_simplifyOperations);
+    handler.setDivisionByConstantAsMultiplication(_divByConstAsMult);
+
+    std::vector<CGBase> indVars(_fun.Domain());
+    makeIndependentVariables(handler, indVars);
+
+    std::vector<CGBase> dep = _fun.Forward(0, indVars);
+
+    const auto& atomics = handler.getAtomicFunctions();
+
+    /**
+     * nodes are numbered in the order they are visited (post-order)
+     * so that the fingerprint does not depend on memory addresses
+     */
+    std::map<const Node*, size_t> ids;
+    for (const CGBase& x : indVars) {
+        if (x.getOperationNode() != nullptr) {
+            size_t id = ids.size();
+            ids[x.getOperationNode()] = id;
+        }
+    }
+
+    auto addArgument = [&](const Argument<Base>& a) {
+        if (a.getOperation() != nullptr) {
+            fp << ids.at(a.getOperation());
+        } else {
+            fp << std::numeric_limits<size_t>::max();
+            fp.addBytes(a.getParameter(), sizeof(Base));
+        }
+    };
+
+    std::vector<std::pair<Node*, size_t> > stack; // node and next argument
+    for (const CGBase& y : dep) {
+        if (y.getOperationNode() == nullptr) {
+            fp << std::numeric_limits<size_t>::max();
+            const Base& v = y.getValue();
+            fp.addBytes(&v, sizeof(Base));
+            continue;
+        }
+
+        stack.emplace_back(y.getOperationNode(), 0);
+        while (!stack.empty()) {
+            Node* node = stack.back().first;
+            size_t& a = stack.back().second;
+
+            if (ids.find(node) != ids.end()) {
+                stack.pop_back();
+                continue;
+            }
+
+            const std::vector<Argument<Base> >& args = node->getArguments();
+            if (a < args.size()) {
+                Node* arg = args[a++].getOperation();
+                if (arg != nullptr && ids.find(arg) == ids.end())
+                    stack.emplace_back(arg, 0);
+                continue;
+            }
+
+            CGOpCode op = node->getOperationType();
+            const std::vector<size_t>& info = node->getInfo();
+            fp << size_t(op) << info.size();
+            for (size_t i = 0; i < info.size(); i++) {
+                if (i == 0 && (op == CGOpCode::AtomicForward || op == CGOpCode::AtomicReverse)) {
+                    // atomic function IDs depend on the creation order of the atomic functions
+                    auto itAtomic = atomics.find(info[0]);
+                    fp << (itAtomic != atomics.end() ? itAtomic->second->afun_name() : std::string());
+                } else {
+                    fp << info[i];
+                }
+            }
+            fp << args.size();
+            for (const Argument<Base>& arg : args)
+                addArgument(arg);
+
+            size_t id = ids.size();
+            ids[node] = id;
+            stack.pop_back();
+        }
+
+        fp << ids.at(y.getOperationNode());
+    }
+}
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -25,15 +25,10 @@ void ModelCSourceGen<Base>::generateZeroSource() {
     startingJob("'" + jobName + "'", JobTimer::GRAPH);
 
     CodeHandler<Base> handler;
-    handler.setJobTimer(_jobTimer);
+    prepareCodeHandler(handler);
 
     std::vector<CGBase> indVars(_fun.Domain());
-    handler.makeVariables(indVars);
-    if (_x.size() > 0) {
-        for (size_t i = 0; i < indVars.size(); i++) {
-            indVars[i].setValue(_x[i]);
-        }
-    }
+    makeIndependentVariables(handler, indVars);
 
     std::vector<CGBase> dep;
 
@@ -48,15 +43,33 @@ void ModelCSourceGen<Base>::generateZeroSource() {
 
     finishedJob();
 
+    size_t n = handler.getIndependentVariableSize();
+
+    if (isSinglePrecision(FUNCTION_FORWAD_ZERO)) {
+        // must be generated before the parameter cache replaces operations
+        std::unique_ptr<VariableNameGenerator<Base> > nameGenFloat(createVariableNameGenerator());
+        generateSinglePrecisionSource(handler, dep, *nameGenFloat, FUNCTION_FORWAD_ZERO, jobName);
+    }
+
+    bool cached = generateParameterCacheSource(handler, indVars, dep, FUNCTION_FORWAD_ZERO);
+
     LanguageC<Base> langC(_baseTypeName);
     langC.setMaxAssigmentsPerFunction(_maxAssignPerFunc, &_sources);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setFuseTranscendentalFunctions(_fuseTranscendentals);
+    langC.setSplitMinimizingLiveVariables(_splitMinimizeLive);
+    langC.setConstantPool(_constantPool);
+    langC.setVectorizeLoops(_vectorizeLoops);
     langC.setGenerateFunction(_name + "_" + FUNCTION_FORWAD_ZERO);
 
     std::ostringstream code;
     std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator());
+    std::unique_ptr<VariableNameGenerator<Base> > nameGenCache;
+    if (cached) {
+        nameGenCache.reset(new LangCDefaultHessianVarNameGenerator<Base>(nameGen.get(), PARAMETER_CACHE_NAME, n));
+    }
 
-    handler.generateCode(code, langC, dep, *nameGen, _atomicFunctions, jobName);
+    handler.generateCode(code, langC, dep, cached ? *nameGenCache : *nameGen, _atomicFunctions, jobName);
 }
 
 
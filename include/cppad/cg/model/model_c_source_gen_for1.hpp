@@ -83,15 +83,10 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesWithAtomics(const std
         startingJob("'" + subJobName + "'", JobTimer::GRAPH);
 
         CodeHandler<Base> handler;
-        handler.setJobTimer(_jobTimer);
+        prepareCodeHandler(handler);
 
         vector<CGBase> indVars(n);
-        handler.makeVariables(indVars);
-        if (_x.size() > 0) {
-            for (size_t i = 0; i < n; i++) {
-                indVars[i].setValue(_x[i]);
-            }
-        }
+        makeIndependentVariables(handler, indVars);
 
         CGBase dx;
         handler.makeVariable(dx);
@@ -116,9 +111,14 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesWithAtomics(const std
         LanguageC<Base> langC(_baseTypeName);
         langC.setMaxAssigmentsPerFunction(_maxAssignPerFunc, &_sources);
         langC.setParameterPrecision(_parameterPrecision);
+        langC.setFuseTranscendentalFunctions(_fuseTranscendentals);
+        langC.setSplitMinimizingLiveVariables(_splitMinimizeLive);
+        langC.setConstantPool(_constantPool);
+        langC.setVectorizeLoops(_vectorizeLoops);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_FORWARD_ONE << "_indep" << j;
         langC.setGenerateFunction(_cache.str());
+        estimateFunctionCost(_cache.str(), dyCustom);
 
         std::ostringstream code;
         std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("dy"));
@@ -138,15 +138,10 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesNoAtomics(const std::
     size_t n = _fun.Domain();
 
     CodeHandler<Base> handler;
-    handler.setJobTimer(_jobTimer);
+    prepareCodeHandler(handler);
 
     vector<CGBase> x(n);
-    handler.makeVariables(x);
-    if (_x.size() > 0) {
-        for (size_t i = 0; i < n; i++) {
-            x[i].setValue(_x[i]);
-        }
-    }
+    makeIndependentVariables(handler, x);
 
     CGBase dx;
     handler.makeVariable(dx);
@@ -202,9 +197,14 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesNoAtomics(const std::
         LanguageC<Base> langC(_baseTypeName);
         langC.setMaxAssigmentsPerFunction(_maxAssignPerFunc, &_sources);
         langC.setParameterPrecision(_parameterPrecision);
+        langC.setFuseTranscendentalFunctions(_fuseTranscendentals);
+        langC.setSplitMinimizingLiveVariables(_splitMinimizeLive);
+        langC.setConstantPool(_constantPool);
+        langC.setVectorizeLoops(_vectorizeLoops);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_FORWARD_ONE << "_indep" << j;
         langC.setGenerateFunction(_cache.str());
+        estimateFunctionCost(_cache.str(), dyCustom);
 
         std::ostringstream code;
         std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("dy"));
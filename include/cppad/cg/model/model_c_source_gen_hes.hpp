@@ -27,7 +27,7 @@ void ModelCSourceGen<Base>::generateHessianSource() {
     startingJob("'" + jobName + "'", JobTimer::GRAPH);
 
     CodeHandler<Base> handler;
-    handler.setJobTimer(_jobTimer);
+    prepareCodeHandler(handler);
 
     size_t m = _fun.Range();
     size_t n = _fun.Domain();
@@ -35,12 +35,7 @@ void ModelCSourceGen<Base>::generateHessianSource() {
 
     // independent variables
     vector<CGBase> indVars(n);
-    handler.makeVariables(indVars);
-    if (_x.size() > 0) {
-        for (size_t i = 0; i < n; i++) {
-            indVars[i].setValue(_x[i]);
-        }
-    }
+    makeIndependentVariables(handler, indVars);
 
     // multipliers
     vector<CGBase> w(m);
@@ -65,6 +60,10 @@ void ModelCSourceGen<Base>::generateHessianSource() {
     LanguageC<Base> langC(_baseTypeName);
     langC.setMaxAssigmentsPerFunction(_maxAssignPerFunc, &_sources);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setFuseTranscendentalFunctions(_fuseTranscendentals);
+    langC.setSplitMinimizingLiveVariables(_splitMinimizeLive);
+    langC.setConstantPool(_constantPool);
+    langC.setVectorizeLoops(_vectorizeLoops);
     langC.setGenerateFunction(_name + "_" + FUNCTION_HESSIAN);
 
     std::ostringstream code;
@@ -81,7 +80,8 @@ void ModelCSourceGen<Base>::generateSparseHessianSource(MultiThreadingType multi
      */
     determineHessianSparsity();
 
-    if (_sparseHessianReusesRev2 && _reverseTwo) {
+    if (_sparseHessianReusesRev2 && _parameterIndep.empty() && _reverseTwo &&
+        !isSinglePrecision(FUNCTION_SPARSE_HESSIAN)) {
         generateSparseHessianSourceFromRev2(multiThreadingType);
     } else {
         generateSparseHessianSourceDirectly();
@@ -160,16 +160,11 @@ void ModelCSourceGen<Base>::generateSparseHessianSourceDirectly() {
     startingJob("'" + jobName + "'", JobTimer::GRAPH);
 
     CodeHandler<Base> handler;
-    handler.setJobTimer(_jobTimer);
+    prepareCodeHandler(handler);
 
     // independent variables
     vector<CGBase> indVars(n);
-    handler.makeVariables(indVars);
-    if (_x.size() > 0) {
-        for (size_t i = 0; i < n; i++) {
-            indVars[i].setValue(_x[i]);
-        }
-    }
+    makeIndependentVariables(handler, indVars);
 
     // multipliers
     vector<CGBase> w(m);
@@ -209,16 +204,33 @@ void ModelCSourceGen<Base>::generateSparseHessianSourceDirectly() {
 
     finishedJob();
 
+    if (isSinglePrecision(FUNCTION_SPARSE_HESSIAN)) {
+        // must be generated before the parameter cache replaces operations
+        std::unique_ptr<VariableNameGenerator<Base> > nameGenFloat(createVariableNameGenerator("hess"));
+        LangCDefaultHessianVarNameGenerator<Base> nameGenHessFloat(nameGenFloat.get(), n);
+        generateSinglePrecisionSource(handler, hess, nameGenHessFloat, FUNCTION_SPARSE_HESSIAN, jobName);
+    }
+
+    bool cached = generateParameterCacheSource(handler, indVars, hess, FUNCTION_SPARSE_HESSIAN);
+
     LanguageC<Base> langC(_baseTypeName);
     langC.setMaxAssigmentsPerFunction(_maxAssignPerFunc, &_sources);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setFuseTranscendentalFunctions(_fuseTranscendentals);
+    langC.setSplitMinimizingLiveVariables(_splitMinimizeLive);
+    langC.setConstantPool(_constantPool);
+    langC.setVectorizeLoops(_vectorizeLoops);
     langC.setGenerateFunction(_name + "_" + FUNCTION_SPARSE_HESSIAN);
 
     std::ostringstream code;
     std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("hess"));
     LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), n);
+    std::unique_ptr<VariableNameGenerator<Base> > nameGenCache;
+    if (cached) {
+        nameGenCache.reset(new LangCDefaultHessianVarNameGenerator<Base>(&nameGenHess, PARAMETER_CACHE_NAME, n + m));
+    }
 
-    handler.generateCode(code, langC, hess, nameGenHess, _atomicFunctions, jobName);
+    handler.generateCode(code, langC, hess, cached ? *nameGenCache : nameGenHess, _atomicFunctions, jobName);
 }
 
 template<class Base>
@@ -493,17 +505,22 @@ std::string ModelCSourceGen<Base>::generateSparseHessianRev2MultiThreadSource(co
     } else {
         assert(multiThreadingType == MultiThreadingType::PTHREADS);
 
-        printFunctionStartPThreads(_cache, hessInfo.size());
-        _cache << "\n"
-                "   for(i = 0; i < " << hessInfo.size() << "; ++i) {\n"
-                "      args[i] = (ExecArgStruct*) malloc(sizeof(ExecArgStruct));\n"
-                "      args[i]->func = p[i];\n"
-                "      args[i]->in = inLocal;\n"
-                "      args[i]->out[0] = &hess[offset[i]];\n"
-                "      args[i]->atomicFun = " << langC .getArgumentAtomic() << ";\n"
-                "   }\n"
-                "\n";
-        printFunctionEndPThreads(_cache, hessInfo.size());
+        std::vector<std::string> functions;
+        functions.reserve(hessInfo.size());
+        for (const auto& it : hessInfo) {
+            functions.push_back(functionRev2 + "_" + rev2Suffix + std::to_string(it.first));
+        }
+
+        std::vector<size_t> jobStart;
+        std::vector<double> jobCost;
+        determineJobs(functions, jobStart, jobCost);
+        size_t nJobs = jobCost.size();
+
+        printFunctionStartPThreads(_cache, jobStart, jobCost);
+        _cache << "\n";
+        printJobArgumentsPThreads(_cache, "inLocal", "hess", langC.getArgumentAtomic(), nJobs);
+        _cache << "\n";
+        printFunctionEndPThreads(_cache, nJobs);
     }
 
     _cache << "\n"
@@ -77,9 +77,36 @@ const std::string ModelCSourceGen<Base>::FUNCTION_INFO = "info";
 template<class Base>
 const std::string ModelCSourceGen<Base>::FUNCTION_ATOMIC_FUNC_NAMES = "atomic_functions";
 
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_DIRECT_FORWARD = "direct_forward";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_DIRECT_REVERSE = "direct_reverse";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_ATOMIC_FORWARD = "atomic_forward";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_ATOMIC_REVERSE = "atomic_reverse";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_ATOMIC_LINKED = "atomic_linked";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_PRECOMPUTE_PARAMETERS = "precompute_parameters";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_PARAMETER_INFO = "parameter_info";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::SINGLE_PRECISION_SUFFIX = "_float";
+
 template<class Base>
 const std::string ModelCSourceGen<Base>::CONST = "const";
 
+template<class Base>
+const double ModelCSourceGen<Base>::ESTIMATED_SECONDS_PER_COST = 1e-9;
+
 template<class Base>
 VariableNameGenerator<Base>* ModelCSourceGen<Base>::createVariableNameGenerator(const std::string& depName,
                                                                                 const std::string& indepName,
@@ -102,6 +129,16 @@ void ModelCSourceGen<Base>::generateSources(MultiThreadingType multiThreadingTyp
                                             JobTimer* timer) {
     _jobTimer = timer;
 
+    if (!_frozenIndep.empty() && !_relatedDepCandidates.empty()) {
+        throw CGException("Frozen independent variables cannot be used with loop detection in model '", _name, "'");
+    }
+    if (!_parameterIndep.empty() && !_relatedDepCandidates.empty()) {
+        throw CGException("Parameters cannot be used with loop detection in model '", _name, "'");
+    }
+
+    _parameterCacheFunctions.clear();
+    _functionCosts.clear();
+
     generateLoops();
 
     startingJob("'" + _name + "'", JobTimer::SOURCE_FOR_MODEL);
@@ -150,6 +187,10 @@ void ModelCSourceGen<Base>::generateSources(MultiThreadingType multiThreadingTyp
         generateHessianSparsitySource();
     }
 
+    if (!_parameterIndep.empty()) {
+        generateParameterCacheSources();
+    }
+
     generateInfoSource();
 
     generateAtomicFuncNames();
@@ -166,7 +207,7 @@ void ModelCSourceGen<Base>::generateLoops() {
     startingJob("", JobTimer::LOOP_DETECTION);
 
     CodeHandler<Base> handler;
-    handler.setJobTimer(_jobTimer);
+    prepareCodeHandler(handler);
 
     std::vector<CGBase> xx(_fun.Domain());
     handler.makeVariables(xx);
@@ -188,6 +229,31 @@ void ModelCSourceGen<Base>::generateLoops() {
     }
 }
 
+template<class Base>
+void ModelCSourceGen<Base>::generateSinglePrecisionSource(CodeHandler<Base>& handler,
+                                                          std::vector<CGBase>& dependents,
+                                                          VariableNameGenerator<Base>& nameGen,
+                                                          const std::string& function,
+                                                          const std::string& jobName) {
+    if (!isSinglePrecision(function))
+        return;
+
+    if (isAtomicsUsed()) {
+        throw CGException("Single precision functions cannot be generated for model '", _name,
+                          "' because it uses atomic functions");
+    }
+
+    LanguageCSinglePrecision<Base> langC;
+    langC.setMaxAssigmentsPerFunction(_maxAssignPerFunc, &_sources);
+    langC.setParameterPrecision(_parameterPrecision);
+    langC.setFuseTranscendentalFunctions(_fuseTranscendentals);
+    langC.setSplitMinimizingLiveVariables(_splitMinimizeLive);
+    langC.setGenerateFunction(_name + "_" + function + SINGLE_PRECISION_SUFFIX);
+
+    std::ostringstream code;
+    handler.generateCode(code, langC, dependents, nameGen, _atomicFunctions, jobName + " (single precision)");
+}
+
 template<class Base>
 void ModelCSourceGen<Base>::generateInfoSource() {
     const char* localBaseName = typeid (Base).name();
@@ -649,21 +715,170 @@ void ModelCSourceGen<Base>::printFileStartPThreads(std::ostringstream& cache,
     cache << CPPADCG_PTHREAD_POOL_H_FILE << "\n";
     cache << "\n";
     cache << "typedef struct ExecArgStruct {\n"
-            "   cppadcg_function_type func;\n"
+            "   cppadcg_function_type const* func;\n"
+            "   long const* offset;\n"
+            "   long begin;\n"
+            "   long end;\n"
             "   " << baseTypeName + " const *const * in;\n"
-            "   " << baseTypeName + "* out[1];\n"
+            "   " << baseTypeName + "* out;\n"
             "   struct LangCAtomicFun atomicFun;\n"
             "} ExecArgStruct;\n"
             "\n"
             "static void exec_func(void* arg) {\n"
             "   ExecArgStruct* eArg = (ExecArgStruct*) arg;\n"
-            "   (*eArg->func)(eArg->in, eArg->out, eArg->atomicFun);\n"
+            "   " << baseTypeName + "* outLocal[1];\n"
+            "   long i;\n"
+            "   for(i = eArg->begin; i < eArg->end; ++i) {\n"
+            "      outLocal[0] = &eArg->out[eArg->offset[i]];\n"
+            "      (*eArg->func[i])(eArg->in, outLocal, eArg->atomicFun);\n"
+            "   }\n"
             "}\n";
 }
 
+template<class Base>
+double ModelCSourceGen<Base>::getOperationCost(CGOpCode op) const {
+    switch (op) {
+        case CGOpCode::Inv:
+        case CGOpCode::Alias:
+        case CGOpCode::Index:
+        case CGOpCode::IndexDeclaration:
+        case CGOpCode::TmpDcl:
+            return 0;
+        case CGOpCode::Div:
+        case CGOpCode::Sqrt:
+            return 4;
+        case CGOpCode::Exp:
+        case CGOpCode::Expm1:
+        case CGOpCode::Log:
+        case CGOpCode::Log1p:
+        case CGOpCode::Erf:
+            return 20;
+        case CGOpCode::Acos:
+        case CGOpCode::Acosh:
+        case CGOpCode::Asin:
+        case CGOpCode::Asinh:
+        case CGOpCode::Atan:
+        case CGOpCode::Atanh:
+        case CGOpCode::Cos:
+        case CGOpCode::Cosh:
+        case CGOpCode::Sin:
+        case CGOpCode::Sinh:
+        case CGOpCode::Tan:
+        case CGOpCode::Tanh:
+            return 25;
+        case CGOpCode::Pow:
+            return 40;
+        case CGOpCode::AtomicForward:
+        case CGOpCode::AtomicReverse:
+            return 200; // unknown
+        default:
+            return 1;
+    }
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::estimateFunctionCost(const std::string& function,
+                                                 const std::vector<CGBase>& dependents) {
+    using Node = OperationNode<Base>;
+
+    std::set<const Node*> visited;
+    std::vector<const Node*> stack;
+
+    for (const CGBase& dep : dependents) {
+        const Node* node = dep.getOperationNode();
+        if (node != nullptr && visited.insert(node).second)
+            stack.push_back(node);
+    }
+
+    double cost = 0;
+    while (!stack.empty()) {
+        const Node* node = stack.back();
+        stack.pop_back();
+
+        cost += getOperationCost(node->getOperationType());
+
+        for (const Argument<Base>& a : node->getArguments()) {
+            const Node* arg = a.getOperation();
+            if (arg != nullptr && visited.insert(arg).second)
+                stack.push_back(arg);
+        }
+    }
+
+    // the assignment of each dependent
+    cost += double(dependents.size());
+
+    _functionCosts[function] = cost;
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::determineJobs(const std::vector<std::string>& functions,
+                                          std::vector<size_t>& jobStart,
+                                          std::vector<double>& jobCost) const {
+    const size_t n = functions.size();
+
+    /**
+     * estimated cost of the functions
+     * (the same cost is used for all if it was not estimated for every function)
+     */
+    std::vector<double> prefix(n + 1, 0.0);
+    bool estimated = true;
+    for (size_t i = 0; i < n; ++i) {
+        auto it = _functionCosts.find(functions[i]);
+        if (it == _functionCosts.end()) {
+            estimated = false;
+            break;
+        }
+        prefix[i + 1] = prefix[i] + std::max(it->second, 1.0);
+    }
+    if (!estimated) {
+        for (size_t i = 0; i < n; ++i)
+            prefix[i + 1] = double(i + 1);
+    }
+    const double total = prefix[n];
+
+    /**
+     * number of jobs
+     */
+    size_t nJobs = _maxMultiThreadingJobs == 0 ? n : std::min(n, _maxMultiThreadingJobs);
+    if (estimated && _minMultiThreadingJobCost > 0) {
+        // tiny functions are merged into larger jobs
+        auto nMin = size_t(total / _minMultiThreadingJobCost);
+        nJobs = std::min(nJobs, std::max<size_t>(nMin, 1));
+    }
+    if (n == 0)
+        nJobs = 0;
+
+    /**
+     * contiguous groups of functions with similar costs
+     */
+    jobStart.clear();
+    jobStart.reserve(nJobs + 1);
+    jobStart.push_back(0);
+    for (size_t k = 1; k < nJobs; ++k) {
+        double target = total * double(k) / double(nJobs);
+        size_t first = jobStart.back() + 1;
+        auto i = size_t(std::lower_bound(prefix.begin() + first, prefix.end(), target) - prefix.begin());
+        if (i > first && target - prefix[i - 1] < prefix[i] - target)
+            i--; // closer to the target
+        i = std::min(i, n - (nJobs - k)); // at least one function in each of the remaining jobs
+        i = std::max(i, first);
+        jobStart.push_back(i);
+    }
+    if (nJobs > 0)
+        jobStart.push_back(n);
+
+    jobCost.resize(nJobs);
+    for (size_t k = 0; k < nJobs; ++k) {
+        jobCost[k] = prefix[jobStart[k + 1]] - prefix[jobStart[k]];
+    }
+}
+
 template<class Base>
 void ModelCSourceGen<Base>::printFunctionStartPThreads(std::ostringstream& cache,
-                                                       size_t size) {
+                                                       const std::vector<size_t>& jobStart,
+                                                       const std::vector<double>& jobCost) {
+    const size_t size = jobCost.size();
+
     auto repeatFill = [&](const std::string& txt){
         cache << "{";
         for (size_t i = 0; i < size; ++i) {
@@ -673,20 +888,46 @@ void ModelCSourceGen<Base>::printFunctionStartPThreads(std::ostringstream& cache
         cache << "};";
     };
 
-    cache << "   ExecArgStruct* args[" << size << "];\n";
+    /**
+     * the argument blocks are in the stack (no memory allocation) and each
+     * job evaluates a range of consecutive functions
+     */
+    cache << "   ExecArgStruct argsData[" << size << "];\n"
+            "   void* args[" << size << "];\n"
+            "   static const long job_start[" << (size + 1) << "] = {";
+    for (size_t j = 0; j <= size; ++j) {
+        if (j != 0) cache << ", ";
+        cache << (size == 0 ? 0 : jobStart[j]);
+    }
+    cache << "};\n";
     cache << "   static cppadcg_thpool_function_type execute_functions[" << size << "] = ";
     repeatFill("exec_func");
     cache << "\n";
-    cache << "   static float ref_elapsed[" << size << "] = ";
-    repeatFill("0");
-    cache << "\n";
+    /**
+     * the estimated costs are used until the elapsed times are measured
+     * (the thread pool can statically balance the jobs from the first call)
+     */
+    std::vector<std::pair<double, size_t> > costOrder(size);
+    for (size_t i = 0; i < size; ++i)
+        costOrder[i] = std::make_pair(jobCost[i], i);
+    std::stable_sort(costOrder.begin(), costOrder.end());
+    std::vector<size_t> order(size);
+    for (size_t i = 0; i < size; ++i)
+        order[costOrder[i].second] = size - i - 1; // same as cppadcg_thpool_update_order()
+
+    cache << "   static float ref_elapsed[" << size << "] = {";
+    for (size_t i = 0; i < size; ++i) {
+        if (i != 0) cache << ", ";
+        cache << float(jobCost[i] * ESTIMATED_SECONDS_PER_COST);
+    }
+    cache << "};\n";
     cache << "   static float elapsed[" << size << "] = ";
     repeatFill("0");
     cache << "\n"
             "   static int order[" << size << "] = {";
     for (size_t i = 0; i < size; ++i) {
         if (i != 0) cache << ", ";
-        cache << i;
+        cache << order[i];
     }
     cache << "};\n"
             "   static int job2Thread[" << size << "] = ";
@@ -699,17 +940,31 @@ void ModelCSourceGen<Base>::printFunctionStartPThreads(std::ostringstream& cache
             "   float* elapsed_p = do_benchmark ? elapsed : NULL;\n";
 }
 
+template<class Base>
+void ModelCSourceGen<Base>::printJobArgumentsPThreads(std::ostringstream& cache,
+                                                      const std::string& in,
+                                                      const std::string& out,
+                                                      const std::string& atomicFun,
+                                                      size_t size) {
+    cache << "   for(i = 0; i < " << size << "; ++i) {\n"
+            "      argsData[i].func = p;\n"
+            "      argsData[i].offset = offset;\n"
+            "      argsData[i].begin = job_start[i];\n"
+            "      argsData[i].end = job_start[i + 1];\n"
+            "      argsData[i].in = " << in << ";\n"
+            "      argsData[i].out = " << out << ";\n"
+            "      argsData[i].atomicFun = " << atomicFun << ";\n"
+            "      args[i] = &argsData[i];\n"
+            "   }\n";
+}
+
 template<class Base>
 void ModelCSourceGen<Base>::printFunctionEndPThreads(std::ostringstream& cache,
                                                      size_t size) {
-    cache << "   cppadcg_thpool_add_jobs(execute_functions, (void**) args, ref_elapsed, elapsed_p, order, job2Thread, " << size << ", last_elapsed_changed" << ");\n"
+    cache << "   cppadcg_thpool_add_jobs(execute_functions, args, ref_elapsed, elapsed_p, order, job2Thread, " << size << ", last_elapsed_changed" << ");\n"
             "\n"
             "   cppadcg_thpool_wait();\n"
             "\n"
-            "   for(i = 0; i < " << size << "; ++i) {\n"
-            "      free(args[i]);\n"
-            "   }\n"
-            "\n"
             "   if(do_benchmark) {\n"
             "      cppadcg_thpool_update_order(ref_elapsed, n_meas, elapsed, order, " << size << ");\n"
             "      n_meas++;\n"
@@ -27,15 +27,10 @@ void ModelCSourceGen<Base>::generateJacobianSource() {
     startingJob("'" + jobName + "'", JobTimer::GRAPH);
 
     CodeHandler<Base> handler;
-    handler.setJobTimer(_jobTimer);
+    prepareCodeHandler(handler);
 
     vector<CGBase> indVars(_fun.Domain());
-    handler.makeVariables(indVars);
-    if (_x.size() > 0) {
-        for (size_t i = 0; i < indVars.size(); i++) {
-            indVars[i].setValue(_x[i]);
-        }
-    }
+    makeIndependentVariables(handler, indVars);
 
     size_t m = _fun.Range();
     size_t n = _fun.Domain();
@@ -54,6 +49,10 @@ void ModelCSourceGen<Base>::generateJacobianSource() {
     LanguageC<Base> langC(_baseTypeName);
     langC.setMaxAssigmentsPerFunction(_maxAssignPerFunc, &_sources);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setFuseTranscendentalFunctions(_fuseTranscendentals);
+    langC.setSplitMinimizingLiveVariables(_splitMinimizeLive);
+    langC.setConstantPool(_constantPool);
+    langC.setVectorizeLoops(_vectorizeLoops);
     langC.setGenerateFunction(_name + "_" + FUNCTION_JACOBIAN);
 
     std::ostringstream code;
@@ -87,9 +86,11 @@ void ModelCSourceGen<Base>::generateSparseJacobianSource(MultiThreadingType mult
     /**
      * call the appropriate method for source code generation
      */
-    if (_sparseJacobianReusesOne && _forwardOne && forwardMode) {
+    bool reuse = _sparseJacobianReusesOne && _parameterIndep.empty() && !isSinglePrecision(FUNCTION_SPARSE_JACOBIAN);
+
+    if (reuse && _forwardOne && forwardMode) {
         generateSparseJacobianForRevSource(true, multiThreadingType);
-    } else if (_sparseJacobianReusesOne && _reverseOne && !forwardMode) {
+    } else if (reuse && _reverseOne && !forwardMode) {
         generateSparseJacobianForRevSource(false, multiThreadingType);
     } else {
         generateSparseJacobianSource(forwardMode);
@@ -108,15 +109,10 @@ void ModelCSourceGen<Base>::generateSparseJacobianSource(bool forward) {
     startingJob("'" + jobName + "'", JobTimer::GRAPH);
 
     CodeHandler<Base> handler;
-    handler.setJobTimer(_jobTimer);
+    prepareCodeHandler(handler);
 
     vector<CGBase> indVars(n);
-    handler.makeVariables(indVars);
-    if (_x.size() > 0) {
-        for (size_t i = 0; i < n; i++) {
-            indVars[i].setValue(_x[i]);
-        }
-    }
+    makeIndependentVariables(handler, indVars);
 
     vector<CGBase> jac(_jacSparsity.rows.size());
     if (_loopTapes.empty()) {
@@ -134,15 +130,31 @@ void ModelCSourceGen<Base>::generateSparseJacobianSource(bool forward) {
 
     finishedJob();
 
+    if (isSinglePrecision(FUNCTION_SPARSE_JACOBIAN)) {
+        // must be generated before the parameter cache replaces operations
+        std::unique_ptr<VariableNameGenerator<Base> > nameGenFloat(createVariableNameGenerator("jac"));
+        generateSinglePrecisionSource(handler, jac, *nameGenFloat, FUNCTION_SPARSE_JACOBIAN, jobName);
+    }
+
+    bool cached = generateParameterCacheSource(handler, indVars, jac, FUNCTION_SPARSE_JACOBIAN);
+
     LanguageC<Base> langC(_baseTypeName);
     langC.setMaxAssigmentsPerFunction(_maxAssignPerFunc, &_sources);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setFuseTranscendentalFunctions(_fuseTranscendentals);
+    langC.setSplitMinimizingLiveVariables(_splitMinimizeLive);
+    langC.setConstantPool(_constantPool);
+    langC.setVectorizeLoops(_vectorizeLoops);
     langC.setGenerateFunction(_name + "_" + FUNCTION_SPARSE_JACOBIAN);
 
     std::ostringstream code;
     std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("jac"));
+    std::unique_ptr<VariableNameGenerator<Base> > nameGenCache;
+    if (cached) {
+        nameGenCache.reset(new LangCDefaultHessianVarNameGenerator<Base>(nameGen.get(), PARAMETER_CACHE_NAME, n));
+    }
 
-    handler.generateCode(code, langC, jac, *nameGen, _atomicFunctions, jobName);
+    handler.generateCode(code, langC, jac, cached ? *nameGenCache : *nameGen, _atomicFunctions, jobName);
 }
 
 template<class Base>
@@ -436,17 +448,22 @@ std::string ModelCSourceGen<Base>::generateSparseJacobianForRevMultiThreadSource
     } else {
         assert(multiThreadingType == MultiThreadingType::PTHREADS);
 
-        printFunctionStartPThreads(_cache, jacInfo.size());
-        _cache << "\n"
-                "   for(i = 0; i < " << jacInfo.size() << "; ++i) {\n"
-                "      args[i] = (ExecArgStruct*) malloc(sizeof(ExecArgStruct));\n"
-                "      args[i]->func = p[i];\n"
-                "      args[i]->in = inLocal;\n"
-                "      args[i]->out[0] = &jac[offset[i]];\n"
-                "      args[i]->atomicFun = " << langC.getArgumentAtomic() << ";\n"
-                "   }\n"
-                "\n";
-        printFunctionEndPThreads(_cache, jacInfo.size());
+        std::vector<std::string> functions;
+        functions.reserve(jacInfo.size());
+        for (const auto& it : jacInfo) {
+            functions.push_back(functionRevFor + "_" + revForSuffix + std::to_string(it.first));
+        }
+
+        std::vector<size_t> jobStart;
+        std::vector<double> jobCost;
+        determineJobs(functions, jobStart, jobCost);
+        size_t nJobs = jobCost.size();
+
+        printFunctionStartPThreads(_cache, jobStart, jobCost);
+        _cache << "\n";
+        printJobArgumentsPThreads(_cache, "inLocal", "jac", langC.getArgumentAtomic(), nJobs);
+        _cache << "\n";
+        printFunctionEndPThreads(_cache, nJobs);
     }
 
     _cache << "\n"
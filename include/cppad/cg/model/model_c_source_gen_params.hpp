@@ -0,0 +1,288 @@
+#ifndef CPPAD_CG_MODEL_C_SOURCE_GEN_PARAMS_INCLUDED
+#define CPPAD_CG_MODEL_C_SOURCE_GEN_PARAMS_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::PARAMETER_CACHE_NAME = "pcache";
+
+template<class Base>
+inline bool ModelCSourceGen<Base>::isParameterCacheable(CGOpCode op) {
+    switch (op) {
+        case CGOpCode::Assign:
+        case CGOpCode::Abs:
+        case CGOpCode::Acos:
+        case CGOpCode::Acosh:
+        case CGOpCode::Add:
+        case CGOpCode::Alias:
+        case CGOpCode::Asin:
+        case CGOpCode::Asinh:
+        case CGOpCode::Atan:
+        case CGOpCode::Atanh:
+        case CGOpCode::ComLt:
+        case CGOpCode::ComLe:
+        case CGOpCode::ComEq:
+        case CGOpCode::ComGe:
+        case CGOpCode::ComGt:
+        case CGOpCode::ComNe:
+        case CGOpCode::Cosh:
+        case CGOpCode::Cos:
+        case CGOpCode::Div:
+        case CGOpCode::Erf:
+        case CGOpCode::Exp:
+        case CGOpCode::Expm1:
+        case CGOpCode::Log:
+        case CGOpCode::Log1p:
+        case CGOpCode::Mul:
+        case CGOpCode::Pow:
+        case CGOpCode::Sign:
+        case CGOpCode::Sinh:
+        case CGOpCode::Sin:
+        case CGOpCode::Sqrt:
+        case CGOpCode::Sub:
+        case CGOpCode::Tanh:
+        case CGOpCode::Tan:
+        case CGOpCode::UnMinus:
+            return true;
+        default:
+            return false;
+    }
+}
+
+template<class Base>
+template<class VectorCG>
+bool ModelCSourceGen<Base>::generateParameterCacheSource(CodeHandler<Base>& handler,
+                                                         const VectorCG& indVars,
+                                                         VectorCG& dependents,
+                                                         const std::string& function) {
+    if (_parameterIndep.empty())
+        return false;
+
+    using Node = OperationNode<Base>;
+
+    /**
+     * determine which nodes only depend on parameters (and constants)
+     */
+    std::map<const Node*, bool> paramOnly;
+    for (size_t j : _parameterIndep) {
+        const Node* node = indVars[j].getOperationNode();
+        if (node != nullptr) // might be frozen
+            paramOnly[node] = true;
+    }
+
+    std::vector<Node*> order; // nodes in the order they were classified
+    std::vector<std::pair<Node*, size_t> > stack;
+
+    auto visit = [&](Node* root) {
+        if (paramOnly.find(root) != paramOnly.end())
+            return;
+        stack.emplace_back(root, 0);
+
+        while (!stack.empty()) {
+            Node* node = stack.back().first;
+            size_t& a = stack.back().second;
+            const std::vector<Argument<Base> >& args = node->getArguments();
+
+            if (a < args.size()) {
+                Node* arg = args[a].getOperation();
+                a++;
+                if (arg != nullptr && paramOnly.find(arg) == paramOnly.end()) {
+                    stack.emplace_back(arg, 0);
+                }
+                continue;
+            }
+
+            bool p = node->getOperationType() != CGOpCode::Inv && isParameterCacheable(node->getOperationType());
+            for (size_t i = 0; p && i < args.size(); i++) {
+                const Node* arg = args[i].getOperation();
+                if (arg != nullptr && !paramOnly.at(arg))
+                    p = false;
+            }
+            paramOnly[node] = p;
+            order.push_back(node);
+            stack.pop_back();
+        }
+    };
+
+    for (size_t i = 0; i < dependents.size(); i++) {
+        Node* node = dependents[i].getOperationNode();
+        if (node != nullptr)
+            visit(node);
+    }
+
+    /**
+     * the values to be cached are the parameter-only operations used
+     * directly by the other operations or by the dependents
+     */
+    std::set<Node*> boundarySet;
+    for (Node* node : order) {
+        if (paramOnly.at(node))
+            continue;
+        for (const Argument<Base>& arg : node->getArguments()) {
+            Node* n = arg.getOperation();
+            if (n != nullptr && n->getOperationType() != CGOpCode::Inv && paramOnly.at(n))
+                boundarySet.insert(n);
+        }
+    }
+    for (size_t i = 0; i < dependents.size(); i++) {
+        Node* n = dependents[i].getOperationNode();
+        if (n != nullptr && n->getOperationType() != CGOpCode::Inv && paramOnly.at(n))
+            boundarySet.insert(n);
+    }
+
+    if (boundarySet.empty())
+        return false;
+
+    std::vector<Node*> boundary;
+    boundary.reserve(boundarySet.size());
+    for (Node* node : order) {
+        if (boundarySet.find(node) != boundarySet.end())
+            boundary.push_back(node);
+    }
+
+    /**
+     * generate the source code which evaluates the cached values
+     */
+    std::vector<CGBase> cacheDep(boundary.size());
+    for (size_t e = 0; e < boundary.size(); e++) {
+        cacheDep[e] = CGBase(*boundary[e]);
+    }
+
+    std::string funcName = _name + "_" + function + "_" + FUNCTION_PRECOMPUTE_PARAMETERS;
+
+    LanguageC<Base> langC(_baseTypeName);
+    langC.setMaxAssigmentsPerFunction(_maxAssignPerFunc, &_sources);
+    langC.setParameterPrecision(_parameterPrecision);
+    langC.setFuseTranscendentalFunctions(_fuseTranscendentals);
+    langC.setSplitMinimizingLiveVariables(_splitMinimizeLive);
+    langC.setConstantPool(_constantPool);
+    langC.setVectorizeLoops(_vectorizeLoops);
+    langC.setGenerateFunction(funcName);
+
+    std::ostringstream code;
+    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator(PARAMETER_CACHE_NAME));
+
+    handler.generateCode(code, langC, cacheDep, *nameGen, _atomicFunctions, function + " parameters");
+
+    _parameterCacheFunctions.emplace_back(function, boundary.size());
+
+    /**
+     * the cached values become new independent variables
+     */
+    std::vector<CGBase> cacheVars(boundary.size());
+    handler.makeVariables(cacheVars);
+    for (size_t e = 0; e < boundary.size(); e++) {
+        boundary[e]->makeAlias(Argument<Base>(*cacheVars[e].getOperationNode()));
+    }
+
+    return true;
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateParameterCacheSources() {
+    size_t cacheSize = 0;
+    for (const auto& it : _parameterCacheFunctions)
+        cacheSize += it.second;
+
+    LanguageC<Base> langC(_baseTypeName);
+    std::string argsDcl = langC.generateDefaultFunctionArgumentsDcl();
+
+    /**
+     * parameter information
+     */
+    std::string funcName = _name + "_" + FUNCTION_PARAMETER_INFO;
+
+    _cache.str("");
+    LanguageC<Base>::printFunctionDeclaration(_cache, "void", funcName, {"unsigned long const** indexes",
+                                                                         "unsigned long* n",
+                                                                         "unsigned long* cacheSize",
+                                                                         "const char*** functions",
+                                                                         "unsigned long const** offsets",
+                                                                         "unsigned long* nFunctions"});
+    _cache << " {\n"
+            "   static unsigned long const idx[] = {";
+    size_t e = 0;
+    for (size_t j : _parameterIndep) {
+        if (e++ > 0) _cache << ", ";
+        _cache << j;
+    }
+    _cache << "};\n"
+            "   static const char* funcs[] = {";
+    e = 0;
+    for (const auto& it : _parameterCacheFunctions) {
+        if (e++ > 0) _cache << ", ";
+        _cache << "\"" << it.first << "\"";
+    }
+    if (_parameterCacheFunctions.empty())
+        _cache << "0";
+    _cache << "};\n"
+            "   static unsigned long const offs[] = {";
+    size_t offset = 0;
+    e = 0;
+    for (const auto& it : _parameterCacheFunctions) {
+        if (e++ > 0) _cache << ", ";
+        _cache << offset;
+        offset += it.second;
+    }
+    if (_parameterCacheFunctions.empty())
+        _cache << "0";
+    _cache << "};\n"
+            "   *indexes = idx;\n"
+            "   *n = " << _parameterIndep.size() << ";\n"
+            "   *cacheSize = " << cacheSize << ";\n"
+            "   *functions = funcs;\n"
+            "   *offsets = offs;\n"
+            "   *nFunctions = " << _parameterCacheFunctions.size() << ";\n"
+            "}\n";
+
+    _sources[funcName + ".c"] = _cache.str();
+
+    /**
+     * evaluation of all cached values
+     */
+    funcName = _name + "_" + FUNCTION_PRECOMPUTE_PARAMETERS;
+
+    _cache.str("");
+    _cache << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n"
+            "\n";
+    for (const auto& it : _parameterCacheFunctions) {
+        _cache << "void " << _name << "_" << it.first << "_" << FUNCTION_PRECOMPUTE_PARAMETERS << "(" << argsDcl << ");\n";
+    }
+    _cache << "\n";
+    LanguageC<Base>::printFunctionDeclaration(_cache, "void", funcName, {_baseTypeName + " const *const * in",
+                                                                         _baseTypeName + "* cache",
+                                                                         langC.generateArgumentAtomicDcl()});
+    _cache << " {\n"
+            "   " << _baseTypeName << "* out[1];\n"
+            "\n";
+    offset = 0;
+    for (const auto& it : _parameterCacheFunctions) {
+        _cache << "   out[0] = &cache[" << offset << "];\n"
+                "   " << _name << "_" << it.first << "_" << FUNCTION_PRECOMPUTE_PARAMETERS << "(in, out, atomicFun);\n";
+        offset += it.second;
+    }
+    _cache << "}\n";
+
+    _sources[funcName + ".c"] = _cache.str();
+    _cache.str("");
+}
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -87,15 +87,10 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSourcesWithAtomics(const std
         startingJob("'" + subJobName + "'", JobTimer::GRAPH);
 
         CodeHandler<Base> handler;
-        handler.setJobTimer(_jobTimer);
+        prepareCodeHandler(handler);
 
         vector<CGBase> indVars(_fun.Domain());
-        handler.makeVariables(indVars);
-        if (_x.size() > 0) {
-            for (size_t i = 0; i < n; i++) {
-                indVars[i].setValue(_x[i]);
-            }
-        }
+        makeIndependentVariables(handler, indVars);
 
         CGBase py;
         handler.makeVariable(py);
@@ -121,9 +116,14 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSourcesWithAtomics(const std
         LanguageC<Base> langC(_baseTypeName);
         langC.setMaxAssigmentsPerFunction(_maxAssignPerFunc, &_sources);
         langC.setParameterPrecision(_parameterPrecision);
+        langC.setFuseTranscendentalFunctions(_fuseTranscendentals);
+        langC.setSplitMinimizingLiveVariables(_splitMinimizeLive);
+        langC.setConstantPool(_constantPool);
+        langC.setVectorizeLoops(_vectorizeLoops);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_ONE << "_dep" << i;
         langC.setGenerateFunction(_cache.str());
+        estimateFunctionCost(_cache.str(), dwCustom);
 
         std::ostringstream code;
         std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("dw"));
@@ -144,15 +144,10 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSourcesNoAtomics(const std::
     size_t n = _fun.Domain();
 
     CodeHandler<Base> handler;
-    handler.setJobTimer(_jobTimer);
+    prepareCodeHandler(handler);
 
     vector<CGBase> x(n);
-    handler.makeVariables(x);
-    if (_x.size() > 0) {
-        for (size_t i = 0; i < n; i++) {
-            x[i].setValue(_x[i]);
-        }
-    }
+    makeIndependentVariables(handler, x);
 
     CGBase py;
     handler.makeVariable(py);
@@ -208,9 +203,14 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSourcesNoAtomics(const std::
         LanguageC<Base> langC(_baseTypeName);
         langC.setMaxAssigmentsPerFunction(_maxAssignPerFunc, &_sources);
         langC.setParameterPrecision(_parameterPrecision);
+        langC.setFuseTranscendentalFunctions(_fuseTranscendentals);
+        langC.setSplitMinimizingLiveVariables(_splitMinimizeLive);
+        langC.setConstantPool(_constantPool);
+        langC.setVectorizeLoops(_vectorizeLoops);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_ONE << "_dep" << i;
         langC.setGenerateFunction(_cache.str());
+        estimateFunctionCost(_cache.str(), dwCustom);
 
         std::ostringstream code;
         std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("dw"));
@@ -87,15 +87,10 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesWithAtomics(const std
         startingJob("'" + subJobName + "'", JobTimer::GRAPH);
 
         CodeHandler<Base> handler;
-        handler.setJobTimer(_jobTimer);
+        prepareCodeHandler(handler);
 
         vector<CGBase> tx0(n);
-        handler.makeVariables(tx0);
-        if (_x.size() > 0) {
-            for (size_t i = 0; i < n; i++) {
-                tx0[i].setValue(_x[i]);
-            }
-        }
+        makeIndependentVariables(handler, tx0);
 
         CGBase tx1;
         handler.makeVariable(tx1);
@@ -129,9 +124,14 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesWithAtomics(const std
         LanguageC<Base> langC(_baseTypeName);
         langC.setMaxAssigmentsPerFunction(_maxAssignPerFunc, &_sources);
         langC.setParameterPrecision(_parameterPrecision);
+        langC.setFuseTranscendentalFunctions(_fuseTranscendentals);
+        langC.setSplitMinimizingLiveVariables(_splitMinimizeLive);
+        langC.setConstantPool(_constantPool);
+        langC.setVectorizeLoops(_vectorizeLoops);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_TWO << "_indep" << j;
         langC.setGenerateFunction(_cache.str());
+        estimateFunctionCost(_cache.str(), pxCustom);
 
         std::ostringstream code;
         std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("px"));
@@ -165,15 +165,10 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesNoAtomics(const std::
 
     // we can use a new handler to reduce memory usage
     CodeHandler<Base> handler;
-    handler.setJobTimer(_jobTimer);
+    prepareCodeHandler(handler);
 
     vector<CGBase> tx0(n);
-    handler.makeVariables(tx0);
-    if (_x.size() > 0) {
-        for (size_t i = 0; i < n; i++) {
-            tx0[i].setValue(_x[i]);
-        }
-    }
+    makeIndependentVariables(handler, tx0);
 
     CGBase tx1;
     handler.makeVariable(tx1);
@@ -231,9 +226,14 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesNoAtomics(const std::
         LanguageC<Base> langC(_baseTypeName);
         langC.setMaxAssigmentsPerFunction(_maxAssignPerFunc, &_sources);
         langC.setParameterPrecision(_parameterPrecision);
+        langC.setFuseTranscendentalFunctions(_fuseTranscendentals);
+        langC.setSplitMinimizingLiveVariables(_splitMinimizeLive);
+        langC.setConstantPool(_constantPool);
+        langC.setVectorizeLoops(_vectorizeLoops);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_TWO << "_indep" << j;
         langC.setGenerateFunction(_cache.str());
+        estimateFunctionCost(_cache.str(), pxCustom);
 
         std::ostringstream code;
         std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("px"));
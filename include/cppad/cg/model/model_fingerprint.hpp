@@ -0,0 +1,118 @@
+#ifndef CPPAD_CG_MODEL_FINGERPRINT_INCLUDED
+#define CPPAD_CG_MODEL_FINGERPRINT_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Accumulates a 64 bit hash (FNV-1a) of the information which determines
+ * the generated and compiled code of a model.
+ * It is used to decide whether or not previously compiled object files
+ * can be reused.
+ *
+ * @author Joao Leal
+ */
+class ModelFingerprint {
+private:
+    uint64_t _hash;
+public:
+
+    inline ModelFingerprint() :
+        _hash(14695981039346656037ull) {
+    }
+
+    inline void addBytes(const void* data,
+                         size_t size) {
+        const unsigned char* b = static_cast<const unsigned char*> (data);
+        for (size_t i = 0; i < size; i++) {
+            _hash ^= b[i];
+            _hash *= 1099511628211ull;
+        }
+    }
+
+    inline ModelFingerprint& operator<<(const std::string& s) {
+        *this << s.size();
+        addBytes(s.data(), s.size());
+        return *this;
+    }
+
+    inline ModelFingerprint& operator<<(const char* s) {
+        return *this << std::string(s);
+    }
+
+    inline ModelFingerprint& operator<<(bool v) {
+        return *this << size_t(v ? 1 : 0);
+    }
+
+    inline ModelFingerprint& operator<<(size_t v) {
+        uint64_t v64 = v;
+        addBytes(&v64, sizeof(v64));
+        return *this;
+    }
+
+    inline ModelFingerprint& operator<<(double v) {
+        addBytes(&v, sizeof(v));
+        return *this;
+    }
+
+    inline ModelFingerprint& operator<<(float v) {
+        addBytes(&v, sizeof(v));
+        return *this;
+    }
+
+    template<class T>
+    inline ModelFingerprint& operator<<(const std::vector<T>& v) {
+        *this << v.size();
+        for (const T& e : v)
+            *this << e;
+        return *this;
+    }
+
+    template<class T>
+    inline ModelFingerprint& operator<<(const std::set<T>& v) {
+        *this << v.size();
+        for (const T& e : v)
+            *this << e;
+        return *this;
+    }
+
+    template<class K, class V>
+    inline ModelFingerprint& operator<<(const std::map<K, V>& v) {
+        *this << v.size();
+        for (const auto& e : v)
+            *this << e.first << e.second;
+        return *this;
+    }
+
+    inline uint64_t getHash() const {
+        return _hash;
+    }
+
+    /**
+     * Provides the hash as an hexadecimal string.
+     */
+    inline std::string toString() const {
+        std::ostringstream os;
+        os << std::hex << std::setw(16) << std::setfill('0') << _hash;
+        return os.str();
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -134,6 +134,78 @@ public:
      */
     virtual unsigned int getThreadPoolNumberOfTimeMeas() const = 0;
 
+    /**
+     * Defines the CPUs where the threads of the thread pool run.
+     * This value is only used by the models if they were compiled with
+     * multithreading support (PThreads).
+     * It must be defined before the thread pool is created, that is, before
+     * using the models.
+     *
+     * @param policy how threads are bound to CPUs
+     * @param cpus the CPUs which can be used by the threads (an empty list
+     *             uses all the CPUs where the process is allowed to run)
+     */
+    virtual void setThreadPoolAffinity(ThreadPoolAffinityPolicy policy,
+                                       const std::vector<int>& cpus = std::vector<int>()) = 0;
+
+    /**
+     * Provides how the threads of the thread pool are bound to CPUs.
+     *
+     * @return the thread affinity policy
+     */
+    virtual ThreadPoolAffinityPolicy getThreadPoolAffinityPolicy() const = 0;
+
+    /**
+     * Provides the CPUs which can be used by the threads of the thread pool.
+     *
+     * @return the CPUs (an empty list if all the CPUs where the process is
+     *         allowed to run are used)
+     */
+    virtual std::vector<int> getThreadPoolAffinityCpus() const = 0;
+
+    /**
+     * Defines whether or not the jobs of a sparse Jacobian or a sparse
+     * Hessian are always executed by the same threads.
+     * Each thread is given a contiguous range of jobs the first time a
+     * model function is called so that the same thread always writes to
+     * the same region of the output (consistent with the first touch
+     * placement of memory pages on NUMA systems).
+     * This value is only used by the models if they were compiled with
+     * multithreading support (PThreads).
+     *
+     * @param sticky true to always use the same threads for each job
+     */
+    virtual void setThreadPoolStickyJobs(bool sticky) = 0;
+
+    /**
+     * Determines whether or not the jobs of a sparse Jacobian or a sparse
+     * Hessian are always executed by the same threads.
+     *
+     * @return true if the same threads are always used for each job
+     */
+    virtual bool isThreadPoolStickyJobs() const = 0;
+
+    /**
+     * Defines the number of iterations a thread waits actively for new
+     * work (or for the work to complete) before it is suspended.
+     * Higher values reduce the latency of repeated model evaluations at
+     * the cost of CPU usage.
+     * This value is only used by the models if they were compiled with
+     * multithreading support (PThreads).
+     *
+     * @param iterations the number of iterations (zero to block
+     *                   immediately)
+     */
+    virtual void setThreadPoolSpinWait(unsigned int iterations) = 0;
+
+    /**
+     * Provides the number of iterations a thread waits actively for new
+     * work (or for the work to complete) before it is suspended.
+     *
+     * @return the number of iterations
+     */
+    virtual unsigned int getThreadPoolSpinWait() const = 0;
+
     inline virtual ~ModelLibrary() {
     }
 
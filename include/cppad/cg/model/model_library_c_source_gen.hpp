@@ -41,6 +41,14 @@ public:
     static const std::string FUNCTION_GETTHREADPOOLGUIDEDMAXGROUPWORK;
     static const std::string FUNCTION_SETTHREADPOOLNUMBEROFTIMEMEAS;
     static const std::string FUNCTION_GETTHREADPOOLNUMBEROFTIMEMEAS;
+    static const std::string FUNCTION_SETTHREADPOOLAFFINITY;
+    static const std::string FUNCTION_GETTHREADPOOLAFFINITYPOLICY;
+    static const std::string FUNCTION_GETTHREADPOOLAFFINITYCPUS;
+    static const std::string FUNCTION_SETTHREADPOOLSTICKYJOBS;
+    static const std::string FUNCTION_ISTHREADPOOLSTICKYJOBS;
+    static const std::string FUNCTION_SETTHREADPOOLSPINWAIT;
+    static const std::string FUNCTION_GETTHREADPOOLSPINWAIT;
+    static const std::string FUNCTION_MODELLIBRARIES;
     static const unsigned long API_VERSION;
 protected:
     static const std::string CONST;
@@ -63,6 +71,21 @@ protected:
      * Parallelization can be disabled locally for each model.
      */
     MultiThreadingType _multiThreading;
+    /**
+     * Whether or not models in this library which use other models from
+     * the same library as atomic functions call the generated functions
+     * of those models directly
+     */
+    bool _directlyLinkNested;
+    /**
+     * Whether or not the long constant values of all models are saved in
+     * a single table
+     */
+    bool _useConstantPool;
+    /**
+     * The distinct long constant values used by the models
+     */
+    LangCConstantPool _constantPool;
     /**
      * temporary stream to generate source code
      */
@@ -77,7 +100,9 @@ public:
      *              this object)
      */
     inline ModelLibraryCSourceGen(ModelCSourceGen<Base>& model):
-        _multiThreading(MultiThreadingType::NONE) {
+        _multiThreading(MultiThreadingType::NONE),
+        _directlyLinkNested(false),
+        _useConstantPool(false) {
         CPPADCG_ASSERT_KNOWN(_models.find(model.getName()) == _models.end(),
                              "Another model with the same name was already registered");
 
@@ -110,6 +135,8 @@ public:
                              "Another model with the same name was already registered");
 
         _models[model.getName()] = &model;
+        if (_useConstantPool)
+            model.setConstantPool(&_constantPool);
 
         _libSources.clear(); // must regenerate library sources again
     }
@@ -158,6 +185,77 @@ public:
         _multiThreading = multiThreading;
     }
 
+    /**
+     * Whether or not the atomic functions of a model which correspond to
+     * other models in this library are evaluated by calling the generated
+     * C functions of those models directly.
+     *
+     * @return true if nested models are linked directly
+     */
+    inline bool isDirectlyLinkNestedModels() const {
+        return _directlyLinkNested;
+    }
+
+    /**
+     * Defines whether or not the atomic functions of a model which
+     * correspond to other models in this library (with the same name) are
+     * evaluated by calling the generated C functions of those models
+     * directly, instead of going through the runtime callbacks of
+     * FunctorGenericModel (external functions).
+     * A model is only linked directly if all the atomic functions it uses
+     * can also be linked directly.
+     * Directly linked atomic functions do not need to be provided with
+     * GenericModel::addAtomicFunction() or GenericModel::addExternalModel()
+     * and any function provided for them is ignored.
+     * The forward and reverse modes used by the caller must be
+     * generated for the nested model (e.g. setCreateForwardOne()).
+     *
+     * @param directlyLink whether or not to link nested models directly
+     */
+    inline void setDirectlyLinkNestedModels(bool directlyLink) {
+        _directlyLinkNested = directlyLink;
+        _libSources.clear(); // must regenerate library sources again
+    }
+
+    /**
+     * Whether or not the long constant values of the models are saved in
+     * a single table shared by all the models.
+     */
+    inline bool isUseConstantPool() const {
+        return _useConstantPool;
+    }
+
+    /**
+     * Defines whether or not the long constant values of all the models
+     * in this library are saved only once in a constant array (created in
+     * its own source file) instead of being printed wherever they are used.
+     * This reduces the size of the generated sources and of the compiled
+     * library when the same values are used many times.
+     * It must be defined before the model sources are generated.
+     *
+     * @param usePool whether or not to use a table of constants
+     * @see getConstantPool()
+     */
+    inline void setUseConstantPool(bool usePool) {
+        _useConstantPool = usePool;
+        for (const auto& it : _models) {
+            it.second->setConstantPool(usePool ? &_constantPool : nullptr);
+        }
+        _libSources.clear(); // must regenerate library sources again
+    }
+
+    /**
+     * Provides the table of constants shared by the models (e.g. to define
+     * the name of the constant array and the literals which are saved).
+     */
+    inline LangCConstantPool& getConstantPool() {
+        return _constantPool;
+    }
+
+    inline const LangCConstantPool& getConstantPool() const {
+        return _constantPool;
+    }
+
     /**
      * Saves the generated C source code into several files.
      * 
@@ -184,8 +282,24 @@ protected:
 
     virtual void generateOnCloseSource(std::map<std::string, std::string>& sources);
 
+    virtual void generateConstantPoolSource(std::map<std::string, std::string>& sources);
+
     virtual void generateThreadPoolSources(std::map<std::string, std::string>& sources);
 
+    /**
+     * Generates the functions which allow models to call other models
+     * from the same library directly when they are used as atomic
+     * functions.
+     */
+    virtual void generateDirectAtomicSources(std::map<std::string, std::string>& sources);
+
+    virtual void generateDirectAtomicSource(ModelCSourceGen<Base>& model,
+                                            std::map<std::string, std::string>& sources);
+
+    virtual void generateAtomicDispatchSource(ModelCSourceGen<Base>& model,
+                                              const std::set<std::string>& linkable,
+                                              std::map<std::string, std::string>& sources);
+
     static void saveSources(const std::string& sourcesFolder,
                             const std::map<std::string, std::string>& sources);
 
@@ -68,6 +68,30 @@ const std::string ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLNUMBEROFTI
 template<class Base>
 const std::string ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLNUMBEROFTIMEMEAS = "cppad_cg_thpool_get_number_of_time_meas";
 
+template<class Base>
+const std::string ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLAFFINITY = "cppad_cg_thpool_set_affinity";
+
+template<class Base>
+const std::string ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLAFFINITYPOLICY = "cppad_cg_thpool_get_affinity_policy";
+
+template<class Base>
+const std::string ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLAFFINITYCPUS = "cppad_cg_thpool_get_affinity_cpus";
+
+template<class Base>
+const std::string ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLSTICKYJOBS = "cppad_cg_thpool_set_sticky_jobs";
+
+template<class Base>
+const std::string ModelLibraryCSourceGen<Base>::FUNCTION_ISTHREADPOOLSTICKYJOBS = "cppad_cg_thpool_is_sticky_jobs";
+
+template<class Base>
+const std::string ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLSPINWAIT = "cppad_cg_thpool_set_spin_wait";
+
+template<class Base>
+const std::string ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLSPINWAIT = "cppad_cg_thpool_get_spin_wait";
+
+template<class Base>
+const std::string ModelLibraryCSourceGen<Base>::FUNCTION_MODELLIBRARIES = "cppad_cg_model_libraries";
+
 template<class Base>
 const std::string ModelLibraryCSourceGen<Base>::CONST = "const";
 
@@ -110,6 +134,14 @@ const std::map<std::string, std::string>& ModelLibraryCSourceGen<Base>::getLibra
         generateOnCloseSource(_libSources);
         generateThreadPoolSources(_libSources);
 
+        if (_useConstantPool) {
+            generateConstantPoolSource(_libSources);
+        }
+
+        if (_directlyLinkNested) {
+            generateDirectAtomicSources(_libSources);
+        }
+
         if(_multiThreading != MultiThreadingType::NONE) {
             bool usingMultiThreading = false;
             for (const auto& it : _models) {
@@ -190,6 +222,18 @@ void ModelLibraryCSourceGen<Base>::generateOnCloseSource(std::map<std::string, s
     sources[FUNCTION_ONCLOSE + ".c"] = _cache.str();
 }
 
+template<class Base>
+void ModelLibraryCSourceGen<Base>::generateConstantPoolSource(std::map<std::string, std::string>& sources) {
+    // the table can only be created after all the values are known
+    for (const auto& it : _models) {
+        it.second->getSources(_multiThreading, this);
+    }
+
+    if (!_constantPool.empty()) {
+        sources[_constantPool.getName() + ".c"] = _constantPool.generateDefinition(ModelCSourceGen<Base>::baseTypeName());
+    }
+}
+
 template<class Base>
 void ModelLibraryCSourceGen<Base>::generateThreadPoolSources(std::map<std::string, std::string>& sources) {
 
@@ -255,6 +299,34 @@ void ModelLibraryCSourceGen<Base>::generateThreadPoolSources(std::map<std::strin
         _cache << "   return cppadcg_thpool_get_n_time_meas();\n";
         _cache << "}\n\n";
 
+        _cache << "void " << FUNCTION_SETTHREADPOOLAFFINITY << "(int policy, const int* cpus, int n) {\n";
+        _cache << "   cppadcg_thpool_set_affinity((enum ThreadAffinityPolicy) policy, cpus, n);\n";
+        _cache << "}\n\n";
+
+        _cache << "int " << FUNCTION_GETTHREADPOOLAFFINITYPOLICY << "() {\n";
+        _cache << "   return cppadcg_thpool_get_affinity_policy();\n";
+        _cache << "}\n\n";
+
+        _cache << "int " << FUNCTION_GETTHREADPOOLAFFINITYCPUS << "(int* cpus, int max) {\n";
+        _cache << "   return cppadcg_thpool_get_affinity_cpus(cpus, max);\n";
+        _cache << "}\n\n";
+
+        _cache << "void " << FUNCTION_SETTHREADPOOLSTICKYJOBS << "(int sticky) {\n";
+        _cache << "   cppadcg_thpool_set_sticky_jobs(sticky);\n";
+        _cache << "}\n\n";
+
+        _cache << "int " << FUNCTION_ISTHREADPOOLSTICKYJOBS << "() {\n";
+        _cache << "   return cppadcg_thpool_is_sticky_jobs();\n";
+        _cache << "}\n\n";
+
+        _cache << "void " << FUNCTION_SETTHREADPOOLSPINWAIT << "(unsigned int n) {\n";
+        _cache << "   cppadcg_thpool_set_spin_wait(n);\n";
+        _cache << "}\n\n";
+
+        _cache << "unsigned int " << FUNCTION_GETTHREADPOOLSPINWAIT << "() {\n";
+        _cache << "   return cppadcg_thpool_get_spin_wait();\n";
+        _cache << "}\n\n";
+
         sources["thread_pool_access.c"] = _cache.str();
 
     } else if(usingMultiThreading && _multiThreading == MultiThreadingType::OPENMP) {
@@ -308,6 +380,31 @@ void ModelLibraryCSourceGen<Base>::generateThreadPoolSources(std::map<std::strin
         _cache << "   return 0;\n";
         _cache << "}\n\n";
 
+        _cache << "void " << FUNCTION_SETTHREADPOOLAFFINITY << "(int policy, const int* cpus, int n) {\n";
+        _cache << "}\n\n";
+
+        _cache << "int " << FUNCTION_GETTHREADPOOLAFFINITYPOLICY << "() {\n";
+        _cache << "   return 0;\n";
+        _cache << "}\n\n";
+
+        _cache << "int " << FUNCTION_GETTHREADPOOLAFFINITYCPUS << "(int* cpus, int max) {\n";
+        _cache << "   return 0;\n";
+        _cache << "}\n\n";
+
+        _cache << "void " << FUNCTION_SETTHREADPOOLSTICKYJOBS << "(int sticky) {\n";
+        _cache << "}\n\n";
+
+        _cache << "int " << FUNCTION_ISTHREADPOOLSTICKYJOBS << "() {\n";
+        _cache << "   return 0;\n";
+        _cache << "}\n\n";
+
+        _cache << "void " << FUNCTION_SETTHREADPOOLSPINWAIT << "(unsigned int n) {\n";
+        _cache << "}\n\n";
+
+        _cache << "unsigned int " << FUNCTION_GETTHREADPOOLSPINWAIT << "() {\n";
+        _cache << "   return 0;\n";
+        _cache << "}\n\n";
+
         sources["thread_pool_access.c"] = _cache.str();
 
     } else {
@@ -356,10 +453,443 @@ void ModelLibraryCSourceGen<Base>::generateThreadPoolSources(std::map<std::strin
         _cache << "   return 0;\n";
         _cache << "}\n\n";
 
+        _cache << "void " << FUNCTION_SETTHREADPOOLAFFINITY << "(int policy, const int* cpus, int n) {\n";
+        _cache << "}\n\n";
+
+        _cache << "int " << FUNCTION_GETTHREADPOOLAFFINITYPOLICY << "() {\n";
+        _cache << "   return 0;\n";
+        _cache << "}\n\n";
+
+        _cache << "int " << FUNCTION_GETTHREADPOOLAFFINITYCPUS << "(int* cpus, int max) {\n";
+        _cache << "   return 0;\n";
+        _cache << "}\n\n";
+
+        _cache << "void " << FUNCTION_SETTHREADPOOLSTICKYJOBS << "(int sticky) {\n";
+        _cache << "}\n\n";
+
+        _cache << "int " << FUNCTION_ISTHREADPOOLSTICKYJOBS << "() {\n";
+        _cache << "   return 0;\n";
+        _cache << "}\n\n";
+
+        _cache << "void " << FUNCTION_SETTHREADPOOLSPINWAIT << "(unsigned int n) {\n";
+        _cache << "}\n\n";
+
+        _cache << "unsigned int " << FUNCTION_GETTHREADPOOLSPINWAIT << "() {\n";
+        _cache << "   return 0;\n";
+        _cache << "}\n\n";
+
         sources["thread_pool_access.c"] = _cache.str();
     }
 }
 
+
+template<class Base>
+void ModelLibraryCSourceGen<Base>::generateDirectAtomicSources(std::map<std::string, std::string>& sources) {
+    /**
+     * the names of the atomic functions are only known after the model
+     * sources are generated
+     */
+    std::set<std::string> linkable;
+    for (const auto& it : _models) {
+        it.second->getSources(_multiThreading, this);
+        if (it.second->getParameterIndependents().empty()) // the parameter cache is only managed by the library
+            linkable.insert(it.first);
+    }
+
+    /**
+     * a model can only be called directly if all its atomic functions can
+     * also be called directly
+     */
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (const auto& it : _models) {
+            if (linkable.find(it.first) == linkable.end())
+                continue;
+
+            for (const std::string& atomicName : it.second->_atomicFunctions) {
+                if (linkable.find(atomicName) == linkable.end()) {
+                    linkable.erase(it.first);
+                    changed = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    std::set<std::string> called;
+    for (const auto& it : _models) {
+        bool used = false;
+        for (const std::string& atomicName : it.second->_atomicFunctions) {
+            if (linkable.find(atomicName) != linkable.end()) {
+                called.insert(atomicName);
+                used = true;
+            }
+        }
+
+        if (used) {
+            generateAtomicDispatchSource(*it.second, linkable, sources);
+        }
+    }
+
+    for (const std::string& name : called) {
+        generateDirectAtomicSource(*_models.at(name), sources);
+    }
+}
+
+template<class Base>
+void ModelLibraryCSourceGen<Base>::generateDirectAtomicSource(ModelCSourceGen<Base>& model,
+                                                              std::map<std::string, std::string>& sources) {
+    typedef ModelCSourceGen<Base> MSG;
+
+    const std::string& name = model.getName();
+    const std::string& baseType = model._baseTypeName;
+    const size_t m = model._fun.Range();
+    const size_t n = model._fun.Domain();
+    const bool atomics = !model._atomicFunctions.empty();
+
+    LanguageC<Base> langC(baseType);
+    std::string argsDcl = langC.generateDefaultFunctionArgumentsDcl();
+    std::string args = langC.generateDefaultFunctionArguments();
+
+    /**
+     * large work arrays are not placed on the stack
+     */
+    const size_t maxStackSize = 4096;
+    auto printCompressedDcl = [&](size_t size) {
+        if (size <= maxStackSize) {
+            _cache << "   " << baseType << " compressed[" << std::max<size_t>(size, 1) << "];\n";
+        } else {
+            _cache << "   " << baseType << "* compressed;\n";
+        }
+    };
+    auto printCompressedAlloc = [&](size_t size, const std::string& indent) {
+        if (size > maxStackSize) {
+            _cache << indent << "compressed = (" << baseType << "*) malloc(" << size << " * sizeof(" << baseType << "));\n"
+                    << indent << "if (compressed == NULL)\n"
+                    << indent << "   return 0; // failure to allocate memory\n";
+        }
+    };
+    auto printCompressedFree = [&](size_t size, const std::string& indent) {
+        if (size > maxStackSize) {
+            _cache << indent << "free(compressed);\n";
+        }
+    };
+    auto printAtomicFunInit = [&]() {
+        _cache << "   atomicFun.libModel = 0;\n";
+        if (atomics) {
+            _cache << "   atomicFun.forward = " << name << "_" << MSG::FUNCTION_ATOMIC_FORWARD << ";\n"
+                    "   atomicFun.reverse = " << name << "_" << MSG::FUNCTION_ATOMIC_REVERSE << ";\n";
+        } else {
+            _cache << "   atomicFun.forward = 0;\n"
+                    "   atomicFun.reverse = 0;\n";
+        }
+    };
+
+    _cache.str("");
+    _cache << "#include <stdlib.h>\n"
+            << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n"
+            "\n";
+    if (model._zero) {
+        _cache << "void " << name << "_" << MSG::FUNCTION_FORWAD_ZERO << "(" << argsDcl << ");\n";
+    }
+    if (model._forwardOne) {
+        _cache << "int " << name << "_" << MSG::FUNCTION_SPARSE_FORWARD_ONE << "(unsigned long pos, " << argsDcl << ");\n"
+                "void " << name << "_" << MSG::FUNCTION_FORWARD_ONE_SPARSITY << "(unsigned long pos, unsigned long const** elements, unsigned long* nnz);\n";
+    }
+    if (model._reverseOne) {
+        _cache << "int " << name << "_" << MSG::FUNCTION_SPARSE_REVERSE_ONE << "(unsigned long pos, " << argsDcl << ");\n"
+                "void " << name << "_" << MSG::FUNCTION_REVERSE_ONE_SPARSITY << "(unsigned long pos, unsigned long const** elements, unsigned long* nnz);\n";
+    }
+    if (model._reverseTwo) {
+        _cache << "int " << name << "_" << MSG::FUNCTION_SPARSE_REVERSE_TWO << "(unsigned long pos, " << argsDcl << ");\n"
+                "void " << name << "_" << MSG::FUNCTION_REVERSE_TWO_SPARSITY << "(unsigned long pos, unsigned long const** elements, unsigned long* nnz);\n";
+    }
+    if (atomics) {
+        _cache << "int " << name << "_" << MSG::FUNCTION_ATOMIC_FORWARD << "(void* libModel, int atomicIndex, int q, int p, const Array tx[], Array* ty);\n"
+                "int " << name << "_" << MSG::FUNCTION_ATOMIC_REVERSE << "(void* libModel, int atomicIndex, int p, const Array tx[], Array* px, const Array py[]);\n";
+    }
+    _cache << "\n";
+
+    /**
+     * forward mode
+     */
+    LanguageC<Base>::printFunctionDeclaration(_cache, "int", name + "_" + MSG::FUNCTION_DIRECT_FORWARD, {"int q",
+                                                                                                       "int p",
+                                                                                                       "const Array tx[]",
+                                                                                                       "Array* ty"});
+    _cache << " {\n"
+            "   unsigned long e, ePos, j, nnz, nnzTx;\n"
+            "   unsigned long const* pos;\n"
+            "   " << baseType << " const * in[2];\n"
+            "   " << baseType << "* out[1];\n"
+            "   " << baseType << " const * tx1;\n"
+            "   " << baseType << "* y;\n";
+    printCompressedDcl(m);
+    _cache << "   struct LangCAtomicFun atomicFun;\n"
+            "\n"
+            "   (void) q;\n";
+    printAtomicFunInit();
+    _cache << "\n"
+            "   if (tx[0].sparse || ty->sparse)\n"
+            "      return 0;\n"
+            "\n"
+            "   in[0] = (" << baseType << " const *) tx[0].data;\n"
+            "   y = (" << baseType << "*) ty->data;\n"
+            "\n";
+    if (model._zero) {
+        _cache << "   if (p == 0) {\n"
+                "      out[0] = y;\n"
+                "      " << name << "_" << MSG::FUNCTION_FORWAD_ZERO << "(" << args << ");\n"
+                "      return 1;\n"
+                "   }\n"
+                "\n";
+    }
+    if (model._forwardOne) {
+        _cache << "   if (p == 1) {\n"
+                "      tx1 = (" << baseType << " const *) tx[1].data;\n"
+                "      nnzTx = tx[1].sparse ? tx[1].nnz : tx[1].size;\n"
+                "      for (ePos = 0; ePos < " << m << "; ePos++)\n"
+                "         y[ePos] = 0;\n";
+        printCompressedAlloc(m, "      ");
+        _cache << "      out[0] = compressed;\n"
+                "\n"
+                "      for (e = 0; e < nnzTx; e++) {\n"
+                "         if (tx[1].sparse) {\n"
+                "            j = tx[1].idx[e];\n"
+                "         } else if (tx1[e] != 0) {\n"
+                "            j = e;\n"
+                "         } else {\n"
+                "            continue;\n"
+                "         }\n"
+                "         " << name << "_" << MSG::FUNCTION_FORWARD_ONE_SPARSITY << "(j, &pos, &nnz);\n"
+                "         for (ePos = 0; ePos < nnz; ePos++)\n"
+                "            compressed[ePos] = 0;\n"
+                "\n"
+                "         in[1] = &tx1[e];\n"
+                "         if (" << name << "_" << MSG::FUNCTION_SPARSE_FORWARD_ONE << "(j, " << args << ") != 0) {\n";
+        printCompressedFree(m, "            ");
+        _cache << "            return 0;\n"
+                "         }\n"
+                "\n"
+                "         for (ePos = 0; ePos < nnz; ePos++)\n"
+                "            y[pos[ePos]] += compressed[ePos];\n"
+                "      }\n";
+        printCompressedFree(m, "      ");
+        _cache << "      return 1;\n"
+                "   }\n"
+                "\n";
+    }
+    _cache << "   return 0;\n"
+            "}\n"
+            "\n";
+
+    /**
+     * reverse mode
+     */
+    LanguageC<Base>::printFunctionDeclaration(_cache, "int", name + "_" + MSG::FUNCTION_DIRECT_REVERSE, {"int p",
+                                                                                                       "const Array tx[]",
+                                                                                                       "Array* px",
+                                                                                                       "const Array py[]"});
+    _cache << " {\n"
+            "   unsigned long e, ePos, i, j, nnz, nnzPy, nnzTx;\n"
+            "   unsigned long const* pos;\n"
+            "   " << baseType << " const * in[3];\n"
+            "   " << baseType << "* out[1];\n"
+            "   " << baseType << " const * tx1;\n"
+            "   " << baseType << " const * py0;\n"
+            "   " << baseType << "* pxd;\n";
+    printCompressedDcl(n);
+    _cache << "   struct LangCAtomicFun atomicFun;\n"
+            "\n";
+    printAtomicFunInit();
+    _cache << "\n"
+            "   if (tx[0].sparse || px->sparse)\n"
+            "      return 0;\n"
+            "\n"
+            "   in[0] = (" << baseType << " const *) tx[0].data;\n"
+            "   pxd = (" << baseType << "*) px->data;\n"
+            "\n";
+    if (model._reverseOne) {
+        _cache << "   if (p == 0) {\n"
+                "      py0 = (" << baseType << " const *) py[0].data;\n"
+                "      nnzPy = py[0].sparse ? py[0].nnz : py[0].size;\n"
+                "      for (ePos = 0; ePos < " << n << "; ePos++)\n"
+                "         pxd[ePos] = 0;\n";
+        printCompressedAlloc(n, "      ");
+        _cache << "      out[0] = compressed;\n"
+                "\n"
+                "      for (e = 0; e < nnzPy; e++) {\n"
+                "         if (py[0].sparse) {\n"
+                "            i = py[0].idx[e];\n"
+                "         } else if (py0[e] != 0) {\n"
+                "            i = e;\n"
+                "         } else {\n"
+                "            continue;\n"
+                "         }\n"
+                "         " << name << "_" << MSG::FUNCTION_REVERSE_ONE_SPARSITY << "(i, &pos, &nnz);\n"
+                "         for (ePos = 0; ePos < nnz; ePos++)\n"
+                "            compressed[ePos] = 0;\n"
+                "\n"
+                "         in[1] = &py0[e];\n"
+                "         if (" << name << "_" << MSG::FUNCTION_SPARSE_REVERSE_ONE << "(i, " << args << ") != 0) {\n";
+        printCompressedFree(n, "            ");
+        _cache << "            return 0;\n"
+                "         }\n"
+                "\n"
+                "         for (ePos = 0; ePos < nnz; ePos++)\n"
+                "            pxd[pos[ePos]] += compressed[ePos];\n"
+                "      }\n";
+        printCompressedFree(n, "      ");
+        _cache << "      return 1;\n"
+                "   }\n"
+                "\n";
+    }
+    if (model._reverseTwo) {
+        _cache << "   if (p == 1) {\n"
+                "      // only the second order reverse mode with zero first order dependent partials is supported\n"
+                "      if (!py[0].sparse || py[0].nnz != 0 || py[1].sparse)\n"
+                "         return 0;\n"
+                "\n"
+                "      tx1 = (" << baseType << " const *) tx[1].data;\n"
+                "      nnzTx = tx[1].sparse ? tx[1].nnz : tx[1].size;\n"
+                "      for (ePos = 0; ePos < " << n << "; ePos++)\n"
+                "         pxd[ePos] = 0;\n";
+        printCompressedAlloc(n, "      ");
+        _cache << "      in[2] = (" << baseType << " const *) py[1].data;\n"
+                "      out[0] = compressed;\n"
+                "\n"
+                "      for (e = 0; e < nnzTx; e++) {\n"
+                "         if (tx[1].sparse) {\n"
+                "            j = tx[1].idx[e];\n"
+                "         } else if (tx1[e] != 0) {\n"
+                "            j = e;\n"
+                "         } else {\n"
+                "            continue;\n"
+                "         }\n"
+                "         " << name << "_" << MSG::FUNCTION_REVERSE_TWO_SPARSITY << "(j, &pos, &nnz);\n"
+                "         for (ePos = 0; ePos < nnz; ePos++)\n"
+                "            compressed[ePos] = 0;\n"
+                "\n"
+                "         in[1] = &tx1[e];\n"
+                "         if (" << name << "_" << MSG::FUNCTION_SPARSE_REVERSE_TWO << "(j, " << args << ") != 0) {\n";
+        printCompressedFree(n, "            ");
+        _cache << "            return 0;\n"
+                "         }\n"
+                "\n"
+                "         for (ePos = 0; ePos < nnz; ePos++)\n"
+                "            pxd[pos[ePos]] += compressed[ePos];\n"
+                "      }\n";
+        printCompressedFree(n, "      ");
+        _cache << "      return 1;\n"
+                "   }\n"
+                "\n";
+    }
+    _cache << "   return 0;\n"
+            "}\n";
+
+    sources[name + "_" + MSG::FUNCTION_DIRECT_FORWARD + ".c"] = _cache.str();
+    _cache.str("");
+}
+
+template<class Base>
+void ModelLibraryCSourceGen<Base>::generateAtomicDispatchSource(ModelCSourceGen<Base>& model,
+                                                                const std::set<std::string>& linkable,
+                                                                std::map<std::string, std::string>& sources) {
+    typedef ModelCSourceGen<Base> MSG;
+
+    const std::string& name = model.getName();
+    const std::vector<std::string>& atomics = model._atomicFunctions;
+
+    _cache.str("");
+    _cache << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n"
+            "\n";
+    std::set<std::string> declared;
+    for (const std::string& atomicName : atomics) {
+        if (linkable.find(atomicName) != linkable.end() && declared.insert(atomicName).second) {
+            _cache << "int " << atomicName << "_" << MSG::FUNCTION_DIRECT_FORWARD << "(int q, int p, const Array tx[], Array* ty);\n"
+                    "int " << atomicName << "_" << MSG::FUNCTION_DIRECT_REVERSE << "(int p, const Array tx[], Array* px, const Array py[]);\n";
+        }
+    }
+    _cache << "\n";
+
+    /**
+     * the list of atomic functions which are called directly
+     */
+    LanguageC<Base>::printFunctionDeclaration(_cache, "void", name + "_" + MSG::FUNCTION_ATOMIC_LINKED, {"int const** linked",
+                                                                                                      "unsigned long* n"});
+    _cache << " {\n"
+            "   static const int l[] = {";
+    for (size_t i = 0; i < atomics.size(); i++) {
+        if (i > 0) _cache << ", ";
+        _cache << (linkable.find(atomics[i]) != linkable.end() ? 1 : 0);
+    }
+    _cache << "};\n"
+            "   *linked = l;\n"
+            "   *n = " << atomics.size() << ";\n"
+            "}\n"
+            "\n";
+
+    /**
+     * forward mode
+     * (libModel is the original atomic function argument used as a fallback)
+     */
+    LanguageC<Base>::printFunctionDeclaration(_cache, "int", name + "_" + MSG::FUNCTION_ATOMIC_FORWARD, {"void* libModel",
+                                                                                                       "int atomicIndex",
+                                                                                                       "int q",
+                                                                                                       "int p",
+                                                                                                       "const Array tx[]",
+                                                                                                       "Array* ty"});
+    _cache << " {\n"
+            "   const struct LangCAtomicFun* fallback;\n"
+            "\n"
+            "   switch (atomicIndex) {\n";
+    for (size_t i = 0; i < atomics.size(); i++) {
+        if (linkable.find(atomics[i]) != linkable.end()) {
+            _cache << "      case " << i << ":\n"
+                    "         return " << atomics[i] << "_" << MSG::FUNCTION_DIRECT_FORWARD << "(q, p, tx, ty);\n";
+        }
+    }
+    _cache << "      default:\n"
+            "         fallback = (const struct LangCAtomicFun*) libModel;\n"
+            "         if (fallback == 0)\n"
+            "            return 0;\n"
+            "         return (*fallback->forward)(fallback->libModel, atomicIndex, q, p, tx, ty);\n"
+            "   }\n"
+            "}\n"
+            "\n";
+
+    /**
+     * reverse mode
+     */
+    LanguageC<Base>::printFunctionDeclaration(_cache, "int", name + "_" + MSG::FUNCTION_ATOMIC_REVERSE, {"void* libModel",
+                                                                                                       "int atomicIndex",
+                                                                                                       "int p",
+                                                                                                       "const Array tx[]",
+                                                                                                       "Array* px",
+                                                                                                       "const Array py[]"});
+    _cache << " {\n"
+            "   const struct LangCAtomicFun* fallback;\n"
+            "\n"
+            "   switch (atomicIndex) {\n";
+    for (size_t i = 0; i < atomics.size(); i++) {
+        if (linkable.find(atomics[i]) != linkable.end()) {
+            _cache << "      case " << i << ":\n"
+                    "         return " << atomics[i] << "_" << MSG::FUNCTION_DIRECT_REVERSE << "(p, tx, px, py);\n";
+        }
+    }
+    _cache << "      default:\n"
+            "         fallback = (const struct LangCAtomicFun*) libModel;\n"
+            "         if (fallback == 0)\n"
+            "            return 0;\n"
+            "         return (*fallback->reverse)(fallback->libModel, atomicIndex, p, tx, px, py);\n"
+            "   }\n"
+            "}\n";
+
+    sources[name + "_" + MSG::FUNCTION_ATOMIC_FORWARD + ".c"] = _cache.str();
+    _cache.str("");
+}
+
 } // END cg namespace
 } // END CppAD namespace
 
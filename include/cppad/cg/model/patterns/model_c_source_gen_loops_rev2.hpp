@@ -67,7 +67,7 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
     size_t n = _fun.Domain();
     
     CodeHandler<Base> handler;
-    handler.setJobTimer(_jobTimer);
+    prepareCodeHandler(handler);
     handler.setZeroDependents(false);
     
     auto& indexJrowDcl = *handler.makeIndexDclrNode("jrow");
@@ -383,6 +383,10 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
             LanguageC<Base> langC(_baseTypeName);
             langC.setFunctionIndexArgument(indexJrowDcl);
             langC.setParameterPrecision(_parameterPrecision);
+            langC.setFuseTranscendentalFunctions(_fuseTranscendentals);
+            langC.setSplitMinimizingLiveVariables(_splitMinimizeLive);
+            langC.setConstantPool(_constantPool);
+            langC.setVectorizeLoops(_vectorizeLoops);
 
             std::ostringstream code;
             std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("px"));
@@ -408,7 +412,8 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
                     "\n"
                     << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n"
                     "\n"
-                    "void " << functionName << "(" << argsDcl << ") {\n";
+                    << langC.generateConstantPoolDeclaration()
+                    << "void " << functionName << "(" << argsDcl << ") {\n";
             nameGenRev2.customFunctionVariableDeclarations(_cache);
             _cache << langC.generateIndependentVariableDeclaration() << "\n";
             _cache << langC.generateDependentVariableDeclaration() << "\n";
@@ -454,7 +459,7 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
 
             // we can use a new handler to reduce memory usage
             CodeHandler<Base> handlerNL;
-            handlerNL.setJobTimer(_jobTimer);
+            prepareCodeHandler(handlerNL);
 
             std::vector<CGBase> tx0(n);
             handlerNL.makeVariables(tx0);
@@ -525,6 +530,10 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
                 LanguageC<Base> langC(_baseTypeName);
                 langC.setMaxAssigmentsPerFunction(_maxAssignPerFunc, &_sources);
                 langC.setParameterPrecision(_parameterPrecision);
+                langC.setFuseTranscendentalFunctions(_fuseTranscendentals);
+                langC.setSplitMinimizingLiveVariables(_splitMinimizeLive);
+                langC.setConstantPool(_constantPool);
+                langC.setVectorizeLoops(_vectorizeLoops);
                 _cache.str("");
                 _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_TWO << "_noloop_indep" << j;
                 string functionName = _cache.str();
@@ -20,6 +20,7 @@
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <sys/stat.h>
+#include <sys/syscall.h>
 
 namespace CppAD {
 namespace cg {
@@ -174,6 +175,28 @@ inline bool isFile(const std::string& path) {
     return false;
 }
 
+inline int createMemoryFile(const std::string& name) {
+#ifdef SYS_memfd_create
+    // file descriptors are inherited by the called executables
+    int fd = (int) syscall(SYS_memfd_create, name.c_str(), 0);
+    if (fd < 0) {
+        char buf[512];
+        throw CGException("Failed to create memory file '", name, "': ", strerror_r(errno, buf, 511));
+    }
+    return fd;
+#else
+    throw CGException("Memory files are not supported by this system");
+#endif
+}
+
+inline std::string memoryFilePath(int fd) {
+    return "/proc/self/fd/" + std::to_string(fd);
+}
+
+inline void closeMemoryFile(int fd) {
+    ::close(fd);
+}
+
 inline void callExecutable(const std::string& executable,
                            const std::vector<std::string>& args,
                            std::string* stdOutErrMessage,
@@ -86,6 +86,34 @@ inline bool isDirectory(const std::string& path);
  */
 inline bool isFile(const std::string& path);
 
+/**
+ * Creates a new file which only exists in memory (system dependent).
+ * The file can be accessed through the path provided by memoryFilePath()
+ * by this process and by the executables it calls, until it is closed.
+ *
+ * @param name a name used to identify the file (not a path)
+ * @return the file descriptor
+ * @throws CGException on failure to create the file
+ */
+inline int createMemoryFile(const std::string& name);
+
+/**
+ * Provides a path to a file created with createMemoryFile()
+ * (system dependent).
+ *
+ * @param fd the file descriptor
+ * @return the path to the file
+ */
+inline std::string memoryFilePath(int fd);
+
+/**
+ * Closes (and deletes) a file created with createMemoryFile()
+ * (system dependent).
+ *
+ * @param fd the file descriptor
+ */
+inline void closeMemoryFile(int fd);
+
 /**
  * Calls an external executable (system dependent).
  * In the case of an error during execution an exception will be thrown.
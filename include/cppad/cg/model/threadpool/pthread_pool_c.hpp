@@ -18,6 +18,10 @@ const char CPPADCG_PTHREAD_POOL_C_FILE[] = R"*=*(/* ----------------------------
  *  https://github.com/Pithikos/C-Thread-Pool/blob/master/thpool.c
  */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* required for the thread affinity */
+#endif
+
 #include <unistd.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -25,13 +29,22 @@ const char CPPADCG_PTHREAD_POOL_C_FILE[] = R"*=*(/* ----------------------------
 #include <errno.h>
 #include <time.h>
 #if defined(__linux__)
+#include <sched.h>
 #include <sys/prctl.h>
 #include <time.h>
 #include <sys/time.h>
+#ifndef __USE_GNU
 #define __USE_GNU /* required before including  resource.h */
+#endif
 #include <sys/resource.h>
 #endif
 
+#if defined(__x86_64__) || defined(__i386__)
+#define CPPADCG_THPOOL_CPU_RELAX() __builtin_ia32_pause()
+#else
+#define CPPADCG_THPOOL_CPU_RELAX() __asm__ __volatile__("" ::: "memory")
+#endif
+
 enum ScheduleStrategy {SCHED_STATIC = 1,
                        SCHED_DYNAMIC = 2,
                        SCHED_GUIDED = 3
@@ -40,6 +53,11 @@ enum ScheduleStrategy {SCHED_STATIC = 1,
 enum ElapsedTimeReference {ELAPSED_TIME_AVG,
                            ELAPSED_TIME_MIN};
 
+enum ThreadAffinityPolicy {AFFINITY_NONE = 0,
+                           AFFINITY_COMPACT = 1,
+                           AFFINITY_SCATTER = 2
+                           };
+
 typedef struct ThPool ThPool;
 typedef void (* thpool_function_type)(void*);
 
@@ -50,6 +68,11 @@ static int cppadcg_pool_verbose = 0; // false
 static enum ElapsedTimeReference cppadcg_pool_time_update = ELAPSED_TIME_MIN;
 static unsigned int cppadcg_pool_time_meas = 10; // default number of time measurements
 static float cppadcg_pool_guided_maxgroupwork = 0.75;
+static enum ThreadAffinityPolicy cppadcg_pool_affinity = AFFINITY_NONE;
+static int* cppadcg_pool_affinity_cpus = NULL; // CPUs used by the threads (NULL for all the allowed CPUs)
+static int cppadcg_pool_affinity_n_cpus = 0;
+static int cppadcg_pool_sticky_jobs = 0; // false
+static unsigned int cppadcg_pool_spin_wait = 0; // number of iterations before blocking
 
 static enum ScheduleStrategy schedule_strategy = SCHED_DYNAMIC;
 
@@ -103,6 +126,8 @@ typedef struct WorkGroup {
     struct WorkGroup*  prev;             /* pointer to previous WorkGroup  */
     struct Job* jobs;                    /* jobs                           */
     int size;                            /* number of jobs                 */
+    int thread;                          /* the thread which must execute
+                                            this group (-1 for any thread) */
     struct timespec startTime;           /* initial time (verbose only)    */
     struct timespec endTime;             /* final time (verbose only)      */
 } WorkGroup;
@@ -113,7 +138,6 @@ typedef struct JobQueue {
     Job  *front;                         /* pointer to front of queue */
     Job  *rear;                          /* pointer to rear  of queue */
     WorkGroup* group_front;              /* previously created work groups (SCHED_STATIC scheduling only)*/
-    BSem *has_jobs;                      /* flag as binary semaphore  */
     int   len;                           /* number of jobs in queue   */
     float total_time;                    /* total expected time to complete the work */
     float highest_expected_return;       /* the time when the last running thread is expected to request new work */
@@ -125,6 +149,8 @@ typedef struct Thread {
     int id;                              /* friendly id                          */
     pthread_t pthread;                   /* pointer to actual thread             */
     struct ThPool* thpool;               /* access to ThPool                     */
+    BSem has_jobs;                       /* there is work for this thread        */
+    int cpu;                             /* the CPU of the thread (-1 for any)   */
     WorkGroup* processed_groups;         /* processed work groups (verbose only) */
 } Thread;
 
@@ -231,6 +257,70 @@ int cppadcg_thpool_is_verbose() {
     return cppadcg_pool_verbose;
 }
 
+void cppadcg_thpool_set_affinity(enum ThreadAffinityPolicy policy,
+                                 const int cpus[],
+                                 int nCpus) {
+    int i;
+
+    if(cppadcg_pool != NULL) {
+        fprintf(stderr, "cppadcg_thpool_set_affinity(): the affinity only applies to thread pools created afterwards\n");
+    }
+
+    free(cppadcg_pool_affinity_cpus);
+    cppadcg_pool_affinity_cpus = NULL;
+    cppadcg_pool_affinity_n_cpus = 0;
+
+    if (cpus != NULL && nCpus > 0) {
+        cppadcg_pool_affinity_cpus = (int*) malloc(nCpus * sizeof(int));
+        if (cppadcg_pool_affinity_cpus == NULL) {
+            fprintf(stderr, "cppadcg_thpool_set_affinity(): Could not allocate memory\n");
+            return;
+        }
+        for (i = 0; i < nCpus; ++i) {
+            cppadcg_pool_affinity_cpus[i] = cpus[i];
+        }
+        cppadcg_pool_affinity_n_cpus = nCpus;
+    }
+
+    cppadcg_pool_affinity = policy;
+}
+
+enum ThreadAffinityPolicy cppadcg_thpool_get_affinity_policy() {
+    return cppadcg_pool_affinity;
+}
+
+int cppadcg_thpool_get_affinity_cpus(int cpus[],
+                                     int maxCpus) {
+    int i;
+    for (i = 0; i < cppadcg_pool_affinity_n_cpus && i < maxCpus; ++i) {
+        cpus[i] = cppadcg_pool_affinity_cpus[i];
+    }
+    return cppadcg_pool_affinity_n_cpus;
+}
+
+void cppadcg_thpool_set_sticky_jobs(int sticky) {
+    if(cppadcg_pool != NULL) {
+        pthread_mutex_lock(&cppadcg_pool->jobqueue->rwmutex);
+        cppadcg_pool_sticky_jobs = sticky;
+        pthread_mutex_unlock(&cppadcg_pool->jobqueue->rwmutex);
+    } else {
+        // pool not yet created
+        cppadcg_pool_sticky_jobs = sticky;
+    }
+}
+
+int cppadcg_thpool_is_sticky_jobs() {
+    return cppadcg_pool_sticky_jobs;
+}
+
+void cppadcg_thpool_set_spin_wait(unsigned int iterations) {
+    cppadcg_pool_spin_wait = iterations;
+}
+
+unsigned int cppadcg_thpool_get_spin_wait() {
+    return cppadcg_pool_spin_wait;
+}
+
 void cppadcg_thpool_prepare() {
     if(cppadcg_pool == NULL) {
         cppadcg_pool = thpool_init(cppadcg_pool_n_threads);
@@ -366,30 +456,37 @@ static void thpool_cleanup(ThPool* thpool);
 
 static int  thread_init(ThPool* thpool,
                         Thread** thread,
-                        int id);
+                        int id,
+                        int cpu);
 static void* thread_do(Thread* thread);
 static void  thread_destroy(Thread* thread);
 
 static int   jobqueue_init(ThPool* thpool);
 static void  jobqueue_clear(ThPool* thpool);
-static void  jobqueue_push(JobQueue* queue,
+static void  jobqueue_push(ThPool* thpool,
                            Job* newjob_p);
-static void jobqueue_multipush(JobQueue* queue,
+static void jobqueue_multipush(ThPool* thpool,
                                Job* newjob[],
                                int nJobs);
 static int jobqueue_push_static_jobs(ThPool* thpool,
                                      Job* newjobs[],
                                      const float avgElapsed[],
+                                     const int order[],
                                      int jobs2thread[],
                                      int nJobs,
                                      int lastElapsedChanged);
 static WorkGroup* jobqueue_pull(ThPool* thpool, int id);
 static void  jobqueue_destroy(ThPool* thpool);
 
+static void  thpool_post_all(ThPool* thpool);
+static int   thpool_select_cpu(const int cpus[],
+                               int nCpus,
+                               int id,
+                               int num_threads);
+static int   thpool_affinity_cpus(int** cpus);
+
 static void  bsem_init(BSem *bsem, int value);
-static void  bsem_reset(BSem *bsem);
 static void  bsem_post(BSem *bsem);
-static void  bsem_post_all(BSem *bsem);
 static void  bsem_wait(BSem *bsem);
 
 
@@ -504,10 +601,21 @@ struct ThPool* thpool_init(int num_threads) {
     pthread_mutex_init(&(thpool->thcount_lock), NULL);
     pthread_cond_init(&thpool->threads_all_idle, NULL);
 
+    /* CPUs used by the threads */
+    int* cpus = NULL;
+    int nCpus = 0;
+    if (cppadcg_pool_affinity != AFFINITY_NONE) {
+        nCpus = thpool_affinity_cpus(&cpus);
+    }
+
     /* Thread init */
     int n;
     for (n = 0; n < num_threads; n++) {
-        thread_init(thpool, &thpool->threads[n], n);
+        thread_init(thpool, &thpool->threads[n], n, thpool_select_cpu(cpus, nCpus, n, num_threads));
+    }
+
+    if (cpus != cppadcg_pool_affinity_cpus) {
+        free(cpus);
     }
 
     /* Wait for threads to initialize */
@@ -563,7 +671,7 @@ static int thpool_add_job(ThPool* thpool,
     newjob->elapsed = elapsed;
 
     /* add job to queue */
-    jobqueue_push(thpool->jobqueue, newjob);
+    jobqueue_push(thpool, newjob);
 
     return 0;
 }
@@ -605,26 +713,37 @@ static int thpool_add_jobs(ThPool* thpool,
     }
 
     /* add jobs to queue */
-    if (schedule_strategy == SCHED_STATIC && avgElapsed != NULL && order != NULL && nJobs > 0 && avgElapsed[0] > 0) {
-        return jobqueue_push_static_jobs(thpool, newjobs, avgElapsed, job2Thread, nJobs, lastElapsedChanged);
+    if (avgElapsed != NULL && order != NULL && job2Thread != NULL && nJobs > 0 &&
+            (cppadcg_pool_sticky_jobs || (schedule_strategy == SCHED_STATIC && avgElapsed[0] > 0))) {
+        return jobqueue_push_static_jobs(thpool, newjobs, avgElapsed, order, job2Thread, nJobs, lastElapsedChanged);
     } else {
-        jobqueue_multipush(thpool->jobqueue, newjobs, nJobs);
+        jobqueue_multipush(thpool, newjobs, nJobs);
         return 0;
     }
 }
 
 /**
  * Split work among the threads evenly considering the elapsed time of each job.
+ *
+ * With sticky jobs each thread is given a contiguous range of jobs which is
+ * only determined once, so that the same thread always writes to the same
+ * region of the output.
+ *
+ * @param order the index of the job placed in each position of newjobs
+ * @param jobs2thread the work group of each job (by job index)
  */
 static int jobqueue_push_static_jobs(ThPool* thpool,
                                      Job* newjobs[],
                                      const float avgElapsed[],
+                                     const int order[],
                                      int jobs2thread[],
                                      int nJobs,
                                      int lastElapsedChanged) {
-    float total_duration, target_duration, next_duration, best_duration;
-    int i, j, iBest;
+    float total_duration, target_duration, next_duration, best_duration, duration;
+    int i, j, k, iBest;
     int added;
+    int uniform;
+    int sticky = cppadcg_pool_sticky_jobs;
     int num_threads = thpool->num_threads;
     int* n_jobs;
     float* durations = NULL;
@@ -655,9 +774,12 @@ static int jobqueue_push_static_jobs(ThPool* thpool,
     for (i = 0; i < nJobs; ++i) {
         total_duration += avgElapsed[i];
     }
+    uniform = !(total_duration > 0); // no timing information
+    if (uniform) {
+        total_duration = (float) nJobs;
+    }
 
-
-    if (nJobs > 0 && (lastElapsedChanged || jobs2thread[0] < 0)) {
+    if (nJobs > 0 && ((lastElapsedChanged && !sticky) || jobs2thread[0] < 0)) {
         durations = (float*) malloc(num_threads * sizeof(float));
         if (durations == NULL) {
             fprintf(stderr, "jobqueue_push_static_jobs(): Could not allocate memory\n");
@@ -673,40 +795,60 @@ static int jobqueue_push_static_jobs(ThPool* thpool,
         // decide in which work group to place each job
         target_duration = total_duration / num_threads;
 
-        for (j = 0; j < nJobs; ++j) {
-            added = 0;
-            for (i = 0; i < num_threads; ++i) {
-                next_duration = durations[i] + avgElapsed[j];
-                if (next_duration < target_duration) {
-                    durations[i] = next_duration;
-                    n_jobs[i]++;
-                    jobs2thread[j] = i;
-                    added = 1;
-                    break;
+        if (sticky) {
+            // contiguous ranges of jobs
+            i = 0;
+            next_duration = 0; // accumulated duration
+            for (k = 0; k < nJobs; ++k) {
+                duration = uniform ? 1 : avgElapsed[k];
+                if (i < num_threads - 1 && n_jobs[i] > 0 &&
+                    (next_duration + 0.5f * duration > target_duration * (i + 1) || nJobs - k <= num_threads - 1 - i)) {
+                    i++;
                 }
+                next_duration += duration;
+                durations[i] += duration;
+                n_jobs[i]++;
+                jobs2thread[k] = i;
             }
 
-            if (!added) {
-                best_duration = durations[0] + avgElapsed[j];
-                iBest = 0;
-                for (i = 1; i < num_threads; ++i) {
-                    next_duration = durations[i] + avgElapsed[j];
-                    if (next_duration < best_duration) {
-                        best_duration = next_duration;
-                        iBest = i;
+        } else {
+            for (j = 0; j < nJobs; ++j) {
+                k = order[j];
+                duration = uniform ? 1 : avgElapsed[k];
+                added = 0;
+                for (i = 0; i < num_threads; ++i) {
+                    next_duration = durations[i] + duration;
+                    if (next_duration < target_duration) {
+                        durations[i] = next_duration;
+                        n_jobs[i]++;
+                        jobs2thread[k] = i;
+                        added = 1;
+                        break;
+                    }
+                }
+
+                if (!added) {
+                    best_duration = durations[0] + duration;
+                    iBest = 0;
+                    for (i = 1; i < num_threads; ++i) {
+                        next_duration = durations[i] + duration;
+                        if (next_duration < best_duration) {
+                            best_duration = next_duration;
+                            iBest = i;
+                        }
                     }
+                    durations[iBest] = best_duration;
+                    n_jobs[iBest]++;
+                    jobs2thread[k] = iBest;
                 }
-                durations[iBest] = best_duration;
-                n_jobs[iBest]++;
-                jobs2thread[j] = iBest;
             }
         }
 
     } else {
         // reuse existing information
 
-        for (j = 0; j < nJobs; ++j) {
-            n_jobs[jobs2thread[j]]++;
+        for (k = 0; k < nJobs; ++k) {
+            n_jobs[jobs2thread[k]]++;
         }
     }
 
@@ -716,6 +858,7 @@ static int jobqueue_push_static_jobs(ThPool* thpool,
     for (i = 0; i < num_threads; ++i) {
         group = (WorkGroup*) malloc(sizeof(WorkGroup));
         group->size = 0;
+        group->thread = sticky ? i : -1;
         group->jobs = (Job*) malloc(n_jobs[i] * sizeof(Job));
         groups[i] = group;
     }
@@ -726,7 +869,7 @@ static int jobqueue_push_static_jobs(ThPool* thpool,
 
     // place jobs on the work groups
     for (j = 0; j < nJobs; ++j) {
-        i = jobs2thread[j];
+        i = jobs2thread[order[j]];
         group = groups[i];
         group->jobs[group->size] = *newjobs[j]; // copy
         group->size++;
@@ -753,10 +896,16 @@ static int jobqueue_push_static_jobs(ThPool* thpool,
     groups[num_threads - 1]->prev = thpool->jobqueue->group_front;
     thpool->jobqueue->group_front = groups[0];
 
-    bsem_post_all(thpool->jobqueue->has_jobs);
-
     pthread_mutex_unlock(&thpool->jobqueue->rwmutex);
 
+    if (sticky) {
+        for (i = 0; i < num_threads; ++i) {
+            bsem_post(&thpool->threads[i]->has_jobs);
+        }
+    } else {
+        thpool_post_all(thpool);
+    }
+
     // clean up
     free(durations);
     free(n_jobs);
@@ -792,6 +941,18 @@ static int jobqueue_push_static_jobs(ThPool* thpool,
  * @param threadpool     the threadpool to wait for
  */
 static void thpool_wait(ThPool* thpool) {
+    unsigned int i;
+
+    /* spin for a while before blocking (lower latency for short jobs) */
+    for (i = 0; i < cppadcg_pool_spin_wait; ++i) {
+        if (__atomic_load_n(&thpool->jobqueue->len, __ATOMIC_ACQUIRE) == 0 &&
+            __atomic_load_n(&thpool->jobqueue->group_front, __ATOMIC_ACQUIRE) == NULL &&
+            __atomic_load_n(&thpool->num_threads_working, __ATOMIC_ACQUIRE) == 0) {
+            break;
+        }
+        CPPADCG_THPOOL_CPU_RELAX();
+    }
+
     pthread_mutex_lock(&thpool->thcount_lock);
     while (thpool->jobqueue->len || thpool->jobqueue->group_front || thpool->num_threads_working) {  //// PROBLEM HERE!!!! len is not locked!!!!
         pthread_cond_wait(&thpool->threads_all_idle, &thpool->thcount_lock);
@@ -891,14 +1052,14 @@ static void thpool_destroy(ThPool* thpool) {
     double tpassed = 0.0;
     time(&start);
     while (tpassed < TIMEOUT && thpool->num_threads_alive) {
-        bsem_post_all(thpool->jobqueue->has_jobs);
+        thpool_post_all(thpool);
         time(&end);
         tpassed = difftime(end, start);
     }
 
     /* Poll remaining threads */
     while (thpool->num_threads_alive) {
-        bsem_post_all(thpool->jobqueue->has_jobs);
+        thpool_post_all(thpool);
         sleep(1);
     }
 
@@ -922,6 +1083,89 @@ static void thpool_destroy(ThPool* thpool) {
     }
 }
 
+/**
+ * Wakes up all the threads in the pool.
+ */
+static void thpool_post_all(ThPool* thpool) {
+    int n;
+    for (n = 0; n < thpool->num_threads; n++) {
+        bsem_post(&thpool->threads[n]->has_jobs);
+    }
+}
+
+/**
+ * Provides the CPUs which can be used by the threads in the pool.
+ *
+ * @param cpus the CPUs (output); it must be released with free() if it is
+ *             not cppadcg_pool_affinity_cpus
+ * @return the number of CPUs
+ */
+static int thpool_affinity_cpus(int** cpus) {
+    *cpus = NULL;
+    if (cppadcg_pool_affinity_n_cpus > 0) {
+        *cpus = cppadcg_pool_affinity_cpus;
+        return cppadcg_pool_affinity_n_cpus;
+    }
+
+#if defined(__linux__)
+    /* all the CPUs where the process is allowed to run */
+    cpu_set_t cpuset;
+    int i;
+    int n = 0;
+    CPU_ZERO(&cpuset);
+    if (sched_getaffinity(0, sizeof(cpu_set_t), &cpuset) != 0) {
+        fprintf(stderr, "thpool_affinity_cpus(): failed to determine the available CPUs\n");
+        return 0;
+    }
+
+    *cpus = (int*) malloc(CPU_COUNT(&cpuset) * sizeof(int));
+    if (*cpus == NULL) {
+        fprintf(stderr, "thpool_affinity_cpus(): Could not allocate memory\n");
+        return 0;
+    }
+    for (i = 0; i < CPU_SETSIZE; ++i) {
+        if (CPU_ISSET(i, &cpuset)) {
+            (*cpus)[n++] = i;
+        }
+    }
+    return n;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * Determines the CPU where a thread should run.
+ *
+ * @param cpus the CPUs which can be used
+ * @param nCpus the number of CPUs
+ * @param id the thread index
+ * @param num_threads the number of threads in the pool
+ * @return the CPU or -1 if the thread is not bound to any CPU
+ */
+static int thpool_select_cpu(const int cpus[],
+                             int nCpus,
+                             int id,
+                             int num_threads) {
+    if (nCpus <= 0 || cpus == NULL) {
+        return -1;
+    }
+
+    switch (cppadcg_pool_affinity) {
+        case AFFINITY_COMPACT:
+            // consecutive threads use consecutive CPUs
+            return cpus[id % nCpus];
+        case AFFINITY_SCATTER:
+            // threads are spread evenly across the CPUs (and the sockets)
+            if (num_threads <= nCpus)
+                return cpus[(id * nCpus) / num_threads];
+            else
+                return cpus[id % nCpus];
+        default:
+            return -1;
+    }
+}
+
 
 /* ============================ THREAD ============================== */
 
@@ -930,11 +1174,13 @@ static void thpool_destroy(ThPool* thpool) {
  *
  * @param thread        address to the pointer of the thread to be created
  * @param id            id to be given to the thread
+ * @param cpu           the CPU where the thread runs (-1 for any CPU)
  * @return 0 on success, -1 otherwise.
  */
 static int thread_init(ThPool* thpool,
                        Thread** thread,
-                       int id) {
+                       int id,
+                       int cpu) {
 
     *thread = (Thread*) malloc(sizeof(Thread));
     if (*thread == NULL) {
@@ -944,7 +1190,9 @@ static int thread_init(ThPool* thpool,
 
     (*thread)->thpool = thpool;
     (*thread)->id = id;
+    (*thread)->cpu = cpu;
     (*thread)->processed_groups = NULL;
+    bsem_init(&(*thread)->has_jobs, 0);
 
     pthread_create(&(*thread)->pthread, NULL, (void*) thread_do, (*thread));
     pthread_detach((*thread)->pthread);
@@ -983,6 +1231,22 @@ static void* thread_do(Thread* thread) {
     fprintf(stderr, "thread_do(): pthread_setname_np is not supported on this system");
 #endif
 
+    /* Bind the thread to a CPU */
+    if (thread->cpu >= 0) {
+#if defined(__linux__)
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(thread->cpu, &cpuset);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset) != 0) {
+            fprintf(stderr, "thread_do(): failed to bind thread %i to CPU %i\n", thread->id, thread->cpu);
+        } else if (cppadcg_pool_verbose) {
+            fprintf(stdout, "thread_do(): thread %i bound to CPU %i\n", thread->id, thread->cpu);
+        }
+#else
+        fprintf(stderr, "thread_do(): thread affinity is not supported on this system\n");
+#endif
+    }
+
     /* Assure all threads have been created before starting serving */
     ThPool* thpool = thread->thpool;
 
@@ -995,7 +1259,7 @@ static void* thread_do(Thread* thread) {
 
     while (thpool->threads_keepalive) {
 
-        bsem_wait(queue->has_jobs);
+        bsem_wait(&thread->has_jobs);
 
         if (!thpool->threads_keepalive) {
             break;
@@ -1102,13 +1366,7 @@ static int jobqueue_init(ThPool* thpool) {
     queue->total_time = 0;
     queue->highest_expected_return = 0;
 
-    queue->has_jobs = (BSem*) malloc(sizeof(BSem));
-    if (queue->has_jobs == NULL) {
-        return -1;
-    }
-
     pthread_mutex_init(&(queue->rwmutex), NULL);
-    bsem_init(queue->has_jobs, 0);
 
     return 0;
 }
@@ -1132,7 +1390,6 @@ static void jobqueue_clear(ThPool* thpool) {
 
     thpool->jobqueue->front = NULL;
     thpool->jobqueue->rear = NULL;
-    bsem_reset(thpool->jobqueue->has_jobs);
     thpool->jobqueue->len = 0;
     thpool->jobqueue->group_front = NULL;
     thpool->jobqueue->total_time = 0;
@@ -1168,24 +1425,27 @@ static void jobqueue_push_internal(JobQueue* queue,
 /**
  * Add (allocated) job to queue
  */
-static void jobqueue_push(JobQueue* queue,
+static void jobqueue_push(ThPool* thpool,
                           Job* newjob) {
+    JobQueue* queue = thpool->jobqueue;
+
     pthread_mutex_lock(&queue->rwmutex);
 
     jobqueue_push_internal(queue, newjob);
 
-    bsem_post(queue->has_jobs);
-
     pthread_mutex_unlock(&queue->rwmutex);
+
+    thpool_post_all(thpool);
 }
 
 
 /**
  * Add (allocated) multiple jobs to queue
  */
-static void jobqueue_multipush(JobQueue* queue,
+static void jobqueue_multipush(ThPool* thpool,
                                Job* newjob[],
                                int nJobs) {
+    JobQueue* queue = thpool->jobqueue;
     int i;
 
     pthread_mutex_lock(&queue->rwmutex);
@@ -1194,9 +1454,34 @@ static void jobqueue_multipush(JobQueue* queue,
         jobqueue_push_internal(queue, newjob[i]);
     }
 
-    bsem_post_all(queue->has_jobs);
-
     pthread_mutex_unlock(&queue->rwmutex);
+
+    thpool_post_all(thpool);
+}
+
+/**
+ * Removes a previously created work group which can be executed by a thread
+ * (without locks).
+ *
+ * @param id the thread identifier (negative for any work group)
+ * @return the work group or NULL if there are none for this thread
+ */
+static WorkGroup* jobqueue_extract_group(JobQueue* queue,
+                                         int id) {
+    WorkGroup** g = &queue->group_front;
+    WorkGroup* group;
+
+    while (*g != NULL) {
+        group = *g;
+        if (id < 0 || group->thread < 0 || group->thread == id) {
+            *g = group->prev;
+            group->prev = NULL;
+            return group;
+        }
+        g = &group->prev;
+    }
+
+    return NULL;
 }
 
 static Job* jobqueue_extract_single(JobQueue* queue) {
@@ -1255,12 +1540,8 @@ static WorkGroup* jobqueue_pull(ThPool* thpool,
     int i;
     JobQueue* queue = thpool->jobqueue;
 
-    if (schedule_strategy == SCHED_STATIC && queue->group_front != NULL) {
+    if (queue->group_front != NULL && (group = jobqueue_extract_group(queue, id)) != NULL) {
         // STATIC
-        group = queue->group_front;
-
-        queue->group_front = group->prev;
-        group->prev = NULL;
 
     } else if (queue->len == 0) {
         // nothing to do
@@ -1349,10 +1630,7 @@ static WorkGroup* jobqueue_pull(ThPool* thpool,
         }
 
     }
-    /* more than one job in queue -> post it */
-    if (queue->len > 0 || queue->group_front != NULL) {
-        bsem_post(queue->has_jobs);
-    }
+    /* all the threads were already notified about the remaining jobs */
 
     return group;
 }
@@ -1361,7 +1639,6 @@ static WorkGroup* jobqueue_pull(ThPool* thpool,
 /* Free all queue resources back to the system */
 static void jobqueue_destroy(ThPool* thpool) {
     jobqueue_clear(thpool);
-    free(thpool->jobqueue->has_jobs);
 }
 
 
@@ -1383,12 +1660,6 @@ static void bsem_init(BSem* bsem, int value) {
 }
 
 
-/* Reset semaphore to 0 */
-static void bsem_reset(BSem* bsem) {
-    bsem_init(bsem, 0);
-}
-
-
 /* Post to at least one thread */
 static void bsem_post(BSem* bsem) {
     pthread_mutex_lock(&bsem->mutex);
@@ -1398,17 +1669,18 @@ static void bsem_post(BSem* bsem) {
 }
 
 
-/* Post to all threads */
-static void bsem_post_all(BSem* bsem) {
-    pthread_mutex_lock(&bsem->mutex);
-    bsem->v = 1;
-    pthread_cond_broadcast(&bsem->cond);
-    pthread_mutex_unlock(&bsem->mutex);
-}
-
-
 /* Wait on semaphore until semaphore has value 0 */
 static void bsem_wait(BSem* bsem) {
+    unsigned int i;
+
+    /* spin for a while before blocking (lower latency for repeated calls) */
+    for (i = 0; i < cppadcg_pool_spin_wait; ++i) {
+        if (__atomic_load_n(&bsem->v, __ATOMIC_ACQUIRE) == 1) {
+            break;
+        }
+        CPPADCG_THPOOL_CPU_RELAX();
+    }
+
     pthread_mutex_lock(&bsem->mutex);
     while (bsem->v != 1) {
         pthread_cond_wait(&bsem->cond, &bsem->mutex);
@@ -1418,5 +1690,5 @@ static void bsem_wait(BSem* bsem) {
 }
 )*=*";
 
-const size_t CPPADCG_PTHREAD_POOL_C_FILE_SIZE = 43345;
+const size_t CPPADCG_PTHREAD_POOL_C_FILE_SIZE = 52542;
 
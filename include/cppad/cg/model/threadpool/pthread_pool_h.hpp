@@ -27,6 +27,11 @@ enum ScheduleStrategy {SCHED_STATIC = 1,
 enum ElapsedTimeReference {ELAPSED_TIME_AVG,
                            ELAPSED_TIME_MIN};
 
+enum ThreadAffinityPolicy {AFFINITY_NONE = 0,
+                           AFFINITY_COMPACT = 1,
+                           AFFINITY_SCATTER = 2
+                           };
+
 typedef void (*cppadcg_thpool_function_type)(void*);
 
 
@@ -60,6 +65,26 @@ void cppadcg_thpool_set_verbose(int v);
 int cppadcg_thpool_is_verbose();
 
 
+void cppadcg_thpool_set_affinity(enum ThreadAffinityPolicy policy,
+                                 const int cpus[],
+                                 int nCpus);
+
+enum ThreadAffinityPolicy cppadcg_thpool_get_affinity_policy();
+
+int cppadcg_thpool_get_affinity_cpus(int cpus[],
+                                     int maxCpus);
+
+
+void cppadcg_thpool_set_sticky_jobs(int sticky);
+
+int cppadcg_thpool_is_sticky_jobs();
+
+
+void cppadcg_thpool_set_spin_wait(unsigned int iterations);
+
+unsigned int cppadcg_thpool_get_spin_wait();
+
+
 void cppadcg_thpool_set_disabled(int disabled);
 
 int cppadcg_thpool_is_disabled();
@@ -98,5 +123,5 @@ void cppadcg_thpool_shutdown();
 #endif
 )*=*";
 
-const size_t CPPADCG_PTHREAD_POOL_H_FILE_SIZE = 2730;
+const size_t CPPADCG_PTHREAD_POOL_H_FILE_SIZE = 3432;
 
@@ -0,0 +1,30 @@
+#ifndef CPPAD_CG_THREAD_POOL_AFFINITY_POLICY_INCLUDED
+#define CPPAD_CG_THREAD_POOL_AFFINITY_POLICY_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+enum class ThreadPoolAffinityPolicy {
+    NONE = 0, // threads can run on any CPU
+    COMPACT = 1, // consecutive threads are bound to consecutive CPUs
+    SCATTER = 2 // threads are bound to CPUs spread evenly across the available CPUs
+};
+
+}
+}
+
+#endif
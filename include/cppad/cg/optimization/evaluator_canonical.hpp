@@ -0,0 +1,139 @@
+#ifndef CPPAD_CG_EVALUATOR_CANONICAL_INCLUDED
+#define CPPAD_CG_EVALUATOR_CANONICAL_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+/**
+ * Clones the operations required by the dependent variables into a new
+ * code handler while rewriting them into a canonical form so that more
+ * operations can be merged by a common subexpression elimination.
+ * Only rewrites which produce exactly the same floating point results are
+ * performed:
+ *  - the arguments of additions and multiplications are sorted
+ *    (variables first, by creation order, and parameters last);
+ *  - -(-x) becomes x;
+ *  - x - c becomes x + (-c) for a constant c;
+ *  - x - (-y) becomes x + y;
+ *  - x + (-y) and (-y) + x become x - y;
+ *  - (-x) * (-y) becomes x * y.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class EvaluatorCanonical : public EvaluatorCloneBase<Base, EvaluatorCanonical<Base> > {
+    /**
+     * must be friends with one of its super classes since there is a cast to
+     * this type due to the curiously recurring template pattern (CRTP)
+     */
+    friend EvaluatorBase<Base, Base, CG<Base>, EvaluatorCanonical<Base> >;
+    friend EvaluatorCloneBase<Base, EvaluatorCanonical<Base> >;
+public:
+    using ActiveOut = CG<Base>;
+    using NodeOut = OperationNode<Base>;
+    using ArgOut = Argument<Base>;
+protected:
+    using Super = EvaluatorCloneBase<Base, EvaluatorCanonical<Base> >;
+public:
+
+    inline EvaluatorCanonical(CodeHandler<Base>& handler) :
+        Super(handler) {
+    }
+
+protected:
+
+    /**
+     * @note overrides the default makeOperation() even though this method
+     *        is not virtual (hides a method in EvaluatorCloneBase)
+     */
+    inline ActiveOut makeOperation(CGOpCode op,
+                                   const std::vector<size_t>& info,
+                                   std::vector<ArgOut>& args) {
+        switch (op) {
+            case CGOpCode::UnMinus:
+                CPPADCG_ASSERT_KNOWN(args.size() == 1, "Invalid number of arguments for unary minus");
+                if (isUnaryMinus(args[0])) {
+                    // -(-x) = x
+                    return Super::asActiveOut(args[0].getOperation()->getArguments()[0]);
+                }
+                break;
+
+            case CGOpCode::Sub:
+                CPPADCG_ASSERT_KNOWN(args.size() == 2, "Invalid number of arguments for subtraction");
+                if (isUnaryMinus(args[1])) {
+                    // x - (-y) = x + y
+                    std::vector<ArgOut> newArgs{args[0], args[1].getOperation()->getArguments()[0]};
+                    return makeOperation(CGOpCode::Add, info, newArgs);
+                } else if (args[1].getParameter() != nullptr && args[0].getOperation() != nullptr) {
+                    // x - c = x + (-c)
+                    std::vector<ArgOut> newArgs{args[0], ArgOut(-*args[1].getParameter())};
+                    return makeOperation(CGOpCode::Add, info, newArgs);
+                }
+                break;
+
+            case CGOpCode::Add:
+                CPPADCG_ASSERT_KNOWN(args.size() == 2, "Invalid number of arguments for addition");
+                sortArguments(args);
+                if (isUnaryMinus(args[1])) {
+                    // x + (-y) = x - y
+                    std::vector<ArgOut> newArgs{args[0], args[1].getOperation()->getArguments()[0]};
+                    return Super::makeOperation(CGOpCode::Sub, info, newArgs);
+                } else if (isUnaryMinus(args[0])) {
+                    // (-y) + x = x - y
+                    std::vector<ArgOut> newArgs{args[1], args[0].getOperation()->getArguments()[0]};
+                    return Super::makeOperation(CGOpCode::Sub, info, newArgs);
+                }
+                break;
+
+            case CGOpCode::Mul:
+                CPPADCG_ASSERT_KNOWN(args.size() == 2, "Invalid number of arguments for multiplication");
+                if (isUnaryMinus(args[0]) && isUnaryMinus(args[1])) {
+                    // (-x) * (-y) = x * y
+                    args[0] = args[0].getOperation()->getArguments()[0];
+                    args[1] = args[1].getOperation()->getArguments()[0];
+                }
+                sortArguments(args);
+                break;
+
+            default:
+                break;
+        }
+
+        return Super::makeOperation(op, info, args);
+    }
+
+    static inline bool isUnaryMinus(const ArgOut& arg) {
+        return arg.getOperation() != nullptr && arg.getOperation()->getOperationType() == CGOpCode::UnMinus;
+    }
+
+    /**
+     * Sorts the arguments of a commutative operation
+     */
+    static inline void sortArguments(std::vector<ArgOut>& args) {
+        const NodeOut* a0 = args[0].getOperation();
+        const NodeOut* a1 = args[1].getOperation();
+        if (a0 == nullptr && a1 != nullptr) {
+            std::swap(args[0], args[1]); // parameters last
+        } else if (a0 != nullptr && a1 != nullptr && a1->getHandlerPosition() < a0->getHandlerPosition()) {
+            std::swap(args[0], args[1]);
+        }
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
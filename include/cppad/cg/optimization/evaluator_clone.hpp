@@ -0,0 +1,153 @@
+#ifndef CPPAD_CG_EVALUATOR_CLONE_INCLUDED
+#define CPPAD_CG_EVALUATOR_CLONE_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+/**
+ * Specialization of EvaluatorCG which clones the operations without using
+ * the CG<Base> arithmetic (no simplifications) and removes the alias and
+ * assign operations.
+ * New operations are created through makeOperation() which can be
+ * overridden by subclasses in order to transform or reuse operations.
+ * This class should not be instantiated directly.
+ *
+ * @author Joao Leal
+ */
+template<class Base, class FinalEvaluatorType>
+class EvaluatorCloneBase : public EvaluatorCG<Base, Base, FinalEvaluatorType> {
+    /**
+     * must be friends with one of its super classes since there is a cast to
+     * this type due to the curiously recurring template pattern (CRTP)
+     */
+    friend EvaluatorBase<Base, Base, CG<Base>, FinalEvaluatorType>;
+    friend EvaluatorOperations<Base, Base, CG<Base>, FinalEvaluatorType>;
+public:
+    using ActiveOut = CG<Base>;
+    using NodeIn = OperationNode<Base>;
+    using NodeOut = OperationNode<Base>;
+    using ArgIn = Argument<Base>;
+    using ArgOut = Argument<Base>;
+protected:
+    using Super = EvaluatorCG<Base, Base, FinalEvaluatorType>;
+public:
+
+    inline EvaluatorCloneBase(CodeHandler<Base>& handler) :
+        Super(handler) {
+    }
+
+protected:
+
+    /**
+     * @note overrides the default evalOperation() even though this method
+     *        is not virtual (hides a method in EvaluatorOperations)
+     */
+    inline ActiveOut evalOperation(NodeIn& node) {
+        const CGOpCode op = node.getOperationType();
+
+        switch (op) {
+            case CGOpCode::Alias:
+            case CGOpCode::Assign:
+                CPPADCG_ASSERT_KNOWN(node.getArguments().size() == 1, "Invalid number of arguments for alias/assign");
+                return this->evalArg(node.getArguments(), 0);
+
+            case CGOpCode::Abs:
+            case CGOpCode::Acos:
+            case CGOpCode::Add:
+            case CGOpCode::Asin:
+            case CGOpCode::Atan:
+            case CGOpCode::ComLt:
+            case CGOpCode::ComLe:
+            case CGOpCode::ComEq:
+            case CGOpCode::ComGe:
+            case CGOpCode::ComGt:
+            case CGOpCode::ComNe:
+            case CGOpCode::Cosh:
+            case CGOpCode::Cos:
+            case CGOpCode::Div:
+            case CGOpCode::Exp:
+            case CGOpCode::Log:
+            case CGOpCode::Mul:
+            case CGOpCode::Pow:
+            case CGOpCode::Sign:
+            case CGOpCode::Sinh:
+            case CGOpCode::Sin:
+            case CGOpCode::Sqrt:
+            case CGOpCode::Sub:
+            case CGOpCode::Tanh:
+            case CGOpCode::Tan:
+            case CGOpCode::UnMinus: {
+                const std::vector<ArgIn>& args = node.getArguments();
+                std::vector<ArgOut> newArgs(args.size());
+                for (size_t i = 0; i < args.size(); i++) {
+                    newArgs[i] = asArgument(this->evalArg(args, i));
+                }
+
+                FinalEvaluatorType& thisOps = static_cast<FinalEvaluatorType&>(*this);
+                return thisOps.makeOperation(op, node.getInfo(), newArgs);
+            }
+
+            default:
+                // independent variables, arrays, atomic functions, ...
+                return Super::evalOperation(node);
+        }
+    }
+
+    /**
+     * Creates a new operation in the output code handler.
+     *
+     * @param op the operation type
+     * @param info the operation information
+     * @param args the new arguments (can be modified)
+     * @return the result of the new operation
+     */
+    inline ActiveOut makeOperation(CGOpCode op,
+                                   const std::vector<size_t>& info,
+                                   std::vector<ArgOut>& args) {
+        if (this->outHandler_ == nullptr) {
+            throw CGException("Evaluator is unable to determine the new CodeHandler for an operation");
+        }
+        return ActiveOut(*this->outHandler_->makeNode(op, info, args));
+    }
+
+    static inline ActiveOut asActiveOut(const ArgOut& arg) {
+        if (arg.getOperation() != nullptr) {
+            return ActiveOut(*arg.getOperation());
+        } else {
+            return ActiveOut(*arg.getParameter());
+        }
+    }
+
+};
+
+/**
+ * Clones the operations required by the dependent variables into a new
+ * code handler (dead code elimination).
+ */
+template<class Base>
+class EvaluatorClone : public EvaluatorCloneBase<Base, EvaluatorClone<Base> > {
+protected:
+    using Super = EvaluatorCloneBase<Base, EvaluatorClone<Base> >;
+public:
+
+    inline EvaluatorClone(CodeHandler<Base>& handler) :
+        Super(handler) {
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
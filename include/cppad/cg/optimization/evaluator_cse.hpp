@@ -0,0 +1,124 @@
+#ifndef CPPAD_CG_EVALUATOR_CSE_INCLUDED
+#define CPPAD_CG_EVALUATOR_CSE_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+/**
+ * Clones the operations required by the dependent variables into a new
+ * code handler while merging operations with the same type, information,
+ * and arguments (common subexpression elimination).
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class EvaluatorCSE : public EvaluatorCloneBase<Base, EvaluatorCSE<Base> > {
+    /**
+     * must be friends with one of its super classes since there is a cast to
+     * this type due to the curiously recurring template pattern (CRTP)
+     */
+    friend EvaluatorBase<Base, Base, CG<Base>, EvaluatorCSE<Base> >;
+    friend EvaluatorCloneBase<Base, EvaluatorCSE<Base> >;
+public:
+    using ActiveOut = CG<Base>;
+    using NodeOut = OperationNode<Base>;
+    using ArgOut = Argument<Base>;
+protected:
+    using Super = EvaluatorCloneBase<Base, EvaluatorCSE<Base> >;
+    /**
+     * an argument is either an operation or a parameter value
+     */
+    using ArgumentKey = std::pair<const NodeOut*, Base>;
+    using OperationKey = std::tuple<CGOpCode, std::vector<size_t>, std::vector<ArgumentKey> >;
+protected:
+    /**
+     * the operations created in the new code handler
+     */
+    std::map<OperationKey, NodeOut*> operations_;
+    /**
+     * the number of operations which were reused
+     */
+    size_t merged_;
+public:
+
+    inline EvaluatorCSE(CodeHandler<Base>& handler) :
+        Super(handler),
+        merged_(0) {
+    }
+
+    /**
+     * @return the number of operations which were merged with an existing
+     *         operation in the last evaluation
+     */
+    inline size_t getMergedOperationCount() const {
+        return merged_;
+    }
+
+protected:
+
+    /**
+     * @note overrides the default prepareNewEvaluation() even though this method
+     *        is not virtual (hides a method in EvaluatorBase)
+     */
+    inline void prepareNewEvaluation() {
+        Super::prepareNewEvaluation();
+
+        operations_.clear();
+        merged_ = 0;
+    }
+
+    /**
+     * @note overrides the default makeOperation() even though this method
+     *        is not virtual (hides a method in EvaluatorCloneBase)
+     */
+    inline ActiveOut makeOperation(CGOpCode op,
+                                   const std::vector<size_t>& info,
+                                   std::vector<ArgOut>& args) {
+        OperationKey key(op, info, std::vector<ArgumentKey>());
+        std::vector<ArgumentKey>& argKeys = std::get<2>(key);
+        argKeys.reserve(args.size());
+
+        for (const ArgOut& a : args) {
+            if (a.getOperation() != nullptr) {
+                argKeys.emplace_back(a.getOperation(), Base(0));
+            } else {
+                const Base& v = *a.getParameter();
+                if (v != v) {
+                    return Super::makeOperation(op, info, args); // NaN cannot be compared
+                } else if (v == Base(0) && std::signbit(v)) {
+                    return Super::makeOperation(op, info, args); // -0.0 would be equal to 0.0
+                }
+                argKeys.emplace_back(nullptr, v);
+            }
+        }
+
+        auto it = operations_.find(key);
+        if (it != operations_.end()) {
+            merged_++;
+            return ActiveOut(*it->second);
+        }
+
+        ActiveOut result = Super::makeOperation(op, info, args);
+        operations_[std::move(key)] = result.getOperationNode();
+
+        return result;
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef CPPAD_CG_GRAPH_OPTIMIZATION_PASS_INCLUDED
+#define CPPAD_CG_GRAPH_OPTIMIZATION_PASS_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A transformation of an operation graph which creates a new (equivalent)
+ * operation graph in a different code handler.
+ * Only the operations required by the dependent variables are recreated
+ * and therefore every pass also removes dead code.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class GraphOptimizationPass {
+public:
+
+    inline virtual ~GraphOptimizationPass() = default;
+
+    /**
+     * @return a name for this pass (used for reporting)
+     */
+    virtual const std::string& getName() const = 0;
+
+    /**
+     * Creates a new operation graph.
+     *
+     * @param handler the code handler with the original operations
+     * @param indepNew the independent variables of the new operation graph
+     *                 (must belong to a different code handler)
+     * @param dep the dependent variables of the original operation graph
+     * @return the dependent variables of the new operation graph
+     */
+    virtual std::vector<CG<Base> > apply(CodeHandler<Base>& handler,
+                                         const std::vector<CG<Base> >& indepNew,
+                                         const std::vector<CG<Base> >& dep) = 0;
+};
+
+/**
+ * An optimization pass which creates the new operation graph using an
+ * evaluator with CG<Base> as the output type.
+ *
+ * @tparam EvaluatorType the evaluator class (e.g. EvaluatorCSE)
+ */
+template<class Base, class EvaluatorType>
+class EvaluatorGraphPass : public GraphOptimizationPass<Base> {
+protected:
+    const std::string name_;
+public:
+
+    inline explicit EvaluatorGraphPass(const std::string& name) :
+        name_(name) {
+    }
+
+    const std::string& getName() const override {
+        return name_;
+    }
+
+    std::vector<CG<Base> > apply(CodeHandler<Base>& handler,
+                                 const std::vector<CG<Base> >& indepNew,
+                                 const std::vector<CG<Base> >& dep) override {
+        EvaluatorType evaluator(handler);
+        evaluator.setPrintOutPrintOperations(false);
+        return evaluator.evaluate(indepNew, dep);
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
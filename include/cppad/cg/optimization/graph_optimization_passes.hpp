@@ -0,0 +1,72 @@
+#ifndef CPPAD_CG_GRAPH_OPTIMIZATION_PASSES_INCLUDED
+#define CPPAD_CG_GRAPH_OPTIMIZATION_PASSES_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+/**
+ * Only keeps the operations required by the dependent variables.
+ */
+template<class Base>
+class DeadCodeEliminationPass : public EvaluatorGraphPass<Base, EvaluatorClone<Base> > {
+public:
+
+    inline DeadCodeEliminationPass() :
+        EvaluatorGraphPass<Base, EvaluatorClone<Base> >("dead code elimination") {
+    }
+};
+
+/**
+ * Recreates the operations using the CG<Base> arithmetic which evaluates
+ * operations with constant arguments and simplifies operations such as
+ * x * 1, x + 0, x * 0.
+ */
+template<class Base>
+class ConstantFoldingPass : public EvaluatorGraphPass<Base, Evaluator<Base, Base, CG<Base> > > {
+public:
+
+    inline ConstantFoldingPass() :
+        EvaluatorGraphPass<Base, Evaluator<Base, Base, CG<Base> > >("constant folding") {
+    }
+};
+
+/**
+ * Rewrites operations into a canonical form (see EvaluatorCanonical).
+ */
+template<class Base>
+class CanonicalizationPass : public EvaluatorGraphPass<Base, EvaluatorCanonical<Base> > {
+public:
+
+    inline CanonicalizationPass() :
+        EvaluatorGraphPass<Base, EvaluatorCanonical<Base> >("canonicalization") {
+    }
+};
+
+/**
+ * Merges identical operations (see EvaluatorCSE).
+ */
+template<class Base>
+class CommonSubexpressionEliminationPass : public EvaluatorGraphPass<Base, EvaluatorCSE<Base> > {
+public:
+
+    inline CommonSubexpressionEliminationPass() :
+        EvaluatorGraphPass<Base, EvaluatorCSE<Base> >("common subexpression elimination") {
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
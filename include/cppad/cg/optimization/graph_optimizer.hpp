@@ -0,0 +1,282 @@
+#ifndef CPPAD_CG_GRAPH_OPTIMIZER_INCLUDED
+#define CPPAD_CG_GRAPH_OPTIMIZER_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+/**
+ * Optimizes the operations of a model by applying a sequence of
+ * optimization passes (GraphOptimizationPass) to its operation graph and
+ * then recording the result in a new ADFun, which can be used to generate
+ * source code (e.g. with ModelCSourceGen).
+ *
+ * The default passes are constant folding, canonicalization, and common
+ * subexpression elimination. Dead code is removed by every pass.
+ * The passes are repeated while the number of operations decreases (up to
+ * a maximum number of iterations).
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class GraphOptimizer {
+public:
+    using CGBase = CG<Base>;
+    using ADCG = CppAD::AD<CGBase>;
+    using Node = OperationNode<Base>;
+protected:
+    std::vector<std::unique_ptr<GraphOptimizationPass<Base> > > passes_;
+    /**
+     * maximum number of times all the passes are applied
+     */
+    size_t maxIterations_;
+    /**
+     * whether or not to print out the number of operations after each pass
+     */
+    bool verbose_;
+    /**
+     * number of operations in the original model (last optimization)
+     */
+    size_t originalOperations_;
+    /**
+     * number of operations in the optimized model (last optimization)
+     */
+    size_t optimizedOperations_;
+public:
+
+    /**
+     * @param defaultPasses whether or not to add the default optimization
+     *                      passes
+     */
+    inline explicit GraphOptimizer(bool defaultPasses = true) :
+        maxIterations_(3),
+        verbose_(false),
+        originalOperations_(0),
+        optimizedOperations_(0) {
+        if (defaultPasses) {
+            addPass(std::unique_ptr<GraphOptimizationPass<Base> >(new ConstantFoldingPass<Base>()));
+            addPass(std::unique_ptr<GraphOptimizationPass<Base> >(new CanonicalizationPass<Base>()));
+            addPass(std::unique_ptr<GraphOptimizationPass<Base> >(new CommonSubexpressionEliminationPass<Base>()));
+        }
+    }
+
+    inline virtual ~GraphOptimizer() = default;
+
+    /**
+     * Adds a new pass which is applied after all the previously added
+     * passes.
+     */
+    inline void addPass(std::unique_ptr<GraphOptimizationPass<Base> > pass) {
+        CPPADCG_ASSERT_KNOWN(pass != nullptr, "Invalid optimization pass");
+        passes_.push_back(std::move(pass));
+    }
+
+    inline const std::vector<std::unique_ptr<GraphOptimizationPass<Base> > >& getPasses() const {
+        return passes_;
+    }
+
+    inline void clearPasses() {
+        passes_.clear();
+    }
+
+    /**
+     * Defines the maximum number of times the sequence of passes is applied.
+     */
+    inline void setMaxIterations(size_t maxIterations) {
+        maxIterations_ = maxIterations;
+    }
+
+    inline size_t getMaxIterations() const {
+        return maxIterations_;
+    }
+
+    inline void setVerbose(bool verbose) {
+        verbose_ = verbose;
+    }
+
+    inline bool isVerbose() const {
+        return verbose_;
+    }
+
+    /**
+     * @return the number of operations in the original model of the last
+     *         optimization
+     */
+    inline size_t getOriginalOperationCount() const {
+        return originalOperations_;
+    }
+
+    /**
+     * @return the number of operations in the optimized model of the last
+     *         optimization
+     */
+    inline size_t getOptimizedOperationCount() const {
+        return optimizedOperations_;
+    }
+
+    /**
+     * Creates an optimized version of a model.
+     *
+     * @param fun the original model
+     * @param x the values of the independent variables used to record the
+     *          new model (zero if not provided)
+     * @return the optimized model
+     * @throws CGException on error (such as an unhandled operation type)
+     */
+    inline std::unique_ptr<ADFun<CGBase> > optimize(ADFun<CGBase>& fun,
+                                                     const std::vector<Base>& x = std::vector<Base>()) {
+        const size_t n = fun.Domain();
+
+        if (!x.empty() && x.size() != n) {
+            throw CGException("Invalid independent variable size. Expected ", n, " but got ", x.size(), ".");
+        }
+
+        /**
+         * original operation graph
+         */
+        std::unique_ptr<CodeHandler<Base> > handler(new CodeHandler<Base>());
+
+        std::vector<CGBase> indep(n);
+        makeVariables(*handler, indep, x);
+
+        std::vector<CGBase> dep = fun.Forward(0, indep);
+
+        // atomic functions are only registered in the original code handler
+        const std::map<size_t, CGAbstractAtomicFun<Base>*> atomics = handler->getAtomicFunctions();
+
+        originalOperations_ = countOperations(*handler, dep);
+        optimizedOperations_ = originalOperations_;
+
+        if (verbose_) {
+            std::cout << "original model: " << originalOperations_ << " operations" << std::endl;
+        }
+
+        /**
+         * apply the passes
+         */
+        for (size_t it = 0; it < maxIterations_ && !passes_.empty(); ++it) {
+            size_t before = optimizedOperations_;
+
+            for (const auto& pass : passes_) {
+                std::unique_ptr<CodeHandler<Base> > handlerNew(new CodeHandler<Base>());
+
+                std::vector<CGBase> indepNew(n);
+                makeVariables(*handlerNew, indepNew, x);
+
+                dep = pass->apply(*handler, indepNew, dep);
+
+                // the previous operation graph is no longer required
+                indep = std::move(indepNew);
+                handler = std::move(handlerNew);
+
+                optimizedOperations_ = countOperations(*handler, dep);
+
+                if (verbose_) {
+                    std::cout << pass->getName() << ": " << optimizedOperations_ << " operations" << std::endl;
+                }
+            }
+
+            if (optimizedOperations_ >= before) {
+                break;
+            }
+        }
+
+        /**
+         * record the new model
+         */
+        std::vector<ADCG> xNew(n);
+        for (size_t j = 0; j < n; j++) {
+            xNew[j] = x.empty() ? Base(0) : x[j];
+        }
+
+        CppAD::Independent(xNew);
+
+        std::vector<ADCG> yNew;
+        try {
+            Evaluator<Base, CGBase> evaluator(*handler);
+            evaluator.setPrintOutPrintOperations(false);
+            for (const auto& itAtomic : atomics) {
+                evaluator.addAtomicFunction(itAtomic.first, *itAtomic.second);
+            }
+
+            yNew = evaluator.evaluate(xNew, dep);
+        } catch (...) {
+            ADCG::abort_recording();
+            throw;
+        }
+
+        try {
+            return std::unique_ptr<ADFun<CGBase> >(new ADFun<CGBase>(xNew, yNew));
+        } catch (const std::exception& ex) {
+            throw CGException("Failed to create ADFun: ", ex.what());
+        }
+    }
+
+    /**
+     * Determines the number of operations required to evaluate the
+     * dependent variables.
+     *
+     * @param handler the code handler which manages the operations
+     * @param dep the dependent variables
+     */
+    static inline size_t countOperations(CodeHandler<Base>& handler,
+                                         const std::vector<CGBase>& dep) {
+        CodeHandlerVector<Base, bool> visited(handler);
+        visited.adjustSize();
+        visited.fill(false);
+
+        std::vector<Node*> stack;
+        for (const CGBase& d : dep) {
+            if (d.getOperationNode() != nullptr) {
+                stack.push_back(d.getOperationNode());
+            }
+        }
+
+        size_t count = 0;
+        while (!stack.empty()) {
+            Node* node = stack.back();
+            stack.pop_back();
+
+            if (visited[*node])
+                continue;
+            visited[*node] = true;
+            count++;
+
+            for (const Argument<Base>& a : node->getArguments()) {
+                if (a.getOperation() != nullptr && !visited[*a.getOperation()]) {
+                    stack.push_back(a.getOperation());
+                }
+            }
+        }
+
+        return count;
+    }
+
+protected:
+
+    static inline void makeVariables(CodeHandler<Base>& handler,
+                                     std::vector<CGBase>& indep,
+                                     const std::vector<Base>& x) {
+        handler.makeVariables(indep);
+        for (size_t j = 0; j < x.size(); j++) {
+            indep[j].setValue(x[j]);
+        }
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
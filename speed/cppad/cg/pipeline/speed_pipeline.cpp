@@ -0,0 +1,649 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+/**
+ * Measures every stage of the creation and usage of a compiled model
+ * (taping, operation graph creation, source generation, compilation,
+ * linking, JIT, loading the dynamic library, and the evaluation of each
+ * GenericModel method) for the models used by the tests.
+ * Each stage is repeated several times and the statistics are written in
+ * CSV or JSON so that they can be compared between releases.
+ *
+ * Usage:
+ *   speed_pipeline [csv|json] [build repetitions] [evaluation repetitions]
+ *                  [evaluations per repetition] [model names...]
+ */
+#include <numeric>
+#include <cppad/cg.hpp>
+#include <cppad/cg/model/llvm/llvm.hpp>
+#include "../../../../test/cppad/cg/models/cstr.hpp"
+#include "../../../../test/cppad/cg/models/distillation.hpp"
+#include "../../../../test/cppad/cg/models/tank_battery.hpp"
+#include "../../../../test/cppad/cg/models/plug_flow.hpp"
+#include "../../../../test/cppad/cg/models/collocation.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+using Base = double;
+using CGD = CG<Base>;
+using ADCGD = AD<CGD>;
+
+namespace {
+
+/**
+ * Collects the elapsed time of the jobs reported while creating a library
+ */
+class PipelineListener : public JobListener {
+public:
+    duration graph;
+    duration source;
+    duration compilation;
+    duration linking;
+    duration library;
+    duration jit;
+public:
+
+    PipelineListener() {
+        reset();
+    }
+
+    inline void reset() {
+        graph = duration(0);
+        source = duration(0);
+        compilation = duration(0);
+        linking = duration(0);
+        library = duration(0);
+        jit = duration(0);
+    }
+
+    void jobStarted(const std::vector<Job>& job) override {
+        // do nothing
+    }
+
+    void jobEndended(const std::vector<Job>& job,
+                     duration elapsed) override {
+        const JobType* type = &job.back().getType();
+
+        if (type == &JobTimer::GRAPH) {
+            graph += elapsed;
+        } else if (type == &JobTimer::SOURCE_FOR_MODEL) {
+            source += elapsed;
+        } else if (type == &JobTimer::COMPILING_FOR_MODEL) {
+            compilation += elapsed;
+        } else if (type == &JobTimer::COMPILING_DYNAMIC_LIBRARY) {
+            linking += elapsed;
+        } else if (type == &JobTimer::DYNAMIC_MODEL_LIBRARY) {
+            library += elapsed;
+        } else if (type == &JobTimer::JIT_MODEL_LIBRARY) {
+            jit += elapsed;
+        }
+    }
+};
+
+inline double seconds(std::chrono::steady_clock::duration dt) {
+    return std::chrono::duration<double>(dt).count();
+}
+
+/**
+ * The measurements of a stage for a model
+ */
+struct Result {
+    std::string model;
+    std::string backend;
+    std::string stage;
+    size_t n;
+    size_t m;
+    std::vector<double> samples; // in seconds
+
+    inline double mean() const {
+        return std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+    }
+
+    inline double stddev() const {
+        if (samples.size() < 2)
+            return 0;
+        double avg = mean();
+        double sum = 0;
+        for (double s : samples)
+            sum += (s - avg) * (s - avg);
+        return std::sqrt(sum / (samples.size() - 1));
+    }
+
+    inline double median() const {
+        std::vector<double> s = samples;
+        std::sort(s.begin(), s.end());
+        size_t k = s.size() / 2;
+        return s.size() % 2 == 1 ? s[k] : 0.5 * (s[k - 1] + s[k]);
+    }
+
+    inline double min() const {
+        return *std::min_element(samples.begin(), samples.end());
+    }
+
+    inline double max() const {
+        return *std::max_element(samples.begin(), samples.end());
+    }
+};
+
+void printCsv(std::ostream& out,
+              const std::vector<Result>& results) {
+    out << "model,backend,stage,n,m,samples,mean,stddev,min,median,max\n";
+    for (const Result& r : results) {
+        out << r.model << "," << r.backend << "," << r.stage << ","
+            << r.n << "," << r.m << "," << r.samples.size() << ","
+            << r.mean() << "," << r.stddev() << "," << r.min() << ","
+            << r.median() << "," << r.max() << "\n";
+    }
+}
+
+void printJson(std::ostream& out,
+               const std::vector<Result>& results,
+               size_t buildRepetitions,
+               size_t evalRepetitions,
+               size_t evaluations) {
+    out << "{\n"
+           "  \"benchmark\": \"pipeline\",\n"
+           "  \"unit\": \"s\",\n"
+           "  \"buildRepetitions\": " << buildRepetitions << ",\n"
+           "  \"evaluationRepetitions\": " << evalRepetitions << ",\n"
+           "  \"evaluationsPerRepetition\": " << evaluations << ",\n"
+           "  \"results\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out << (i == 0 ? "\n" : ",\n")
+            << "    {\"model\": \"" << r.model << "\", "
+            << "\"backend\": \"" << r.backend << "\", "
+            << "\"stage\": \"" << r.stage << "\", "
+            << "\"n\": " << r.n << ", "
+            << "\"m\": " << r.m << ", "
+            << "\"samples\": " << r.samples.size() << ", "
+            << "\"mean\": " << r.mean() << ", "
+            << "\"stddev\": " << r.stddev() << ", "
+            << "\"min\": " << r.min() << ", "
+            << "\"median\": " << r.median() << ", "
+            << "\"max\": " << r.max() << "}";
+    }
+    out << "\n  ]\n"
+           "}\n";
+}
+
+/**
+ * The average time of a call to f() for each repetition
+ */
+template<class Func>
+std::vector<double> measure(size_t nRepetitions,
+                            size_t nEvaluations,
+                            Func f) {
+    f(); // warm up
+    std::vector<double> samples(nRepetitions);
+    for (size_t r = 0; r < nRepetitions; r++) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t e = 0; e < nEvaluations; e++)
+            f();
+        samples[r] = seconds(std::chrono::steady_clock::now() - start) / nEvaluations;
+    }
+    return samples;
+}
+
+/**
+ * Collocation model using the plug flow model as an atomic function
+ * (see also speed_collocation)
+ */
+class PlugFlowCollocationModel : public CollocationModel<CGD> {
+protected:
+    size_t nEls_; // number of plug flow discretization elements
+public:
+
+    PlugFlowCollocationModel(size_t nEls) :
+        CollocationModel<CGD>(PlugFlowModel<AD<double>>::N_EL_STATES * nEls, // ns
+                              PlugFlowModel<AD<double>>::N_CONTROLS, // nm
+                              PlugFlowModel<AD<double>>::N_PAR), // npar
+        nEls_(nEls) {
+        setTypicalAtomModelValues(PlugFlowModel<CGD>::getTypicalValues(nEls));
+    }
+
+    /**
+     * Compiles the atomic function with the default compiler flags
+     * (the tests use flags for debugging)
+     */
+    void createAtomicLib() {
+        std::vector<ADCGD> xa(xa_.begin(), xa_.end());
+        CppAD::Independent(xa);
+
+        std::vector<ADCGD> ya(ns_);
+        atomicFunction(xa, ya);
+
+        ADFun<CGD> fun;
+        fun.Dependent(ya);
+
+        std::string lName = getAtomicLibName();
+        ModelCSourceGen<double> cSource(fun, lName);
+        cSource.setCreateForwardZero(true);
+        cSource.setCreateForwardOne(true);
+        cSource.setCreateReverseOne(true);
+        cSource.setCreateReverseTwo(true);
+        cSource.setTypicalIndependentValues(xa_);
+
+        ModelLibraryCSourceGen<double> libSource(cSource);
+
+        DynamicModelLibraryProcessor<double> p(libSource, "lib" + lName);
+        GccCompiler<double> compiler;
+        atomicDynamicLib_ = p.createDynamicLibrary(compiler);
+        atomicModel_ = atomicDynamicLib_->model(lName);
+    }
+
+protected:
+
+    void atomicFunction(const std::vector<AD<CG<double> > >& x,
+                        std::vector<AD<CG<double> > >& y) override {
+        PlugFlowModel<CG<double> > m;
+        y = m.model2(x, nEls_);
+    }
+
+    void atomicFunction(const std::vector<AD<double> >& x,
+                        std::vector<AD<double> >& y) override {
+        PlugFlowModel<double> m;
+        y = m.model2(x, nEls_);
+    }
+
+    std::string getAtomicLibName() override {
+        return "plugflow";
+    }
+};
+
+/**
+ * A model which is used in the benchmark
+ */
+struct BenchmarkModel {
+    std::string name;
+    std::vector<Base> x;
+    std::function<std::vector<ADCGD>(const std::vector<ADCGD>&)> tape;
+    std::vector<GenericModel<Base>*> externalModels;
+};
+
+const size_t nCstrInd = 28;
+
+std::vector<Base> cstrValues(size_t nCstr) {
+    std::vector<Base> xNorm{0.3, 7.82e3, 304.65, 301.15, 2.3333e-04, 6.6667e-05,
+                            6.2e14, 10080, 2e3, 10e3, 1e-11, 6.6667e-05, 294.15, 294.15,
+                            1000, 4184, -33488, 299.15, 302.65, 7e5, 1203, 3.22, 950.0,
+                            0.48649427192323, 1000, 4184, 0.014, 1e-7};
+
+    std::vector<Base> x(nCstr * nCstrInd);
+    for (size_t i = 0; i < nCstr; i++)
+        std::copy(xNorm.begin(), xNorm.end(), x.begin() + i * nCstrInd);
+    return x;
+}
+
+std::vector<ADCGD> cstrModel(const std::vector<ADCGD>& x) {
+    size_t nCstr = x.size() / nCstrInd;
+
+    std::vector<ADCGD> y;
+    y.reserve(nCstr * 4);
+
+    std::vector<ADCGD> ind(nCstrInd);
+    for (size_t i = 0; i < nCstr; i++) {
+        std::copy(x.begin() + i * nCstrInd, x.begin() + (i + 1) * nCstrInd, ind.begin());
+        std::vector<ADCGD> dxdt = CstrFunc<CGD>(ind);
+        y.insert(y.end(), dxdt.begin(), dxdt.end());
+    }
+
+    return y;
+}
+
+std::vector<Base> distillationValues() {
+    const size_t nStage = 8;
+
+    std::vector<Base> x;
+    for (size_t i = 0; i < nStage; i++) x.push_back(12000 + 1); // mWater
+    for (size_t i = 0; i < nStage; i++) x.push_back(12000 + 1); // mEthanol[i]
+    for (size_t i = 0; i < nStage; i++) x.push_back(360 + (i + 1)); // T[i]
+    for (size_t i = 0; i < nStage; i++) x.push_back(0.3 + 0.05 * i); // yWater[i]
+    for (size_t i = 0; i < nStage; i++) x.push_back(0.7 - 0.05 * i); // yEthanol[i]
+    for (size_t i = 0; i < nStage - 1; i++) x.push_back(8 + 0.1 * i); // V[i]
+    x.push_back(150e3); // Qc
+
+    x.push_back(250e3); // Qsteam
+    x.push_back(0.1); // Fdistillate
+    x.push_back(2.5); // reflux
+    x.push_back(4); // Frectifier
+
+    x.push_back(30); // feed
+    x.push_back(1.01325e5); // P
+    x.push_back(0.7); // xFWater
+    x.push_back(366); // Tfeed
+
+    return x;
+}
+
+std::vector<Base> tankBatteryValues() {
+    std::vector<Base> x(8);
+    for (size_t j = 0; j < 6; j++)
+        x[j] = 1.0 + 0.1 * j; // mass of water in each tank
+    x[6] = 10; // inlet flow
+    x[7] = 0.05; // radius of the outlet
+    return x;
+}
+
+/**
+ * Evaluates each method of the compiled model
+ */
+void measureEvaluation(const std::string& modelName,
+                       const std::string& backend,
+                       GenericModel<Base>& model,
+                       const std::vector<Base>& x,
+                       size_t nRepetitions,
+                       size_t nEvaluations,
+                       std::vector<Result>& results) {
+    const size_t n = model.Domain();
+    const size_t m = model.Range();
+
+    ArrayView<const Base> xv(x);
+
+    auto add = [&](const std::string& stage, std::vector<double> samples) {
+        results.push_back(Result{modelName, backend, stage, n, m, std::move(samples)});
+    };
+
+    // values used by the first and second order methods (direction of x[0])
+    std::vector<Base> y(m);
+    std::vector<Base> w(m, 1.0);
+    std::vector<Base> tx(2 * n), ty(2 * m), px(2 * n), py(2 * m);
+    for (size_t j = 0; j < n; j++) {
+        tx[j * 2] = x[j];
+        tx[j * 2 + 1] = j == 0 ? 1.0 : 0.0;
+    }
+    std::vector<size_t> idx(m);
+    std::iota(idx.begin(), idx.end(), 0);
+    const size_t idx0 = 0;
+    const Base one = 1.0;
+
+    if (model.isForwardZeroAvailable()) {
+        model.ForwardZero(xv, ArrayView<Base>(y));
+        add("ForwardZero", measure(nRepetitions, nEvaluations, [&]() {
+            model.ForwardZero(xv, ArrayView<Base>(y));
+        }));
+    }
+
+    if (model.isJacobianAvailable()) {
+        std::vector<Base> jac(m * n);
+        add("Jacobian", measure(nRepetitions, nEvaluations, [&]() {
+            model.Jacobian(xv, ArrayView<Base>(jac));
+        }));
+    }
+
+    if (model.isHessianAvailable()) {
+        std::vector<Base> hess(n * n);
+        add("Hessian", measure(nRepetitions, nEvaluations, [&]() {
+            model.Hessian(xv, ArrayView<const Base>(w), ArrayView<Base>(hess));
+        }));
+    }
+
+    if (model.isSparseJacobianAvailable()) {
+        std::vector<size_t> rows, cols;
+        model.JacobianSparsity(rows, cols);
+        std::vector<Base> jac(rows.size());
+        const size_t* row;
+        const size_t* col;
+        add("SparseJacobian", measure(nRepetitions, nEvaluations, [&]() {
+            model.SparseJacobian(xv, ArrayView<Base>(jac), &row, &col);
+        }));
+    }
+
+    if (model.isSparseHessianAvailable()) {
+        std::vector<size_t> rows, cols;
+        model.HessianSparsity(rows, cols);
+        std::vector<Base> hess(rows.size());
+        const size_t* row;
+        const size_t* col;
+        add("SparseHessian", measure(nRepetitions, nEvaluations, [&]() {
+            model.SparseHessian(xv, ArrayView<const Base>(w), ArrayView<Base>(hess), &row, &col);
+        }));
+    }
+
+    if (model.isForwardOneAvailable()) {
+        add("ForwardOne", measure(nRepetitions, nEvaluations, [&]() {
+            model.ForwardOne(ArrayView<const Base>(tx), ArrayView<Base>(ty));
+        }));
+    }
+
+    if (model.isSparseForwardOneAvailable()) {
+        std::vector<Base> ty1(m);
+        add("SparseForwardOne", measure(nRepetitions, nEvaluations, [&]() {
+            model.ForwardOne(xv, 1, &idx0, &one, ArrayView<Base>(ty1));
+        }));
+    }
+
+    if (model.isReverseOneAvailable()) {
+        std::vector<Base> ty0(y), px1(n);
+        add("ReverseOne", measure(nRepetitions, nEvaluations, [&]() {
+            model.ReverseOne(xv, ArrayView<const Base>(ty0), ArrayView<Base>(px1), ArrayView<const Base>(w));
+        }));
+    }
+
+    if (model.isSparseReverseOneAvailable()) {
+        std::vector<Base> px1(n);
+        add("SparseReverseOne", measure(nRepetitions, nEvaluations, [&]() {
+            model.ReverseOne(xv, ArrayView<Base>(px1), m, idx.data(), w.data());
+        }));
+    }
+
+    if (model.isReverseTwoAvailable()) {
+        for (size_t i = 0; i < m; i++) {
+            py[i * 2] = 0.0; // must be zero
+            py[i * 2 + 1] = 1.0;
+        }
+        add("ReverseTwo", measure(nRepetitions, nEvaluations, [&]() {
+            model.ReverseTwo(ArrayView<const Base>(tx), ArrayView<const Base>(ty),
+                             ArrayView<Base>(px), ArrayView<const Base>(py));
+        }));
+    }
+
+    if (model.isSparseReverseTwoAvailable()) {
+        std::vector<Base> px2(n);
+        add("SparseReverseTwo", measure(nRepetitions, nEvaluations, [&]() {
+            model.ReverseTwo(xv, 1, &idx0, &one, ArrayView<Base>(px2), ArrayView<const Base>(w));
+        }));
+    }
+}
+
+/**
+ * Creates the libraries of a model several times and then evaluates
+ * the compiled model
+ */
+void benchmark(const BenchmarkModel& bm,
+               size_t buildRepetitions,
+               size_t evalRepetitions,
+               size_t nEvaluations,
+               std::vector<Result>& results) {
+    const std::string& name = bm.name;
+    const std::string libName = "lib" + name;
+    const size_t n = bm.x.size();
+    size_t m = 0;
+
+    std::vector<std::string> stages{"taping", "graph", "source", "compilation",
+                                    "linking", "library", "dlopen", "jit"};
+    std::map<std::string, std::vector<double> > samples;
+
+    PipelineListener listener;
+
+    std::unique_ptr<LinuxDynamicLib<Base> > dynLib;
+    std::unique_ptr<GenericModel<Base> > dynModel;
+    std::unique_ptr<LlvmModelLibrary<Base> > llvmLib;
+    std::unique_ptr<GenericModel<Base> > llvmModel;
+
+    for (size_t r = 0; r < buildRepetitions; r++) {
+        std::cerr << name << ": build " << (r + 1) << "/" << buildRepetitions << std::endl;
+
+        // the library file is replaced and it must not be loaded anymore
+        dynModel.reset();
+        dynLib.reset();
+        llvmModel.reset();
+        llvmLib.reset();
+
+        /**
+         * taping
+         */
+        auto start = std::chrono::steady_clock::now();
+
+        std::vector<ADCGD> x(bm.x.begin(), bm.x.end());
+        CppAD::Independent(x);
+        std::vector<ADCGD> y = bm.tape(x);
+        ADFun<CGD> fun(x, y);
+
+        samples["taping"].push_back(seconds(std::chrono::steady_clock::now() - start));
+        m = fun.Range();
+
+        /**
+         * source generation and compilation
+         */
+        ModelCSourceGen<Base> cSource(fun, name);
+        cSource.setCreateForwardZero(true);
+        cSource.setCreateJacobian(true);
+        cSource.setCreateHessian(true);
+        cSource.setCreateSparseJacobian(true);
+        cSource.setCreateSparseHessian(true);
+        cSource.setCreateForwardOne(true);
+        cSource.setCreateReverseOne(true);
+        cSource.setCreateReverseTwo(true);
+        cSource.setTypicalIndependentValues(bm.x);
+
+        ModelLibraryCSourceGen<Base> libSource(cSource);
+        libSource.addListener(listener);
+
+        listener.reset();
+
+        DynamicModelLibraryProcessor<Base> p(libSource, libName);
+        GccCompiler<Base> compiler;
+        p.createDynamicLibrary(compiler, false);
+
+        samples["graph"].push_back(seconds(listener.graph));
+        samples["source"].push_back(seconds(listener.source));
+        samples["compilation"].push_back(seconds(listener.compilation));
+        samples["linking"].push_back(seconds(listener.linking));
+        samples["library"].push_back(seconds(listener.library));
+
+        /**
+         * load the dynamic library
+         */
+        start = std::chrono::steady_clock::now();
+
+        dynLib.reset(new LinuxDynamicLib<Base>(libName + system::SystemInfo<>::DYNAMIC_LIB_EXTENSION));
+        dynModel = dynLib->model(name);
+
+        samples["dlopen"].push_back(seconds(std::chrono::steady_clock::now() - start));
+
+        /**
+         * JIT (the sources were already generated)
+         */
+        listener.reset();
+
+        llvmLib = LlvmModelLibraryProcessor<Base>::create(libSource);
+        llvmModel = llvmLib->model(name);
+
+        samples["jit"].push_back(seconds(listener.jit));
+    }
+
+    for (const std::string& stage : stages) {
+        results.push_back(Result{name, "build", stage, n, m, samples[stage]});
+    }
+
+    /**
+     * evaluation
+     */
+    for (GenericModel<Base>* atom : bm.externalModels) {
+        dynModel->addExternalModel(*atom);
+        llvmModel->addExternalModel(*atom);
+    }
+
+    std::cerr << name << ": evaluation" << std::endl;
+    measureEvaluation(name, "dynamic", *dynModel, bm.x, evalRepetitions, nEvaluations, results);
+    measureEvaluation(name, "llvm", *llvmModel, bm.x, evalRepetitions, nEvaluations, results);
+}
+
+size_t parseArgument(int pos, int argc, char **argv, size_t defaultValue) {
+    if (argc > pos)
+        return std::stoul(argv[pos]);
+    return defaultValue;
+}
+
+} // END namespace
+
+int main(int argc, char **argv) {
+    std::string format = argc > 1 ? argv[1] : "csv";
+    size_t buildRepetitions = parseArgument(2, argc, argv, 3);
+    size_t evalRepetitions = parseArgument(3, argc, argv, 10);
+    size_t nEvaluations = parseArgument(4, argc, argv, 100);
+    std::set<std::string> selected(argv + std::min(argc, 5), argv + argc);
+
+    if (format != "csv" && format != "json") {
+        std::cerr << "Unknown output format '" << format << "' (expected csv or json)" << std::endl;
+        return 1;
+    }
+    if (buildRepetitions == 0 || evalRepetitions == 0 || nEvaluations == 0) {
+        std::cerr << "The number of repetitions and evaluations must be positive" << std::endl;
+        return 1;
+    }
+
+    const size_t nCstr = 10;
+    const size_t nPlugFlowEls = 10;
+    const size_t nCollocationEls = 5;
+    const size_t nTimeIntervals = 5;
+
+    PlugFlowCollocationModel collocation(nCollocationEls);
+
+    std::vector<BenchmarkModel> models;
+
+    models.push_back(BenchmarkModel{"cstr", cstrValues(nCstr), cstrModel, {}});
+
+    models.push_back(BenchmarkModel{"distillation", distillationValues(), [](const std::vector<ADCGD>& x) {
+        return distillationFunc<CGD>(x);
+    }, {}});
+
+    models.push_back(BenchmarkModel{"plugflow", PlugFlowModel<Base>::getTypicalValues(nPlugFlowEls), [&](const std::vector<ADCGD>& x) {
+        PlugFlowModel<CGD> m;
+        return m.model2(x, nPlugFlowEls);
+    }, {}});
+
+    models.push_back(BenchmarkModel{"tankbattery", tankBatteryValues(), [](const std::vector<ADCGD>& x) {
+        return tankBatteryFunc<CGD>(x);
+    }, {}});
+
+    models.push_back(BenchmarkModel{"collocation", collocation.getTypicalValues(nTimeIntervals), [&](const std::vector<ADCGD>& x) {
+        return collocation.evaluateModel(x, nTimeIntervals);
+    }, {}});
+
+    std::vector<Result> results;
+
+    for (BenchmarkModel& bm : models) {
+        if (!selected.empty() && selected.find(bm.name) == selected.end())
+            continue;
+
+        if (bm.name == "collocation") {
+            // the atomic function is compiled only once (not measured)
+            collocation.createAtomicLib();
+            bm.externalModels.push_back(collocation.getGenericModel());
+        }
+
+        benchmark(bm, buildRepetitions, evalRepetitions, nEvaluations, results);
+    }
+
+    std::cout << std::setprecision(9);
+    if (format == "json") {
+        printJson(std::cout, results, buildRepetitions, evalRepetitions, nEvaluations);
+    } else {
+        printCsv(std::cout, results);
+    }
+}
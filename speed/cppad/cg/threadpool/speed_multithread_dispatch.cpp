@@ -0,0 +1,113 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+/**
+ * Compares the call latency of the multithreaded (PThreads) sparse Jacobian
+ * and sparse Hessian when each function is a job and when consecutive
+ * functions are grouped into a few jobs, for different numbers of threads
+ */
+#include <cppad/cg.hpp>
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+using Base = double;
+using CGD = CG<Base>;
+using ADCGD = AD<CGD>;
+
+namespace {
+
+/**
+ * A large and very sparse model (each equation only depends on a few
+ * variables) with many small row/column functions
+ */
+std::vector<ADCGD> model(const std::vector<ADCGD>& x) {
+    size_t n = x.size();
+    std::vector<ADCGD> y(n);
+    for (size_t i = 0; i < n; i++) {
+        const ADCGD& xp = x[(i + 1) % n];
+        y[i] = x[i] * xp + sin(x[i]) * 0.5 - exp(-xp * xp);
+    }
+    return y;
+}
+
+template<class Func>
+double measure(size_t nExecutions, Func f) {
+    f(); // warm up (and time measurements used by the thread pool)
+    auto start = std::chrono::steady_clock::now();
+    for (size_t e = 0; e < nExecutions; e++)
+        f();
+    std::chrono::duration<double> dt = std::chrono::steady_clock::now() - start;
+    return dt.count() / nExecutions;
+}
+
+} // END namespace
+
+int main(int argc, char **argv) {
+    size_t n = 2000;
+    size_t nExecutions = 1000;
+    if (argc > 1)
+        n = std::stoul(argv[1]);
+    if (argc > 2)
+        nExecutions = std::stoul(argv[2]);
+
+    std::vector<Base> xv(n);
+    for (size_t j = 0; j < n; j++)
+        xv[j] = 0.5 + 1e-3 * j;
+
+    std::vector<ADCGD> x(xv.begin(), xv.end());
+    Independent(x);
+    ADFun<CGD> fun(x, model(x));
+
+    std::vector<Base> w(fun.Range(), 1.0);
+
+    std::cout << "# variables: " << n << "\n"
+            "# executions: " << nExecutions << "\n"
+            "# max_jobs   threads   jacobian(s)   hessian(s)" << std::endl;
+
+    for (size_t maxJobs : {size_t(0), size_t(256), size_t(32)}) {
+        std::string name = "dispatch" + std::to_string(maxJobs);
+        ModelCSourceGen<Base> cSource(fun, name);
+        cSource.setCreateSparseJacobian(true);
+        cSource.setCreateSparseHessian(true);
+        cSource.setCreateForwardOne(true);
+        cSource.setCreateReverseTwo(true);
+        cSource.setMultiThreading(true);
+        cSource.setMaxMultiThreadingJobs(maxJobs);
+
+        ModelLibraryCSourceGen<Base> libSource(cSource);
+        libSource.setMultiThreading(MultiThreadingType::PTHREADS);
+
+        GccCompiler<Base> compiler;
+        compiler.setCompileFlags({"-O2"});
+
+        DynamicModelLibraryProcessor<Base> p(libSource, "lib" + name);
+        std::unique_ptr<DynamicLib<Base> > lib = p.createDynamicLibrary(compiler);
+        std::unique_ptr<GenericModel<Base> > m = lib->model(name);
+
+        for (unsigned int nThreads : {1u, 2u, 4u, 8u}) {
+            lib->setThreadNumber(nThreads);
+
+            double tJac = measure(nExecutions, [&]() {
+                m->SparseJacobian(xv);
+            });
+            double tHess = measure(nExecutions, [&]() {
+                m->SparseHessian(xv, w);
+            });
+
+            std::cout << maxJobs << "   " << nThreads << "   " << tJac << "   " << tHess << std::endl;
+        }
+    }
+}
@@ -0,0 +1,135 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+/**
+ * Compares the speed of models generated with and without fused
+ * transcendental functions (sincos(), shared exp() for sinh()/cosh())
+ */
+#include <cppad/cg.hpp>
+#include "../../../../test/cppad/cg/models/cstr.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+using Base = double;
+using CGD = CG<Base>;
+using ADCGD = AD<CGD>;
+
+namespace {
+
+const size_t nCstrInd = 28;
+
+/**
+ * CSTRs with a periodic feed and a Butler-Volmer like heat exchange term
+ */
+std::vector<ADCGD> model(const std::vector<ADCGD>& x, size_t nCstr) {
+    const ADCGD& t = x[nCstr * nCstrInd];
+
+    std::vector<ADCGD> y;
+    y.reserve(nCstr * 4);
+
+    std::vector<ADCGD> ind(nCstrInd);
+    for (size_t i = 0; i < nCstr; i++) {
+        std::copy(x.begin() + i * nCstrInd, x.begin() + (i + 1) * nCstrInd, ind.begin());
+
+        std::vector<ADCGD> dxdt = CstrFunc<CGD>(ind);
+
+        ADCGD phase = 0.1 * t + 0.05 * double(i);
+        dxdt[0] += ind[4] * (0.1 * sin(phase) + 0.05 * cos(phase));
+
+        ADCGD eta = 0.5 * (ind[2] - ind[3]) / ind[2];
+        dxdt[2] += 1e-3 * sinh(eta);
+        dxdt[3] -= 1e-3 * sinh(eta) * exp(-eta);
+
+        y.insert(y.end(), dxdt.begin(), dxdt.end());
+    }
+
+    return y;
+}
+
+std::vector<Base> typicalValues(size_t nCstr) {
+    std::vector<Base> xNorm{0.3, 7.82e3, 304.65, 301.15, 2.3333e-04, 6.6667e-05,
+                            6.2e14, 10080, 2e3, 10e3, 1e-11, 6.6667e-05, 294.15, 294.15,
+                            1000, 4184, -33488, 299.15, 302.65, 7e5, 1203, 3.22, 950.0,
+                            0.48649427192323, 1000, 4184, 0.014, 1e-7};
+
+    std::vector<Base> x(nCstr * nCstrInd + 1);
+    for (size_t i = 0; i < nCstr; i++)
+        std::copy(xNorm.begin(), xNorm.end(), x.begin() + i * nCstrInd);
+    x.back() = 10.0; // time
+    return x;
+}
+
+template<class Func>
+double measure(size_t nExecutions, Func f) {
+    f(); // warm up
+    auto start = std::chrono::steady_clock::now();
+    for (size_t e = 0; e < nExecutions; e++)
+        f();
+    std::chrono::duration<double> dt = std::chrono::steady_clock::now() - start;
+    return dt.count() / nExecutions;
+}
+
+} // END namespace
+
+int main(int argc, char **argv) {
+    size_t nCstr = 10;
+    size_t nExecutions = 1000;
+    if (argc > 1)
+        nCstr = std::stoul(argv[1]);
+    if (argc > 2)
+        nExecutions = std::stoul(argv[2]);
+
+    std::vector<Base> xv = typicalValues(nCstr);
+    std::vector<ADCGD> x(xv.begin(), xv.end());
+    Independent(x);
+    ADFun<CGD> fun(x, model(x, nCstr));
+
+    std::vector<Base> w(fun.Range(), 1.0);
+
+    std::cout << "# nCstr: " << nCstr << "\n"
+            "# executions: " << nExecutions << "\n"
+            "# fused   zero(s)   jacobian(s)   hessian(s)" << std::endl;
+
+    for (bool fuse : {false, true}) {
+        std::string name = fuse ? "cstr_fused" : "cstr";
+        ModelCSourceGen<Base> cSource(fun, name);
+        cSource.setCreateForwardZero(true);
+        cSource.setCreateSparseJacobian(true);
+        cSource.setCreateSparseHessian(true);
+        cSource.setFuseTranscendentalFunctions(fuse);
+
+        ModelLibraryCSourceGen<Base> libSource(cSource);
+
+        GccCompiler<Base> compiler;
+        compiler.setCompileFlags({"-O2"});
+
+        DynamicModelLibraryProcessor<Base> p(libSource, "lib" + name);
+        std::unique_ptr<DynamicLib<Base> > lib = p.createDynamicLibrary(compiler);
+        std::unique_ptr<GenericModel<Base> > m = lib->model(name);
+
+        double tZero = measure(nExecutions, [&]() {
+            m->ForwardZero(xv);
+        });
+        double tJac = measure(nExecutions, [&]() {
+            m->SparseJacobian(xv);
+        });
+        double tHess = measure(nExecutions, [&]() {
+            m->SparseHessian(xv, w);
+        });
+
+        std::cout << (fuse ? "1" : "0") << "   " << tZero << "   " << tJac << "   " << tHess << std::endl;
+    }
+}
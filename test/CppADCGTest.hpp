@@ -210,6 +210,27 @@ protected:
         }
     }
 
+    /**
+     * Provides the source files generated for a model of a library
+     * (these are only available to library processors).
+     */
+    static inline std::map<std::string, std::string> getModelSources(ModelLibraryCSourceGen<Base>& libSourceGen,
+                                                                     ModelCSourceGen<Base>& model) {
+        class SourceReader : public ModelLibraryProcessor<Base> {
+        public:
+            explicit SourceReader(ModelLibraryCSourceGen<Base>& libSourceGen) :
+                ModelLibraryProcessor<Base>(libSourceGen) {
+            }
+
+            const std::map<std::string, std::string>& read(ModelCSourceGen<Base>& model) {
+                return this->getSources(model);
+            }
+        };
+
+        SourceReader reader(libSourceGen);
+        return reader.read(model);
+    }
+
     template <class T>
     static inline ::testing::AssertionResult nearEqual(const T &x, const T &y,
                                                        const T &r = std::numeric_limits<T>::epsilon() * 100,
@@ -37,6 +37,7 @@ protected:
     bool forwardOne = true;
     bool reverseOne = true;
     bool reverseTwo = true;
+    bool directlyLinkNested = false;
 public:
 
     inline CppADCGDynamicAtomicNestedTest(const std::string& modelName,
@@ -630,6 +631,7 @@ private:
          * generate source code
          */
         ModelLibraryCSourceGen<double> compDynHelp(compHelp1, compHelp2);
+        compDynHelp.setDirectlyLinkNestedModels(directlyLinkNested);
         std::string folder = std::string("nested_sources_atomiclibmodelbridge_") + (createOuterReverse2 ? "rev2_" : "dir_") + _modelName;
         SaveFilesModelLibraryProcessor<double>::saveLibrarySourcesTo(compDynHelp, folder);
 
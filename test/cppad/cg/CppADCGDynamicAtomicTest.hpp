@@ -21,6 +21,41 @@
 namespace CppAD {
 namespace cg {
 
+/**
+ * An atomic function which only forwards the zero and first order methods
+ * to another atomic function.
+ * Since it is not a CGAtomicGenericModel, compiled models call it through
+ * the generic atomic function interface.
+ */
+template<class Base>
+class AtomicForwarder : public atomic_base<Base> {
+private:
+    atomic_base<Base>& atomic_;
+public:
+
+    AtomicForwarder(atomic_base<Base>& atomic) :
+        atomic_base<Base>(atomic.afun_name()),
+        atomic_(atomic) {
+    }
+
+    bool forward(size_t q,
+                 size_t p,
+                 const CppAD::vector<bool>& vx,
+                 CppAD::vector<bool>& vy,
+                 const CppAD::vector<Base>& tx,
+                 CppAD::vector<Base>& ty) override {
+        return atomic_.forward(q, p, vx, vy, tx, ty);
+    }
+
+    bool reverse(size_t p,
+                 const CppAD::vector<Base>& tx,
+                 const CppAD::vector<Base>& ty,
+                 CppAD::vector<Base>& px,
+                 const CppAD::vector<Base>& py) override {
+        return atomic_.reverse(p, tx, ty, px, py);
+    }
+};
+
 class CppADCGDynamicAtomicTest : public CppADCGTest {
 public:
     using Base = CppADCGTest::Base;
@@ -377,6 +412,106 @@ public:
                                  x, xNorm, eqNorm, epsilonR, epsilonA);
     }
 
+    /**
+     * Test 2 models in 2 dynamic libraries where the outer model passes its
+     * arrays directly to the inner compiled model.
+     * The results are compared with those obtained when the inner model is
+     * called through the generic atomic function interface.
+     */
+    void testAtomicLibAtomicLibDirectArrays(const CppAD::vector<Base>& x,
+                                            Base epsilonR = 1e-14, Base epsilonA = 1e-14) {
+        using namespace std;
+        using CppAD::vector;
+
+        CppAD::vector<Base> xNorm(x.size());
+        for (size_t i = 0; i < xNorm.size(); i++)
+            xNorm[i] = 1.0;
+        CppAD::vector<Base> eqNorm;
+
+        prepareAtomicLibAtomicLib(x, xNorm, eqNorm);
+        ASSERT_TRUE(_modelLib != nullptr);
+
+        // the direct path requires the sparse directional methods
+        ASSERT_TRUE(_modelLib->isSparseForwardOneAvailable());
+        ASSERT_TRUE(_modelLib->isSparseReverseOneAvailable());
+        ASSERT_TRUE(_modelLib->isSparseReverseTwoAvailable());
+
+        AtomicForwarder<Base> forwarder(_modelLib->asAtomic());
+
+        unique_ptr<GenericModel<Base> > modelDirect = _dynamicLibOuter->model(_modelName + "_outer");
+        unique_ptr<GenericModel<Base> > modelGeneric = _dynamicLibOuter->model(_modelName + "_outer");
+        ASSERT_TRUE(modelDirect.get() != nullptr);
+        ASSERT_TRUE(modelGeneric.get() != nullptr);
+
+        ASSERT_TRUE(modelDirect->addAtomicFunction(_modelLib->asAtomic()));
+        ASSERT_TRUE(modelGeneric->addAtomicFunction(forwarder));
+
+        const size_t n = modelDirect->Domain();
+        const size_t m = modelDirect->Range();
+
+        /**
+         * zero order
+         */
+        vector<Base> y = modelGeneric->ForwardZero(x);
+        ASSERT_TRUE(compareValues<double>(modelDirect->ForwardZero(x), y, epsilonR, epsilonA));
+
+        /**
+         * first order forward mode
+         */
+        vector<Base> tx(2 * n);
+        for (size_t j = 0; j < n; j++)
+            tx[j * 2] = x[j];
+
+        for (size_t j = 0; j < n; j++) {
+            tx[j * 2 + 1] = 1;
+            ASSERT_TRUE(compareValues<double>(modelDirect->ForwardOne(tx), modelGeneric->ForwardOne(tx), epsilonR, epsilonA));
+            tx[j * 2 + 1] = 0;
+        }
+
+        /**
+         * first order reverse mode
+         */
+        vector<Base> w(m);
+        for (size_t i = 0; i < m; i++) {
+            w[i] = 1;
+            ASSERT_TRUE(compareValues<double>(modelDirect->ReverseOne(x, y, w), modelGeneric->ReverseOne(x, y, w), epsilonR, epsilonA));
+            w[i] = 0;
+        }
+
+        /**
+         * second order reverse mode
+         */
+        vector<Base> ty(2 * m);
+        vector<Base> py(2 * m);
+        for (size_t i = 0; i < m; i++) {
+            ty[i * 2] = y[i];
+            py[i * 2 + 1] = 1.0;
+        }
+
+        for (size_t j = 0; j < n; j++) {
+            tx[j * 2 + 1] = 1;
+            vector<Base> pxDirect = modelDirect->ReverseTwo(tx, ty, py);
+            vector<Base> pxGeneric = modelGeneric->ReverseTwo(tx, ty, py);
+            tx[j * 2 + 1] = 0;
+
+            // only the second order information is defined
+            for (size_t j2 = 0; j2 < n; j2++) {
+                ASSERT_TRUE(nearEqual(pxDirect[j2 * 2], pxGeneric[j2 * 2], epsilonR, epsilonA));
+            }
+        }
+
+        /**
+         * Jacobian and Hessian
+         */
+        for (size_t i = 0; i < m; i++)
+            w[i] = 1;
+
+        ASSERT_TRUE(compareValues<double>(modelDirect->Jacobian(x), modelGeneric->Jacobian(x), epsilonR, epsilonA));
+        ASSERT_TRUE(compareValues<double>(modelDirect->SparseJacobian(x), modelGeneric->SparseJacobian(x), epsilonR, epsilonA));
+        ASSERT_TRUE(compareValues<double>(modelDirect->Hessian(x, w), modelGeneric->Hessian(x, w), epsilonR, epsilonA));
+        ASSERT_TRUE(compareValues<double>(modelDirect->SparseHessian(x, w), modelGeneric->SparseHessian(x, w), epsilonR, epsilonA));
+    }
+
     /**
      * Test 2 models in the same dynamic library
      */
@@ -38,6 +38,11 @@ protected:
     MultiThreadingType _multithread;
     bool _multithreadDisabled;
     ThreadPoolScheduleStrategy _multithreadScheduler;
+    size_t _multithreadMaxJobs;
+    double _multithreadMinJobCost;
+    bool _multithreadStickyJobs;
+    ThreadPoolAffinityPolicy _multithreadAffinity;
+    unsigned int _multithreadSpinWait;
 public:
 
     inline CppADCGDynamicTest(const std::string& testName,
@@ -52,7 +57,12 @@ public:
         _reverseTwo(true),
         _multithread(MultiThreadingType::NONE),
         _multithreadDisabled(false),
-        _multithreadScheduler(ThreadPoolScheduleStrategy::DYNAMIC) {
+        _multithreadScheduler(ThreadPoolScheduleStrategy::DYNAMIC),
+        _multithreadMaxJobs(256),
+        _multithreadMinJobCost(0),
+        _multithreadStickyJobs(false),
+        _multithreadAffinity(ThreadPoolAffinityPolicy::NONE),
+        _multithreadSpinWait(0) {
     }
 
     virtual std::vector<ADCGD> model(const std::vector<ADCGD>& ind) = 0;
@@ -118,6 +128,8 @@ public:
         compHelp.setCreateReverseTwo(_reverseTwo);
         compHelp.setMaxAssignmentsPerFunc(maxAssignPerFunc);
         compHelp.setMultiThreading(true);
+        compHelp.setMaxMultiThreadingJobs(_multithreadMaxJobs);
+        compHelp.setMinMultiThreadingJobCost(_multithreadMinJobCost);
 
         ModelLibraryCSourceGen<double> compDynHelp(compHelp);
         compDynHelp.setMultiThreading(_multithread);
@@ -147,6 +159,9 @@ public:
         dynamicLib->setThreadPoolDisabled(_multithreadDisabled);
         dynamicLib->setThreadPoolSchedulerStrategy(_multithreadScheduler);
         dynamicLib->setThreadPoolGuidedMaxWork(0.75);
+        dynamicLib->setThreadPoolStickyJobs(_multithreadStickyJobs);
+        dynamicLib->setThreadPoolAffinity(_multithreadAffinity);
+        dynamicLib->setThreadPoolSpinWait(_multithreadSpinWait);
 
         /**
          * test the library
@@ -191,6 +206,8 @@ public:
         compHelp.setCustomSparseHessianElements(hessRow, hessCol);
 
         compHelp.setMultiThreading(true);
+        compHelp.setMaxMultiThreadingJobs(_multithreadMaxJobs);
+        compHelp.setMinMultiThreadingJobCost(_multithreadMinJobCost);
 
         ModelLibraryCSourceGen<double> compDynHelp(compHelp);
         compDynHelp.setMultiThreading(_multithread);
@@ -220,6 +237,9 @@ public:
         dynamicLib->setThreadPoolDisabled(_multithreadDisabled);
         dynamicLib->setThreadPoolSchedulerStrategy(_multithreadScheduler);
         dynamicLib->setThreadPoolGuidedMaxWork(0.75);
+        dynamicLib->setThreadPoolStickyJobs(_multithreadStickyJobs);
+        dynamicLib->setThreadPoolAffinity(_multithreadAffinity);
+        dynamicLib->setThreadPoolSpinWait(_multithreadSpinWait);
 
         /**
          * test the library
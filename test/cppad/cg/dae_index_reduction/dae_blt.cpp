@@ -0,0 +1,154 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include <cppad/cg/dae_index_reduction/dummy_deriv.hpp>
+#include <cppad/cg/dae_index_reduction/dae_blt.hpp>
+
+#include "CppADCGIndexReductionTest.hpp"
+#include "model/pendulum.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+/**
+ * Checks that each equation only depends on the unknowns of its own block
+ * or of previous blocks
+ */
+void checkBltOrder(ADFun<CG<double> >& fun,
+                   const DaeBltDecomposition<double>& blt) {
+    using std::vector;
+
+    const vector<DaeBltBlock>& blocks = blt.getBlocks();
+
+    std::vector<std::set<size_t> > sparsity = jacobianSparsitySet<vector<std::set<size_t> > >(fun);
+
+    std::map<size_t, size_t> var2Block;
+    size_t nEq = 0;
+    for (size_t b = 0; b < blocks.size(); ++b) {
+        ASSERT_EQ(blocks[b].getEquations().size(), blocks[b].getVariables().size());
+        for (size_t j : blocks[b].getVariables())
+            var2Block[j] = b;
+        nEq += blocks[b].size();
+    }
+    ASSERT_EQ(fun.Range(), nEq);
+
+    for (size_t b = 0; b < blocks.size(); ++b) {
+        for (size_t i : blocks[b].getEquations()) {
+            for (size_t j : sparsity[i]) {
+                auto it = var2Block.find(j);
+                if (it != var2Block.end()) {
+                    ASSERT_LE(it->second, b);
+                }
+            }
+        }
+    }
+}
+
+} // END namespace
+
+TEST_F(IndexReductionTest, BltSimple) {
+    using ADCGD = AD<CGD>;
+
+    std::vector<ADCGD> U(5);
+    Independent(U);
+
+    ADCGD x = U[0];
+    ADCGD y = U[1];
+    ADCGD z = U[2];
+    ADCGD dxdt = U[4];
+
+    std::vector<ADCGD> Z(3);
+    Z[0] = dxdt + x - y;
+    Z[1] = y + z - x;
+    Z[2] = y - z * z - 1;
+
+    ADFun<CGD> fun(U, Z);
+
+    std::vector<DaeVarInfo> daeVar(5);
+    daeVar[0] = DaeVarInfo("x");
+    daeVar[1] = DaeVarInfo("y");
+    daeVar[2] = DaeVarInfo("z");
+    daeVar[3].makeIntegratedVariable();
+    daeVar[4] = DaeVarInfo(0, "dxdt");
+    daeVar[0].setDerivative(4);
+
+    std::vector<DaeEquationInfo> eqInfo(3);
+    for (size_t i = 0; i < eqInfo.size(); ++i)
+        eqInfo[i] = DaeEquationInfo(i, i, -1, -1);
+
+    DaeBltDecomposition<double> blt(fun, daeVar, eqInfo);
+    const std::vector<DaeBltBlock>& blocks = blt.decompose();
+
+    ASSERT_EQ(size_t(2), blocks.size());
+
+    ASSERT_EQ(size_t(2), blocks[0].size());
+    ASSERT_EQ(std::vector<size_t>({1, 2}), blocks[0].getEquations());
+    std::set<size_t> vars0(blocks[0].getVariables().begin(), blocks[0].getVariables().end());
+    ASSERT_EQ(std::set<size_t>({1, 2}), vars0);
+
+    ASSERT_TRUE(blocks[1].isScalar());
+    ASSERT_EQ(size_t(0), blocks[1].getEquations()[0]);
+    ASSERT_EQ(size_t(4), blocks[1].getVariables()[0]);
+
+    checkBltOrder(fun, blt);
+
+    std::vector<double> xTyp{1.0, 2.0, 1.0, 0.0, 1.0};
+    std::vector<std::unique_ptr<ModelCSourceGen<double> > > gens = blt.createBlockSourceGenerators("simple", xTyp);
+    ASSERT_EQ(blocks.size(), gens.size());
+    ASSERT_EQ("simple_block0", gens[0]->getName());
+}
+
+TEST_F(IndexReductionTest, BltPendulum2D) {
+    std::vector<DaeVarInfo> daeVar;
+
+    ADFun<CGD>* fun = Pendulum2D<CGD> (daeVar);
+
+    std::vector<double> x(daeVar.size());
+    std::vector<double> normVar(daeVar.size(), 1.0);
+    std::vector<double> normEq(5, 1.0);
+
+    x[0] = -1.0; // x
+    x[1] = 0.0; // y
+    x[2] = 0.0; // vx
+    x[3] = 0.0; // vy
+    x[4] = 1.0; // Tension
+    x[5] = 1.0; // length
+    x[6] = 0.0; // time
+    x[7] = 0.0; // dxdt
+    x[8] = 0.0; // dydt
+    x[9] = -1.0; // dvxdt
+    x[10] = 9.80665; // dvydt
+
+    std::vector<std::string> eqName; // empty
+
+    Pantelides<double> pantelides(*fun, daeVar, eqName, x);
+    DummyDerivatives<double> dummyD(pantelides, x, normVar, normEq);
+    dummyD.setReduceEquations(false);
+
+    std::vector<DaeVarInfo> newDaeVar;
+    std::vector<DaeEquationInfo> newEqInfo;
+    std::unique_ptr<ADFun<CGD>> reducedFun;
+    ASSERT_NO_THROW(reducedFun = dummyD.reduceIndex(newDaeVar, newEqInfo));
+    ASSERT_TRUE(reducedFun != nullptr);
+
+    DaeBltDecomposition<double> blt(*reducedFun, newDaeVar, newEqInfo);
+    ASSERT_NO_THROW(blt.decompose());
+
+    ASSERT_FALSE(blt.getBlocks().empty());
+    checkBltOrder(*reducedFun, blt);
+
+    delete fun;
+}
@@ -0,0 +1,38 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGEvaluatorTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+/**
+ * A very long chain of operations which would exceed the stack limit
+ * with a recursive evaluation
+ */
+TEST_F(CppADCGEvaluatorTest, DeepGraph) {
+    ModelType model = [](const std::vector<CGD>& x) {
+        std::vector<CGD> y(2);
+
+        CGD v = x[0];
+        for (size_t i = 0; i < 200000; i++) {
+            v = v * 0.999 + x[1];
+        }
+        y[0] = v;
+        y[1] = sin(v) * x[0];
+        return y;
+    };
+
+    this->test(model, std::vector<double>{0.5, 0.001});
+}
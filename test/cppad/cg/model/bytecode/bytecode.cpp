@@ -0,0 +1,335 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGBytecodeTest : public CppADCGTest {
+protected:
+    const static size_t n;
+    const static size_t m;
+    std::vector<double> x;
+    std::vector<double> w;
+    std::unique_ptr<ADFun<CGD>> _fun;
+    std::unique_ptr<GenericModel<double>> _model;
+public:
+
+    inline CppADCGBytecodeTest(bool verbose = false, bool printValues = false) :
+        CppADCGTest(verbose, printValues),
+        x(n),
+        w(m) {
+    }
+
+    virtual void SetUp() {
+        using ADCG = AD<CGD>;
+
+        x[0] = 0.5;
+        x[1] = 1.5;
+        x[2] = 2.0;
+        for (size_t i = 0; i < m; i++)
+            w[i] = 1.0 + i;
+
+        // independent variables
+        std::vector<ADCG> u(n);
+        for (size_t j = 0; j < n; j++)
+            u[j] = x[j];
+
+        CppAD::Independent(u);
+
+        std::vector<ADCG> Z(m);
+        Z[0] = cos(u[0]) * u[1] + 2.0;
+        Z[1] = u[1] * u[2] + sin(u[0]) / u[2];
+        Z[2] = CondExpLt(u[0], u[1], exp(u[2]) * u[0], log(u[1]) - u[2]);
+        Z[3] = pow(u[1], 2.5) + sqrt(u[2]) * tanh(u[0]);
+        Z[4] = u[1]; // independent used as a dependent
+        Z[5] = 3.0;  // constant dependent
+        Z[6] = -u[0] * u[0] * u[2] + abs(u[1] - u[2]);
+
+        _fun.reset(new ADFun<CGD>(u, Z));
+
+        std::unique_ptr<BytecodeModel<double>> model(new BytecodeModel<double>(*_fun, "model"));
+        model->setCreateForwardZero(true);
+        model->setCreateJacobian(true);
+        model->setCreateHessian(true);
+        model->setCreateSparseJacobian(true);
+        model->setCreateSparseHessian(true);
+        model->setCreateForwardOne(true);
+        model->setCreateReverseOne(true);
+        model->setCreateReverseTwo(true);
+        model->compile();
+
+        _model = std::move(model);
+
+        ASSERT_EQ(_model->Domain(), _fun->Domain());
+        ASSERT_EQ(_model->Range(), _fun->Range());
+    }
+
+    virtual void TearDown() {
+        _model.reset(nullptr);
+        _fun.reset(nullptr);
+    }
+
+protected:
+
+    inline std::vector<CGD> origX() const {
+        return std::vector<CGD>(x.begin(), x.end());
+    }
+
+    inline std::vector<CGD> origW() const {
+        return std::vector<CGD>(w.begin(), w.end());
+    }
+};
+
+const size_t CppADCGBytecodeTest::n = 3;
+const size_t CppADCGBytecodeTest::m = 7;
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGBytecodeTest, ForwardZero) {
+    std::vector<CGD> yOrig = _fun->Forward(0, origX());
+    std::vector<double> y = _model->ForwardZero(x);
+
+    ASSERT_TRUE(compareValues(y, yOrig));
+
+    // other branch of the conditional expression
+    std::vector<double> x2{2.0, 1.5, 2.0};
+    std::vector<CGD> yOrig2 = _fun->Forward(0, std::vector<CGD>(x2.begin(), x2.end()));
+    std::vector<double> y2 = _model->ForwardZero(x2);
+
+    ASSERT_TRUE(compareValues(y2, yOrig2));
+}
+
+TEST_F(CppADCGBytecodeTest, Jacobian) {
+    std::vector<CGD> jacOrig = _fun->Jacobian(origX());
+    std::vector<double> jac = _model->Jacobian(x);
+
+    ASSERT_TRUE(compareValues(jac, jacOrig));
+}
+
+TEST_F(CppADCGBytecodeTest, Hessian) {
+    std::vector<CGD> hessOrig = _fun->Hessian(origX(), origW());
+    std::vector<double> hess = _model->Hessian(x, w);
+
+    ASSERT_TRUE(compareValues(hess, hessOrig));
+}
+
+TEST_F(CppADCGBytecodeTest, SparseJacobian) {
+    const std::vector<bool> p = jacobianSparsity<std::vector<bool>, CGD>(*_fun);
+
+    std::vector<CGD> jacOrig = _fun->SparseJacobian(origX(), p);
+    std::vector<double> jac = _model->SparseJacobian(x);
+
+    ASSERT_TRUE(compareValues(jac, jacOrig));
+
+    std::vector<double> jacSparse;
+    std::vector<size_t> rows, cols;
+    _model->SparseJacobian(x, jacSparse, rows, cols);
+
+    std::vector<size_t> rowsOrig, colsOrig;
+    _model->JacobianSparsity(rowsOrig, colsOrig);
+    ASSERT_EQ(rows, rowsOrig);
+    ASSERT_EQ(cols, colsOrig);
+
+    for (size_t e = 0; e < rows.size(); e++) {
+        ASSERT_TRUE(nearEqual(jacSparse[e], jacOrig[rows[e] * n + cols[e]].getValue()));
+    }
+}
+
+TEST_F(CppADCGBytecodeTest, SparseHessian) {
+    std::vector<CGD> hessOrig = _fun->SparseHessian(origX(), origW());
+    std::vector<double> hess = _model->SparseHessian(x, w);
+
+    ASSERT_TRUE(compareValues(hess, hessOrig));
+}
+
+TEST_F(CppADCGBytecodeTest, ForwardOne) {
+    std::vector<double> tx1{0.5, -1.0, 2.0};
+
+    std::vector<double> tx(2 * n);
+    for (size_t j = 0; j < n; j++) {
+        tx[j * 2] = x[j];
+        tx[j * 2 + 1] = tx1[j];
+    }
+
+    _fun->Forward(0, origX());
+    std::vector<CGD> ty1Orig = _fun->Forward(1, std::vector<CGD>(tx1.begin(), tx1.end()));
+
+    std::vector<double> ty1 = _model->ForwardOne(tx);
+    ASSERT_TRUE(compareValues(ty1, ty1Orig));
+
+    // sparse
+    std::vector<size_t> idx{0, 2};
+    std::vector<double> tx1Nnz{tx1[0], tx1[2]};
+    std::vector<CGD> tx1Sparse{tx1[0], 0.0, tx1[2]};
+
+    _fun->Forward(0, origX());
+    ty1Orig = _fun->Forward(1, tx1Sparse);
+
+    std::vector<double> ty1Sparse(m);
+    _model->ForwardOne(x, idx.size(), idx.data(), tx1Nnz.data(), ty1Sparse);
+    ASSERT_TRUE(compareValues(ty1Sparse, ty1Orig));
+}
+
+TEST_F(CppADCGBytecodeTest, ReverseOne) {
+    std::vector<CGD> yOrig = _fun->Forward(0, origX());
+    std::vector<CGD> pxOrig = _fun->Reverse(1, origW());
+
+    std::vector<double> y(m);
+    for (size_t i = 0; i < m; i++)
+        y[i] = yOrig[i].getValue();
+
+    std::vector<double> px = _model->ReverseOne(x, y, w);
+    ASSERT_TRUE(compareValues(px, pxOrig));
+
+    // sparse
+    std::vector<size_t> idx{1, 3};
+    std::vector<double> pyNnz{w[1], w[3]};
+    std::vector<CGD> pySparse(m, 0.0);
+    pySparse[1] = w[1];
+    pySparse[3] = w[3];
+
+    _fun->Forward(0, origX());
+    pxOrig = _fun->Reverse(1, pySparse);
+
+    std::vector<double> pxSparse(n);
+    _model->ReverseOne(x, pxSparse, idx.size(), idx.data(), pyNnz.data());
+    ASSERT_TRUE(compareValues(pxSparse, pxOrig));
+}
+
+TEST_F(CppADCGBytecodeTest, ReverseTwo) {
+    std::vector<double> tx1{0.5, -1.0, 2.0};
+
+    std::vector<CGD> tx1Orig(tx1.begin(), tx1.end());
+    std::vector<CGD> pyOrig(2 * m);
+    for (size_t i = 0; i < m; i++) {
+        pyOrig[i * 2] = 0.0;
+        pyOrig[i * 2 + 1] = w[i];
+    }
+
+    _fun->Forward(0, origX());
+    _fun->Forward(1, tx1Orig);
+    std::vector<CGD> pxAll = _fun->Reverse(2, pyOrig);
+
+    std::vector<CGD> px2Orig(n);
+    for (size_t j = 0; j < n; j++)
+        px2Orig[j] = pxAll[j * 2];
+
+    std::vector<double> tx(2 * n), ty(2 * m), py(2 * m);
+    for (size_t j = 0; j < n; j++) {
+        tx[j * 2] = x[j];
+        tx[j * 2 + 1] = tx1[j];
+    }
+    for (size_t i = 0; i < m; i++) {
+        py[i * 2 + 1] = w[i];
+    }
+
+    std::vector<double> px = _model->ReverseTwo(tx, ty, py);
+    std::vector<double> px2(n);
+    for (size_t j = 0; j < n; j++)
+        px2[j] = px[j * 2];
+
+    ASSERT_TRUE(compareValues(px2, px2Orig));
+
+    // sparse
+    std::vector<size_t> idx{0, 1, 2};
+    std::vector<double> px2Sparse(n);
+    _model->ReverseTwo(x, idx.size(), idx.data(), tx1.data(), px2Sparse, w);
+
+    ASSERT_TRUE(compareValues(px2Sparse, px2Orig));
+}
+
+TEST_F(CppADCGBytecodeTest, RegisterReuse) {
+    using ADCG = AD<CGD>;
+
+    const size_t nn = 20;
+    std::vector<ADCG> u(nn);
+    for (size_t j = 0; j < nn; j++)
+        u[j] = 1.0 + j;
+
+    CppAD::Independent(u);
+
+    std::vector<ADCG> y(1);
+    y[0] = 0.0;
+    for (size_t j = 0; j < nn; j++)
+        y[0] += sin(u[j]) * cos(u[j]);
+
+    ADFun<CGD> fun(u, y);
+
+    CodeHandler<double> handler;
+    std::vector<CGD> indVars(nn);
+    handler.makeVariables(indVars);
+    std::vector<CGD> dep = fun.Forward(0, indVars);
+
+    LanguageBytecode<double> lang;
+    LangCDefaultVariableNameGenerator<double> nameGen;
+    std::ostringstream code;
+    handler.generateCode(code, lang, dep, nameGen, "reuse");
+
+    std::unique_ptr<BytecodeProgram<double>> program = lang.releaseProgram();
+    ASSERT_TRUE(program != nullptr);
+
+    // temporary variables are reused
+    ASSERT_LT(program->getRegisterCount() - program->getConstantCount(), program->getInstructions().size());
+
+    std::vector<double> xx(nn), yy(1);
+    double yExpected = 0;
+    for (size_t j = 0; j < nn; j++) {
+        xx[j] = 0.1 * j;
+        yExpected += std::sin(xx[j]) * std::cos(xx[j]);
+    }
+    program->evaluate(xx, yy);
+
+    ASSERT_TRUE(nearEqual(yy[0], yExpected));
+}
+
+TEST_F(CppADCGBytecodeTest, SignedZeroConstants) {
+    using ADCG = AD<CGD>;
+
+    std::vector<ADCG> u(1);
+    u[0] = 1.0;
+
+    CppAD::Independent(u);
+
+    std::vector<ADCG> y(2);
+    y[0] = u[0] / 0.0;
+    y[1] = u[0] / -0.0;
+
+    ADFun<CGD> fun(u, y);
+
+    CodeHandler<double> handler;
+    std::vector<CGD> indVars(1);
+    handler.makeVariables(indVars);
+    std::vector<CGD> dep = fun.Forward(0, indVars);
+
+    LanguageBytecode<double> lang;
+    LangCDefaultVariableNameGenerator<double> nameGen;
+    std::ostringstream code;
+    handler.generateCode(code, lang, dep, nameGen, "signedZero");
+
+    std::unique_ptr<BytecodeProgram<double>> program = lang.releaseProgram();
+    ASSERT_TRUE(program != nullptr);
+
+    std::vector<double> xx{1.0}, yy(2);
+    program->evaluate(xx, yy);
+
+    // -0.0 must not share the register of 0.0
+    ASSERT_TRUE(std::isinf(yy[0]) && yy[0] > 0);
+    ASSERT_TRUE(std::isinf(yy[1]) && yy[1] < 0);
+}
@@ -0,0 +1,85 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGDynamicAdaptiveOptTest : public CppADCGTest {
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+/**
+ * Compiles the sources of a model with different flags
+ */
+TEST_F(CppADCGDynamicAdaptiveOptTest, FlagsPerSource) {
+    const std::string modelName = "model_adaptive";
+    std::vector<double> x{1.0, 2.0, 0.5};
+
+    std::vector<ADCGD> u(x.size());
+    for (size_t j = 0; j < x.size(); j++)
+        u[j] = x[j];
+
+    CppAD::Independent(u);
+
+    std::vector<ADCGD> Z(2);
+    Z[0] = u[0] * exp(u[2]) + u[1] * u[1];
+    Z[1] = sin(u[0]) * u[1] / u[2];
+
+    ADFun<CGD> fun(u, Z);
+
+    ModelCSourceGen<double> compHelp(fun, modelName);
+    compHelp.setCreateForwardZero(true);
+    compHelp.setCreateSparseJacobian(true);
+    compHelp.setHotFunctions({ModelCSourceGen<double>::FUNCTION_FORWAD_ZERO});
+
+    ModelLibraryCSourceGen<double> compDynHelp(compHelp);
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+    compiler.setAdaptiveOptimization(true);
+    compiler.setHotSourceFlags({"-O3"});
+    compiler.setLargeSourceFlags({"-O1"});
+    compiler.setLargeSourceAssignments(1000000);
+
+    DynamicModelLibraryProcessor<double> p(compDynHelp, "cppad_cg_adaptive");
+    std::unique_ptr<DynamicLib<double>> dynamicLib = p.createDynamicLibrary(compiler);
+    std::unique_ptr<GenericModel<double>> model = dynamicLib->model(modelName);
+
+    std::map<std::string, SourceStatistics> stats = compHelp.getSourceStatistics();
+    ASSERT_TRUE(stats.at(modelName + "_" + ModelCSourceGen<double>::FUNCTION_FORWAD_ZERO + ".c").hot);
+    ASSERT_FALSE(stats.at(modelName + "_" + ModelCSourceGen<double>::FUNCTION_SPARSE_JACOBIAN + ".c").hot);
+
+    bool hotCompiled = false;
+    for (const auto& info : compiler.getCompilationReport()) {
+        if (info.statistics.hot) {
+            ASSERT_EQ(std::vector<std::string>{"-O3"}, info.flags);
+            hotCompiled = true;
+        } else {
+            ASSERT_TRUE(info.flags.empty());
+        }
+    }
+    ASSERT_TRUE(hotCompiled);
+
+    std::vector<CGD> yOrig = fun.Forward(0, std::vector<CGD>(x.begin(), x.end()));
+    std::vector<double> yCG = model->ForwardZero(x);
+    ASSERT_TRUE(compareValues(yCG, yOrig));
+}
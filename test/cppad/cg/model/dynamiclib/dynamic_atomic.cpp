@@ -181,6 +181,8 @@ TEST_F(CppADCGDynamicAtomicModel1Test, DynamicForRevNonlinearLinear) {
     this->testADFunAtomicLib(x); // 1 compiled inner model used by CppAD
 
     this->testAtomicLibAtomicLib(x); // 2 models in 2 dynamic libraries
+
+    this->testAtomicLibAtomicLibDirectArrays(x); // arrays passed directly to the inner model
 }
 
 /**
@@ -204,6 +206,8 @@ TEST_F(CppADCGDynamicAtomicModel2Test, DynamicForRevNonlinearLinear) {
     this->testADFunAtomicLib(x); // 1 compiled inner model used by CppAD
 
     this->testAtomicLibAtomicLib(x); // 2 models in 2 dynamic libraries
+
+    this->testAtomicLibAtomicLibDirectArrays(x); // arrays passed directly to the inner model
 }
 
 #if 0 // TODO: make this work
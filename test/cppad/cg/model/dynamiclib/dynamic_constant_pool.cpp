@@ -0,0 +1,101 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGDynamicConstantPoolTest : public CppADCGTest {
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+/**
+ * Long constants shared by two models are only saved once
+ */
+TEST_F(CppADCGDynamicConstantPoolTest, SharedConstants) {
+    const std::string libName = "cppad_cg_constant_pool";
+    const double c = 1.0 / 3.0;
+    std::vector<double> x{1.0, 2.0, 0.5};
+
+    std::vector<ADCGD> u(x.size());
+    for (size_t j = 0; j < x.size(); j++)
+        u[j] = x[j];
+
+    CppAD::Independent(u);
+
+    std::vector<ADCGD> Z(3);
+    Z[0] = u[0] * c + u[1] * 9.80665;
+    Z[1] = sin(u[0] * c) + u[2] * 2.0;
+    Z[2] = u[2] * c - 9.80665 * u[1];
+
+    ADFun<CGD> fun1(u, Z);
+
+    CppAD::Independent(u);
+
+    std::vector<ADCGD> Z2(1);
+    Z2[0] = u[0] * u[1] * c + u[2];
+
+    ADFun<CGD> fun2(u, Z2);
+
+    ModelCSourceGen<double> compHelp1(fun1, "model_pool1");
+    compHelp1.setCreateForwardZero(true);
+    compHelp1.setCreateSparseJacobian(true);
+
+    ModelCSourceGen<double> compHelp2(fun2, "model_pool2");
+    compHelp2.setCreateForwardZero(true);
+
+    ModelLibraryCSourceGen<double> compDynHelp(compHelp1, compHelp2);
+    compDynHelp.setUseConstantPool(true);
+
+    const std::map<std::string, std::string>& libSources = compDynHelp.getLibrarySources();
+    auto itPool = libSources.find(compDynHelp.getConstantPool().getName() + ".c");
+    ASSERT_TRUE(itPool != libSources.end());
+
+    const std::string& table = itPool->second;
+    size_t pos = table.find("0.333333333333333");
+    ASSERT_NE(std::string::npos, pos);
+    ASSERT_EQ(std::string::npos, table.find("0.333333333333333", pos + 1)); // only once for both models
+    ASSERT_EQ(std::string::npos, table.find(" 2,")); // short values are not saved
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+
+    DynamicModelLibraryProcessor<double> p(compDynHelp, libName);
+
+    std::unique_ptr<DynamicLib<double>> dynamicLib = p.createDynamicLibrary(compiler);
+    std::unique_ptr<GenericModel<double>> model1 = dynamicLib->model("model_pool1");
+    std::unique_ptr<GenericModel<double>> model2 = dynamicLib->model("model_pool2");
+
+    std::vector<CGD> xCG(x.begin(), x.end());
+
+    std::vector<CGD> yOrig = fun1.Forward(0, xCG);
+    std::vector<double> yCG = model1->ForwardZero(x);
+    ASSERT_TRUE(compareValues(yCG, yOrig));
+
+    const std::vector<bool> sparsity = jacobianSparsity<std::vector<bool>, CGD>(fun1);
+    std::vector<CGD> jacOrig = fun1.SparseJacobian(xCG, sparsity);
+    std::vector<double> jacCG = model1->SparseJacobian(x);
+    ASSERT_TRUE(compareValues(jacCG, jacOrig));
+
+    yOrig = fun2.Forward(0, xCG);
+    yCG = model2->ForwardZero(x);
+    ASSERT_TRUE(compareValues(yCG, yOrig));
+}
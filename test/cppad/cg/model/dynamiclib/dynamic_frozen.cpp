@@ -0,0 +1,170 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Model where the second independent variable is frozen at generation time
+ */
+class CppADCGDynamicFrozenTest : public CppADCGTest {
+protected:
+    const std::string _modelName;
+    const static size_t n;
+    const static size_t m;
+    const static size_t frozen;
+    std::vector<double> x;
+    ADFun<CGD>* _fun;
+    std::unique_ptr<DynamicLib<double>> _dynamicLib;
+    std::unique_ptr<GenericModel<double>> _model;
+public:
+
+    inline CppADCGDynamicFrozenTest(bool verbose = false, bool printValues = false) :
+        CppADCGTest(verbose, printValues),
+        _modelName("model_frozen"),
+        x(n),
+        _fun(nullptr) {
+    }
+
+    virtual void SetUp() {
+        using ADCG = AD<CGD>;
+
+        for (size_t j = 0; j < n; j++)
+            x[j] = j + 2;
+
+        // independent variables
+        std::vector<ADCG> u(n);
+        for (size_t j = 0; j < n; j++)
+            u[j] = x[j];
+
+        CppAD::Independent(u);
+
+        std::vector<ADCG> Z(m);
+        Z[0] = cos(u[0]);
+        Z[1] = u[1] * u[2] + sin(u[0]);
+        Z[2] = u[2] * u[2] + sin(u[1]) * exp(u[1]);
+        Z[3] = u[0] / u[2] + u[1] * u[2] + 5.0;
+
+        _fun = new ADFun<CGD>(u, Z);
+
+        /**
+         * Create the dynamic library
+         * (generate and compile source code)
+         */
+        ModelCSourceGen<double> compHelp(*_fun, _modelName);
+
+        compHelp.setCreateForwardZero(true);
+        compHelp.setCreateForwardOne(true);
+        compHelp.setCreateReverseOne(true);
+        compHelp.setCreateReverseTwo(true);
+        compHelp.setCreateSparseJacobian(true);
+        compHelp.setCreateSparseHessian(true);
+        compHelp.setFrozenIndependent(frozen, x[frozen]);
+
+        GccCompiler<double> compiler;
+        prepareTestCompilerFlags(compiler);
+
+        ModelLibraryCSourceGen<double> compDynHelp(compHelp);
+
+        DynamicModelLibraryProcessor<double> p(compDynHelp);
+
+        _dynamicLib = p.createDynamicLibrary(compiler);
+        _model = _dynamicLib->model(_modelName);
+
+        ASSERT_EQ(_model->Domain(), _fun->Domain());
+        ASSERT_EQ(_model->Range(), _fun->Range());
+    }
+
+    virtual void TearDown() {
+        _dynamicLib.reset(nullptr);
+        _model.reset(nullptr);
+        delete _fun;
+        _fun = nullptr;
+    }
+
+protected:
+
+    /**
+     * independent vector with a different value for the frozen variable
+     * (which must be ignored)
+     */
+    inline std::vector<double> runtimeX() const {
+        std::vector<double> xr = x;
+        xr[frozen] = -100;
+        return xr;
+    }
+
+    inline std::vector<CGD> origX() const {
+        return std::vector<CGD>(x.begin(), x.end());
+    }
+};
+
+const size_t CppADCGDynamicFrozenTest::n = 3;
+const size_t CppADCGDynamicFrozenTest::m = 4;
+const size_t CppADCGDynamicFrozenTest::frozen = 1;
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGDynamicFrozenTest, ForwardZero) {
+    std::vector<CGD> yOrig = _fun->Forward(0, origX());
+    std::vector<double> yCG = _model->ForwardZero(runtimeX());
+
+    ASSERT_TRUE(compareValues(yCG, yOrig));
+}
+
+TEST_F(CppADCGDynamicFrozenTest, SparseJacobian) {
+    const std::vector<bool> p = jacobianSparsity<std::vector<bool>, CGD>(*_fun);
+
+    std::vector<CGD> jacOrig = _fun->SparseJacobian(origX(), p);
+    std::vector<double> jacCG = _model->SparseJacobian(runtimeX());
+
+    ASSERT_TRUE(compareValues(jacCG, jacOrig));
+}
+
+TEST_F(CppADCGDynamicFrozenTest, SparseHessian) {
+    std::vector<double> w(m, 1.0);
+    std::vector<CGD> wOrig(w.begin(), w.end());
+
+    std::vector<CGD> hessOrig = _fun->SparseHessian(origX(), wOrig);
+    std::vector<double> hessCG = _model->SparseHessian(runtimeX(), w);
+
+    ASSERT_TRUE(compareValues(hessCG, hessOrig));
+}
+
+TEST_F(CppADCGDynamicFrozenTest, ForwardOne) {
+    std::vector<double> xr = runtimeX();
+    std::vector<double> tx(2 * n);
+    std::vector<CGD> dx(n);
+
+    for (size_t j = 0; j < n; j++) {
+        for (size_t j2 = 0; j2 < n; j2++) {
+            tx[j2 * 2] = xr[j2];
+            tx[j2 * 2 + 1] = j2 == j ? 1 : 0;
+            dx[j2] = j2 == j ? 1 : 0;
+        }
+
+        _fun->Forward(0, origX());
+        std::vector<CGD> dyOrig = _fun->Forward(1, dx);
+        std::vector<double> dyCG = _model->ForwardOne(tx);
+
+        ASSERT_TRUE(compareValues(dyCG, dyOrig));
+    }
+}
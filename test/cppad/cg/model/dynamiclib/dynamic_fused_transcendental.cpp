@@ -0,0 +1,167 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Model with several transcendental functions of the same arguments which
+ * are evaluated together in the generated source code
+ */
+class CppADCGDynamicFusedTest : public CppADCGTest {
+protected:
+    const std::string _modelName;
+    const static size_t n;
+    const static size_t m;
+    std::vector<double> x;
+    ADFun<CGD>* _fun;
+    std::unique_ptr<DynamicLib<double>> _dynamicLib;
+    std::unique_ptr<GenericModel<double>> _model;
+public:
+
+    inline CppADCGDynamicFusedTest(bool verbose = false, bool printValues = false) :
+        CppADCGTest(verbose, printValues),
+        _modelName("model_fused"),
+        x(n),
+        _fun(nullptr) {
+    }
+
+    virtual void SetUp() {
+        using ADCG = AD<CGD>;
+
+        for (size_t j = 0; j < n; j++)
+            x[j] = 0.5 * j + 0.25;
+
+        // independent variables
+        std::vector<ADCG> u(n);
+        for (size_t j = 0; j < n; j++)
+            u[j] = x[j];
+
+        CppAD::Independent(u);
+
+        ADCG a = u[0] * u[1];
+
+        std::vector<ADCG> Z(m);
+        Z[0] = sin(a) * u[2] + cos(a);
+        Z[1] = sinh(u[1]) + u[0] * cosh(u[1]);
+        Z[2] = exp(u[2] / u[0]) * u[1];
+
+        _fun = new ADFun<CGD>(u, Z);
+
+        /**
+         * Create the dynamic library
+         * (generate and compile source code)
+         */
+        ModelCSourceGen<double> compHelp(*_fun, _modelName);
+
+        compHelp.setCreateForwardZero(true);
+        compHelp.setCreateSparseJacobian(true);
+        compHelp.setCreateSparseHessian(true);
+        compHelp.setFuseTranscendentalFunctions(true);
+
+        GccCompiler<double> compiler;
+        prepareTestCompilerFlags(compiler);
+
+        ModelLibraryCSourceGen<double> compDynHelp(compHelp);
+
+        bool sincos = false;
+        for (const auto& it : getModelSources(compDynHelp, compHelp)) {
+            const std::string& source = it.second;
+            for (size_t pos = source.find("sincos("); pos != std::string::npos; pos = source.find("sincos(", pos + 1)) {
+                if (source.compare(pos, 8, "sincos()") == 0)
+                    continue; // comment
+                sincos = true;
+                // the fused values must be determined in their own statements
+                size_t lineStart = source.rfind('\n', pos) + 1;
+                ASSERT_EQ(source.find_first_not_of(' ', lineStart), pos);
+            }
+        }
+        ASSERT_TRUE(sincos);
+
+        DynamicModelLibraryProcessor<double> p(compDynHelp);
+
+        _dynamicLib = p.createDynamicLibrary(compiler);
+        _model = _dynamicLib->model(_modelName);
+
+        ASSERT_EQ(_model->Domain(), _fun->Domain());
+        ASSERT_EQ(_model->Range(), _fun->Range());
+    }
+
+    virtual void TearDown() {
+        _dynamicLib.reset(nullptr);
+        _model.reset(nullptr);
+        delete _fun;
+        _fun = nullptr;
+    }
+};
+
+const size_t CppADCGDynamicFusedTest::n = 3;
+const size_t CppADCGDynamicFusedTest::m = 3;
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGDynamicFusedTest, ForwardZero) {
+    std::vector<CGD> yOrig = _fun->Forward(0, std::vector<CGD>(x.begin(), x.end()));
+    std::vector<double> yCG = _model->ForwardZero(x);
+
+    ASSERT_TRUE(compareValues(yCG, yOrig));
+}
+
+TEST_F(CppADCGDynamicFusedTest, SparseJacobian) {
+    const std::vector<bool> p = jacobianSparsity<std::vector<bool>, CGD>(*_fun);
+
+    std::vector<CGD> jacOrig = _fun->SparseJacobian(std::vector<CGD>(x.begin(), x.end()), p);
+    std::vector<double> jacCG = _model->SparseJacobian(x);
+
+    ASSERT_TRUE(compareValues(jacCG, jacOrig));
+}
+
+TEST_F(CppADCGDynamicFusedTest, SparseHessian) {
+    std::vector<double> w(m, 1.0);
+    w[1] = 2.0;
+    std::vector<CGD> wOrig(w.begin(), w.end());
+
+    std::vector<CGD> hessOrig = _fun->SparseHessian(std::vector<CGD>(x.begin(), x.end()), wOrig);
+    std::vector<double> hessCG = _model->SparseHessian(x, w);
+
+    ASSERT_TRUE(compareValues(hessCG, hessOrig));
+}
+
+TEST_F(CppADCGDynamicFusedTest, ForwardZeroNegative) {
+    // exp(x) underflows relative to 1 for these arguments
+    std::vector<double> xNeg{0.5, -40.0, -30.0};
+
+    std::vector<CGD> yOrig = _fun->Forward(0, std::vector<CGD>(xNeg.begin(), xNeg.end()));
+    std::vector<double> yCG = _model->ForwardZero(xNeg);
+
+    ASSERT_TRUE(compareValues(yCG, yOrig));
+}
+
+TEST_F(CppADCGDynamicFusedTest, SparseHessianNegative) {
+    std::vector<double> xNeg{0.5, -40.0, -30.0};
+    std::vector<double> w(m, 1.0);
+    std::vector<CGD> wOrig(w.begin(), w.end());
+
+    std::vector<CGD> hessOrig = _fun->SparseHessian(std::vector<CGD>(xNeg.begin(), xNeg.end()), wOrig);
+    std::vector<double> hessCG = _model->SparseHessian(xNeg, w);
+
+    ASSERT_TRUE(compareValues(hessCG, hessOrig));
+}
@@ -0,0 +1,229 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * CppAD is also used by the background thread of the hot-swap models
+ */
+class CppADCGDynamicHotSwapTest : public CppADCGTest {
+protected:
+    static std::thread::id mainThread_;
+    static std::atomic<bool> parallel_;
+public:
+
+    static bool inParallel() {
+        return parallel_;
+    }
+
+    static size_t threadNumber() {
+        return std::this_thread::get_id() == mainThread_ ? 0 : 1;
+    }
+
+    virtual void SetUp() {
+        mainThread_ = std::this_thread::get_id();
+        thread_alloc::parallel_setup(2, inParallel, threadNumber);
+        parallel_ad<CGD>();
+    }
+
+    virtual void TearDown() {
+        parallel_ = false;
+        thread_alloc::free_available(1);
+        thread_alloc::parallel_setup(1, nullptr, nullptr);
+
+        CppADCGTest::TearDown();
+    }
+};
+
+std::thread::id CppADCGDynamicHotSwapTest::mainThread_;
+std::atomic<bool> CppADCGDynamicHotSwapTest::parallel_(false);
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+/**
+ * Starts with an interpreted model and switches to the compiled model
+ */
+TEST_F(CppADCGDynamicHotSwapTest, BytecodeToDynamicLib) {
+    const std::string modelName = "model_hot_swap";
+    const std::string libName = "cppad_cg_hot_swap";
+    std::vector<double> x{1.0, 2.0, 0.5};
+
+    std::vector<ADCGD> u(x.size());
+    for (size_t j = 0; j < x.size(); j++)
+        u[j] = x[j];
+
+    CppAD::Independent(u);
+
+    std::vector<ADCGD> Z(3);
+    Z[0] = u[0] * exp(u[2]) + u[1] * u[1];
+    Z[1] = cos(u[0]) * u[1] / u[2];
+    Z[2] = CondExpGt(u[0], u[2], u[1], log(u[2]));
+
+    ADFun<CGD> fun(u, Z);
+
+    std::vector<CGD> yOrig = fun.Forward(0, std::vector<CGD>(x.begin(), x.end()));
+    const std::vector<bool> sparsity = jacobianSparsity<std::vector<bool>, CGD>(fun);
+    std::vector<CGD> jacOrig = fun.SparseJacobian(std::vector<CGD>(x.begin(), x.end()), sparsity);
+
+    /**
+     * the initial (interpreted) model
+     */
+    std::unique_ptr<BytecodeModel<double>> bytecode(new BytecodeModel<double>(fun, modelName));
+    bytecode->setCreateForwardZero(true);
+    bytecode->setCreateSparseJacobian(true);
+    bytecode->compile();
+
+    /**
+     * the compiled model
+     */
+    ModelCSourceGen<double> compHelp(fun, modelName);
+    compHelp.setCreateForwardZero(true);
+    compHelp.setCreateSparseJacobian(true);
+
+    ModelLibraryCSourceGen<double> compDynHelp(compHelp);
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+
+    DynamicModelLibraryProcessor<double> p(compDynHelp, libName);
+
+    parallel_ = true; // until the background thread finishes
+    HotSwapModel<double> model(std::move(bytecode), p, compiler);
+    GenericModel<double>& gmodel = model;
+
+    // the results are available immediately
+    std::vector<double> yCG = gmodel.ForwardZero(x);
+    ASSERT_TRUE(compareValues(yCG, yOrig));
+
+    std::vector<double> jacCG = gmodel.SparseJacobian(x);
+    ASSERT_TRUE(compareValues(jacCG, jacOrig));
+
+    std::vector<size_t> rowsInit, colsInit;
+    gmodel.JacobianSparsity(rowsInit, colsInit);
+
+    model.waitForCompiledModel();
+    parallel_ = false;
+
+    ASSERT_TRUE(model.isCompilationFinished());
+    ASSERT_TRUE(model.isUsingCompiledModel());
+    ASSERT_TRUE(model.getCompiledModel() != nullptr);
+
+    // the same results from the compiled model
+    yCG = gmodel.ForwardZero(x);
+    ASSERT_TRUE(compareValues(yCG, yOrig));
+
+    jacCG = gmodel.SparseJacobian(x);
+    ASSERT_TRUE(compareValues(jacCG, jacOrig));
+
+    std::vector<size_t> rows, cols;
+    gmodel.JacobianSparsity(rows, cols);
+    ASSERT_EQ(rows, rowsInit);
+    ASSERT_EQ(cols, colsInit);
+}
+
+/**
+ * The initial model continues to be used when the compilation fails
+ */
+TEST_F(CppADCGDynamicHotSwapTest, CompilationFailure) {
+    std::vector<double> x{1.0, 2.0};
+
+    std::vector<ADCGD> u(x.size());
+    for (size_t j = 0; j < x.size(); j++)
+        u[j] = x[j];
+
+    CppAD::Independent(u);
+
+    std::vector<ADCGD> Z(1);
+    Z[0] = u[0] * u[1];
+
+    ADFun<CGD> fun(u, Z);
+
+    std::unique_ptr<BytecodeModel<double>> bytecode(new BytecodeModel<double>(fun, "model_fail"));
+    bytecode->setCreateForwardZero(true);
+    bytecode->compile();
+
+    parallel_ = true; // until the background thread finishes
+    HotSwapModel<double> model(std::move(bytecode), []() -> std::unique_ptr<ModelLibrary<double>> {
+        throw CGException("compilation failed");
+    });
+
+    ASSERT_THROW(model.waitForCompiledModel(), CGException);
+    parallel_ = false;
+    ASSERT_FALSE(model.isUsingCompiledModel());
+
+    GenericModel<double>& gmodel = model;
+    std::vector<double> y = gmodel.ForwardZero(x);
+    ASSERT_TRUE(nearEqual(y[0], x[0] * x[1]));
+}
+
+/**
+ * The compiled model is rejected when it does not provide a function
+ * provided by the initial model
+ */
+TEST_F(CppADCGDynamicHotSwapTest, MissingFunction) {
+    const std::string modelName = "model_hot_swap_missing";
+    std::vector<double> x{1.0, 2.0};
+
+    std::vector<ADCGD> u(x.size());
+    for (size_t j = 0; j < x.size(); j++)
+        u[j] = x[j];
+
+    CppAD::Independent(u);
+
+    std::vector<ADCGD> Z(1);
+    Z[0] = u[0] * u[1];
+
+    ADFun<CGD> fun(u, Z);
+
+    std::unique_ptr<BytecodeModel<double>> bytecode(new BytecodeModel<double>(fun, modelName));
+    bytecode->setCreateForwardZero(true);
+    bytecode->setCreateSparseJacobian(true);
+    bytecode->compile();
+
+    // no sparse Jacobian in the compiled model
+    ModelCSourceGen<double> compHelp(fun, modelName);
+    compHelp.setCreateForwardZero(true);
+
+    ModelLibraryCSourceGen<double> compDynHelp(compHelp);
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+
+    DynamicModelLibraryProcessor<double> p(compDynHelp, "cppad_cg_hot_swap_missing");
+
+    parallel_ = true; // until the background thread finishes
+    HotSwapModel<double> model(std::move(bytecode), p, compiler);
+
+    ASSERT_THROW(model.waitForCompiledModel(), CGException);
+    parallel_ = false;
+    ASSERT_TRUE(model.isCompilationFinished());
+    ASSERT_FALSE(model.isUsingCompiledModel());
+
+    GenericModel<double>& gmodel = model;
+    std::vector<double> y = gmodel.ForwardZero(x);
+    ASSERT_TRUE(nearEqual(y[0], x[0] * x[1]));
+
+    std::vector<double> jac = gmodel.SparseJacobian(x);
+    ASSERT_EQ(jac.size(), 2u);
+    ASSERT_TRUE(nearEqual(jac[0], x[1]));
+    ASSERT_TRUE(nearEqual(jac[1], x[0]));
+}
@@ -0,0 +1,78 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGDynamicInMemoryTest : public CppADCGTest {
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+/**
+ * Creates a dynamic library without saving files to disk
+ */
+TEST_F(CppADCGDynamicInMemoryTest, MemoryFiles) {
+    const std::string modelName = "model_memory";
+    const std::string libName = "cppad_cg_memory";
+    std::vector<double> x{1.0, 2.0, 0.5};
+
+    std::vector<ADCGD> u(x.size());
+    for (size_t j = 0; j < x.size(); j++)
+        u[j] = x[j];
+
+    CppAD::Independent(u);
+
+    std::vector<ADCGD> Z(2);
+    Z[0] = u[0] * exp(u[2]) + u[1] * u[1];
+    Z[1] = cos(u[0]) * u[1] / u[2];
+
+    ADFun<CGD> fun(u, Z);
+
+    ModelCSourceGen<double> compHelp(fun, modelName);
+    compHelp.setCreateForwardZero(true);
+    compHelp.setCreateSparseJacobian(true);
+
+    ModelLibraryCSourceGen<double> compDynHelp(compHelp);
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+    compiler.setUseMemoryFiles(true);
+    compiler.setTemporaryFolder("cppadcg_memory_tmp");
+
+    DynamicModelLibraryProcessor<double> p(compDynHelp, libName);
+    p.setCreateInMemory(true);
+
+    std::unique_ptr<DynamicLib<double>> dynamicLib = p.createDynamicLibrary(compiler);
+    std::unique_ptr<GenericModel<double>> model = dynamicLib->model(modelName);
+
+    ASSERT_FALSE(system::isFile(libName + system::SystemInfo<>::DYNAMIC_LIB_EXTENSION));
+    ASSERT_FALSE(system::isDirectory("cppadcg_memory_tmp"));
+
+    std::vector<CGD> yOrig = fun.Forward(0, std::vector<CGD>(x.begin(), x.end()));
+    std::vector<double> yCG = model->ForwardZero(x);
+    ASSERT_TRUE(compareValues(yCG, yOrig));
+
+    const std::vector<bool> sparsity = jacobianSparsity<std::vector<bool>, CGD>(fun);
+    std::vector<CGD> jacOrig = fun.SparseJacobian(std::vector<CGD>(x.begin(), x.end()), sparsity);
+    std::vector<double> jacCG = model->SparseJacobian(x);
+    ASSERT_TRUE(compareValues(jacCG, jacOrig));
+}
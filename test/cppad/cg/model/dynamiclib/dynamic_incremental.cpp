@@ -0,0 +1,137 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGDynamicIncrementalTest : public CppADCGTest {
+protected:
+    const std::string incrementalFolder_ = "cppadcg_incremental";
+    const std::vector<double> x_{1.0, 2.0, 0.5};
+
+    void SetUp() override {
+        // start without the object files of previous test runs
+        for (const std::string& name : {"model_a", "model_b"}) {
+            std::string manifest = system::createPath(incrementalFolder_, name + ".fingerprint");
+            remove(manifest.c_str());
+        }
+    }
+
+    std::unique_ptr<ADFun<CGD>> tape(double coefficient) {
+        std::vector<ADCGD> u(x_.size());
+        for (size_t j = 0; j < x_.size(); j++)
+            u[j] = x_[j];
+
+        CppAD::Independent(u);
+
+        std::vector<ADCGD> Z(2);
+        Z[0] = coefficient * u[0] * exp(u[2]) + u[1] * u[1];
+        Z[1] = cos(u[0]) * u[1] / u[2];
+
+        return std::unique_ptr<ADFun<CGD>>(new ADFun<CGD>(u, Z));
+    }
+
+    /**
+     * Creates a library with two models and checks their results.
+     *
+     * @return the models whose object files were reused
+     */
+    std::set<std::string> build(ADFun<CGD>& funA,
+                                ADFun<CGD>& funB,
+                                const std::string& libName) {
+        ModelCSourceGen<double> modelA(funA, "model_a");
+        modelA.setCreateForwardZero(true);
+        modelA.setCreateSparseJacobian(true);
+
+        ModelCSourceGen<double> modelB(funB, "model_b");
+        modelB.setCreateForwardZero(true);
+        modelB.setCreateSparseJacobian(true);
+
+        ModelLibraryCSourceGen<double> libSrc(modelA, modelB);
+
+        GccCompiler<double> compiler;
+        prepareTestCompilerFlags(compiler);
+
+        DynamicModelLibraryProcessor<double> p(libSrc, libName);
+        p.setIncrementalBuildFolder(incrementalFolder_);
+
+        std::unique_ptr<DynamicLib<double>> lib = p.createDynamicLibrary(compiler);
+
+        for (auto* fun : {&funA, &funB}) {
+            std::unique_ptr<GenericModel<double>> model = lib->model(fun == &funA ? "model_a" : "model_b");
+
+            std::vector<CGD> yOrig = fun->Forward(0, std::vector<CGD>(x_.begin(), x_.end()));
+            std::vector<double> y = model->ForwardZero(x_);
+            EXPECT_TRUE(compareValues(y, yOrig));
+        }
+
+        return p.getReusedModels();
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+/**
+ * Only the models which changed are compiled again
+ */
+TEST_F(CppADCGDynamicIncrementalTest, ReuseUnchangedModels) {
+    std::unique_ptr<ADFun<CGD>> funA = tape(1.0);
+    std::unique_ptr<ADFun<CGD>> funB = tape(2.0);
+
+    std::set<std::string> reused = build(*funA, *funB, "cppad_cg_incremental_1");
+    ASSERT_TRUE(reused.empty());
+
+    // nothing changed
+    reused = build(*funA, *funB, "cppad_cg_incremental_2");
+    ASSERT_EQ(reused, std::set<std::string>({"model_a", "model_b"}));
+
+    // a different tape for the second model
+    std::unique_ptr<ADFun<CGD>> funB2 = tape(3.0);
+    reused = build(*funA, *funB2, "cppad_cg_incremental_3");
+    ASSERT_EQ(reused, std::set<std::string>({"model_a"}));
+
+    // the fingerprint is kept for the next builds
+    reused = build(*funA, *funB2, "cppad_cg_incremental_4");
+    ASSERT_EQ(reused, std::set<std::string>({"model_a", "model_b"}));
+}
+
+/**
+ * The generation options are part of the fingerprint
+ */
+TEST_F(CppADCGDynamicIncrementalTest, Fingerprint) {
+    std::unique_ptr<ADFun<CGD>> fun = tape(1.0);
+    std::unique_ptr<ADFun<CGD>> funSame = tape(1.0);
+    std::unique_ptr<ADFun<CGD>> funOther = tape(1.5);
+
+    ModelCSourceGen<double> model(*fun, "model");
+    ModelCSourceGen<double> modelSame(*funSame, "model");
+    ModelCSourceGen<double> modelOther(*funOther, "model");
+
+    std::string fp = model.getFingerprint(MultiThreadingType::NONE);
+
+    ASSERT_EQ(fp, model.getFingerprint(MultiThreadingType::NONE));
+    ASSERT_EQ(fp, modelSame.getFingerprint(MultiThreadingType::NONE));
+    ASSERT_NE(fp, modelOther.getFingerprint(MultiThreadingType::NONE));
+    ASSERT_NE(fp, model.getFingerprint(MultiThreadingType::PTHREADS));
+
+    model.setCreateSparseHessian(true);
+    ASSERT_NE(fp, model.getFingerprint(MultiThreadingType::NONE));
+}
@@ -0,0 +1,198 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Model where the first two independent variables are parameters whose
+ * dependent operations are cached
+ */
+class CppADCGDynamicParametersTest : public CppADCGTest {
+protected:
+    const std::string _modelName;
+    const static size_t n;
+    const static size_t m;
+    std::vector<double> x;
+    ADFun<CGD>* _fun;
+    std::unique_ptr<DynamicLib<double>> _dynamicLib;
+    std::unique_ptr<GenericModel<double>> _model;
+public:
+
+    inline CppADCGDynamicParametersTest(bool verbose = false, bool printValues = false) :
+        CppADCGTest(verbose, printValues),
+        _modelName("model_params"),
+        x(n),
+        _fun(nullptr) {
+    }
+
+    virtual void SetUp() {
+        using ADCG = AD<CGD>;
+
+        for (size_t j = 0; j < n; j++)
+            x[j] = j + 2;
+
+        // independent variables
+        std::vector<ADCG> u(n);
+        for (size_t j = 0; j < n; j++)
+            u[j] = x[j];
+
+        CppAD::Independent(u);
+
+        std::vector<ADCG> Z(m);
+        Z[0] = cos(u[0]);
+        Z[1] = u[2] * sin(u[0]) * exp(u[1]) + u[3];
+        Z[2] = u[2] * u[3] / (u[0] * u[0] + 1.0);
+        Z[3] = pow(u[1], 2) * u[3] * u[3] + log(u[0] + u[1]);
+
+        _fun = new ADFun<CGD>(u, Z);
+
+        /**
+         * Create the dynamic library
+         * (generate and compile source code)
+         */
+        ModelCSourceGen<double> compHelp(*_fun, _modelName);
+
+        compHelp.setCreateForwardZero(true);
+        compHelp.setCreateForwardOne(true);
+        compHelp.setCreateSparseJacobian(true);
+        compHelp.setCreateSparseHessian(true);
+        compHelp.setParameterIndependents({0, 1});
+
+        GccCompiler<double> compiler;
+        prepareTestCompilerFlags(compiler);
+
+        ModelLibraryCSourceGen<double> compDynHelp(compHelp);
+
+        std::map<std::string, std::string> sources = getModelSources(compDynHelp, compHelp);
+        ASSERT_TRUE(sources.find(_modelName + "_" + ModelCSourceGen<double>::FUNCTION_PRECOMPUTE_PARAMETERS + ".c") != sources.end());
+
+        DynamicModelLibraryProcessor<double> p(compDynHelp);
+
+        _dynamicLib = p.createDynamicLibrary(compiler);
+        _model = _dynamicLib->model(_modelName);
+
+        ASSERT_EQ(_model->Domain(), _fun->Domain());
+        ASSERT_EQ(_model->Range(), _fun->Range());
+    }
+
+    virtual void TearDown() {
+        _dynamicLib.reset(nullptr);
+        _model.reset(nullptr);
+        delete _fun;
+        _fun = nullptr;
+    }
+
+protected:
+
+    /**
+     * independent vectors with changes in the states and in the parameters
+     */
+    inline std::vector<std::vector<double> > values() const {
+        std::vector<std::vector<double> > xs(4, x);
+        xs[1][2] = 0.5; // state change only
+        xs[2][0] = 1.5; // parameter change
+        xs[3][1] = 4.0; // parameter change
+        xs[3][3] = -1.0;
+        return xs;
+    }
+};
+
+const size_t CppADCGDynamicParametersTest::n = 4;
+const size_t CppADCGDynamicParametersTest::m = 4;
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGDynamicParametersTest, ForwardZero) {
+    for (const auto& xv : values()) {
+        std::vector<CGD> yOrig = _fun->Forward(0, std::vector<CGD>(xv.begin(), xv.end()));
+        std::vector<double> yCG = _model->ForwardZero(xv);
+
+        ASSERT_TRUE(compareValues(yCG, yOrig));
+    }
+}
+
+TEST_F(CppADCGDynamicParametersTest, SparseJacobian) {
+    const std::vector<bool> p = jacobianSparsity<std::vector<bool>, CGD>(*_fun);
+
+    for (const auto& xv : values()) {
+        std::vector<CGD> jacOrig = _fun->SparseJacobian(std::vector<CGD>(xv.begin(), xv.end()), p);
+        std::vector<double> jacCG = _model->SparseJacobian(xv);
+
+        ASSERT_TRUE(compareValues(jacCG, jacOrig));
+    }
+}
+
+TEST_F(CppADCGDynamicParametersTest, SparseHessian) {
+    std::vector<double> w(m, 1.0);
+    w[1] = 2.0;
+    std::vector<CGD> wOrig(w.begin(), w.end());
+
+    for (const auto& xv : values()) {
+        std::vector<CGD> hessOrig = _fun->SparseHessian(std::vector<CGD>(xv.begin(), xv.end()), wOrig);
+        std::vector<double> hessCG = _model->SparseHessian(xv, w);
+
+        ASSERT_TRUE(compareValues(hessCG, hessOrig));
+    }
+}
+
+/**
+ * Each function uses its own part of the parameter cache
+ */
+TEST_F(CppADCGDynamicParametersTest, AllFunctions) {
+    const std::vector<bool> p = jacobianSparsity<std::vector<bool>, CGD>(*_fun);
+    std::vector<double> w(m, 1.0);
+    w[1] = 2.0;
+    std::vector<CGD> wOrig(w.begin(), w.end());
+
+    for (const auto& xv : values()) {
+        std::vector<CGD> xOrig(xv.begin(), xv.end());
+
+        std::vector<double> jacCG = _model->SparseJacobian(xv);
+        std::vector<double> yCG = _model->ForwardZero(xv);
+        std::vector<double> hessCG = _model->SparseHessian(xv, w);
+
+        ASSERT_TRUE(compareValues(jacCG, _fun->SparseJacobian(xOrig, p)));
+        ASSERT_TRUE(compareValues(yCG, _fun->Forward(0, xOrig)));
+        ASSERT_TRUE(compareValues(hessCG, _fun->SparseHessian(xOrig, wOrig)));
+    }
+}
+
+TEST_F(CppADCGDynamicParametersTest, ForwardOne) {
+    std::vector<double> tx(2 * n);
+    std::vector<CGD> dx(n);
+
+    for (const auto& xv : values()) {
+        for (size_t j = 0; j < n; j++) {
+            for (size_t j2 = 0; j2 < n; j2++) {
+                tx[j2 * 2] = xv[j2];
+                tx[j2 * 2 + 1] = j2 == j ? 1 : 0;
+                dx[j2] = j2 == j ? 1 : 0;
+            }
+
+            _fun->Forward(0, std::vector<CGD>(xv.begin(), xv.end()));
+            std::vector<CGD> dyOrig = _fun->Forward(1, dx);
+            std::vector<double> dyCG = _model->ForwardOne(tx);
+
+            ASSERT_TRUE(compareValues(dyCG, dyOrig));
+        }
+    }
+}
@@ -0,0 +1,81 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGDynamicProfileTest : public CppADCGTest {
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+/**
+ * Creates a dynamic library with profile guided optimizations
+ */
+TEST_F(CppADCGDynamicProfileTest, ProfileGuided) {
+    using ADCG = AD<CGD>;
+
+    const std::string modelName = "model_profile";
+    std::vector<double> x{1.0, 2.0, 0.5};
+
+    std::vector<ADCG> u(x.size());
+    for (size_t j = 0; j < x.size(); j++)
+        u[j] = x[j];
+
+    CppAD::Independent(u);
+
+    std::vector<ADCG> Z(2);
+    Z[0] = CondExpLt(u[0], u[1], u[0] * exp(u[2]), u[1] * u[2]);
+    Z[1] = CondExpGt(u[2], u[0], u[2] * u[2], sin(u[0]) * u[1]);
+
+    ADFun<CGD> fun(u, Z);
+
+    ModelCSourceGen<double> compHelp(fun, modelName);
+    compHelp.setCreateForwardZero(true);
+    compHelp.setCreateSparseJacobian(true);
+    compHelp.setCreateSparseHessian(true);
+    compHelp.setTypicalIndependentValues(x);
+
+    ModelLibraryCSourceGen<double> compDynHelp(compHelp);
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+
+    DynamicModelLibraryProcessor<double> p(compDynHelp, "cppad_cg_profile");
+    p.setProfileGuidedOptimization(true);
+    p.setProfileFolder("cppadcg_profile_test");
+
+    std::unique_ptr<DynamicLib<double>> dynamicLib = p.createDynamicLibrary(compiler);
+    std::unique_ptr<GenericModel<double>> model = dynamicLib->model(modelName);
+
+    ASSERT_TRUE(compiler.getProfileFlags().empty());
+
+    std::vector<double> xv{3.0, 2.0, 0.5};
+
+    std::vector<CGD> yOrig = fun.Forward(0, std::vector<CGD>(xv.begin(), xv.end()));
+    std::vector<double> yCG = model->ForwardZero(xv);
+    ASSERT_TRUE(compareValues(yCG, yOrig));
+
+    const std::vector<bool> sparsity = jacobianSparsity<std::vector<bool>, CGD>(fun);
+    std::vector<CGD> jacOrig = fun.SparseJacobian(std::vector<CGD>(xv.begin(), xv.end()), sparsity);
+    std::vector<double> jacCG = model->SparseJacobian(xv);
+    ASSERT_TRUE(compareValues(jacCG, jacOrig));
+}
@@ -0,0 +1,112 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGDynamicSinglePrecisionTest : public CppADCGTest {
+protected:
+
+    static void compareFloat(const std::vector<double>& expected,
+                             const std::vector<float>& values) {
+        ASSERT_EQ(expected.size(), values.size());
+        for (size_t i = 0; i < values.size(); i++) {
+            ASSERT_NEAR(expected[i], values[i], 1e-5 * std::max(1.0, std::abs(expected[i])));
+        }
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+/**
+ * Evaluates float versions of functions taped with doubles
+ */
+TEST_F(CppADCGDynamicSinglePrecisionTest, FloatFunctions) {
+    const std::string modelName = "model_single";
+    const std::string libName = "cppad_cg_single";
+    std::vector<double> x{1.0, 2.0, 0.5};
+    std::vector<double> w{1.0, 0.5};
+
+    std::vector<ADCGD> u(x.size());
+    for (size_t j = 0; j < x.size(); j++)
+        u[j] = x[j];
+
+    CppAD::Independent(u);
+
+    std::vector<ADCGD> Z(2);
+    Z[0] = u[0] * exp(u[2]) + sin(u[1]) * 0.1;
+    Z[1] = cos(u[0]) * u[1] / u[2] + pow(u[1], 3.0);
+
+    ADFun<CGD> fun(u, Z);
+
+    ModelCSourceGen<double> compHelp(fun, modelName);
+    compHelp.setCreateForwardZero(true);
+    compHelp.setCreateForwardOne(true);
+    compHelp.setCreateSparseJacobian(true);
+    compHelp.setCreateSparseHessian(true);
+    compHelp.setSinglePrecisionFunctions({ModelCSourceGen<double>::FUNCTION_FORWAD_ZERO,
+                                          ModelCSourceGen<double>::FUNCTION_SPARSE_JACOBIAN,
+                                          ModelCSourceGen<double>::FUNCTION_SPARSE_HESSIAN});
+
+    ModelLibraryCSourceGen<double> compDynHelp(compHelp);
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+
+    DynamicModelLibraryProcessor<double> p(compDynHelp, libName);
+
+    std::unique_ptr<DynamicLib<double>> dynamicLib = p.createDynamicLibrary(compiler);
+    std::unique_ptr<GenericModel<double>> model = dynamicLib->model(modelName);
+
+    ASSERT_TRUE(model->isForwardZeroFloatAvailable());
+    ASSERT_TRUE(model->isSparseJacobianFloatAvailable());
+    ASSERT_TRUE(model->isSparseHessianFloatAvailable());
+
+    std::vector<float> xf(x.begin(), x.end());
+    std::vector<float> wf(w.begin(), w.end());
+
+    // model
+    std::vector<double> y = model->ForwardZero(x);
+    std::vector<float> yf(y.size());
+    model->ForwardZeroFloat(xf, yf);
+    compareFloat(y, yf);
+
+    // sparse Jacobian
+    std::vector<double> jac;
+    std::vector<size_t> row, col;
+    model->SparseJacobian(x, jac, row, col);
+
+    std::vector<float> jacf(jac.size());
+    size_t const* rowf;
+    size_t const* colf;
+    model->SparseJacobianFloat(xf, jacf, &rowf, &colf);
+    ASSERT_EQ(row, std::vector<size_t>(rowf, rowf + row.size()));
+    ASSERT_EQ(col, std::vector<size_t>(colf, colf + col.size()));
+    compareFloat(jac, jacf);
+
+    // sparse Hessian
+    std::vector<double> hess;
+    model->SparseHessian(x, w, hess, row, col);
+
+    std::vector<float> hessf(hess.size());
+    model->SparseHessianFloat(xf, wf, hessf, &rowf, &colf);
+    compareFloat(hess, hessf);
+}
@@ -0,0 +1,137 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Model whose source code is split into many local functions at positions
+ * with few live temporary variables
+ */
+class CppADCGDynamicSplitTest : public CppADCGTest {
+protected:
+    const std::string _modelName;
+    const static size_t n;
+    const static size_t m;
+    std::vector<double> x;
+    ADFun<CGD>* _fun;
+    std::unique_ptr<DynamicLib<double>> _dynamicLib;
+    std::unique_ptr<GenericModel<double>> _model;
+public:
+
+    inline CppADCGDynamicSplitTest(bool verbose = false, bool printValues = false) :
+        CppADCGTest(verbose, printValues),
+        _modelName("model_split"),
+        x(n),
+        _fun(nullptr) {
+    }
+
+    virtual void SetUp() {
+        for (size_t j = 0; j < n; j++)
+            x[j] = 0.1 * j + 0.5;
+
+        // independent variables
+        std::vector<ADCGD> u(n);
+        for (size_t j = 0; j < n; j++)
+            u[j] = x[j];
+
+        CppAD::Independent(u);
+
+        std::vector<ADCGD> Z(m);
+        for (size_t i = 0; i < m; i++) {
+            // independent blocks of operations
+            ADCGD a = u[i % n] * u[(i + 1) % n];
+            ADCGD b = sin(a) + a * u[(i + 2) % n];
+            ADCGD c = exp(-b * b) * u[i % n];
+            Z[i] = c / (1.0 + a * a) + b;
+        }
+
+        _fun = new ADFun<CGD>(u, Z);
+
+        /**
+         * Create the dynamic library
+         * (generate and compile source code)
+         */
+        ModelCSourceGen<double> compHelp(*_fun, _modelName);
+
+        compHelp.setCreateForwardZero(true);
+        compHelp.setCreateSparseJacobian(true);
+        compHelp.setCreateSparseHessian(true);
+        compHelp.setMaxAssignmentsPerFunc(20);
+        compHelp.setSplitMinimizingLiveVariables(true);
+
+        GccCompiler<double> compiler;
+        prepareTestCompilerFlags(compiler);
+
+        ModelLibraryCSourceGen<double> compDynHelp(compHelp);
+
+        DynamicModelLibraryProcessor<double> p(compDynHelp, "cppad_cg_split");
+
+        _dynamicLib = p.createDynamicLibrary(compiler);
+        _model = _dynamicLib->model(_modelName);
+
+        // the code was split into several local functions
+        bool split = false;
+        for (const auto& it : compHelp.getSourceStatistics()) {
+            if (it.first.find("__") != std::string::npos)
+                split = true;
+        }
+        ASSERT_TRUE(split);
+    }
+
+    virtual void TearDown() {
+        _dynamicLib.reset(nullptr);
+        _model.reset(nullptr);
+        delete _fun;
+        _fun = nullptr;
+    }
+};
+
+const size_t CppADCGDynamicSplitTest::n = 5;
+const size_t CppADCGDynamicSplitTest::m = 12;
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGDynamicSplitTest, ForwardZero) {
+    std::vector<CGD> yOrig = _fun->Forward(0, std::vector<CGD>(x.begin(), x.end()));
+    std::vector<double> yCG = _model->ForwardZero(x);
+
+    ASSERT_TRUE(compareValues(yCG, yOrig));
+}
+
+TEST_F(CppADCGDynamicSplitTest, SparseJacobian) {
+    const std::vector<bool> p = jacobianSparsity<std::vector<bool>, CGD>(*_fun);
+
+    std::vector<CGD> jacOrig = _fun->SparseJacobian(std::vector<CGD>(x.begin(), x.end()), p);
+    std::vector<double> jacCG = _model->SparseJacobian(x);
+
+    ASSERT_TRUE(compareValues(jacCG, jacOrig));
+}
+
+TEST_F(CppADCGDynamicSplitTest, SparseHessian) {
+    std::vector<double> w(m, 1.0);
+    std::vector<CGD> wOrig(w.begin(), w.end());
+
+    std::vector<CGD> hessOrig = _fun->SparseHessian(std::vector<CGD>(x.begin(), x.end()), wOrig);
+    std::vector<double> hessCG = _model->SparseHessian(x, w);
+
+    ASSERT_TRUE(compareValues(hessCG, hessOrig));
+}
@@ -0,0 +1,145 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGDynamicSplitModelsTest : public CppADCGTest {
+protected:
+    const std::vector<double> x_{1.0, 2.0, 0.5};
+
+    std::unique_ptr<ADFun<CGD>> tape(double coefficient) {
+        std::vector<ADCGD> u(x_.size());
+        for (size_t j = 0; j < x_.size(); j++)
+            u[j] = x_[j];
+
+        CppAD::Independent(u);
+
+        std::vector<ADCGD> Z(2);
+        Z[0] = coefficient * u[0] * exp(u[2]) + u[1] * u[1];
+        Z[1] = cos(u[0]) * u[1] / (coefficient * u[2]);
+
+        return std::unique_ptr<ADFun<CGD>>(new ADFun<CGD>(u, Z));
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+/**
+ * Each model is placed in its own dynamic library which is only loaded
+ * when the model is requested
+ */
+TEST_F(CppADCGDynamicSplitModelsTest, LazyLoading) {
+    const std::string libName = "cppad_cg_split_models";
+
+    std::unique_ptr<ADFun<CGD>> funA = tape(1.0);
+    std::unique_ptr<ADFun<CGD>> funB = tape(2.0);
+
+    ModelCSourceGen<double> modelA(*funA, "model_a");
+    modelA.setCreateForwardZero(true);
+    modelA.setCreateSparseJacobian(true);
+
+    ModelCSourceGen<double> modelB(*funB, "model_b");
+    modelB.setCreateForwardZero(true);
+    modelB.setCreateSparseJacobian(true);
+
+    ModelLibraryCSourceGen<double> libSrc(modelA, modelB);
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+
+    DynamicModelLibraryProcessor<double> p(libSrc, libName);
+    p.setSplitModels(true);
+    p.getOptions()["dlOpenMode"] = std::to_string(RTLD_LAZY);
+
+    std::unique_ptr<DynamicLib<double>> dynamicLib = p.createDynamicLibrary(compiler);
+
+    ASSERT_TRUE(system::isFile(p.getModelLibraryPath("model_a")));
+    ASSERT_TRUE(system::isFile(p.getModelLibraryPath("model_b")));
+
+    auto* lib = dynamic_cast<LinuxDynamicLib<double>*>(dynamicLib.get());
+    ASSERT_TRUE(lib != nullptr);
+    ASSERT_TRUE(lib->isSplitModels());
+    ASSERT_EQ(lib->getModelNames(), std::set<std::string>({"model_a", "model_b"}));
+    ASSERT_FALSE(lib->isModelLibraryLoaded("model_a"));
+    ASSERT_FALSE(lib->isModelLibraryLoaded("model_b"));
+
+    std::unique_ptr<GenericModel<double>> model = lib->model("model_a");
+    ASSERT_TRUE(model != nullptr);
+    ASSERT_TRUE(lib->isModelLibraryLoaded("model_a"));
+    ASSERT_FALSE(lib->isModelLibraryLoaded("model_b"));
+
+    std::vector<CGD> xOrig(x_.begin(), x_.end());
+    ASSERT_TRUE(compareValues(model->ForwardZero(x_), funA->Forward(0, xOrig)));
+
+    const std::vector<bool> sparsity = jacobianSparsity<std::vector<bool>, CGD>(*funA);
+    ASSERT_TRUE(compareValues(model->SparseJacobian(x_), funA->SparseJacobian(xOrig, sparsity)));
+
+    model = lib->model("model_b");
+    ASSERT_TRUE(lib->isModelLibraryLoaded("model_b"));
+    ASSERT_TRUE(compareValues(model->ForwardZero(x_), funB->Forward(0, xOrig)));
+}
+
+/**
+ * Each model in a separate dynamic library gets its own copy of the constant
+ * pool
+ */
+TEST_F(CppADCGDynamicSplitModelsTest, ConstantPool) {
+    const std::string libName = "cppad_cg_split_models_pool";
+
+    // long constants which are saved in the constant pool
+    std::unique_ptr<ADFun<CGD>> funA = tape(1.0 / 3.0);
+    std::unique_ptr<ADFun<CGD>> funB = tape(2.0 / 3.0);
+
+    ModelCSourceGen<double> modelA(*funA, "model_pool_a");
+    modelA.setCreateForwardZero(true);
+    modelA.setCreateSparseJacobian(true);
+
+    ModelCSourceGen<double> modelB(*funB, "model_pool_b");
+    modelB.setCreateForwardZero(true);
+
+    ModelLibraryCSourceGen<double> libSrc(modelA, modelB);
+    libSrc.setUseConstantPool(true);
+
+    const std::map<std::string, std::string>& libSources = libSrc.getLibrarySources();
+    ASSERT_TRUE(libSources.find(libSrc.getConstantPool().getName() + ".c") != libSources.end());
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+
+    DynamicModelLibraryProcessor<double> p(libSrc, libName);
+    p.setSplitModels(true);
+
+    std::unique_ptr<DynamicLib<double>> dynamicLib = p.createDynamicLibrary(compiler);
+
+    std::vector<CGD> xOrig(x_.begin(), x_.end());
+
+    std::unique_ptr<GenericModel<double>> model = dynamicLib->model("model_pool_a");
+    ASSERT_TRUE(model != nullptr);
+    ASSERT_TRUE(compareValues(model->ForwardZero(x_), funA->Forward(0, xOrig)));
+
+    const std::vector<bool> sparsity = jacobianSparsity<std::vector<bool>, CGD>(*funA);
+    ASSERT_TRUE(compareValues(model->SparseJacobian(x_), funA->SparseJacobian(xOrig, sparsity)));
+
+    model = dynamicLib->model("model_pool_b");
+    ASSERT_TRUE(model != nullptr);
+    ASSERT_TRUE(compareValues(model->ForwardZero(x_), funB->Forward(0, xOrig)));
+}
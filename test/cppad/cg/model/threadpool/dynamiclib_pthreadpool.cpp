@@ -109,6 +109,60 @@ TEST_F(CppADCGThreadPoolTest, StaticFullVars) {
     this->testDynamicFull(u, x, 1000);
 }
 
+TEST_F(CppADCGThreadPoolTest, DynamicJobRangesFullVars) {
+    this->_multithreadDisabled = false;
+    this->_multithreadScheduler = ThreadPoolScheduleStrategy::DYNAMIC;
+    this->_multithreadMaxJobs = 2; // several functions per job
+
+    this->_reverseOne = true;
+    this->_reverseTwo = true;
+    this->_denseJacobian = false;
+    this->_denseHessian = false;
+
+    this->testDynamicFull(u, x, 1000);
+}
+
+TEST_F(CppADCGThreadPoolTest, DynamicOneJobPerFunctionFullVars) {
+    this->_multithreadDisabled = false;
+    this->_multithreadScheduler = ThreadPoolScheduleStrategy::DYNAMIC;
+    this->_multithreadMaxJobs = 0;
+
+    this->_reverseOne = true;
+    this->_reverseTwo = true;
+    this->_denseJacobian = false;
+    this->_denseHessian = false;
+
+    this->testDynamicFull(u, x, 1000);
+}
+
+TEST_F(CppADCGThreadPoolTest, StaticCostGroupedFullVars) {
+    this->_multithreadDisabled = false;
+    this->_multithreadScheduler = ThreadPoolScheduleStrategy::STATIC;
+    this->_multithreadMinJobCost = 40; // groups the cheapest functions
+
+    this->_reverseOne = true;
+    this->_reverseTwo = true;
+    this->_denseJacobian = false;
+    this->_denseHessian = false;
+
+    this->testDynamicFull(u, x, 1000);
+}
+
+TEST_F(CppADCGThreadPoolTest, StickyJobsFullVars) {
+    this->_multithreadDisabled = false;
+    this->_multithreadScheduler = ThreadPoolScheduleStrategy::STATIC;
+    this->_multithreadStickyJobs = true;
+    this->_multithreadAffinity = ThreadPoolAffinityPolicy::COMPACT;
+    this->_multithreadSpinWait = 10000;
+
+    this->_reverseOne = true;
+    this->_reverseTwo = true;
+    this->_denseJacobian = false;
+    this->_denseHessian = false;
+
+    this->testDynamicFull(u, x, 1000);
+}
+
 TEST_F(CppADCGThreadPoolTest, DynamicCustomElements) {
     this->_multithreadScheduler = ThreadPoolScheduleStrategy::DYNAMIC;
 
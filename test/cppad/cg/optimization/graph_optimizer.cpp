@@ -0,0 +1,149 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGGraphOptimizerTest : public CppADCGTest {
+protected:
+    std::unique_ptr<ADFun<CGD>> _fun;
+    std::vector<double> x;
+public:
+
+    virtual void SetUp() {
+        x = {0.5, 1.5, 2.0};
+
+        std::vector<ADCGD> u(x.size());
+        for (size_t j = 0; j < x.size(); j++)
+            u[j] = x[j];
+
+        CppAD::Independent(u);
+
+        std::vector<ADCGD> Z(4);
+        Z[0] = sin(u[0]) * u[1] + u[1] * sin(u[0]);
+        Z[1] = (u[0] - 2.0) * (u[0] + (-2.0)) - (-u[2]);
+        Z[2] = -(-u[1]) * exp(u[2]) + u[1] * exp(u[2]);
+        Z[3] = CondExpLt(u[0], u[1], (-u[0]) * (-u[2]), u[0] * u[2]);
+
+        _fun.reset(new ADFun<CGD>(u, Z));
+    }
+
+    virtual void TearDown() {
+        _fun.reset(nullptr);
+    }
+
+protected:
+
+    static inline std::vector<double> values(const std::vector<CGD>& v) {
+        std::vector<double> r(v.size());
+        for (size_t i = 0; i < v.size(); i++)
+            r[i] = v[i].getValue();
+        return r;
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGGraphOptimizerTest, DefaultPasses) {
+    GraphOptimizer<double> optimizer;
+    std::unique_ptr<ADFun<CGD>> funOpt = optimizer.optimize(*_fun, x);
+
+    ASSERT_EQ(funOpt->Domain(), _fun->Domain());
+    ASSERT_EQ(funOpt->Range(), _fun->Range());
+    ASSERT_LT(optimizer.getOptimizedOperationCount(), optimizer.getOriginalOperationCount());
+
+    std::vector<std::vector<double>> xs{x, {2.0, 1.0, 0.5}};
+    for (const std::vector<double>& xx : xs) {
+        std::vector<CGD> xcg(xx.begin(), xx.end());
+
+        std::vector<CGD> y = _fun->Forward(0, xcg);
+        std::vector<CGD> yOpt = funOpt->Forward(0, xcg);
+        ASSERT_TRUE(compareValues(values(yOpt), y));
+
+        std::vector<CGD> jac = _fun->Jacobian(xcg);
+        std::vector<CGD> jacOpt = funOpt->Jacobian(xcg);
+        ASSERT_TRUE(compareValues(values(jacOpt), jac));
+    }
+}
+
+TEST_F(CppADCGGraphOptimizerTest, CommonSubexpressions) {
+    CodeHandler<double> handler;
+    std::vector<CGD> indep(2);
+    handler.makeVariables(indep);
+
+    std::vector<CGD> dep(3);
+    dep[0] = indep[0] * indep[1];
+    dep[1] = indep[1] * indep[0];
+    dep[2] = indep[0] - 3.0;
+
+    // canonicalization
+    CodeHandler<double> handler2;
+    std::vector<CGD> indep2(2);
+    handler2.makeVariables(indep2);
+
+    EvaluatorCanonical<double> canonical(handler);
+    std::vector<CGD> dep2 = canonical.evaluate(indep2, dep);
+
+    ASSERT_EQ(dep2[2].getOperationNode()->getOperationType(), CGOpCode::Add);
+
+    // common subexpression elimination
+    CodeHandler<double> handler3;
+    std::vector<CGD> indep3(2);
+    handler3.makeVariables(indep3);
+
+    EvaluatorCSE<double> cse(handler2);
+    std::vector<CGD> dep3 = cse.evaluate(indep3, dep2);
+
+    ASSERT_EQ(cse.getMergedOperationCount(), 1u);
+    ASSERT_EQ(dep3[0].getOperationNode(), dep3[1].getOperationNode());
+    ASSERT_EQ(GraphOptimizer<double>::countOperations(handler3, dep3), 4u);
+}
+
+TEST_F(CppADCGGraphOptimizerTest, SignedZeroParameters) {
+    CodeHandler<double> handler;
+    std::vector<CGD> indep(1);
+    handler.makeVariables(indep);
+
+    std::vector<CGD> dep(2);
+    dep[0] = indep[0] / 0.0;
+    dep[1] = indep[0] / -0.0; // different sign
+
+    CodeHandler<double> handler2;
+    std::vector<CGD> indep2(1);
+    handler2.makeVariables(indep2);
+
+    EvaluatorCSE<double> cse(handler);
+    std::vector<CGD> dep2 = cse.evaluate(indep2, dep);
+
+    ASSERT_EQ(cse.getMergedOperationCount(), 0u);
+    ASSERT_NE(dep2[0].getOperationNode(), dep2[1].getOperationNode());
+}
+
+TEST_F(CppADCGGraphOptimizerTest, DeadCodeOnly) {
+    GraphOptimizer<double> optimizer(false);
+    optimizer.addPass(std::unique_ptr<GraphOptimizationPass<double>>(new DeadCodeEliminationPass<double>()));
+
+    std::unique_ptr<ADFun<CGD>> funOpt = optimizer.optimize(*_fun, x);
+
+    ASSERT_LE(optimizer.getOptimizedOperationCount(), optimizer.getOriginalOperationCount());
+
+    std::vector<CGD> xcg(x.begin(), x.end());
+    ASSERT_TRUE(compareValues(values(funOpt->Forward(0, xcg)), _fun->Forward(0, xcg)));
+}
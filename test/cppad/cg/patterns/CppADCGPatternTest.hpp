@@ -40,6 +40,10 @@ protected:
     Base hessianEpsilonR_;
     std::vector<std::set<size_t> > customJacSparsity_;
     std::vector<std::set<size_t> > customHessSparsity_;
+    bool vectorizeLoops_;
+    bool vectorMathLibrary_;
+    // the sources of the last model created with loops
+    std::map<std::string, std::string> loopSources_;
 private:
     std::unique_ptr<DefaultPatternTestModel<CG<Base> > > modelMem_;
 public:
@@ -53,7 +57,9 @@ public:
         epsilonA_(std::numeric_limits<Base>::epsilon() * 1e2),
         epsilonR_(std::numeric_limits<Base>::epsilon() * 1e2),
         hessianEpsilonA_(std::numeric_limits<Base>::epsilon() * 1e2),
-        hessianEpsilonR_(std::numeric_limits<Base>::epsilon() * 1e2) {
+        hessianEpsilonR_(std::numeric_limits<Base>::epsilon() * 1e2),
+        vectorizeLoops_(false),
+        vectorMathLibrary_(false) {
         //this->verbose_ = true;
     }
 
@@ -400,6 +406,7 @@ public:
         compHelpL.setRelatedDependents(relatedDepCandidates);
         compHelpL.setTypicalIndependentValues(xTypical);
         compHelpL.setParameterPrecision(std::numeric_limits<Base>::digits10 + 4);
+        compHelpL.setVectorizeLoops(vectorizeLoops_);
 
         if (!customJacSparsity_.empty())
             compHelpL.setCustomSparseJacobianElements(customJacSparsity_);
@@ -409,6 +416,10 @@ public:
 
         GccCompiler<double> compiler;
         prepareTestCompilerFlags(compiler);
+        if (vectorMathLibrary_)
+            compiler.setVectorMathLibrary(true);
+        else if (vectorizeLoops_)
+            compiler.addCompileFlag("-fopenmp-simd");
         compiler.setSourcesFolder("sources_" + libBaseName);
         compiler.setSaveToDiskFirst(true);
 
@@ -417,6 +428,8 @@ public:
 
         //SaveFilesModelLibraryProcessor<double>::saveLibrarySourcesTo(compDynHelpL, "sources_" + libBaseName);
 
+        loopSources_ = getModelSources(compDynHelpL, compHelpL);
+
         DynamicModelLibraryProcessor<double> p(compDynHelpL, libBaseName + "Loops");
         std::unique_ptr<DynamicLib<double> > dynamicLibL = p.createDynamicLibrary(compiler);
         std::unique_ptr<GenericModel<double> > modelL;
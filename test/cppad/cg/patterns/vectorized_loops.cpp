@@ -0,0 +1,192 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGPatternTest.hpp"
+
+using Base = double;
+using CGD = CppAD::cg::CG<Base>;
+using ADCGD = CppAD::AD<CGD>;
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+/**
+ * Provides the loops annotated for vectorization in the zero order
+ * forward mode sources of a model
+ */
+std::vector<std::string> findSimdLoops(const std::map<std::string, std::string>& sources) {
+    const std::string pragma = "#pragma omp simd";
+
+    std::vector<std::string> loops;
+    for (const auto& it : sources) {
+        if (it.first.find("forward_zero") == std::string::npos)
+            continue;
+
+        const std::string& source = it.second;
+        for (size_t pos = source.find(pragma); pos != std::string::npos; pos = source.find(pragma, pos + 1)) {
+            size_t start = source.find('\n', pos) + 1;
+            size_t end = start;
+            size_t depth = 0;
+            for (; end < source.size(); end++) {
+                if (source[end] == '{') {
+                    depth++;
+                } else if (source[end] == '}' && --depth == 0) {
+                    break;
+                }
+            }
+            loops.push_back(source.substr(start, end + 1 - start));
+        }
+    }
+
+    return loops;
+}
+
+/**
+ * @test Model with independent iterations which call mathematical
+ *       functions (loops annotated for vectorization)
+ */
+std::vector<ADCGD> modelVectorizedLoops(const std::vector<ADCGD>& x, size_t repeat) {
+    size_t m = 2;
+    size_t n = 2;
+
+    std::vector<ADCGD> y(repeat * m);
+
+    for (size_t i = 0; i < repeat; i++) {
+        ADCGD a = exp(x[i * n]) * sin(x[i * n + 1]);
+        y[i * m] = a + x[i * n] * x[i * n];
+        y[i * m + 1] = log(1.0 + x[i * n + 1] * x[i * n + 1]) * cos(a);
+    }
+
+    return y;
+}
+
+TEST_F(CppADCGPatternTest, modelVectorizedLoops) {
+    size_t m = 2;
+    size_t n = 2;
+    size_t repeat = 8;
+
+    vectorizeLoops_ = true;
+    vectorMathLibrary_ = true;
+
+    setModel(modelVectorizedLoops);
+
+    testLibCreation("modelVectorizedLoops", m, n, repeat);
+
+    std::vector<std::string> loops = findSimdLoops(loopSources_);
+    ASSERT_FALSE(loops.empty());
+
+    bool loopTemporaries = false;
+    for (const std::string& loop : loops) {
+        // the pragma must be right before the loop
+        ASSERT_EQ(0, loop.compare(loop.find_first_not_of(' '), 4, "for("));
+        // the temporary variables used several times in an iteration
+        // are declared inside the loop body
+        if (loop.find(" lt") != std::string::npos)
+            loopTemporaries = true;
+    }
+    ASSERT_TRUE(loopTemporaries);
+}
+
+TEST_F(CppADCGPatternTest, modelVectorizedLoopsDisabled) {
+    size_t m = 2;
+    size_t n = 2;
+    size_t repeat = 8;
+
+    setModel(modelVectorizedLoops);
+
+    testLibCreation("modelVectorizedLoopsDisabled", m, n, repeat);
+
+    ASSERT_TRUE(findSimdLoops(loopSources_).empty());
+}
+
+/**
+ * @test Model with iterations which depend on a shared value (accumulation
+ *       between iterations must not be vectorized)
+ */
+std::vector<ADCGD> modelVectorizedLoopsShared(const std::vector<ADCGD>& x, size_t repeat) {
+    size_t m = 1;
+    size_t n = 2;
+
+    std::vector<ADCGD> y(repeat * m);
+
+    ADCGD sum = 0;
+    for (size_t i = 0; i < repeat; i++) {
+        sum += exp(x[i * n]) * x[i * n + 1];
+    }
+    for (size_t i = 0; i < repeat; i++) {
+        y[i] = sum * x[i * n + 1];
+    }
+
+    return y;
+}
+
+TEST_F(CppADCGPatternTest, modelVectorizedLoopsShared) {
+    size_t m = 1;
+    size_t n = 2;
+    size_t repeat = 6;
+
+    vectorizeLoops_ = true;
+
+    setModel(modelVectorizedLoopsShared);
+
+    testLibCreation("modelVectorizedLoopsShared", m, n, repeat);
+}
+
+/**
+ * @test Model with iterations which call an atomic function (loops with
+ *       atomic functions must not be vectorized)
+ */
+std::vector<ADCGD> modelVectorizedLoopsAtomic(const std::vector<ADCGD>& x, size_t repeat, atomic_base<CGD>& atomic) {
+    size_t m = 2;
+    size_t n = 2;
+
+    std::vector<ADCGD> y(repeat * m), ax(2), ay(2);
+
+    for (size_t i = 0; i < repeat; i++) {
+        ax[0] = x[i * n];
+        ax[1] = x[i * n + 1];
+        atomic(ax, ay);
+        y[i * m] = exp(ay[0]);
+        y[i * m + 1] = ay[1] * ay[0];
+    }
+
+    return y;
+}
+
+void vectorizedLoopsAtomicFunction(const std::vector<AD<double> >& x,
+                                   std::vector<AD<double> >& y) {
+    y[0] = x[0] * x[1];
+    y[1] = 2 * x[1] * x[1];
+}
+
+TEST_F(CppADCGPatternTest, modelVectorizedLoopsAtomic) {
+    size_t m = 2;
+    size_t n = 2;
+    size_t repeat = 6;
+
+    std::vector<AD<double> > ay(2), ax(2);
+    checkpoint<double> atomicfun("vectorizedLoopsAtomicFunc", vectorizedLoopsAtomicFunction, ax, ay);
+    CGAtomicFun<double> cgatomicfun(atomicfun, ax, true);
+    PatternTestModelWithAtom<CGD> model(modelVectorizedLoopsAtomic, cgatomicfun);
+    setModel(model);
+    this->atoms_.push_back(&atomicfun);
+
+    vectorizeLoops_ = true;
+
+    testLibCreation("modelVectorizedLoopsAtomic", m, n, repeat);
+
+    for (const std::string& loop : findSimdLoops(loopSources_)) {
+        ASSERT_EQ(std::string::npos, loop.find("atomicFun.forward("));
+    }
+}
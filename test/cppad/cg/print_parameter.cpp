@@ -0,0 +1,74 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+template<class Base>
+std::string generate(const std::vector<Base>& values,
+                     size_t precision) {
+    CodeHandler<Base> handler;
+
+    std::vector<CG<Base> > x(1);
+    handler.makeVariables(x);
+
+    std::vector<CG<Base> > y(values.size());
+    for (size_t i = 0; i < values.size(); i++)
+        y[i] = x[0] * values[i];
+
+    LanguageC<Base> langC("double");
+    langC.setParameterPrecision(precision);
+    LangCDefaultVariableNameGenerator<Base> nameGen;
+
+    std::ostringstream code;
+    handler.generateCode(code, langC, y, nameGen);
+    return code.str();
+}
+
+} // END namespace
+
+TEST(CppADCGPrintParameterTest, ShortestRoundTrip) {
+    std::vector<double> values{0.1, 9.80665, 1.0 / 3.0, 3.0, 1e-7};
+
+    std::string code = generate(values, std::numeric_limits<double>::max_digits10);
+
+    ASSERT_NE(std::string::npos, code.find(" 0.1;"));
+    ASSERT_NE(std::string::npos, code.find(" 9.80665;"));
+    ASSERT_NE(std::string::npos, code.find(" 0.3333333333333333;"));
+    ASSERT_NE(std::string::npos, code.find(" 3.;")); // avoid integer operations
+    ASSERT_NE(std::string::npos, code.find(" 1e-07;"));
+    ASSERT_EQ(std::string::npos, code.find("0.10000000000000001"));
+}
+
+TEST(CppADCGPrintParameterTest, DefaultPrecision) {
+    std::vector<double> values{0.1, 1.0 / 3.0};
+
+    std::string code = generate(values, std::numeric_limits<double>::digits10);
+
+    ASSERT_NE(std::string::npos, code.find(" 0.1;"));
+    ASSERT_NE(std::string::npos, code.find(" 0.333333333333333;"));
+}
+
+TEST(CppADCGPrintParameterTest, Float) {
+    std::vector<float> values{0.1f, 2.5f};
+
+    std::string code = generate(values, std::numeric_limits<float>::max_digits10);
+
+    ASSERT_NE(std::string::npos, code.find(" 0.1;"));
+    ASSERT_NE(std::string::npos, code.find(" 2.5;"));
+}
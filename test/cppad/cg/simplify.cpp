@@ -0,0 +1,101 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+size_t count(const std::map<CGOpCode, size_t>& counts, CGOpCode op) {
+    auto it = counts.find(op);
+    return it == counts.end() ? 0 : it->second;
+}
+
+std::string generate(CodeHandler<double>& handler,
+                     std::vector<CG<double> >& dep) {
+    LanguageC<double> langC("double");
+    LangCDefaultVariableNameGenerator<double> nameGen;
+
+    std::ostringstream code;
+    handler.generateCode(code, langC, dep, nameGen);
+    return code.str();
+}
+
+} // END namespace
+
+TEST(CppADCGSimplifyTest, PowAndIdentities) {
+    CodeHandler<double> handler;
+    handler.setSimplifyOperations(true);
+
+    std::vector<CG<double> > x(2);
+    handler.makeVariables(x);
+
+    std::vector<CG<double> > y(4);
+    y[0] = pow(x[0], 2.0) + pow(x[1], 3.0);
+    y[1] = pow(x[0], 0.5);
+    y[2] = -(-x[1]);
+    y[3] = x[0] / 4.0;
+
+    std::string code = generate(handler, y);
+
+    const auto& before = handler.getOperationCountBeforeSimplification();
+    const auto& after = handler.getOperationCountAfterSimplification();
+
+    ASSERT_EQ(size_t(3), count(before, CGOpCode::Pow));
+    ASSERT_EQ(size_t(2), count(before, CGOpCode::UnMinus));
+
+    ASSERT_EQ(size_t(0), count(after, CGOpCode::Pow));
+    ASSERT_EQ(size_t(0), count(after, CGOpCode::UnMinus));
+    ASSERT_EQ(size_t(1), count(after, CGOpCode::Sqrt));
+    ASSERT_EQ(size_t(3), count(after, CGOpCode::Mul));
+    ASSERT_EQ(size_t(1), count(after, CGOpCode::Div)); // not replaced by default
+
+    ASSERT_EQ(std::string::npos, code.find("pow("));
+    ASSERT_NE(std::string::npos, code.find("sqrt("));
+}
+
+TEST(CppADCGSimplifyTest, DivisionByConstant) {
+    CodeHandler<double> handler;
+    handler.setSimplifyOperations(true);
+    handler.setDivisionByConstantAsMultiplication(true);
+
+    std::vector<CG<double> > x(1);
+    handler.makeVariables(x);
+
+    std::vector<CG<double> > y(1);
+    y[0] = x[0] / 4.0;
+
+    std::string code = generate(handler, y);
+
+    const auto& after = handler.getOperationCountAfterSimplification();
+    ASSERT_EQ(size_t(0), count(after, CGOpCode::Div));
+    ASSERT_EQ(size_t(1), count(after, CGOpCode::Mul));
+    ASSERT_NE(std::string::npos, code.find("0.25"));
+}
+
+TEST(CppADCGSimplifyTest, Disabled) {
+    CodeHandler<double> handler;
+
+    std::vector<CG<double> > x(1);
+    handler.makeVariables(x);
+
+    std::vector<CG<double> > y(1);
+    y[0] = pow(x[0], 2.0);
+
+    std::string code = generate(handler, y);
+
+    ASSERT_NE(std::string::npos, code.find("pow("));
+}